@@ -16,7 +16,8 @@ using namespace swss;
 #define LOOPBACK_PREFIX     "Loopback"
 #define VNET_PREFIX         "Vnet"
 
-IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
+IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+                 bool useNetlink) :
         Orch(cfgDb, tableNames),
         m_cfgIntfTable(cfgDb, CFG_INTF_TABLE_NAME),
         m_cfgVlanIntfTable(cfgDb, CFG_VLAN_INTF_TABLE_NAME),
@@ -27,11 +28,32 @@ IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
         m_stateIntfTable(stateDb, STATE_INTERFACE_TABLE_NAME),
         m_appIntfTableProducer(appDb, APP_INTF_TABLE_NAME)
 {
+    if (useNetlink)
+    {
+        m_netlink = unique_ptr<NetlinkCmd>(new NetlinkCmd());
+    }
 }
 
 void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
                         const string &ipPrefixStr, const bool ipv4)
 {
+    if (m_netlink)
+    {
+        if (opCmd == "add")
+        {
+            m_netlink->addAddress(alias, IpPrefix(ipPrefixStr));
+        }
+        else
+        {
+            m_netlink->delAddress(alias, IpPrefix(ipPrefixStr));
+        }
+        if (!m_netlink->commit())
+        {
+            SWSS_LOG_ERROR("Netlink request failed: %s", m_netlink->getError().c_str());
+        }
+        return;
+    }
+
     stringstream cmd;
     string res;
 
@@ -52,6 +74,16 @@ void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
 
 void IntfMgr::setIntfVrf(const string &alias, const string vrfName)
 {
+    if (m_netlink)
+    {
+        m_netlink->setLinkMaster(alias, vrfName);
+        if (!m_netlink->commit())
+        {
+            throw runtime_error(m_netlink->getError());
+        }
+        return;
+    }
+
     stringstream cmd;
     string res;
 
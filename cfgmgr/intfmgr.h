@@ -4,8 +4,10 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netlinkcmd.h"
 
 #include <map>
+#include <memory>
 #include <string>
 
 namespace swss {
@@ -13,13 +15,15 @@ namespace swss {
 class IntfMgr : public Orch
 {
 public:
-    IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames);
+    IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+            bool useNetlink = false);
     using Orch::doTask;
 
 private:
     ProducerStateTable m_appIntfTableProducer;
     Table m_cfgIntfTable, m_cfgVlanIntfTable;
     Table m_statePortTable, m_stateLagTable, m_stateVlanTable, m_stateVrfTable, m_stateIntfTable;
+    std::unique_ptr<NetlinkCmd> m_netlink;
 
     void setIntfIp(const string &alias, const string &opCmd, const string &ipPrefixStr, const bool ipv4 = true);
     void setIntfVrf(const string &alias, const string vrfName);
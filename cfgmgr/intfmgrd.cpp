@@ -1,3 +1,4 @@
+#include <getopt.h>
 #include <unistd.h>
 #include <vector>
 #include <mutex>
@@ -6,6 +7,7 @@
 #include "exec.h"
 #include "schema.h"
 #include "intfmgr.h"
+#include "swssrecorder.h"
 #include <fstream>
 #include <iostream>
 
@@ -26,13 +28,37 @@ using namespace swss;
 int gBatchSize = 0;
 bool gSwssRecord = false;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
+SwssRecorder gSwssRecorder;
 /* Global database mutex */
 mutex gDbMutex;
 
+void usage()
+{
+    cout << "Usage: intfmgrd [-n]" << endl;
+    cout << "       -n: program the kernel through netlink instead of /sbin/ip" << endl;
+}
+
 int main(int argc, char **argv)
 {
+    int opt;
+    bool useNetlink = false;
+
+    while ((opt = getopt(argc, argv, "nh")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'n':
+            useNetlink = true;
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     Logger::linkToDbNative("intfmgrd");
     SWSS_LOG_ENTER();
 
@@ -51,7 +77,7 @@ int main(int argc, char **argv)
         DBConnector appDb(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
         DBConnector stateDb(STATE_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
 
-        IntfMgr intfmgr(&cfgDb, &appDb, &stateDb, cfg_intf_tables);
+        IntfMgr intfmgr(&cfgDb, &appDb, &stateDb, cfg_intf_tables, useNetlink);
 
         // TODO: add tables in stateDB which interface depends on to monitor list
         std::vector<Orch *> cfgOrchList = {&intfmgr};
@@ -0,0 +1,568 @@
+#include <string.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <linux/if_bridge.h>
+#include <linux/if_link.h>
+#include <linux/rtnetlink.h>
+#include <netlink/netlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <stdexcept>
+#include "logger.h"
+#include "netlinkcmd.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * Limits of a multipart batch. The acks of a whole batch must fit in the
+ * receive buffer, failure acks carry a copy of the request.
+ */
+#define BATCH_MAX_REQUESTS      256
+#define BATCH_MAX_BYTES         (64 * 1024)
+#define SOCKET_BUFFER_SIZE      (4 * 1024 * 1024)
+
+NetlinkCmd::NetlinkCmd() :
+    m_sock(NULL),
+    m_seq(0),
+    m_failed(false)
+{
+    SWSS_LOG_ENTER();
+
+    m_sock = nl_socket_alloc();
+    if (!m_sock)
+    {
+        throw runtime_error("Netlink socket alloc failed");
+    }
+
+    int err = nl_connect(m_sock, NETLINK_ROUTE);
+    if (err < 0)
+    {
+        nl_socket_free(m_sock);
+        throw runtime_error(string("Netlink socket connect failed: ") + nl_geterror(err));
+    }
+
+    /* Acks are requested and collected per request */
+    nl_socket_disable_auto_ack(m_sock);
+    nl_socket_set_buffer_size(m_sock, SOCKET_BUFFER_SIZE, SOCKET_BUFFER_SIZE);
+}
+
+NetlinkCmd::~NetlinkCmd()
+{
+    nl_socket_free(m_sock);
+}
+
+int NetlinkCmd::getIfIndex(const string &name)
+{
+    /* The index changes when a queued request creates or deletes the link */
+    if (m_pendingLinks.find(name) != m_pendingLinks.end() && !commit())
+    {
+        m_failed = true;
+    }
+
+    return (int)if_nametoindex(name.c_str());
+}
+
+struct nl_msg *NetlinkCmd::allocLinkMsg(int type, int flags, int family, int ifindex, const string &name)
+{
+    struct nl_msg *msg = nlmsg_alloc_simple(type, NLM_F_REQUEST | NLM_F_ACK | flags);
+    if (!msg)
+    {
+        throw runtime_error("Netlink message alloc failed");
+    }
+
+    struct ifinfomsg ifi;
+    memset(&ifi, 0, sizeof(ifi));
+    ifi.ifi_family = (unsigned char)family;
+    ifi.ifi_index = ifindex;
+    nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO);
+
+    /* Links are looked up by name when no index is given */
+    if (ifindex == 0)
+    {
+        nla_put_string(msg, IFLA_IFNAME, name.c_str());
+    }
+
+    return msg;
+}
+
+void NetlinkCmd::queue(struct nl_msg *msg, const string &description)
+{
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+    hdr->nlmsg_seq = ++m_seq;
+
+    size_t len = hdr->nlmsg_len;
+    const char *data = reinterpret_cast<const char *>(hdr);
+    m_batch.insert(m_batch.end(), data, data + len);
+    m_batch.resize(m_batch.size() + NLMSG_ALIGN(len) - len, 0);
+
+    m_requests.push_back({ hdr->nlmsg_seq, description, false });
+    nlmsg_free(msg);
+}
+
+void NetlinkCmd::fail(const string &description, const string &error)
+{
+    m_error = description + " : " + error;
+    SWSS_LOG_ERROR("%s", m_error.c_str());
+}
+
+void NetlinkCmd::addBridge(const string &name, bool up, bool vlanFiltering)
+{
+    SWSS_LOG_ENTER();
+
+    struct nl_msg *msg = allocLinkMsg(RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, AF_UNSPEC, 0, name);
+    if (up)
+    {
+        auto *ifi = static_cast<struct ifinfomsg *>(nlmsg_data(nlmsg_hdr(msg)));
+        ifi->ifi_flags = IFF_UP;
+        ifi->ifi_change = IFF_UP;
+    }
+
+    struct nlattr *info = nla_nest_start(msg, IFLA_LINKINFO);
+    nla_put_string(msg, IFLA_INFO_KIND, "bridge");
+    if (vlanFiltering)
+    {
+        struct nlattr *data = nla_nest_start(msg, IFLA_INFO_DATA);
+        nla_put_u8(msg, IFLA_BR_VLAN_FILTERING, 1);
+        nla_nest_end(msg, data);
+    }
+    nla_nest_end(msg, info);
+
+    m_pendingLinks.insert(name);
+    queue(msg, "ip link add " + name + " type bridge");
+}
+
+void NetlinkCmd::addVlanLink(const string &parent, const string &name, uint16_t vid,
+                             const MacAddress &mac, bool up)
+{
+    SWSS_LOG_ENTER();
+
+    string description = "ip link add link " + parent + " name " + name + " type vlan id " + to_string(vid);
+
+    int parentIndex = getIfIndex(parent);
+    if (parentIndex == 0)
+    {
+        fail(description, "Cannot find device " + parent);
+        m_failed = true;
+        return;
+    }
+
+    struct nl_msg *msg = allocLinkMsg(RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, AF_UNSPEC, 0, name);
+    if (up)
+    {
+        auto *ifi = static_cast<struct ifinfomsg *>(nlmsg_data(nlmsg_hdr(msg)));
+        ifi->ifi_flags = IFF_UP;
+        ifi->ifi_change = IFF_UP;
+    }
+
+    nla_put_u32(msg, IFLA_LINK, (uint32_t)parentIndex);
+    if (mac)
+    {
+        nla_put(msg, IFLA_ADDRESS, ETHER_ADDR_LEN, mac.getMac());
+    }
+
+    struct nlattr *info = nla_nest_start(msg, IFLA_LINKINFO);
+    nla_put_string(msg, IFLA_INFO_KIND, "vlan");
+    struct nlattr *data = nla_nest_start(msg, IFLA_INFO_DATA);
+    nla_put_u16(msg, IFLA_VLAN_ID, vid);
+    nla_nest_end(msg, data);
+    nla_nest_end(msg, info);
+
+    m_pendingLinks.insert(name);
+    queue(msg, description);
+}
+
+void NetlinkCmd::addVrf(const string &name, uint32_t table)
+{
+    SWSS_LOG_ENTER();
+
+    struct nl_msg *msg = allocLinkMsg(RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, AF_UNSPEC, 0, name);
+
+    struct nlattr *info = nla_nest_start(msg, IFLA_LINKINFO);
+    nla_put_string(msg, IFLA_INFO_KIND, "vrf");
+    struct nlattr *data = nla_nest_start(msg, IFLA_INFO_DATA);
+    nla_put_u32(msg, IFLA_VRF_TABLE, table);
+    nla_nest_end(msg, data);
+    nla_nest_end(msg, info);
+
+    m_pendingLinks.insert(name);
+    queue(msg, "ip link add " + name + " type vrf table " + to_string(table));
+}
+
+void NetlinkCmd::delLink(const string &name)
+{
+    SWSS_LOG_ENTER();
+
+    m_pendingLinks.insert(name);
+    queue(allocLinkMsg(RTM_DELLINK, 0, AF_UNSPEC, 0, name), "ip link del " + name);
+}
+
+void NetlinkCmd::setLinkMtu(const string &name, uint32_t mtu)
+{
+    SWSS_LOG_ENTER();
+
+    struct nl_msg *msg = allocLinkMsg(RTM_SETLINK, 0, AF_UNSPEC, 0, name);
+    nla_put_u32(msg, IFLA_MTU, mtu);
+
+    queue(msg, "ip link set " + name + " mtu " + to_string(mtu));
+}
+
+void NetlinkCmd::setLinkAdminState(const string &name, bool up)
+{
+    SWSS_LOG_ENTER();
+
+    struct nl_msg *msg = allocLinkMsg(RTM_SETLINK, 0, AF_UNSPEC, 0, name);
+    auto *ifi = static_cast<struct ifinfomsg *>(nlmsg_data(nlmsg_hdr(msg)));
+    ifi->ifi_flags = up ? IFF_UP : 0;
+    ifi->ifi_change = IFF_UP;
+
+    queue(msg, "ip link set " + name + (up ? " up" : " down"));
+}
+
+void NetlinkCmd::setLinkMaster(const string &name, const string &master)
+{
+    SWSS_LOG_ENTER();
+
+    string description = "ip link set " + name + (master.empty() ? " nomaster" : " master " + master);
+
+    int masterIndex = 0;
+    if (!master.empty())
+    {
+        masterIndex = getIfIndex(master);
+        if (masterIndex == 0)
+        {
+            fail(description, "Cannot find device " + master);
+            m_failed = true;
+            return;
+        }
+    }
+
+    struct nl_msg *msg = allocLinkMsg(RTM_SETLINK, 0, AF_UNSPEC, 0, name);
+    nla_put_u32(msg, IFLA_MASTER, (uint32_t)masterIndex);
+
+    queue(msg, description);
+}
+
+void NetlinkCmd::addBridgeVlan(const string &dev, uint16_t vid, bool untagged, bool self)
+{
+    SWSS_LOG_ENTER();
+
+    string description = "bridge vlan add vid " + to_string(vid) + " dev " + dev +
+                         (untagged ? " pvid untagged" : "") + (self ? " self" : "");
+
+    /* Bridge requests are only looked up by index */
+    int ifindex = getIfIndex(dev);
+    if (ifindex == 0)
+    {
+        fail(description, "Cannot find device " + dev);
+        m_failed = true;
+        return;
+    }
+
+    struct nl_msg *msg = allocLinkMsg(RTM_SETLINK, 0, AF_BRIDGE, ifindex, dev);
+
+    struct nlattr *spec = nla_nest_start(msg, IFLA_AF_SPEC);
+    if (self)
+    {
+        nla_put_u16(msg, IFLA_BRIDGE_FLAGS, BRIDGE_FLAGS_SELF);
+    }
+
+    struct bridge_vlan_info vinfo;
+    memset(&vinfo, 0, sizeof(vinfo));
+    vinfo.vid = vid;
+    if (untagged)
+    {
+        vinfo.flags = BRIDGE_VLAN_INFO_PVID | BRIDGE_VLAN_INFO_UNTAGGED;
+    }
+    nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo);
+    nla_nest_end(msg, spec);
+
+    queue(msg, description);
+}
+
+void NetlinkCmd::delBridgeVlan(const string &dev, uint16_t vid, bool self)
+{
+    SWSS_LOG_ENTER();
+
+    string description = "bridge vlan del vid " + to_string(vid) + " dev " + dev + (self ? " self" : "");
+
+    int ifindex = getIfIndex(dev);
+    if (ifindex == 0)
+    {
+        fail(description, "Cannot find device " + dev);
+        m_failed = true;
+        return;
+    }
+
+    struct nl_msg *msg = allocLinkMsg(RTM_DELLINK, 0, AF_BRIDGE, ifindex, dev);
+
+    struct nlattr *spec = nla_nest_start(msg, IFLA_AF_SPEC);
+    if (self)
+    {
+        nla_put_u16(msg, IFLA_BRIDGE_FLAGS, BRIDGE_FLAGS_SELF);
+    }
+
+    struct bridge_vlan_info vinfo;
+    memset(&vinfo, 0, sizeof(vinfo));
+    vinfo.vid = vid;
+    nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo);
+    nla_nest_end(msg, spec);
+
+    queue(msg, description);
+}
+
+void NetlinkCmd::addAddress(const string &dev, const IpPrefix &prefix)
+{
+    SWSS_LOG_ENTER();
+
+    setAddress(RTM_NEWADDR, dev, prefix);
+}
+
+void NetlinkCmd::delAddress(const string &dev, const IpPrefix &prefix)
+{
+    SWSS_LOG_ENTER();
+
+    setAddress(RTM_DELADDR, dev, prefix);
+}
+
+void NetlinkCmd::setAddress(int type, const string &dev, const IpPrefix &prefix)
+{
+    string description = string("ip address ") + (type == RTM_NEWADDR ? "add " : "del ") +
+                         prefix.to_string() + " dev " + dev;
+
+    int ifindex = getIfIndex(dev);
+    if (ifindex == 0)
+    {
+        fail(description, "Cannot find device " + dev);
+        m_failed = true;
+        return;
+    }
+
+    int flags = NLM_F_REQUEST | NLM_F_ACK;
+    if (type == RTM_NEWADDR)
+    {
+        flags |= NLM_F_CREATE | NLM_F_EXCL;
+    }
+
+    struct nl_msg *msg = nlmsg_alloc_simple(type, flags);
+    if (!msg)
+    {
+        throw runtime_error("Netlink message alloc failed");
+    }
+
+    ip_addr_t ip = prefix.getIp().getIp();
+
+    struct ifaddrmsg ifa;
+    memset(&ifa, 0, sizeof(ifa));
+    ifa.ifa_family = ip.family;
+    ifa.ifa_prefixlen = (unsigned char)prefix.getMaskLength();
+    ifa.ifa_index = (uint32_t)ifindex;
+    nlmsg_append(msg, &ifa, sizeof(ifa), NLMSG_ALIGNTO);
+
+    if (ip.family == AF_INET)
+    {
+        nla_put(msg, IFA_LOCAL, sizeof(ip.ip_addr.ipv4_addr), &ip.ip_addr.ipv4_addr);
+        nla_put(msg, IFA_ADDRESS, sizeof(ip.ip_addr.ipv4_addr), &ip.ip_addr.ipv4_addr);
+    }
+    else
+    {
+        nla_put(msg, IFA_LOCAL, sizeof(ip.ip_addr.ipv6_addr), ip.ip_addr.ipv6_addr);
+        nla_put(msg, IFA_ADDRESS, sizeof(ip.ip_addr.ipv6_addr), ip.ip_addr.ipv6_addr);
+    }
+
+    queue(msg, description);
+}
+
+bool NetlinkCmd::commit()
+{
+    SWSS_LOG_ENTER();
+
+    bool ok = !m_failed;
+
+    size_t first = 0;
+    size_t begin = 0;
+    size_t end = 0;
+    for (size_t i = 0; i < m_requests.size(); i++)
+    {
+        auto *hdr = reinterpret_cast<struct nlmsghdr *>(&m_batch[end]);
+        end += NLMSG_ALIGN(hdr->nlmsg_len);
+
+        if (i + 1 == m_requests.size() || i + 1 - first == BATCH_MAX_REQUESTS || end - begin >= BATCH_MAX_BYTES)
+        {
+            ok = sendBatch(begin, end, first, i + 1) && ok;
+            first = i + 1;
+            begin = end;
+        }
+    }
+
+    m_batch.clear();
+    m_requests.clear();
+    m_pendingLinks.clear();
+    m_failed = false;
+
+    return ok;
+}
+
+bool NetlinkCmd::sendBatch(size_t begin, size_t end, size_t firstRequest, size_t lastRequest)
+{
+    bool ok = true;
+
+    int ret = nl_sendto(m_sock, &m_batch[begin], end - begin);
+    if (ret < 0)
+    {
+        for (size_t i = firstRequest; i < lastRequest; i++)
+        {
+            fail(m_requests[i].description, nl_geterror(ret));
+        }
+        return false;
+    }
+
+    size_t remaining = lastRequest - firstRequest;
+    uint32_t firstSeq = m_requests[firstRequest].seq;
+
+    while (remaining > 0)
+    {
+        struct sockaddr_nl nla;
+        unsigned char *buf = NULL;
+
+        int len = nl_recv(m_sock, &nla, &buf, NULL);
+        if (len <= 0)
+        {
+            free(buf);
+            for (size_t i = firstRequest; i < lastRequest; i++)
+            {
+                if (!m_requests[i].acked)
+                {
+                    fail(m_requests[i].description, len < 0 ? nl_geterror(len) : "No ack received");
+                }
+            }
+            return false;
+        }
+
+        for (auto *hdr = reinterpret_cast<struct nlmsghdr *>(buf); nlmsg_ok(hdr, len); hdr = nlmsg_next(hdr, &len))
+        {
+            if (hdr->nlmsg_type != NLMSG_ERROR)
+            {
+                continue;
+            }
+
+            size_t index = firstRequest + (hdr->nlmsg_seq - firstSeq);
+            if (hdr->nlmsg_seq < firstSeq || index >= lastRequest || m_requests[index].acked)
+            {
+                continue;
+            }
+
+            m_requests[index].acked = true;
+            remaining--;
+
+            auto *err = static_cast<struct nlmsgerr *>(nlmsg_data(hdr));
+            if (err->error != 0)
+            {
+                fail(m_requests[index].description, strerror(-err->error));
+                ok = false;
+            }
+        }
+
+        free(buf);
+    }
+
+    return ok;
+}
+
+const string &NetlinkCmd::getError() const
+{
+    return m_error;
+}
+
+size_t NetlinkCmd::pending() const
+{
+    return m_requests.size();
+}
+
+bool NetlinkCmd::hasBridgeVlans(const string &dev)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_requests.empty() && !commit())
+    {
+        m_failed = true;
+    }
+
+    int ifindex = (int)if_nametoindex(dev.c_str());
+    if (ifindex == 0)
+    {
+        return false;
+    }
+
+    /* Bridge VLANs are only reported by a dump of the bridge family */
+    struct nl_msg *msg = allocLinkMsg(RTM_GETLINK, NLM_F_DUMP, AF_BRIDGE, ifindex, dev);
+    nlmsg_hdr(msg)->nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    nlmsg_hdr(msg)->nlmsg_seq = ++m_seq;
+    nla_put_u32(msg, IFLA_EXT_MASK, RTEXT_FILTER_BRVLAN);
+
+    int ret = nl_sendto(m_sock, nlmsg_hdr(msg), nlmsg_hdr(msg)->nlmsg_len);
+    nlmsg_free(msg);
+    if (ret < 0)
+    {
+        throw runtime_error("bridge vlan show dev " + dev + " : " + nl_geterror(ret));
+    }
+
+    bool found = false;
+    bool done = false;
+    while (!done)
+    {
+        struct sockaddr_nl nla;
+        unsigned char *buf = NULL;
+
+        int len = nl_recv(m_sock, &nla, &buf, NULL);
+        if (len <= 0)
+        {
+            free(buf);
+            throw runtime_error("bridge vlan show dev " + dev + " : " + (len < 0 ? nl_geterror(len) : "No reply"));
+        }
+
+        for (auto *hdr = reinterpret_cast<struct nlmsghdr *>(buf); nlmsg_ok(hdr, len); hdr = nlmsg_next(hdr, &len))
+        {
+            if (hdr->nlmsg_seq != m_seq)
+            {
+                continue;
+            }
+            if (hdr->nlmsg_type == NLMSG_DONE || hdr->nlmsg_type == NLMSG_ERROR)
+            {
+                done = true;
+                break;
+            }
+            if (hdr->nlmsg_type != RTM_NEWLINK)
+            {
+                continue;
+            }
+
+            auto *ifi = static_cast<struct ifinfomsg *>(nlmsg_data(hdr));
+            if (ifi->ifi_index != ifindex)
+            {
+                continue;
+            }
+
+            struct nlattr *spec = nlmsg_find_attr(hdr, sizeof(struct ifinfomsg), IFLA_AF_SPEC);
+            if (!spec)
+            {
+                continue;
+            }
+
+            struct nlattr *attr;
+            int rem;
+            nla_for_each_nested(attr, spec, rem)
+            {
+                if (nla_type(attr) == IFLA_BRIDGE_VLAN_INFO)
+                {
+                    found = true;
+                }
+            }
+        }
+
+        free(buf);
+    }
+
+    return found;
+}
@@ -0,0 +1,115 @@
+#ifndef __NETLINKCMD__
+#define __NETLINKCMD__
+
+#include <stdint.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ipprefix.h"
+#include "macaddress.h"
+
+struct nl_sock;
+struct nl_msg;
+
+namespace swss {
+
+/*
+ * NetlinkCmd: kernel link, bridge VLAN and address programming through
+ * rtnetlink, as an alternative to running /sbin/ip and /sbin/bridge.
+ *
+ * Requests are queued and only sent by commit(). Queued requests are packed
+ * in multipart batches, each batch is sent with a single sendto() and all
+ * its acks are collected before the next one, so a whole configuration can
+ * be applied with a handful of system calls. Requests of a commit are
+ * applied in order and a failed request does not stop the next ones.
+ *
+ * Interfaces are resolved by name when the request is queued. A request on
+ * an interface created or deleted by a queued request commits the queue
+ * first.
+ *
+ * The cfgmgr managers own one when started with -n, and run /sbin/ip and
+ * /sbin/bridge otherwise.
+ */
+class NetlinkCmd
+{
+public:
+    NetlinkCmd();
+    ~NetlinkCmd();
+
+    NetlinkCmd(const NetlinkCmd&) = delete;
+    NetlinkCmd& operator=(const NetlinkCmd&) = delete;
+
+    /* ip link add <name> [up] type bridge [vlan_filtering 1] */
+    void addBridge(const std::string &name, bool up, bool vlanFiltering);
+    /* ip link add link <parent> [up] name <name> address <mac> type vlan id <vid> */
+    void addVlanLink(const std::string &parent, const std::string &name, uint16_t vid,
+                     const MacAddress &mac, bool up);
+    /* ip link add <name> type vrf table <table> */
+    void addVrf(const std::string &name, uint32_t table);
+    /* ip link del <name> */
+    void delLink(const std::string &name);
+
+    /* ip link set <name> mtu <mtu> */
+    void setLinkMtu(const std::string &name, uint32_t mtu);
+    /* ip link set <name> up|down */
+    void setLinkAdminState(const std::string &name, bool up);
+    /* ip link set <name> master <master>, nomaster if master is empty */
+    void setLinkMaster(const std::string &name, const std::string &master);
+
+    /* bridge vlan add vid <vid> dev <dev> [pvid untagged] [self] */
+    void addBridgeVlan(const std::string &dev, uint16_t vid, bool untagged, bool self);
+    /* bridge vlan del vid <vid> dev <dev> [self] */
+    void delBridgeVlan(const std::string &dev, uint16_t vid, bool self);
+
+    /* ip address add|del <prefix> dev <dev> */
+    void addAddress(const std::string &dev, const IpPrefix &prefix);
+    void delAddress(const std::string &dev, const IpPrefix &prefix);
+
+    /* Send the queued requests, return false if any of them failed */
+    bool commit();
+
+    /* Error of the last failed request */
+    const std::string &getError() const;
+
+    /* Number of queued requests */
+    size_t pending() const;
+
+    /*
+     * Return true if a bridge port still has VLANs, i.e. the opposite of
+     * "bridge vlan show dev <dev>" reporting None. Commits the queue first.
+     */
+    bool hasBridgeVlans(const std::string &dev);
+
+private:
+    struct Request
+    {
+        uint32_t seq;
+        std::string description;
+        bool acked;
+    };
+
+    struct nl_sock *m_sock;
+    uint32_t m_seq;
+
+    std::vector<char> m_batch;
+    std::vector<Request> m_requests;
+    /* Links created or deleted by the queued requests */
+    std::set<std::string> m_pendingLinks;
+
+    /* Requests which failed before being sent, e.g. unknown interface */
+    bool m_failed;
+    std::string m_error;
+
+    int getIfIndex(const std::string &name);
+    struct nl_msg *allocLinkMsg(int type, int flags, int family, int ifindex, const std::string &name);
+    void setAddress(int type, const std::string &dev, const IpPrefix &prefix);
+    void queue(struct nl_msg *msg, const std::string &description);
+    void fail(const std::string &description, const std::string &error);
+
+    bool sendBatch(size_t begin, size_t end, size_t firstRequest, size_t lastRequest);
+};
+
+}
+
+#endif /* __NETLINKCMD__ */
@@ -10,13 +10,18 @@
 using namespace std;
 using namespace swss;
 
-PortMgr::PortMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
+PortMgr::PortMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+                 bool useNetlink) :
         Orch(cfgDb, tableNames),
         m_cfgPortTable(cfgDb, CFG_PORT_TABLE_NAME),
         m_cfgLagMemberTable(cfgDb, CFG_LAG_MEMBER_TABLE_NAME),
         m_statePortTable(stateDb, STATE_PORT_TABLE_NAME),
         m_appPortTable(appDb, APP_PORT_TABLE_NAME)
 {
+    if (useNetlink)
+    {
+        m_netlink = unique_ptr<NetlinkCmd>(new NetlinkCmd());
+    }
 }
 
 bool PortMgr::setPortMtu(const string &alias, const string &mtu)
@@ -25,8 +30,19 @@ bool PortMgr::setPortMtu(const string &alias, const string &mtu)
     string res;
 
     // ip link set dev <port_name> mtu <mtu>
-    cmd << IP_CMD << " link set dev " << alias << " mtu " << mtu;
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    if (m_netlink)
+    {
+        m_netlink->setLinkMtu(alias, (uint32_t)stoul(mtu));
+        if (!m_netlink->commit())
+        {
+            throw runtime_error(m_netlink->getError());
+        }
+    }
+    else
+    {
+        cmd << IP_CMD << " link set dev " << alias << " mtu " << mtu;
+        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    }
 
     // Set the port MTU in application database to update both
     // the port MTU and possibly the port based router interface MTU
@@ -44,8 +60,19 @@ bool PortMgr::setPortAdminStatus(const string &alias, const bool up)
     string res;
 
     // ip link set dev <port_name> [up|down]
-    cmd << IP_CMD << " link set dev " << alias << (up ? " up" : " down");
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    if (m_netlink)
+    {
+        m_netlink->setLinkAdminState(alias, up);
+        if (!m_netlink->commit())
+        {
+            throw runtime_error(m_netlink->getError());
+        }
+    }
+    else
+    {
+        cmd << IP_CMD << " link set dev " << alias << (up ? " up" : " down");
+        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    }
 
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("admin_status", (up ? "up" : "down"));
@@ -3,8 +3,10 @@
 #include "dbconnector.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "netlinkcmd.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -17,7 +19,8 @@ namespace swss {
 class PortMgr : public Orch
 {
 public:
-    PortMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames);
+    PortMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+            bool useNetlink = false);
 
     using Orch::doTask;
 private:
@@ -25,6 +28,7 @@ private:
     Table m_cfgLagMemberTable;
     Table m_statePortTable;
     ProducerStateTable m_appPortTable;
+    std::unique_ptr<NetlinkCmd> m_netlink;
 
     set<string> m_portList;
 
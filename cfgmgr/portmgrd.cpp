@@ -1,3 +1,4 @@
+#include <getopt.h>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -8,6 +9,7 @@
 #include "portmgr.h"
 #include "schema.h"
 #include "select.h"
+#include "swssrecorder.h"
 
 using namespace std;
 using namespace swss;
@@ -26,13 +28,37 @@ using namespace swss;
 int gBatchSize = 0;
 bool gSwssRecord = false;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
+SwssRecorder gSwssRecorder;
 /* Global database mutex */
 mutex gDbMutex;
 
+void usage()
+{
+    cout << "Usage: portmgrd [-n]" << endl;
+    cout << "       -n: program the kernel through netlink instead of /sbin/ip" << endl;
+}
+
 int main(int argc, char **argv)
 {
+    int opt;
+    bool useNetlink = false;
+
+    while ((opt = getopt(argc, argv, "nh")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'n':
+            useNetlink = true;
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     Logger::linkToDbNative("portmgrd");
     SWSS_LOG_ENTER();
 
@@ -48,7 +74,7 @@ int main(int argc, char **argv)
         DBConnector appDb(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
         DBConnector stateDb(STATE_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
 
-        PortMgr portmgr(&cfgDb, &appDb, &stateDb, cfg_port_tables);
+        PortMgr portmgr(&cfgDb, &appDb, &stateDb, cfg_port_tables, useNetlink);
 
         // TODO: add tables in stateDB which interface depends on to monitor list
         vector<Orch *> cfgOrchList = {&portmgr};
@@ -19,7 +19,7 @@ using namespace swss;
 
 
 TeamMgr::TeamMgr(DBConnector *confDb, DBConnector *applDb, DBConnector *statDb,
-        const vector<TableConnector> &tables) :
+        const vector<TableConnector> &tables, bool useNetlink) :
     Orch(tables),
     m_cfgMetadataTable(confDb, CFG_DEVICE_METADATA_TABLE_NAME),
     m_cfgPortTable(confDb, CFG_PORT_TABLE_NAME),
@@ -32,6 +32,11 @@ TeamMgr::TeamMgr(DBConnector *confDb, DBConnector *applDb, DBConnector *statDb,
 {
     SWSS_LOG_ENTER();
 
+    if (useNetlink)
+    {
+        m_netlink = unique_ptr<NetlinkCmd>(new NetlinkCmd());
+    }
+
     // Clean up state database LAG entries
     vector<string> keys;
     m_stateLagTable.getKeys(keys);
@@ -319,8 +324,19 @@ bool TeamMgr::setLagAdminStatus(const string &alias, const string &admin_status)
     string res;
 
     // ip link set dev <port_channel_name> [up|down]
-    cmd << IP_CMD << " link set dev " << alias << " " << admin_status;
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    if (m_netlink)
+    {
+        m_netlink->setLinkAdminState(alias, admin_status == "up");
+        if (!m_netlink->commit())
+        {
+            throw runtime_error(m_netlink->getError());
+        }
+    }
+    else
+    {
+        cmd << IP_CMD << " link set dev " << alias << " " << admin_status;
+        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    }
 
     SWSS_LOG_NOTICE("Set port channel %s admin status to %s",
             alias.c_str(), admin_status.c_str());
@@ -336,8 +352,19 @@ bool TeamMgr::setLagMtu(const string &alias, const string &mtu)
     string res;
 
     // ip link set dev <port_channel_name> mtu <mtu_value>
-    cmd << IP_CMD << " link set dev " << alias << " mtu " << mtu;
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    if (m_netlink)
+    {
+        m_netlink->setLinkMtu(alias, (uint32_t)stoul(mtu));
+        if (!m_netlink->commit())
+        {
+            throw runtime_error(m_netlink->getError());
+        }
+    }
+    else
+    {
+        cmd << IP_CMD << " link set dev " << alias << " mtu " << mtu;
+        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    }
 
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("mtu", mtu);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -7,6 +8,7 @@
 #include "netmsg.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "netlinkcmd.h"
 
 namespace swss {
 
@@ -14,7 +16,7 @@ class TeamMgr : public Orch
 {
 public:
     TeamMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *staDb,
-            const vector<TableConnector> &tables);
+            const vector<TableConnector> &tables, bool useNetlink = false);
 
     using Orch::doTask;
 private:
@@ -32,6 +34,8 @@ private:
 
     MacAddress m_mac;
 
+    std::unique_ptr<NetlinkCmd> m_netlink;
+
     void doTask(Consumer &consumer);
     void doLagTask(Consumer &consumer);
     void doLagMemberTask(Consumer &consumer);
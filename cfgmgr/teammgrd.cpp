@@ -1,3 +1,5 @@
+#include <getopt.h>
+#include <iostream>
 #include <fstream>
 
 #include "teammgr.h"
@@ -5,6 +7,7 @@
 #include "netlink.h"
 #include "select.h"
 #include "warm_restart.h"
+#include "swssrecorder.h"
 
 using namespace std;
 using namespace swss;
@@ -14,11 +17,35 @@ using namespace swss;
 int gBatchSize = 0;
 bool gSwssRecord = false;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
+SwssRecorder gSwssRecorder;
+
+void usage()
+{
+    cout << "Usage: teammgrd [-n]" << endl;
+    cout << "       -n: program the kernel through netlink instead of /sbin/ip" << endl;
+}
 
 int main(int argc, char **argv)
 {
+    int opt;
+    bool useNetlink = false;
+
+    while ((opt = getopt(argc, argv, "nh")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'n':
+            useNetlink = true;
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     Logger::linkToDbNative("teammgrd");
     SWSS_LOG_ENTER();
 
@@ -43,7 +70,7 @@ int main(int argc, char **argv)
             state_port_table
         };
 
-        TeamMgr teammgr(&conf_db, &app_db, &state_db, tables);
+        TeamMgr teammgr(&conf_db, &app_db, &state_db, tables, useNetlink);
 
         vector<Orch *> cfgOrchList = {&teammgr};
 
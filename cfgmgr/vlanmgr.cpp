@@ -1,4 +1,5 @@
 #include <string.h>
+#include <net/if.h>
 #include "logger.h"
 #include "producerstatetable.h"
 #include "macaddress.h"
@@ -20,7 +21,8 @@ using namespace swss;
 
 extern MacAddress gMacAddress;
 
-VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
+VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+                 bool useNetlink) :
         Orch(cfgDb, tableNames),
         m_cfgVlanTable(cfgDb, CFG_VLAN_TABLE_NAME),
         m_cfgVlanMemberTable(cfgDb, CFG_VLAN_MEMBER_TABLE_NAME),
@@ -33,13 +35,26 @@ VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
 {
     SWSS_LOG_ENTER();
 
+    if (useNetlink)
+    {
+        m_netlink = unique_ptr<NetlinkCmd>(new NetlinkCmd());
+    }
+
     if (WarmStart::isWarmStart())
     {
-        const std::string cmds = std::string("")
-          + IP_CMD + " link show " + DOT1Q_BRIDGE_NAME + " 2>/dev/null";
+        int ret;
+        if (m_netlink)
+        {
+            ret = if_nametoindex(DOT1Q_BRIDGE_NAME) ? 0 : -1;
+        }
+        else
+        {
+            const std::string cmds = std::string("")
+              + IP_CMD + " link show " + DOT1Q_BRIDGE_NAME + " 2>/dev/null";
 
-        std::string res;
-        int ret = swss::exec(cmds, res);
+            std::string res;
+            ret = swss::exec(cmds, res);
+        }
         if (ret == 0)
         {
             // Don't reset vlan aware bridge upon swss docker warm restart.
@@ -48,6 +63,18 @@ VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
         }
     }
     // Initialize Linux dot1q bridge and enable vlan filtering
+    if (m_netlink)
+    {
+        if (if_nametoindex(DOT1Q_BRIDGE_NAME))
+        {
+            m_netlink->delLink(DOT1Q_BRIDGE_NAME);
+        }
+        m_netlink->addBridge(DOT1Q_BRIDGE_NAME, true, true);
+        m_netlink->delBridgeVlan(DOT1Q_BRIDGE_NAME, (uint16_t)stoi(DEFAULT_VLAN_ID), true);
+        commitNetlink();
+        return;
+    }
+
     // The command should be generated as:
     // /bin/bash -c "/sbin/ip link del Bridge 2>/dev/null ;
     //               /sbin/ip link add Bridge up type bridge &&
@@ -82,10 +109,27 @@ VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
     }
 }
 
+void VlanMgr::commitNetlink()
+{
+    if (!m_netlink->commit())
+    {
+        throw runtime_error(m_netlink->getError());
+    }
+}
+
 bool VlanMgr::addHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
+    if (m_netlink)
+    {
+        m_netlink->addBridgeVlan(DOT1Q_BRIDGE_NAME, (uint16_t)vlan_id, false, true);
+        m_netlink->addVlanLink(DOT1Q_BRIDGE_NAME, VLAN_PREFIX + std::to_string(vlan_id), (uint16_t)vlan_id,
+                               gMacAddress, true);
+        commitNetlink();
+        return true;
+    }
+
     // The command should be generated as:
     // /bin/bash -c "/sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
     //               /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}"
@@ -108,6 +152,14 @@ bool VlanMgr::removeHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
+    if (m_netlink)
+    {
+        m_netlink->delLink(VLAN_PREFIX + std::to_string(vlan_id));
+        m_netlink->delBridgeVlan(DOT1Q_BRIDGE_NAME, (uint16_t)vlan_id, true);
+        commitNetlink();
+        return true;
+    }
+
     // The command should be generated as:
     // /bin/bash -c "/sbin/ip link del Vlan{{vlan_id}} &&
     //               /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self"
@@ -126,6 +178,13 @@ bool VlanMgr::setHostVlanAdminState(int vlan_id, const string &admin_status)
 {
     SWSS_LOG_ENTER();
 
+    if (m_netlink)
+    {
+        m_netlink->setLinkAdminState(VLAN_PREFIX + std::to_string(vlan_id), admin_status == "up");
+        commitNetlink();
+        return true;
+    }
+
     // The command should be generated as:
     // /sbin/ip link set Vlan{{vlan_id}} {{admin_status}}
     const std::string cmds = std::string("")
@@ -141,6 +200,13 @@ bool VlanMgr::setHostVlanMtu(int vlan_id, uint32_t mtu)
 {
     SWSS_LOG_ENTER();
 
+    if (m_netlink)
+    {
+        /* VLAN mtu should not be larger than member mtu */
+        m_netlink->setLinkMtu(VLAN_PREFIX + std::to_string(vlan_id), mtu);
+        return m_netlink->commit();
+    }
+
     // The command should be generated as:
     // /sbin/ip link set Vlan{{vlan_id}} mtu {{mtu}}
     const std::string cmds = std::string("")
@@ -167,6 +233,14 @@ bool VlanMgr::addHostVlanMember(int vlan_id, const string &port_alias, const str
         tagging_cmd = "pvid untagged";
     }
 
+    if (m_netlink)
+    {
+        m_netlink->setLinkMaster(port_alias, DOT1Q_BRIDGE_NAME);
+        m_netlink->addBridgeVlan(port_alias, (uint16_t)vlan_id, !tagging_cmd.empty(), false);
+        commitNetlink();
+        return true;
+    }
+
     // The command should be generated as:
     // /bin/bash -c "/sbin/ip link set {{port_alias}} master Bridge &&
     //               /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}"
@@ -185,6 +259,20 @@ bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
 {
     SWSS_LOG_ENTER();
 
+    if (m_netlink)
+    {
+        m_netlink->delBridgeVlan(port_alias, (uint16_t)vlan_id, false);
+        commitNetlink();
+
+        // When port is not member of any VLAN, it shall be detached from Dot1Q bridge!
+        if (!m_netlink->hasBridgeVlans(port_alias))
+        {
+            m_netlink->setLinkMaster(port_alias, "");
+            commitNetlink();
+        }
+        return true;
+    }
+
     // The command should be generated as:
     // /bin/bash -c '/sbin/bridge vlan del vid {{vlan_id}} dev {{port_alias}} &&
     //               ( /sbin/bridge vlan show dev {{port_alias}} | /bin/grep -q None;
@@ -4,9 +4,11 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netlinkcmd.h"
 
 #include <set>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace swss {
@@ -14,7 +16,8 @@ namespace swss {
 class VlanMgr : public Orch
 {
 public:
-    VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames);
+    VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+            bool useNetlink = false);
     using Orch::doTask;
 
 private:
@@ -23,12 +26,14 @@ private:
     Table m_statePortTable, m_stateLagTable;
     Table m_stateVlanTable, m_stateVlanMemberTable;
     std::set<std::string> m_vlans;
+    std::unique_ptr<NetlinkCmd> m_netlink;
 
     void doTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
     void doVlanMemberTask(Consumer &consumer);
     void processUntaggedVlanMembers(string vlan, const string &members);
 
+    void commitNetlink();
     bool addHostVlan(int vlan_id);
     bool removeHostVlan(int vlan_id);
     bool setHostVlanAdminState(int vlan_id, const string &admin_status);
@@ -1,3 +1,4 @@
+#include <getopt.h>
 #include <unistd.h>
 #include <vector>
 #include <sstream>
@@ -14,6 +15,7 @@
 #include "vlanmgr.h"
 #include "shellcmd.h"
 #include "warm_restart.h"
+#include "swssrecorder.h"
 
 using namespace std;
 using namespace swss;
@@ -34,13 +36,37 @@ MacAddress gMacAddress;
 int gBatchSize = 0;
 bool gSwssRecord = false;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
+SwssRecorder gSwssRecorder;
 /* Global database mutex */
 mutex gDbMutex;
 
+void usage()
+{
+    cout << "Usage: vlanmgrd [-n]" << endl;
+    cout << "       -n: program the kernel through netlink instead of /sbin/ip and /sbin/bridge" << endl;
+}
+
 int main(int argc, char **argv)
 {
+    int opt;
+    bool useNetlink = false;
+
+    while ((opt = getopt(argc, argv, "nh")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'n':
+            useNetlink = true;
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     Logger::linkToDbNative("vlanmgrd");
     SWSS_LOG_ENTER();
 
@@ -74,7 +100,7 @@ int main(int argc, char **argv)
         }
         gMacAddress = MacAddress(it->second);
 
-        VlanMgr vlanmgr(&cfgDb, &appDb, &stateDb, cfg_vlan_tables);
+        VlanMgr vlanmgr(&cfgDb, &appDb, &stateDb, cfg_vlan_tables, useNetlink);
 
         std::vector<Orch *> cfgOrchList = {&vlanmgr};
 
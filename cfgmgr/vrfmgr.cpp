@@ -13,12 +13,18 @@
 
 using namespace swss;
 
-VrfMgr::VrfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
+VrfMgr::VrfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+               bool useNetlink) :
         Orch(cfgDb, tableNames),
         m_appVrfTableProducer(appDb, APP_VRF_TABLE_NAME),
         m_appVnetTableProducer(appDb, APP_VNET_TABLE_NAME),
         m_stateVrfTable(stateDb, STATE_VRF_TABLE_NAME)
 {
+    if (useNetlink)
+    {
+        m_netlink = unique_ptr<NetlinkCmd>(new NetlinkCmd());
+    }
+
     for (uint32_t i = VRF_TABLE_START; i < VRF_TABLE_END; i++)
     {
         m_freeTables.emplace(i);
@@ -99,8 +105,19 @@ bool VrfMgr::delLink(const string& vrfName)
         return false;
     }
 
-    cmd << IP_CMD << " link del " << vrfName;
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    if (m_netlink)
+    {
+        m_netlink->delLink(vrfName);
+        if (!m_netlink->commit())
+        {
+            throw runtime_error(m_netlink->getError());
+        }
+    }
+    else
+    {
+        cmd << IP_CMD << " link del " << vrfName;
+        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    }
 
     recycleTable(m_vrfTableMap[vrfName]);
     m_vrfTableMap.erase(vrfName);
@@ -126,6 +143,19 @@ bool VrfMgr::setLink(const string& vrfName)
         return false;
     }
 
+    if (m_netlink)
+    {
+        m_netlink->addVrf(vrfName, table);
+        m_netlink->setLinkAdminState(vrfName, true);
+        if (!m_netlink->commit())
+        {
+            throw runtime_error(m_netlink->getError());
+        }
+
+        m_vrfTableMap.emplace(vrfName, table);
+        return true;
+    }
+
     cmd << IP_CMD << " link add " << vrfName << " type vrf table " << table;
     EXEC_WITH_ERROR_THROW(cmd.str(), res);
 
@@ -4,9 +4,11 @@
 #include <string>
 #include <map>
 #include <set>
+#include <memory>
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netlinkcmd.h"
 
 using namespace std;
 
@@ -15,7 +17,8 @@ namespace swss {
 class VrfMgr : public Orch
 {
 public:
-    VrfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames);
+    VrfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames,
+           bool useNetlink = false);
     using Orch::doTask;
 
 private:
@@ -31,6 +34,7 @@ private:
 
     Table m_stateVrfTable;
     ProducerStateTable m_appVrfTableProducer, m_appVnetTableProducer;
+    unique_ptr<NetlinkCmd> m_netlink;
 };
 
 }
@@ -81,6 +81,16 @@ void FpmLink::accept()
     SWSS_LOG_INFO("New connection accepted from: %s\n", inet_ntoa(client_addr.sin_addr));
 }
 
+void FpmLink::shutdown()
+{
+    ::shutdown(m_connection_socket, SHUT_RDWR);
+}
+
+void FpmLink::setNetlinkHandler(NetlinkHandler handler)
+{
+    m_netlinkHandler = handler;
+}
+
 int FpmLink::getFd()
 {
     return m_connection_socket;
@@ -115,7 +125,11 @@ void FpmLink::readData()
         if (!fpm_msg_ok(hdr, left))
             throw system_error(make_error_code(errc::bad_message), "Malformed FPM message received");
 
-        if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
+        if (hdr->msg_type == FPM_MSG_TYPE_NETLINK && m_netlinkHandler)
+        {
+            m_netlinkHandler((nlmsghdr *)fpm_msg_data(hdr));
+        }
+        else if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
         {
             nl_msg *msg = nlmsg_convert((nlmsghdr *)fpm_msg_data(hdr));
             if (msg == NULL)
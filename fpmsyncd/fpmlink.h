@@ -10,6 +10,7 @@
 #include <assert.h>
 #include <unistd.h>
 #include <exception>
+#include <functional>
 
 #include "selectable.h"
 #include "fpm/fpm.h"
@@ -18,6 +19,8 @@ namespace swss {
 
 class FpmLink : public Selectable {
 public:
+    typedef std::function<void(nlmsghdr *)> NetlinkHandler;
+
     const int MSG_BATCH_SIZE;
     FpmLink(unsigned short port = FPM_DEFAULT_PORT);
     virtual ~FpmLink();
@@ -25,6 +28,15 @@ public:
     /* Wait for connection (blocking) */
     void accept();
 
+    /* Unblock a readData() pending on another thread */
+    void shutdown();
+
+    /*
+     * Hand the received netlink messages to handler rather than dispatching
+     * them through NetDispatcher. The message is only valid during the call.
+     */
+    void setNetlinkHandler(NetlinkHandler handler);
+
     int getFd() override;
     void readData() override;
     /* readMe throws FpmConnectionClosedException when connection is lost */
@@ -36,6 +48,7 @@ private:
     unsigned int m_bufSize;
     char *m_messageBuffer;
     unsigned int m_pos;
+    NetlinkHandler m_netlinkHandler;
 
     bool m_connected;
     bool m_server_up;
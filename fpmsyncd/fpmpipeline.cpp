@@ -0,0 +1,258 @@
+#include <inttypes.h>
+#include <netlink/route/route.h>
+#include "logger.h"
+#include "fpmsyncd/fpmpipeline.h"
+
+using namespace std;
+using namespace swss;
+
+/* Interval between two reports of the throughput counters */
+#define STATS_INTERVAL_SEC 10
+
+FpmPipeline::FpmPipeline(FpmLink &link, RouteSync &sync, size_t decoders, size_t ringSize) :
+    m_link(link),
+    m_sync(sync),
+    m_slots(ringSize),
+    m_stop(false),
+    m_readMessages(0),
+    m_readBytes(0),
+    m_ringFull(0),
+    m_decodedMessages(0),
+    m_lastStats(chrono::steady_clock::now())
+{
+    SWSS_LOG_ENTER();
+
+    m_link.setNetlinkHandler([this](nlmsghdr *hdr) { receive(hdr); });
+
+    for (size_t i = 0; i < decoders; i++)
+    {
+        m_decoders.emplace_back(&FpmPipeline::decodeMessages, this);
+    }
+    m_reader = thread(&FpmPipeline::readMessages, this);
+
+    SWSS_LOG_NOTICE("FPM pipeline started with %zu decoders and %zu slots", decoders, ringSize);
+}
+
+FpmPipeline::~FpmPipeline()
+{
+    SWSS_LOG_ENTER();
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_notFull.notify_all();
+    m_received.notify_all();
+
+    /* The reader may be blocked on the socket */
+    m_link.shutdown();
+
+    m_reader.join();
+    for (auto &decoder : m_decoders)
+    {
+        decoder.join();
+    }
+    m_link.setNetlinkHandler(nullptr);
+
+    logStats(true);
+}
+
+Selectable *FpmPipeline::getSelectable()
+{
+    return &m_decodedEvent;
+}
+
+FpmPipeline::Slot &FpmPipeline::getSlot(uint64_t seq)
+{
+    return m_slots[seq % m_slots.size()];
+}
+
+void FpmPipeline::readMessages()
+{
+    try
+    {
+        while (!m_stop)
+        {
+            m_link.readData();
+        }
+    }
+    catch (...)
+    {
+        m_readerError = current_exception();
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_readerDone = true;
+    }
+    m_decodedEvent.notify();
+}
+
+void FpmPipeline::receive(nlmsghdr *hdr)
+{
+    /* NetDispatcher only has handlers for the route messages */
+    if (hdr->nlmsg_type != RTM_NEWROUTE && hdr->nlmsg_type != RTM_DELROUTE)
+    {
+        return;
+    }
+
+    {
+        unique_lock<mutex> lock(m_mutex);
+        if (m_readSeq - m_writeSeq >= m_slots.size())
+        {
+            m_ringFull++;
+            m_notFull.wait(lock, [this] { return m_stop || m_readSeq - m_writeSeq < m_slots.size(); });
+        }
+        if (m_stop)
+        {
+            return;
+        }
+    }
+
+    /* The slot is free and only the reader fills slots */
+    Slot &slot = getSlot(m_readSeq);
+    const char *data = reinterpret_cast<const char *>(hdr);
+    slot.message.assign(data, data + hdr->nlmsg_len);
+
+    m_readMessages++;
+    m_readBytes += hdr->nlmsg_len;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_readSeq++;
+    }
+    m_received.notify_one();
+}
+
+void FpmPipeline::decodeMessages()
+{
+    unique_lock<mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_received.wait(lock, [this] { return m_stop || m_decodeSeq < m_readSeq; });
+        if (m_stop)
+        {
+            return;
+        }
+
+        uint64_t seq = m_decodeSeq++;
+        Slot &slot = getSlot(seq);
+
+        lock.unlock();
+        decode(slot);
+        m_decodedMessages++;
+        lock.lock();
+
+        slot.decoded = true;
+        if (seq == m_writeSeq)
+        {
+            m_decodedEvent.notify();
+        }
+    }
+}
+
+void FpmPipeline::decode(Slot &slot)
+{
+    nlmsghdr *hdr = reinterpret_cast<nlmsghdr *>(slot.message.data());
+    struct rtnl_route *route = NULL;
+
+    slot.valid = false;
+
+    /* Parse the message in place, without converting it to a nl_msg first */
+    int err = rtnl_route_parse(hdr, &route);
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Unable to parse route message: %s", nl_geterror(err));
+        return;
+    }
+
+    slot.valid = m_sync.decodeRoute(hdr->nlmsg_type, (struct nl_object *)route, slot.record);
+    rtnl_route_put(route);
+}
+
+size_t FpmPipeline::write()
+{
+    SWSS_LOG_ENTER();
+
+    size_t written = 0;
+
+    while (true)
+    {
+        uint64_t seq;
+        uint64_t ready = 0;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            seq = m_writeSeq;
+            while (seq + ready < m_decodeSeq && getSlot(seq + ready).decoded)
+            {
+                ready++;
+            }
+        }
+
+        if (ready == 0)
+        {
+            break;
+        }
+
+        /* Decoded slots are owned by the writer until released */
+        for (uint64_t i = 0; i < ready; i++)
+        {
+            Slot &slot = getSlot(seq + i);
+            if (slot.valid)
+            {
+                m_sync.onRoute(slot.record);
+            }
+        }
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            for (uint64_t i = 0; i < ready; i++)
+            {
+                getSlot(seq + i).decoded = false;
+            }
+            m_writeSeq += ready;
+        }
+        m_notFull.notify_one();
+
+        m_writtenMessages += ready;
+        m_writeBatches++;
+        written += ready;
+    }
+
+    logStats(false);
+
+    lock_guard<mutex> lock(m_mutex);
+    if (m_readerDone && m_writeSeq == m_readSeq && m_readerError)
+    {
+        rethrow_exception(m_readerError);
+    }
+
+    return written;
+}
+
+void FpmPipeline::logStats(bool force)
+{
+    auto now = chrono::steady_clock::now();
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - m_lastStats).count();
+    if (!force && elapsed < STATS_INTERVAL_SEC * 1000)
+    {
+        return;
+    }
+
+    uint64_t read = m_readMessages;
+    uint64_t decoded = m_decodedMessages;
+    uint64_t seconds = max<uint64_t>((uint64_t)elapsed / 1000, 1);
+
+    SWSS_LOG_NOTICE("FPM pipeline: read %" PRIu64 " msgs (%" PRIu64 "/s, %" PRIu64 " bytes, ring full %" PRIu64 " times), "
+                    "decoded %" PRIu64 " msgs (%" PRIu64 "/s), written %" PRIu64 " msgs (%" PRIu64 "/s) in %" PRIu64 " batches",
+                    read, (read - m_lastReadMessages) / seconds, m_readBytes.load(), m_ringFull.load(),
+                    decoded, (decoded - m_lastDecodedMessages) / seconds,
+                    m_writtenMessages, (m_writtenMessages - m_lastWrittenMessages) / seconds, m_writeBatches);
+
+    m_lastStats = now;
+    m_lastReadMessages = read;
+    m_lastDecodedMessages = decoded;
+    m_lastWrittenMessages = m_writtenMessages;
+}
@@ -0,0 +1,106 @@
+#ifndef __FPMPIPELINE__
+#define __FPMPIPELINE__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "selectableevent.h"
+#include "fpmsyncd/fpmlink.h"
+#include "fpmsyncd/routesync.h"
+
+namespace swss {
+
+/*
+ * FpmPipeline: pipelined ingestion of the FPM messages.
+ *
+ * A reader thread drains the FPM socket and copies every route message in a
+ * ring of slots. Decoder threads parse the slots into route records, and the
+ * writer, i.e. the thread calling write(), updates the route tables with the
+ * records in the order the messages were received. Only the writer touches
+ * the RedisPipeline and the warm-restart state.
+ *
+ * The writer is woken up through the selectable event when the oldest slot
+ * has been decoded. When the ring is full, the reader stops reading the
+ * socket until the writer caught up.
+ */
+class FpmPipeline
+{
+public:
+    static const size_t DEFAULT_RING_SIZE = 4096;
+
+    FpmPipeline(FpmLink &link, RouteSync &sync, size_t decoders,
+                size_t ringSize = DEFAULT_RING_SIZE);
+    ~FpmPipeline();
+
+    FpmPipeline(const FpmPipeline&) = delete;
+    FpmPipeline& operator=(const FpmPipeline&) = delete;
+
+    Selectable *getSelectable();
+
+    /*
+     * Update the route tables with all decoded routes, return the number of
+     * messages written. Once all messages have been written, rethrows the
+     * error which stopped the reader, FpmConnectionClosedException when the
+     * connection was lost.
+     */
+    size_t write();
+
+private:
+    struct Slot
+    {
+        std::vector<char> message;
+        RouteRecord record;
+        bool valid = false;     // record holds a supported route
+        bool decoded = false;
+    };
+
+    FpmLink &m_link;
+    RouteSync &m_sync;
+
+    std::vector<Slot> m_slots;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_received;
+    SelectableEvent m_decodedEvent;
+
+    /* Sequence numbers of the next message to read, decode and write */
+    uint64_t m_readSeq = 0;
+    uint64_t m_decodeSeq = 0;
+    uint64_t m_writeSeq = 0;
+
+    std::atomic<bool> m_stop;
+    bool m_readerDone = false;
+    std::exception_ptr m_readerError;
+
+    std::thread m_reader;
+    std::vector<std::thread> m_decoders;
+
+    /* Per stage throughput counters */
+    std::atomic<uint64_t> m_readMessages;
+    std::atomic<uint64_t> m_readBytes;
+    std::atomic<uint64_t> m_ringFull;
+    std::atomic<uint64_t> m_decodedMessages;
+    uint64_t m_writtenMessages = 0;
+    uint64_t m_writeBatches = 0;
+    uint64_t m_lastReadMessages = 0;
+    uint64_t m_lastDecodedMessages = 0;
+    uint64_t m_lastWrittenMessages = 0;
+    std::chrono::steady_clock::time_point m_lastStats;
+
+    Slot &getSlot(uint64_t seq);
+
+    void readMessages();
+    void receive(nlmsghdr *hdr);
+    void decodeMessages();
+    void decode(Slot &slot);
+    void logStats(bool force);
+};
+
+}
+
+#endif
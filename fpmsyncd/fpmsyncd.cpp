@@ -1,10 +1,14 @@
+#include <getopt.h>
+#include <stdlib.h>
 #include <iostream>
+#include <memory>
 #include "logger.h"
 #include "select.h"
 #include "selectabletimer.h"
 #include "netdispatcher.h"
 #include "warmRestartHelper.h"
 #include "fpmsyncd/fpmlink.h"
+#include "fpmsyncd/fpmpipeline.h"
 #include "fpmsyncd/routesync.h"
 
 
@@ -18,9 +22,39 @@ using namespace swss;
  */
 const uint32_t DEFAULT_ROUTING_RESTART_INTERVAL = 120;
 
+void usage()
+{
+    cout << "Usage: fpmsyncd [-p decoders]" << endl;
+    cout << "       -p decoders: pipelined mode, read the FPM socket on its own thread and" << endl;
+    cout << "                    decode the route messages on the given number of threads" << endl;
+}
 
 int main(int argc, char **argv)
 {
+    int opt;
+    int decoders = 0;
+
+    while ((opt = getopt(argc, argv, "p:h")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'p':
+            decoders = atoi(optarg);
+            if (decoders <= 0)
+            {
+                usage();
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     swss::Logger::linkToDbNative("fpmsyncd");
     DBConnector db(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     RedisPipeline pipeline(&db);
@@ -47,7 +81,20 @@ int main(int argc, char **argv)
             fpm.accept();
             cout << "Connected!" << endl;
 
-            s.addSelectable(&fpm);
+            /*
+             * In pipelined mode the socket is read by the pipeline threads,
+             * the loop only writes the decoded routes.
+             */
+            unique_ptr<FpmPipeline> fpmPipeline;
+            if (decoders > 0)
+            {
+                fpmPipeline.reset(new FpmPipeline(fpm, sync, (size_t)decoders));
+                s.addSelectable(fpmPipeline->getSelectable());
+            }
+            else
+            {
+                s.addSelectable(&fpm);
+            }
 
             /* If warm-restart feature is enabled, execute 'restoration' logic */
             bool warmStartEnabled = sync.m_warmStartHelper.checkAndStart();
@@ -79,6 +126,11 @@ int main(int argc, char **argv)
                 /* Reading FPM messages forever (and calling "readMe" to read them) */
                 s.select(&temps);
 
+                if (fpmPipeline && temps == fpmPipeline->getSelectable())
+                {
+                    fpmPipeline->write();
+                }
+
                 /*
                  * Upon expiration of the warm-restart timer, proceed to run the
                  * reconciliation process and remove warm-restart timer from
@@ -30,6 +30,24 @@ RouteSync::RouteSync(RedisPipeline *pipeline) :
 }
 
 void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
+{
+    RouteRecord record;
+
+    if (decodeRoute(nlmsg_type, obj, record))
+    {
+        onRoute(record);
+    }
+}
+
+/*
+ * Decode a route object
+ * @arg nlmsg_type      Netlink message type
+ * @arg obj             Netlink object
+ * @arg record          Decoded route
+ *
+ * Return false if the route is not supported.
+ */
+bool RouteSync::decodeRoute(int nlmsg_type, struct nl_object *obj, RouteRecord &record)
 {
     struct rtnl_route *route_obj = (struct rtnl_route *)obj;
 
@@ -38,7 +56,7 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
     if (family != AF_INET && family != AF_INET6)
     {
         SWSS_LOG_INFO("Unknown route family support (object: %s)", nl_object_get_type(obj));
-        return;
+        return false;
     }
 
     /* Get the index of the master device */
@@ -47,33 +65,70 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
 
     /* Get the name of the master device */
     getIfName(master_index, master_name, IFNAMSIZ);
-    
+
     /* If the master device name starts with VNET_PREFIX, it is a VNET route.
        The VNET name is exactly the name of the associated master device. */
     if (string(master_name).find(VNET_PREFIX) == 0)
     {
-        onVnetRouteMsg(nlmsg_type, obj, string(master_name));
+        record.vnet = master_name;
     }
     /* Otherwise, it is a regular route (include VRF route). */
     else
     {
-        onRouteMsg(nlmsg_type, obj);
+        record.vnet.clear();
+    }
+
+    /* Get the destination IP prefix */
+    struct nl_addr *dip = rtnl_route_get_dst(route_obj);
+    char destipprefix[MAX_ADDR_SIZE + 1] = {0};
+    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
+
+    record.nlmsg_type = nlmsg_type;
+    record.prefix = destipprefix;
+    record.type = rtnl_route_get_type(route_obj);
+    record.has_nexthops = false;
+    record.nexthops.clear();
+    record.ifnames.clear();
+    record.nnexthops = 0;
+
+    /* Next hops are only used by unicast route updates */
+    if (nlmsg_type == RTM_NEWROUTE && record.type == RTN_UNICAST &&
+        rtnl_route_get_nexthops(route_obj))
+    {
+        record.has_nexthops = true;
+        record.nexthops = getNextHopGw(route_obj);
+        record.ifnames = getNextHopIf(route_obj);
+        record.nnexthops = rtnl_route_get_nnexthops(route_obj);
+    }
+
+    return true;
+}
+
+/*
+ * Update the route tables with a decoded route
+ * @arg record          Decoded route
+ */
+void RouteSync::onRoute(const RouteRecord &record)
+{
+    if (!record.vnet.empty())
+    {
+        onVnetRouteMsg(record);
+    }
+    else
+    {
+        onRouteMsg(record);
     }
 }
 
 /* 
  * Handle regular route (include VRF route) 
- * @arg nlmsg_type      Netlink message type
- * @arg obj             Netlink object
+ * @arg record          Decoded route
  */
-void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
+void RouteSync::onRouteMsg(const RouteRecord &record)
 {
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
-    struct nl_addr *dip;
-    char destipprefix[MAX_ADDR_SIZE + 1] = {0};
+    const char *destipprefix = record.prefix.c_str();
+    int nlmsg_type = record.nlmsg_type;
 
-    dip = rtnl_route_get_dst(route_obj);
-    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
     SWSS_LOG_DEBUG("Receive new route message dest ip prefix: %s", destipprefix);
 
     /*
@@ -86,7 +141,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            m_routeTable.del(record.prefix);
             return;
         }
         else
@@ -95,7 +150,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
                           destipprefix);
 
             vector<FieldValueTuple> fvVector;
-            const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
+            const KeyOpFieldsValuesTuple kfv = std::make_tuple(record.prefix,
                                                                DEL_COMMAND,
                                                                fvVector);
             m_warmStartHelper.insertRefreshMap(kfv);
@@ -108,14 +163,14 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (record.type)
     {
         case RTN_BLACKHOLE:
         {
             vector<FieldValueTuple> fvVector;
             FieldValueTuple fv("blackhole", "true");
             fvVector.push_back(fv);
-            m_routeTable.set(destipprefix, fvVector);
+            m_routeTable.set(record.prefix, fvVector);
             return;
         }
         case RTN_UNICAST:
@@ -131,29 +186,24 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
             return;
     }
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    if (!record.has_nexthops)
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s", destipprefix);
         return;
     }
 
-    /* Get nexthop lists */
-    string nexthops = getNextHopGw(route_obj);
-    string ifnames = getNextHopIf(route_obj);
-
     vector<FieldValueTuple> fvVector;
-    FieldValueTuple nh("nexthop", nexthops);
-    FieldValueTuple idx("ifname", ifnames);
+    FieldValueTuple nh("nexthop", record.nexthops);
+    FieldValueTuple idx("ifname", record.ifnames);
 
     fvVector.push_back(nh);
     fvVector.push_back(idx);
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        m_routeTable.set(record.prefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s %s %s",
-                       destipprefix, nexthops.c_str(), ifnames.c_str());
+                       destipprefix, record.nexthops.c_str(), record.ifnames.c_str());
     }
 
     /*
@@ -163,9 +213,9 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
     else
     {
         SWSS_LOG_INFO("Warm-Restart mode: RouteTable set msg: %s %s %s",
-                      destipprefix, nexthops.c_str(), ifnames.c_str());
+                      destipprefix, record.nexthops.c_str(), record.ifnames.c_str());
 
-        const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
+        const KeyOpFieldsValuesTuple kfv = std::make_tuple(record.prefix,
                                                            SET_COMMAND,
                                                            fvVector);
         m_warmStartHelper.insertRefreshMap(kfv);
@@ -174,36 +224,27 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj)
 
 /* 
  * Handle vnet route 
- * @arg nlmsg_type      Netlink message type
- * @arg obj             Netlink object
- * @arg vnet            Vnet name
+ * @arg record          Decoded route
  */     
-void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vnet)
+void RouteSync::onVnetRouteMsg(const RouteRecord &record)
 {
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
-
-    /* Get the destination IP prefix */
-    struct nl_addr *dip = rtnl_route_get_dst(route_obj);
-    char destipprefix[MAX_ADDR_SIZE + 1] = {0};
-    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
-
-    string vnet_dip =  vnet + string(":") + destipprefix;
+    string vnet_dip =  record.vnet + string(":") + record.prefix;
     SWSS_LOG_DEBUG("Receive new vnet route message %s", vnet_dip.c_str());
 
-    if (nlmsg_type == RTM_DELROUTE)
+    if (record.nlmsg_type == RTM_DELROUTE)
     {
         /* Duplicated delete as we do not know if it is a VXLAN tunnel route*/
         m_vnet_routeTable.del(vnet_dip);
         m_vnet_tunnelTable.del(vnet_dip);
         return;
     }
-    else if (nlmsg_type != RTM_NEWROUTE)
+    else if (record.nlmsg_type != RTM_NEWROUTE)
     {
-        SWSS_LOG_INFO("Unknown message-type: %d for %s", nlmsg_type, vnet_dip.c_str());
+        SWSS_LOG_INFO("Unknown message-type: %d for %s", record.nlmsg_type, vnet_dip.c_str());
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (record.type)
     {
         case RTN_UNICAST:
             break;
@@ -223,16 +264,14 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
             return;
     }
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    if (!record.has_nexthops)
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s", vnet_dip.c_str());
         return;
     }
 
-    /* Get nexthop lists */
-    string nexthops = getNextHopGw(route_obj);
-    string ifnames = getNextHopIf(route_obj);
+    const string &nexthops = record.nexthops;
+    const string &ifnames = record.ifnames;
 
     /* If the the first interface name starts with VXLAN_IF_NAME_PREFIX,
        the route is a VXLAN tunnel route. */
@@ -255,7 +294,7 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
         fvVector.push_back(idx);
 
         /* If the route has at least one next hop gateway, e.g., nexthops does not only have ',' */
-        if (nexthops.length() + 1 > (unsigned int)rtnl_route_get_nnexthops(route_obj))
+        if (nexthops.length() + 1 > (unsigned int)record.nnexthops)
         {
             FieldValueTuple nh("nexthop", nexthops);
             fvVector.push_back(nh);
@@ -289,6 +328,8 @@ bool RouteSync::getIfName(int if_index, char *if_name, size_t name_len)
 
     memset(if_name, 0, name_len);
 
+    lock_guard<mutex> lock(m_link_cache_mutex);
+
     /* Cannot get interface name. Possibly the interface gets re-created. */
     if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
     {
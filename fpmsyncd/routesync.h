@@ -6,11 +6,28 @@
 #include "netmsg.h"
 #include "warmRestartHelper.h"
 #include <string.h>
+#include <mutex>
 
 using namespace std;
 
 namespace swss {
 
+/*
+ * Compact form of a route message, holding everything needed to update the
+ * route tables once the netlink object has been released.
+ */
+struct RouteRecord
+{
+    int     nlmsg_type;
+    string  vnet;               /* Vnet name, empty for regular routes */
+    string  prefix;             /* Destination IP prefix */
+    uint8_t type;               /* RTN_* route type */
+    bool    has_nexthops;       /* Next hop lists below are valid */
+    string  nexthops;           /* Next hop gateways, comma separated */
+    string  ifnames;            /* Next hop interfaces, comma separated */
+    int     nnexthops;
+};
+
 class RouteSync : public NetMsg
 {
 public:
@@ -20,6 +37,16 @@ public:
 
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
+    /*
+     * Decode a route object into a record, return false if the route is not
+     * supported. Only uses the link cache, so it can run on other threads
+     * than the one calling onRoute().
+     */
+    bool decodeRoute(int nlmsg_type, struct nl_object *obj, RouteRecord &record);
+
+    /* Update the route tables with a decoded route */
+    void onRoute(const RouteRecord &record);
+
     WarmStartHelper  m_warmStartHelper;
 
 private:
@@ -31,12 +58,14 @@ private:
     ProducerStateTable  m_vnet_tunnelTable; 
     struct nl_cache    *m_link_cache;
     struct nl_sock     *m_nl_sock;
+    /* Protects the link cache against concurrent decoders */
+    std::mutex          m_link_cache_mutex;
 
     /* Handle regular route (include VRF route) */
-    void onRouteMsg(int nlmsg_type, struct nl_object *obj);
+    void onRouteMsg(const RouteRecord &record);
 
     /* Handle vnet route */
-    void onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vnet);
+    void onVnetRouteMsg(const RouteRecord &record);
 
     /* Get interface name based on interface index */
     bool getIfName(int if_index, char *if_name, size_t name_len);
@@ -0,0 +1,230 @@
+#include <memory>
+#include <set>
+#include "aclcounterpoller.h"
+#include "logger.h"
+
+/* Granularity of the table polling intervals */
+#define ACL_COUNTER_POLL_TICK_MSECS 1000
+
+AclCounterPoller::AclCounterPoller(Reader reader) :
+    m_reader(reader),
+    m_pendingTables(nullptr),
+    m_pendingUpdates(nullptr),
+    m_stop(false)
+{
+}
+
+AclCounterPoller::~AclCounterPoller()
+{
+    stop();
+
+    delete m_pendingTables.exchange(nullptr);
+    delete m_pendingUpdates.exchange(nullptr);
+}
+
+void AclCounterPoller::start()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_thread.joinable())
+    {
+        return;
+    }
+
+    m_stop = false;
+    m_thread = thread(&AclCounterPoller::run, this);
+}
+
+void AclCounterPoller::stop()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_sleepGuard.notify_all();
+    m_thread.join();
+}
+
+void AclCounterPoller::run()
+{
+    SWSS_LOG_ENTER();
+
+    unique_lock<mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        lock.unlock();
+        poll(chrono::steady_clock::now());
+        lock.lock();
+
+        m_sleepGuard.wait_for(lock, chrono::milliseconds(ACL_COUNTER_POLL_TICK_MSECS),
+                [this]() { return m_stop; });
+    }
+}
+
+void AclCounterPoller::setTables(vector<AclCounterPollTable> tables)
+{
+    /* Drop the previous tables if the thread did not take them yet */
+    unique_ptr<Tables> previous(m_pendingTables.exchange(new Tables(move(tables))));
+}
+
+vector<AclCounterUpdate> AclCounterPoller::takeUpdates()
+{
+    unique_ptr<Updates> updates(m_pendingUpdates.exchange(nullptr));
+    if (!updates)
+    {
+        return Updates();
+    }
+
+    return move(*updates);
+}
+
+void AclCounterPoller::poll(chrono::steady_clock::time_point now)
+{
+    unique_ptr<Tables> tables(m_pendingTables.exchange(nullptr));
+    if (tables)
+    {
+        applyTables(*tables);
+    }
+
+    Updates updates;
+    for (auto &it : m_tables)
+    {
+        PolledTable &polled = it.second;
+        if (now < polled.nextPoll)
+        {
+            continue;
+        }
+
+        polled.nextPoll = now + chrono::seconds(polled.table.interval);
+        pollTable(polled.table, updates);
+    }
+
+    if (!updates.empty())
+    {
+        handOver(updates);
+    }
+}
+
+void AclCounterPoller::applyTables(const Tables &tables)
+{
+    map<sai_object_id_t, PolledTable> polledTables;
+    set<string> keys;
+
+    for (const auto &table : tables)
+    {
+        PolledTable polled = { table, chrono::steady_clock::time_point() };
+
+        /* Tables already polled keep their schedule, new ones are polled now */
+        auto it = m_tables.find(table.oid);
+        if (it != m_tables.end() && it->second.table.interval == table.interval)
+        {
+            polled.nextPoll = it->second.nextPoll;
+        }
+        polledTables.emplace(table.oid, polled);
+
+        for (const auto &rule : table.rules)
+        {
+            keys.insert(table.id + ":" + rule.id);
+        }
+    }
+
+    /* Forget the removed rules so that they are published again if added back */
+    for (auto it = m_published.begin(); it != m_published.end();)
+    {
+        if (keys.find(it->first) == keys.end())
+        {
+            it = m_published.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    m_tables.swap(polledTables);
+}
+
+void AclCounterPoller::pollTable(AclCounterPollTable &table, Updates &updates)
+{
+    vector<sai_object_id_t> oids;
+    for (const auto &rule : table.rules)
+    {
+        if (rule.counterOid != SAI_NULL_OBJECT_ID)
+        {
+            oids.push_back(rule.counterOid);
+        }
+    }
+
+    vector<AclRuleCounters> counters(oids.size());
+    vector<bool> valid(oids.size(), false);
+    if (!oids.empty())
+    {
+        m_reader(oids, counters, valid);
+    }
+
+    size_t index = 0;
+    for (const auto &rule : table.rules)
+    {
+        AclRuleCounters cnt(rule.stored);
+
+        if (rule.counterOid != SAI_NULL_OBJECT_ID)
+        {
+            size_t i = index++;
+            if (!valid[i])
+            {
+                continue;
+            }
+            cnt += counters[i];
+        }
+
+        /* Only publish the counters which changed */
+        string key = table.id + ":" + rule.id;
+        auto it = m_published.find(key);
+        if (it != m_published.end() &&
+                it->second.counterOid == rule.counterOid &&
+                it->second.counters == cnt)
+        {
+            continue;
+        }
+
+        m_published[key] = { rule.counterOid, cnt };
+        updates.push_back({ table.oid, table.id, rule.id, rule.counterOid, cnt });
+    }
+}
+
+void AclCounterPoller::handOver(Updates &updates)
+{
+    unique_ptr<Updates> batch(new Updates(move(updates)));
+
+    /*
+     * Keep the updates of the previous batch which was not taken yet, unless
+     * superseded by this one. Only this thread stores batches, so no batch
+     * can be stored between the exchange and the store.
+     */
+    unique_ptr<Updates> previous(m_pendingUpdates.exchange(nullptr));
+    if (previous)
+    {
+        set<string> keys;
+        for (const auto &update : *batch)
+        {
+            keys.insert(update.tableId + ":" + update.ruleId);
+        }
+
+        for (auto &update : *previous)
+        {
+            if (keys.find(update.tableId + ":" + update.ruleId) == keys.end())
+            {
+                batch->push_back(move(update));
+            }
+        }
+    }
+
+    m_pendingUpdates.store(batch.release());
+}
@@ -0,0 +1,152 @@
+#ifndef SWSS_ACLCOUNTERPOLLER_H
+#define SWSS_ACLCOUNTERPOLLER_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+struct AclRuleCounters
+{
+    uint64_t packets;
+    uint64_t bytes;
+
+    AclRuleCounters(uint64_t p = 0, uint64_t b = 0) :
+        packets(p),
+        bytes(b)
+    {
+    }
+
+    AclRuleCounters(const AclRuleCounters& rhs) :
+        packets(rhs.packets),
+        bytes(rhs.bytes)
+    {
+    }
+
+    AclRuleCounters& operator =(const AclRuleCounters& rhs) = default;
+
+    AclRuleCounters& operator +=(const AclRuleCounters& rhs)
+    {
+        packets += rhs.packets;
+        bytes += rhs.bytes;
+        return *this;
+    }
+
+    bool operator ==(const AclRuleCounters& rhs) const
+    {
+        return packets == rhs.packets && bytes == rhs.bytes;
+    }
+
+    bool operator !=(const AclRuleCounters& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+struct AclCounterPollRule
+{
+    string id;
+    sai_object_id_t counterOid;         // SAI_NULL_OBJECT_ID if the rule has no counter installed
+    AclRuleCounters stored;             // added to the counter, e.g. of a deactivated mirror rule
+};
+
+struct AclCounterPollTable
+{
+    sai_object_id_t oid;
+    string id;
+    uint32_t interval;                  // seconds
+    vector<AclCounterPollRule> rules;
+};
+
+struct AclCounterUpdate
+{
+    sai_object_id_t tableOid;
+    string tableId;
+    string ruleId;
+    sai_object_id_t counterOid;         // counter polled, to detect rules changed since
+    AclRuleCounters counters;
+};
+
+/*
+ * AclCounterPoller: reads the ACL rule counters on its own thread.
+ *
+ * AclOrch hands over the rules to poll with setTables() and takes the
+ * counters which changed since they were last taken with takeUpdates().
+ * Both are exchanged through atomic pointers, neither side ever waits for
+ * the other. Each table is polled at its own interval, the counters of a
+ * table are read by one call of the reader.
+ */
+class AclCounterPoller
+{
+public:
+    /* Read the counters of the oids, valid[i] is false if counters[i] could not be read */
+    typedef function<void(const vector<sai_object_id_t> &oids,
+                          vector<AclRuleCounters> &counters, vector<bool> &valid)> Reader;
+
+    AclCounterPoller(Reader reader);
+    ~AclCounterPoller();
+
+    AclCounterPoller(const AclCounterPoller&) = delete;
+    AclCounterPoller& operator=(const AclCounterPoller&) = delete;
+
+    void start();
+    void stop();
+
+    /* Replace the tables to poll, the tables kept keep their schedule */
+    void setTables(vector<AclCounterPollTable> tables);
+
+    /* Counters changed since the last call, the latest value of each rule */
+    vector<AclCounterUpdate> takeUpdates();
+
+    /* Poll the tables which are due, done by the thread once started */
+    void poll(chrono::steady_clock::time_point now);
+
+private:
+    typedef vector<AclCounterPollTable> Tables;
+    typedef vector<AclCounterUpdate> Updates;
+
+    struct PolledTable
+    {
+        AclCounterPollTable table;
+        chrono::steady_clock::time_point nextPoll;
+    };
+
+    struct PublishedCounters
+    {
+        sai_object_id_t counterOid;
+        AclRuleCounters counters;
+    };
+
+    Reader m_reader;
+
+    atomic<Tables *> m_pendingTables;
+    atomic<Updates *> m_pendingUpdates;
+
+    /* Owned by the polling thread */
+    map<sai_object_id_t, PolledTable> m_tables;
+    unordered_map<string, PublishedCounters> m_published;
+
+    thread m_thread;
+    mutex m_mutex;
+    condition_variable m_sleepGuard;
+    bool m_stop;
+
+    void run();
+    void applyTables(const Tables &tables);
+    void pollTable(AclCounterPollTable &table, Updates &updates);
+    void handOver(Updates &updates);
+};
+
+#endif /* SWSS_ACLCOUNTERPOLLER_H */
@@ -15,8 +15,6 @@ using namespace swss;
 
 mutex AclOrch::m_countersMutex;
 map<acl_range_properties_t, AclRange*> AclRange::m_ranges;
-condition_variable AclOrch::m_sleepGuard;
-bool AclOrch::m_bCollectCounters = true;
 sai_uint32_t AclRule::m_minPriority = 0;
 sai_uint32_t AclRule::m_maxPriority = 0;
 
@@ -551,6 +549,39 @@ bool AclRule::remove()
     return res;
 }
 
+static bool getAclCounter(sai_object_id_t counter_oid, AclRuleCounters &counters)
+{
+    sai_attribute_t counter_attr[2];
+    counter_attr[0].id = SAI_ACL_COUNTER_ATTR_PACKETS;
+    counter_attr[1].id = SAI_ACL_COUNTER_ATTR_BYTES;
+
+    if (sai_acl_api->get_acl_counter_attribute(counter_oid, 2, counter_attr) != SAI_STATUS_SUCCESS)
+    {
+        return false;
+    }
+
+    counters = AclRuleCounters(counter_attr[0].value.u64, counter_attr[1].value.u64);
+    return true;
+}
+
+/*
+ * Reader of the ACL counter poller. The SAI ACL API has no bulk get, so
+ * the counters of a table are read one by one, off the orchagent thread.
+ */
+static void readAclCounters(const vector<sai_object_id_t> &counter_oids,
+                            vector<AclRuleCounters> &counters, vector<bool> &valid)
+{
+    for (size_t i = 0; i < counter_oids.size(); i++)
+    {
+        valid[i] = getAclCounter(counter_oids[i], counters[i]);
+        if (!valid[i])
+        {
+            /* The counter may have been removed since the tables were handed over */
+            SWSS_LOG_INFO("Failed to get ACL counter %lx", counter_oids[i]);
+        }
+    }
+}
+
 AclRuleCounters AclRule::getCounters()
 {
     SWSS_LOG_ENTER();
@@ -560,17 +591,14 @@ AclRuleCounters AclRule::getCounters()
         return AclRuleCounters();
     }
 
-    sai_attribute_t counter_attr[2];
-    counter_attr[0].id = SAI_ACL_COUNTER_ATTR_PACKETS;
-    counter_attr[1].id = SAI_ACL_COUNTER_ATTR_BYTES;
-
-    if (sai_acl_api->get_acl_counter_attribute(m_counterOid, 2, counter_attr) != SAI_STATUS_SUCCESS)
+    AclRuleCounters counters;
+    if (!getAclCounter(m_counterOid, counters))
     {
         SWSS_LOG_ERROR("Failed to get counters for %s rule", m_id.c_str());
         return AclRuleCounters();
     }
 
-    return AclRuleCounters(counter_attr[0].value.u64, counter_attr[1].value.u64);
+    return counters;
 }
 
 shared_ptr<AclRule> AclRule::makeShared(acl_table_type_t type, AclOrch *acl, MirrorOrch *mirror, DTelOrch *dtel, const string& rule, const string& table, const KeyOpFieldsValuesTuple& data)
@@ -1524,6 +1552,11 @@ bool AclTable::clear()
     return true;
 }
 
+AclRuleCounters AclRuleMirror::getStoredCounters()
+{
+    return counters;
+}
+
 AclRuleCounters AclRuleMirror::getCounters()
 {
     AclRuleCounters cnt(counters);
@@ -2012,7 +2045,12 @@ void AclOrch::init(vector<TableConnector>& connectors, PortsOrch *portOrch, Mirr
 
     // Should be initialized last to guaranty that object is
     // initialized before thread start.
-    auto interv = timespec { .tv_sec = COUNTERS_READ_INTERVAL, .tv_nsec = 0 };
+    m_countersPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(&m_db));
+    m_countersUpdateTable = unique_ptr<Table>(new Table(m_countersPipeline.get(), "COUNTERS", true));
+    m_counterPoller = unique_ptr<AclCounterPoller>(new AclCounterPoller(readAclCounters));
+    m_counterPoller->start();
+
+    auto interv = timespec { .tv_sec = COUNTERS_PUBLISH_INTERVAL, .tv_nsec = 0 };
     auto timer = new SelectableTimer(interv);
     auto executor = new ExecutableTimer(timer, this, "ACL_POLL_TIMER");
     Orch::addExecutor(executor);
@@ -2048,8 +2086,7 @@ AclOrch::~AclOrch()
         m_dTelOrch->detach(this);
     }
 
-    m_bCollectCounters = false;
-    m_sleepGuard.notify_all();
+    m_counterPoller->stop();
 
     deleteDTelWatchListTables();
 }
@@ -2067,6 +2104,8 @@ void AclOrch::update(SubjectType type, void *cntx)
 
     unique_lock<mutex> lock(m_countersMutex);
 
+    m_counterTablesChanged = true;
+
     // ACL table deals with port change
     // ACL rule deals with mirror session change and int session change
     for (auto& table : m_AclTables)
@@ -2100,11 +2139,13 @@ void AclOrch::doTask(Consumer &consumer)
     {
         unique_lock<mutex> lock(m_countersMutex);
         doAclTableTask(consumer);
+        m_counterTablesChanged = true;
     }
     else if (table_name == CFG_ACL_RULE_TABLE_NAME)
     {
         unique_lock<mutex> lock(m_countersMutex);
         doAclRuleTask(consumer);
+        m_counterTablesChanged = true;
     }
     else
     {
@@ -2340,6 +2381,16 @@ void AclOrch::doAclTableTask(Consumer &consumer)
                     // TODO: validate control plane ACL table has this attribute
                     continue;
                 }
+                else if (attr_name == TABLE_COUNTER_POLL_INTERVAL)
+                {
+                    if (!processAclTableCounterPollInterval(attr_value, newTable.counterPollInterval))
+                    {
+                        SWSS_LOG_ERROR("Failed to process ACL table %s counter poll interval",
+                                table_id.c_str());
+                        bAllAttributesOk = false;
+                        break;
+                    }
+                }
                 else
                 {
                     SWSS_LOG_ERROR("Unknown table attribute '%s'", attr_name.c_str());
@@ -2578,6 +2629,23 @@ bool AclOrch::processAclTableStage(string stage, acl_stage_type_t &acl_stage)
     return true;
 }
 
+bool AclOrch::processAclTableCounterPollInterval(string interval, uint32_t &poll_interval)
+{
+    SWSS_LOG_ENTER();
+
+    try
+    {
+        poll_interval = to_uint<uint32_t>(interval, 1);
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid counter poll interval %s: %s", interval.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
 sai_object_id_t AclOrch::getTableById(string table_id)
 {
     SWSS_LOG_ENTER();
@@ -2646,23 +2714,71 @@ void AclOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& table_it : m_AclTables)
+    unique_lock<mutex> lock(m_countersMutex);
+
+    if (m_counterTablesChanged)
     {
-        vector<swss::FieldValueTuple> values;
+        m_counterPoller->setTables(getCounterPollTables());
+        m_counterTablesChanged = false;
+    }
+
+    vector<AclCounterUpdate> updates = m_counterPoller->takeUpdates();
+    if (updates.empty())
+    {
+        return;
+    }
 
-        for (auto rule_it : table_it.second.rules)
+    for (const auto& update : updates)
+    {
+        // Skip the rules removed or changed since their counter was polled
+        auto table_it = m_AclTables.find(update.tableOid);
+        if (table_it == m_AclTables.end())
         {
-            AclRuleCounters cnt = rule_it.second->getCounters();
+            continue;
+        }
+        auto rule_it = table_it->second.rules.find(update.ruleId);
+        if (rule_it == table_it->second.rules.end() ||
+                rule_it->second->getCounterOid() != update.counterOid)
+        {
+            continue;
+        }
+
+        vector<swss::FieldValueTuple> values;
+        values.emplace_back("Packets", to_string(update.counters.packets));
+        values.emplace_back("Bytes", to_string(update.counters.bytes));
 
-            swss::FieldValueTuple fvtp("Packets", to_string(cnt.packets));
-            values.push_back(fvtp);
-            swss::FieldValueTuple fvtb("Bytes", to_string(cnt.bytes));
-            values.push_back(fvtb);
+        m_countersUpdateTable->set(update.tableId + ":" + update.ruleId, values, "");
+    }
 
-            AclOrch::getCountersTable().set(table_it.second.id + ":" + rule_it.second->getId(), values, "");
+    m_countersUpdateTable->flush();
+}
+
+vector<AclCounterPollTable> AclOrch::getCounterPollTables()
+{
+    SWSS_LOG_ENTER();
+
+    vector<AclCounterPollTable> tables;
+
+    for (auto& table_it : m_AclTables)
+    {
+        AclCounterPollTable table;
+        table.oid = table_it.first;
+        table.id = table_it.second.id;
+        table.interval = table_it.second.counterPollInterval;
+
+        for (auto& rule_it : table_it.second.rules)
+        {
+            AclCounterPollRule rule;
+            rule.id = rule_it.second->getId();
+            rule.counterOid = rule_it.second->getCounterOid();
+            rule.stored = rule_it.second->getStoredCounters();
+            table.rules.push_back(rule);
         }
-        values.clear();
+
+        tables.push_back(move(table));
     }
+
+    return tables;
 }
 
 sai_status_t AclOrch::bindAclTable(sai_object_id_t table_oid, AclTable &aclTable, bool bind)
@@ -9,20 +9,26 @@
 #include <map>
 #include <condition_variable>
 #include "orch.h"
+#include "redispipeline.h"
 #include "portsorch.h"
 #include "mirrororch.h"
 #include "dtelorch.h"
 #include "observer.h"
+#include "aclcounterpoller.h"
 
-// ACL counters update interval in the DB
-// Value is in seconds. Should not be less than 5 seconds
-// (in worst case update of 1265 counters takes almost 5 sec)
+// Default ACL counters read interval of a table, in seconds
+// The counters are read by the ACL counter poller thread
 #define COUNTERS_READ_INTERVAL 10
 
+// ACL counters update interval in the DB, in seconds
+// Only the counters which changed since the last update are written
+#define COUNTERS_PUBLISH_INTERVAL 1
+
 #define TABLE_DESCRIPTION "POLICY_DESC"
 #define TABLE_TYPE        "TYPE"
 #define TABLE_PORTS       "PORTS"
 #define TABLE_SERVICES    "SERVICES"
+#define TABLE_COUNTER_POLL_INTERVAL "COUNTER_POLL_INTERVAL"
 
 #define TABLE_TYPE_L3                   "L3"
 #define TABLE_TYPE_L3V6                 "L3V6"
@@ -137,31 +143,6 @@ private:
     static map<acl_range_properties_t, AclRange*> m_ranges;
 };
 
-struct AclRuleCounters
-{
-    uint64_t packets;
-    uint64_t bytes;
-
-    AclRuleCounters(uint64_t p = 0, uint64_t b = 0) :
-        packets(p),
-        bytes(b)
-    {
-    }
-
-    AclRuleCounters(const AclRuleCounters& rhs) :
-        packets(rhs.packets),
-        bytes(rhs.bytes)
-    {
-    }
-
-    AclRuleCounters& operator +=(const AclRuleCounters& rhs)
-    {
-        packets += rhs.packets;
-        bytes += rhs.bytes;
-        return *this;
-    }
-};
-
 class AclRule
 {
 public:
@@ -181,6 +162,11 @@ public:
     virtual bool remove();
     virtual void update(SubjectType, void *) = 0;
     virtual AclRuleCounters getCounters();
+    // Counters not accounted by the installed counter
+    virtual AclRuleCounters getStoredCounters()
+    {
+        return AclRuleCounters();
+    }
 
     string getId()
     {
@@ -268,6 +254,7 @@ public:
     bool remove();
     void update(SubjectType, void *);
     AclRuleCounters getCounters();
+    AclRuleCounters getStoredCounters();
 
 protected:
     bool m_state;
@@ -313,6 +300,8 @@ public:
     string description;
     acl_table_type_t type;
     acl_stage_type_t stage;
+    // Counters read interval of the rules, in seconds
+    uint32_t counterPollInterval;
 
     // Map port oid to group member oid
     std::map<sai_object_id_t, sai_object_id_t> ports;
@@ -328,6 +317,7 @@ public:
         , type(ACL_TABLE_UNKNOWN)
         , m_oid(SAI_NULL_OBJECT_ID)
         , stage(ACL_STAGE_INGRESS)
+        , counterPollInterval(COUNTERS_READ_INTERVAL)
     {}
 
     AclTable(AclOrch *aclOrch)
@@ -335,6 +325,7 @@ public:
         , type(ACL_TABLE_UNKNOWN)
         , m_oid(SAI_NULL_OBJECT_ID)
         , stage(ACL_STAGE_INGRESS)
+        , counterPollInterval(COUNTERS_READ_INTERVAL)
     {}
 
     sai_object_id_t getOid() { return m_oid; }
@@ -417,7 +408,7 @@ private:
 
     void queryMirrorTableCapability();
 
-    static void collectCountersThread(AclOrch *pAclOrch);
+    vector<AclCounterPollTable> getCounterPollTables();
 
     bool createBindAclTable(AclTable &aclTable, sai_object_id_t &table_oid);
     sai_status_t bindAclTable(sai_object_id_t table_oid, AclTable &aclTable, bool bind = true);
@@ -425,6 +416,7 @@ private:
 
     bool processAclTableType(string type, acl_table_type_t &table_type);
     bool processAclTableStage(string stage, acl_stage_type_t &acl_stage);
+    bool processAclTableCounterPollInterval(string interval, uint32_t &poll_interval);
     bool processAclTablePorts(string portList, AclTable &aclTable);
     bool validateAclTable(AclTable &aclTable);
     sai_status_t createDTelWatchListTables();
@@ -435,11 +427,15 @@ private:
     map<string, AclTable> m_ctrlAclTables;
 
     static mutex m_countersMutex;
-    static condition_variable m_sleepGuard;
-    static bool m_bCollectCounters;
     static DBConnector m_db;
     static Table m_countersTable;
 
+    unique_ptr<AclCounterPoller> m_counterPoller;
+    // Rules changed since the poller tables were last set
+    bool m_counterTablesChanged = true;
+    unique_ptr<RedisPipeline> m_countersPipeline;
+    unique_ptr<Table> m_countersUpdateTable;
+
     string m_mirrorTableId;
     string m_mirrorV6TableId;
 };
@@ -0,0 +1,55 @@
+#include <algorithm>
+
+#include "batchrounds.h"
+
+using namespace std;
+
+BatchRounds::BatchRounds() :
+        m_rounds(1),
+        m_taskTime(0)
+{
+}
+
+bool BatchRounds::canPop(size_t rounds, uint64_t popTime, uint64_t budget) const
+{
+    if (rounds >= m_rounds || rounds == 0)
+    {
+        return false;
+    }
+
+    uint64_t round_time = popTime / rounds + m_taskTime;
+    return (rounds + 1) * round_time <= budget;
+}
+
+void BatchRounds::adapt(size_t rounds, bool backlog, uint64_t popTime, uint64_t taskTime,
+                        uint64_t budget, size_t maxRounds, bool yield)
+{
+    rounds = max<size_t>(rounds, 1);
+    m_taskTime = taskTime / rounds;
+
+    uint64_t elapsed = popTime + taskTime;
+    size_t batch_rounds = m_rounds;
+
+    if (yield)
+    {
+        batch_rounds = 1;
+    }
+    else if (!backlog)
+    {
+        batch_rounds = max<size_t>(batch_rounds / 2, 1);
+    }
+    else if (elapsed > budget)
+    {
+        batch_rounds = max<size_t>((size_t)((uint64_t)rounds * budget / elapsed), 1);
+    }
+    else if (rounds < batch_rounds)
+    {
+        batch_rounds = rounds;
+    }
+    else
+    {
+        batch_rounds *= 2;
+    }
+
+    m_rounds = max<size_t>(min(batch_rounds, maxRounds), 1);
+}
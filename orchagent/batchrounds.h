@@ -0,0 +1,43 @@
+#ifndef SWSS_BATCHROUNDS_H
+#define SWSS_BATCHROUNDS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * BatchRounds: number of pop batches a consumer pops per execution.
+ *
+ * An execution pops batches then runs doTask() on them, its time budget
+ * covers both. The doTask() time per batch is taken from the previous
+ * executions, so that popping stops before the batches popped so far and
+ * their doTask() would overrun the budget.
+ *
+ * The number of batches doubles while they all come full and the execution
+ * fits in the budget. It halves once the backlog is gone, is cut to the
+ * batches that fit when the budget is overrun, and drops to a single batch
+ * when the consumer has to yield to latency sensitive tables.
+ */
+class BatchRounds
+{
+public:
+    BatchRounds();
+
+    size_t get() const { return m_rounds; }
+
+    /* Whether one more batch can be popped, after rounds batches popped in popTime us */
+    bool canPop(size_t rounds, uint64_t popTime, uint64_t budget) const;
+
+    /*
+     * Adapt after an execution which popped rounds batches in popTime us,
+     * the last one full if backlog, then spent taskTime us in doTask().
+     */
+    void adapt(size_t rounds, bool backlog, uint64_t popTime, uint64_t taskTime,
+               uint64_t budget, size_t maxRounds, bool yield);
+
+private:
+    size_t m_rounds;
+    /* us spent in doTask() per batch by the last execution */
+    uint64_t m_taskTime;
+};
+
+#endif /* SWSS_BATCHROUNDS_H */
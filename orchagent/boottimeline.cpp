@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "boottimeline.h"
+
+using namespace std;
+
+namespace
+{
+    string toMsecs(BootTimeline::Clock::duration d)
+    {
+        ostringstream os;
+        os << fixed << setprecision(1)
+           << (double)chrono::duration_cast<chrono::microseconds>(d).count() / 1000 << " ms";
+        return os.str();
+    }
+}
+
+BootTimeline::ScopedPhase::ScopedPhase(BootTimeline &timeline, const string &phase, size_t items) :
+    m_timeline(timeline),
+    m_phase(phase),
+    m_items(items),
+    m_start(Clock::now())
+{
+}
+
+BootTimeline::ScopedPhase::~ScopedPhase()
+{
+    m_timeline.addPhase(m_phase, Clock::now() - m_start, m_items);
+}
+
+BootTimeline::BootTimeline(Clock::time_point start) :
+    m_start(start)
+{
+}
+
+void BootTimeline::mark(const string &milestone, Clock::time_point when)
+{
+    if (hasMark(milestone))
+    {
+        return;
+    }
+
+    m_milestones.push_back({ milestone, when - m_start });
+}
+
+bool BootTimeline::hasMark(const string &milestone) const
+{
+    for (const auto &m : m_milestones)
+    {
+        if (m.name == milestone)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BootTimeline::addPhase(const string &phase, Clock::duration elapsed, size_t items)
+{
+    for (auto &p : m_phases)
+    {
+        if (p.name == phase)
+        {
+            p.elapsed += elapsed;
+            p.items += items;
+            return;
+        }
+    }
+
+    m_phases.push_back({ phase, elapsed, items });
+}
+
+vector<string> BootTimeline::report() const
+{
+    vector<string> lines;
+
+    vector<Milestone> milestones = m_milestones;
+    stable_sort(milestones.begin(), milestones.end(),
+                [](const Milestone &a, const Milestone &b) { return a.offset < b.offset; });
+
+    for (const auto &m : milestones)
+    {
+        lines.push_back(m.name + " at +" + toMsecs(m.offset));
+    }
+
+    for (const auto &p : m_phases)
+    {
+        string line = p.name + ": " + toMsecs(p.elapsed) + " for " + to_string(p.items) + " items";
+        if (p.items > 0)
+        {
+            line += " (" + toMsecs(p.elapsed / p.items) + " each)";
+        }
+        lines.push_back(line);
+    }
+
+    return lines;
+}
@@ -0,0 +1,65 @@
+#ifndef SWSS_BOOTTIMELINE_H
+#define SWSS_BOOTTIMELINE_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ * BootTimeline: where the time went during the port bring-up.
+ *
+ * Milestones are points in time since the timeline start, phases accumulate
+ * the time spent in a step of the bring-up and the number of items (ports)
+ * it handled. report() returns the milestones in time order followed by the
+ * phases in the order they were first added.
+ */
+class BootTimeline
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /* Add the time since its construction to a phase */
+    class ScopedPhase
+    {
+    public:
+        ScopedPhase(BootTimeline &timeline, const std::string &phase, size_t items);
+        ~ScopedPhase();
+
+    private:
+        BootTimeline &m_timeline;
+        std::string m_phase;
+        size_t m_items;
+        Clock::time_point m_start;
+    };
+
+    explicit BootTimeline(Clock::time_point start = Clock::now());
+
+    /* Only the first occurrence of a milestone is kept */
+    void mark(const std::string &milestone, Clock::time_point when = Clock::now());
+    bool hasMark(const std::string &milestone) const;
+
+    void addPhase(const std::string &phase, Clock::duration elapsed, size_t items);
+
+    std::vector<std::string> report() const;
+
+private:
+    struct Milestone
+    {
+        std::string name;
+        Clock::duration offset;
+    };
+
+    struct Phase
+    {
+        std::string name;
+        Clock::duration elapsed;
+        size_t items;
+    };
+
+    Clock::time_point m_start;
+    std::vector<Milestone> m_milestones;
+    std::vector<Phase> m_phases;
+};
+
+#endif /* SWSS_BOOTTIMELINE_H */
@@ -209,6 +209,7 @@ task_process_status BufferOrch::processBufferPool(Consumer &consumer)
             }
             (*(m_buffer_type_maps[map_type_name]))[object_name] = sai_object;
             SWSS_LOG_NOTICE("Created buffer pool %s with type %s", object_name.c_str(), map_type_name.c_str());
+            notifyObjectReady(map_type_name, object_name);
         }
     }
     else if (op == DEL_COMMAND)
@@ -347,6 +348,7 @@ task_process_status BufferOrch::processBufferProfile(Consumer &consumer)
             }
             (*(m_buffer_type_maps[map_type_name]))[object_name] = sai_object;
             SWSS_LOG_NOTICE("Created buffer profile %s with type %s", object_name.c_str(), map_type_name.c_str());
+            notifyObjectReady(map_type_name, object_name);
         }
     }
     else if (op == DEL_COMMAND)
@@ -667,6 +669,44 @@ void BufferOrch::doTask()
     }
 }
 
+/*
+ * Let the task wait for the first buffer pool or profile it references which
+ * does not exist yet. References are "[TABLE|name]", possibly in a list.
+ */
+void BufferOrch::waitForBufferObjects(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &fv : kfvFieldsValues(tuple))
+    {
+        for (const auto &ref : tokenize(fvValue(fv), list_item_delimiter))
+        {
+            if (ref.size() <= 2 || ref.front() != ref_start || ref.back() != ref_end)
+            {
+                continue;
+            }
+
+            string ref_content = ref.substr(1, ref.size() - 2);
+            vector<string> tokens = tokenize(ref_content, config_db_key_delimiter);
+            if (tokens.size() != 2)
+            {
+                tokens = tokenize(ref_content, delimiter);
+                if (tokens.size() != 2)
+                {
+                    continue;
+                }
+            }
+
+            auto type_it = m_buffer_type_maps.find(tokens[0]);
+            if (type_it != m_buffer_type_maps.end() && type_it->second->find(tokens[1]) == type_it->second->end())
+            {
+                consumer.waitFor(kfvKey(tuple), tokens[0], tokens[1]);
+                return;
+            }
+        }
+    }
+}
+
 void BufferOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -704,6 +744,8 @@ void BufferOrch::doTask(Consumer &consumer)
                 return;
             case task_process_status::task_need_retry:
                 SWSS_LOG_INFO("Failed to process buffer task, retry it");
+                /* The handlers process the first task */
+                waitForBufferObjects(consumer, consumer.m_toSync.begin()->second);
                 it++;
                 break;
             default:
@@ -46,6 +46,7 @@ private:
     task_process_status processPriorityGroup(Consumer &consumer);
     task_process_status processIngressBufferProfileList(Consumer &consumer);
     task_process_status processEgressBufferProfileList(Consumer &consumer);
+    void waitForBufferObjects(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple);
 
     buffer_table_handler_map m_bufferHandlerMap;
     std::unordered_map<std::string, bool> m_ready_list;
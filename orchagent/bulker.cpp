@@ -0,0 +1,292 @@
+#include <algorithm>
+#include "bulker.h"
+#include "logger.h"
+
+RouteBulker::RouteBulker(sai_route_api_t *api, size_t max_bulk_size) :
+        m_api(api),
+        m_maxBulkSize(max_bulk_size)
+{
+    SWSS_LOG_ENTER();
+
+    /* Never issue an empty chunk even if bulk mode is disabled */
+    if (m_maxBulkSize == 0)
+    {
+        m_maxBulkSize = 1;
+    }
+}
+
+void RouteBulker::createEntry(sai_status_t *object_status, const sai_route_entry_t &entry,
+                              uint32_t attr_count, const sai_attribute_t *attr_list)
+{
+    *object_status = SAI_STATUS_NOT_EXECUTED;
+    m_creatingEntries.push_back({ entry, vector<sai_attribute_t>(attr_list, attr_list + attr_count), object_status });
+}
+
+void RouteBulker::removeEntry(sai_status_t *object_status, const sai_route_entry_t &entry)
+{
+    *object_status = SAI_STATUS_NOT_EXECUTED;
+    m_removingEntries.push_back({ entry, object_status });
+}
+
+void RouteBulker::setEntryAttribute(sai_status_t *object_status, const sai_route_entry_t &entry,
+                                    const sai_attribute_t &attr)
+{
+    *object_status = SAI_STATUS_NOT_EXECUTED;
+    m_settingEntries.push_back({ entry, attr, object_status });
+}
+
+size_t RouteBulker::size() const
+{
+    return m_creatingEntries.size() + m_removingEntries.size() + m_settingEntries.size();
+}
+
+void RouteBulker::clear()
+{
+    m_creatingEntries.clear();
+    m_removingEntries.clear();
+    m_settingEntries.clear();
+}
+
+void RouteBulker::flush()
+{
+    SWSS_LOG_ENTER();
+
+    flushRemovingEntries();
+    flushCreatingEntries();
+    flushSettingEntries();
+
+    clear();
+}
+
+void RouteBulker::flushRemovingEntries()
+{
+    for (size_t start = 0; start < m_removingEntries.size(); start += m_maxBulkSize)
+    {
+        size_t count = min(m_maxBulkSize, m_removingEntries.size() - start);
+
+        vector<sai_route_entry_t> entries;
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+        for (size_t i = start; i < start + count; i++)
+        {
+            entries.push_back(m_removingEntries[i].entry);
+        }
+
+        if (m_api->remove_route_entries != NULL)
+        {
+            sai_status_t status = m_api->remove_route_entries((uint32_t)count, entries.data(),
+                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            SWSS_LOG_INFO("Bulk removed %zu route entries, rv:%d", count, status);
+        }
+        else
+        {
+            /* Fall back to per entry calls if bulk API is not implemented */
+            for (size_t i = 0; i < count; i++)
+            {
+                statuses[i] = m_api->remove_route_entry(&entries[i]);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            *m_removingEntries[start + i].status = statuses[i];
+        }
+    }
+}
+
+void RouteBulker::flushCreatingEntries()
+{
+    for (size_t start = 0; start < m_creatingEntries.size(); start += m_maxBulkSize)
+    {
+        size_t count = min(m_maxBulkSize, m_creatingEntries.size() - start);
+
+        vector<sai_route_entry_t> entries;
+        vector<uint32_t> attr_counts;
+        vector<const sai_attribute_t *> attr_lists;
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+        for (size_t i = start; i < start + count; i++)
+        {
+            entries.push_back(m_creatingEntries[i].entry);
+            attr_counts.push_back((uint32_t)m_creatingEntries[i].attrs.size());
+            attr_lists.push_back(m_creatingEntries[i].attrs.data());
+        }
+
+        if (m_api->create_route_entries != NULL)
+        {
+            sai_status_t status = m_api->create_route_entries((uint32_t)count, entries.data(),
+                    attr_counts.data(), attr_lists.data(),
+                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            SWSS_LOG_INFO("Bulk created %zu route entries, rv:%d", count, status);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                statuses[i] = m_api->create_route_entry(&entries[i], attr_counts[i], attr_lists[i]);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            *m_creatingEntries[start + i].status = statuses[i];
+        }
+    }
+}
+
+void RouteBulker::flushSettingEntries()
+{
+    for (size_t start = 0; start < m_settingEntries.size(); start += m_maxBulkSize)
+    {
+        size_t count = min(m_maxBulkSize, m_settingEntries.size() - start);
+
+        vector<sai_route_entry_t> entries;
+        vector<sai_attribute_t> attrs;
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+        for (size_t i = start; i < start + count; i++)
+        {
+            entries.push_back(m_settingEntries[i].entry);
+            attrs.push_back(m_settingEntries[i].attr);
+        }
+
+        if (m_api->set_route_entries_attribute != NULL)
+        {
+            sai_status_t status = m_api->set_route_entries_attribute((uint32_t)count, entries.data(),
+                    attrs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            SWSS_LOG_INFO("Bulk set %zu route entries, rv:%d", count, status);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                statuses[i] = m_api->set_route_entry_attribute(&entries[i], &attrs[i]);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            *m_settingEntries[start + i].status = statuses[i];
+        }
+    }
+}
+
+NextHopGroupMemberBulker::NextHopGroupMemberBulker(sai_next_hop_group_api_t *api, sai_object_id_t switch_id,
+                                                   size_t max_bulk_size) :
+        m_api(api),
+        m_switchId(switch_id),
+        m_maxBulkSize(max_bulk_size)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_maxBulkSize == 0)
+    {
+        m_maxBulkSize = 1;
+    }
+}
+
+void NextHopGroupMemberBulker::createEntry(sai_object_id_t *object_id, sai_status_t *object_status,
+                                           uint32_t attr_count, const sai_attribute_t *attr_list)
+{
+    *object_id = SAI_NULL_OBJECT_ID;
+    *object_status = SAI_STATUS_NOT_EXECUTED;
+    m_creatingEntries.push_back({ vector<sai_attribute_t>(attr_list, attr_list + attr_count), object_id, object_status });
+}
+
+void NextHopGroupMemberBulker::removeEntry(sai_status_t *object_status, sai_object_id_t object_id)
+{
+    *object_status = SAI_STATUS_NOT_EXECUTED;
+    m_removingEntries.push_back({ object_id, object_status });
+}
+
+size_t NextHopGroupMemberBulker::size() const
+{
+    return m_creatingEntries.size() + m_removingEntries.size();
+}
+
+void NextHopGroupMemberBulker::clear()
+{
+    m_creatingEntries.clear();
+    m_removingEntries.clear();
+}
+
+void NextHopGroupMemberBulker::flush()
+{
+    SWSS_LOG_ENTER();
+
+    flushRemovingEntries();
+    flushCreatingEntries();
+
+    clear();
+}
+
+void NextHopGroupMemberBulker::flushRemovingEntries()
+{
+    for (size_t start = 0; start < m_removingEntries.size(); start += m_maxBulkSize)
+    {
+        size_t count = min(m_maxBulkSize, m_removingEntries.size() - start);
+
+        vector<sai_object_id_t> object_ids;
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+        for (size_t i = start; i < start + count; i++)
+        {
+            object_ids.push_back(m_removingEntries[i].object_id);
+        }
+
+        if (m_api->remove_next_hop_group_members != NULL)
+        {
+            sai_status_t status = m_api->remove_next_hop_group_members((uint32_t)count, object_ids.data(),
+                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            SWSS_LOG_INFO("Bulk removed %zu next hop group members, rv:%d", count, status);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                statuses[i] = m_api->remove_next_hop_group_member(object_ids[i]);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            *m_removingEntries[start + i].status = statuses[i];
+        }
+    }
+}
+
+void NextHopGroupMemberBulker::flushCreatingEntries()
+{
+    for (size_t start = 0; start < m_creatingEntries.size(); start += m_maxBulkSize)
+    {
+        size_t count = min(m_maxBulkSize, m_creatingEntries.size() - start);
+
+        vector<uint32_t> attr_counts;
+        vector<const sai_attribute_t *> attr_lists;
+        vector<sai_object_id_t> object_ids(count, SAI_NULL_OBJECT_ID);
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+        for (size_t i = start; i < start + count; i++)
+        {
+            attr_counts.push_back((uint32_t)m_creatingEntries[i].attrs.size());
+            attr_lists.push_back(m_creatingEntries[i].attrs.data());
+        }
+
+        if (m_api->create_next_hop_group_members != NULL)
+        {
+            sai_status_t status = m_api->create_next_hop_group_members(m_switchId, (uint32_t)count,
+                    attr_counts.data(), attr_lists.data(),
+                    SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, object_ids.data(), statuses.data());
+            SWSS_LOG_INFO("Bulk created %zu next hop group members, rv:%d", count, status);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                statuses[i] = m_api->create_next_hop_group_member(&object_ids[i], m_switchId,
+                                                                  attr_counts[i], attr_lists[i]);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            *m_creatingEntries[start + i].object_id = object_ids[i];
+            *m_creatingEntries[start + i].status = statuses[i];
+        }
+    }
+}
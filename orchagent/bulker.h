@@ -0,0 +1,119 @@
+#ifndef SWSS_BULKER_H
+#define SWSS_BULKER_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <vector>
+
+using namespace std;
+
+/*
+ * RouteBulker queues route entry create/remove/set operations and commits
+ * them through the SAI bulk route entry API on flush().
+ *
+ * The status of each queued operation is written back through the pointer
+ * given when it was queued, so the caller must keep the status storage valid
+ * until flush() returns. Operations are committed in the order removes,
+ * creates, sets, and each group is split in chunks of at most max_bulk_size.
+ */
+class RouteBulker
+{
+public:
+    RouteBulker(sai_route_api_t *api, size_t max_bulk_size);
+
+    void createEntry(sai_status_t *object_status, const sai_route_entry_t &entry,
+                     uint32_t attr_count, const sai_attribute_t *attr_list);
+    void removeEntry(sai_status_t *object_status, const sai_route_entry_t &entry);
+    void setEntryAttribute(sai_status_t *object_status, const sai_route_entry_t &entry,
+                           const sai_attribute_t &attr);
+
+    void flush();
+    void clear();
+
+    size_t size() const;
+    size_t getMaxBulkSize() const { return m_maxBulkSize; }
+
+private:
+    struct CreatingEntry
+    {
+        sai_route_entry_t           entry;
+        vector<sai_attribute_t>     attrs;
+        sai_status_t               *status;
+    };
+
+    struct RemovingEntry
+    {
+        sai_route_entry_t           entry;
+        sai_status_t               *status;
+    };
+
+    struct SettingEntry
+    {
+        sai_route_entry_t           entry;
+        sai_attribute_t             attr;
+        sai_status_t               *status;
+    };
+
+    sai_route_api_t *m_api;
+    size_t m_maxBulkSize;
+
+    vector<CreatingEntry> m_creatingEntries;
+    vector<RemovingEntry> m_removingEntries;
+    vector<SettingEntry> m_settingEntries;
+
+    void flushRemovingEntries();
+    void flushCreatingEntries();
+    void flushSettingEntries();
+};
+
+/*
+ * NextHopGroupMemberBulker queues next hop group member create/remove
+ * operations and commits them through the SAI bulk object API on flush().
+ *
+ * As for RouteBulker, the status and the object id of each queued operation
+ * are written back through the pointers given when it was queued. Removes
+ * are committed before creates, each in chunks of at most max_bulk_size.
+ */
+class NextHopGroupMemberBulker
+{
+public:
+    NextHopGroupMemberBulker(sai_next_hop_group_api_t *api, sai_object_id_t switch_id, size_t max_bulk_size);
+
+    void createEntry(sai_object_id_t *object_id, sai_status_t *object_status,
+                     uint32_t attr_count, const sai_attribute_t *attr_list);
+    void removeEntry(sai_status_t *object_status, sai_object_id_t object_id);
+
+    void flush();
+    void clear();
+
+    size_t size() const;
+    size_t getMaxBulkSize() const { return m_maxBulkSize; }
+
+private:
+    struct CreatingEntry
+    {
+        vector<sai_attribute_t>     attrs;
+        sai_object_id_t            *object_id;
+        sai_status_t               *status;
+    };
+
+    struct RemovingEntry
+    {
+        sai_object_id_t             object_id;
+        sai_status_t               *status;
+    };
+
+    sai_next_hop_group_api_t *m_api;
+    sai_object_id_t m_switchId;
+    size_t m_maxBulkSize;
+
+    vector<CreatingEntry> m_creatingEntries;
+    vector<RemovingEntry> m_removingEntries;
+
+    void flushRemovingEntries();
+    void flushCreatingEntries();
+};
+
+#endif /* SWSS_BULKER_H */
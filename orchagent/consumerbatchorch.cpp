@@ -0,0 +1,78 @@
+#include "consumerbatchorch.h"
+#include "logger.h"
+
+ConsumerBatchOrch::ConsumerBatchOrch(DBConnector *db, const string &tableName) :
+        Orch(db, tableName)
+{
+    SWSS_LOG_ENTER();
+}
+
+void ConsumerBatchOrch::doTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        KeyOpFieldsValuesTuple t = it->second;
+
+        string table_name = kfvKey(t);
+        string op = kfvOp(t);
+
+        if (op == SET_COMMAND)
+        {
+            ConsumerBatchConfig config = Consumer::getDefaultBatchConfig(table_name);
+            bool valid = true;
+
+            for (const auto &fv : kfvFieldsValues(t))
+            {
+                const auto &field = fvField(fv);
+                const auto &value = fvValue(fv);
+
+                try
+                {
+                    if (field == "max_batch_size")
+                    {
+                        config.maxBatchSize = stoul(value);
+                    }
+                    else if (field == "budget_us")
+                    {
+                        config.budget = stoull(value);
+                    }
+                    else if (field == "latency_sensitive")
+                    {
+                        config.latencySensitive = value == "true";
+                    }
+                    else
+                    {
+                        SWSS_LOG_WARN("Unsupported field %s of %s", field.c_str(), table_name.c_str());
+                    }
+                }
+                catch (const exception &)
+                {
+                    SWSS_LOG_ERROR("Invalid value %s of %s for %s", value.c_str(), field.c_str(), table_name.c_str());
+                    valid = false;
+                }
+            }
+
+            if (valid)
+            {
+                Consumer::setBatchConfig(table_name, config);
+                SWSS_LOG_NOTICE("Consumers of %s pop %zu entries and %lu us at most%s", table_name.c_str(),
+                                config.maxBatchSize, config.budget,
+                                config.latencySensitive ? ", latency sensitive" : "");
+            }
+        }
+        else if (op == DEL_COMMAND)
+        {
+            Consumer::resetBatchConfig(table_name);
+            SWSS_LOG_NOTICE("Consumers of %s pop a single batch", table_name.c_str());
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+        }
+
+        it = consumer.m_toSync.erase(it);
+    }
+}
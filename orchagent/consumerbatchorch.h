@@ -0,0 +1,27 @@
+#ifndef SWSS_CONSUMERBATCHORCH_H
+#define SWSS_CONSUMERBATCHORCH_H
+
+#include "orch.h"
+
+#define CFG_CONSUMER_BATCH_TABLE_NAME   "CONSUMER_BATCH"
+
+/*
+ * Live tuning of the pop batching of the consumers. Keys are table names,
+ * fields are:
+ *   max_batch_size     entries popped per execution at most
+ *   budget_us          time spent popping and in doTask() per execution at most
+ *   latency_sensitive  "true" to make the other tables yield to this one
+ *
+ * Only the configured tables adapt their batching, the others pop a single
+ * batch of the -b size per execution.
+ */
+class ConsumerBatchOrch : public Orch
+{
+public:
+    ConsumerBatchOrch(DBConnector *db, const string &tableName);
+
+private:
+    void doTask(Consumer &consumer);
+};
+
+#endif /* SWSS_CONSUMERBATCHORCH_H */
@@ -58,12 +58,13 @@ void CounterCheckOrch::mcCounterCheck()
         auto mcCounters = i.second;
         uint8_t pfcMask = 0;
 
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
+        const Port *found = gPortsOrch->findPort(oid);
+        if (found == nullptr)
         {
             SWSS_LOG_ERROR("Invalid port oid 0x%lx", oid);
             continue;
         }
+        const Port &port = *found;
 
         auto newMcCounters = getQueueMcCounters(port);
 
@@ -106,12 +107,13 @@ void CounterCheckOrch::pfcFrameCounterCheck()
         auto newCounters = getPfcFrameCounters(oid);
         uint8_t pfcMask = 0;
 
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
+        const Port *found = gPortsOrch->findPort(oid);
+        if (found == nullptr)
         {
             SWSS_LOG_ERROR("Invalid port oid 0x%lx", oid);
             continue;
         }
+        const Port &port = *found;
 
         if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
         {
@@ -0,0 +1,79 @@
+#include "crmcounter.h"
+
+using namespace std;
+
+CrmUsedCounter::CrmUsedCounter() :
+    m_used(0),
+    m_high(0),
+    m_low(0),
+    m_free(false),
+    m_enabled(false)
+{
+}
+
+bool CrmUsedCounter::inc()
+{
+    uint32_t prev = m_used.fetch_add(1, memory_order_relaxed);
+    return crossed(prev, prev + 1);
+}
+
+bool CrmUsedCounter::dec()
+{
+    uint32_t prev = m_used.fetch_sub(1, memory_order_relaxed);
+    return crossed(prev, prev - 1);
+}
+
+uint32_t CrmUsedCounter::get() const
+{
+    return m_used.load(memory_order_relaxed);
+}
+
+void CrmUsedCounter::setThresholds(CrmThresholdType type, uint32_t low, uint32_t high, uint64_t total)
+{
+    int64_t t = (int64_t)total;
+
+    switch (type)
+    {
+        case CrmThresholdType::CRM_PERCENTAGE:
+            /* Smallest count with used * 100 / total >= high, largest with <= low */
+            m_high.store((high * t + 99) / 100, memory_order_relaxed);
+            m_low.store(((low + 1) * t + 99) / 100 - 1, memory_order_relaxed);
+            m_free.store(false, memory_order_relaxed);
+            m_enabled.store(total != 0, memory_order_relaxed);
+            break;
+        case CrmThresholdType::CRM_USED:
+            m_high.store(high, memory_order_relaxed);
+            m_low.store(low, memory_order_relaxed);
+            m_free.store(false, memory_order_relaxed);
+            m_enabled.store(true, memory_order_relaxed);
+            break;
+        case CrmThresholdType::CRM_FREE:
+            /* The free count exceeds high at low used counts */
+            m_high.store(t - high, memory_order_relaxed);
+            m_low.store(t - low, memory_order_relaxed);
+            m_free.store(true, memory_order_relaxed);
+            m_enabled.store(total != 0, memory_order_relaxed);
+            break;
+        default:
+            m_enabled.store(false, memory_order_relaxed);
+            break;
+    }
+}
+
+bool CrmUsedCounter::crossed(uint32_t prev, uint32_t next) const
+{
+    if (!m_enabled.load(memory_order_relaxed))
+    {
+        return false;
+    }
+
+    int64_t high = m_high.load(memory_order_relaxed);
+    int64_t low = m_low.load(memory_order_relaxed);
+
+    if (m_free.load(memory_order_relaxed))
+    {
+        return ((prev <= high) != (next <= high)) || ((prev >= low) != (next >= low));
+    }
+
+    return ((prev >= high) != (next >= high)) || ((prev <= low) != (next <= low));
+}
@@ -0,0 +1,53 @@
+#ifndef SWSS_CRMCOUNTER_H
+#define SWSS_CRMCOUNTER_H
+
+#include <atomic>
+#include <cstdint>
+
+enum class CrmThresholdType
+{
+    CRM_PERCENTAGE,
+    CRM_USED,
+    CRM_FREE,
+};
+
+/*
+ * CrmUsedCounter: "used" counter of a CRM resource, updated without lock by
+ * the orchs of every execution domain.
+ *
+ * The thresholds are converted to used counts from the used and available
+ * counters of the last poll, so that inc() and dec() tell when the count
+ * crosses one of them without taking the CRM lock. The thresholds are not
+ * updated atomically with the count, a crossing missed while they change is
+ * found by the next poll.
+ */
+class CrmUsedCounter
+{
+public:
+    CrmUsedCounter();
+
+    CrmUsedCounter(const CrmUsedCounter&) = delete;
+    CrmUsedCounter& operator=(const CrmUsedCounter&) = delete;
+
+    /* Return true if the new count crossed a threshold */
+    bool inc();
+    bool dec();
+
+    uint32_t get() const;
+
+    /* total is the used count plus the available count, 0 if not known yet */
+    void setThresholds(CrmThresholdType type, uint32_t low, uint32_t high, uint64_t total);
+
+private:
+    std::atomic<uint32_t> m_used;
+
+    /* Used counts of the thresholds, reversed for the free threshold type */
+    std::atomic<int64_t> m_high;
+    std::atomic<int64_t> m_low;
+    std::atomic<bool> m_free;
+    std::atomic<bool> m_enabled;
+
+    bool crossed(uint32_t prev, uint32_t next) const;
+};
+
+#endif /* SWSS_CRMCOUNTER_H */
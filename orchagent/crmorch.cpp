@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <set>
 #include <sstream>
 
 #include "crmorch.h"
@@ -161,6 +163,7 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
     {
         m_resourcesMap.emplace(res.first, CrmResourceEntry(res.second, CRM_THRESHOLD_TYPE_DEFAULT, CRM_THRESHOLD_LOW_DEFAULT, CRM_THRESHOLD_HIGH_DEFAULT));
     }
+    m_usedCounters.reset(new CrmUsedCounter[crmResTypeNameMap.size()]);
 
     // The CRM stats needs to be populated again
     m_countersCrmTable->del(CRM_COUNTERS_TABLE_KEY);
@@ -229,6 +232,8 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_resourcesMutex);
+
     for (auto i : data)
     {
         const auto &field = fvField(i);
@@ -249,6 +254,7 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 auto thresholdType = crmThreshTypeMap.at(value);
 
                 m_resourcesMap.at(resourceType).thresholdType = thresholdType;
+                setUsedThresholds(resourceType);
             }
             else if (crmThreshLowResMap.find(field) != crmThreshLowResMap.end())
             {
@@ -256,6 +262,7 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 auto thresholdValue = to_uint<uint32_t>(value);
 
                 m_resourcesMap.at(resourceType).lowThreshold = thresholdValue;
+                setUsedThresholds(resourceType);
             }
             else if (crmThreshHighResMap.find(field) != crmThreshHighResMap.end())
             {
@@ -263,6 +270,7 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 auto thresholdValue = to_uint<uint32_t>(value);
 
                 m_resourcesMap.at(resourceType).highThreshold = thresholdValue;
+                setUsedThresholds(resourceType);
             }
             else
             {
@@ -283,18 +291,18 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
     }
 }
 
+CrmUsedCounter &CrmOrch::getUsedCounter(CrmResourceType resource)
+{
+    return m_usedCounters[static_cast<size_t>(resource)];
+}
+
 void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
-    try
-    {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
-    }
-    catch (...)
+    if (getUsedCounter(resource).inc())
     {
-        SWSS_LOG_ERROR("Failed to increment \"used\" counter for the %s CRM resource.", crmResTypeNameMap.at(resource).c_str());
-        return;
+        checkCrmResThresholds(resource);
     }
 }
 
@@ -302,14 +310,9 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
-    try
+    if (getUsedCounter(resource).dec())
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
-    }
-    catch (...)
-    {
-        SWSS_LOG_ERROR("Failed to decrement \"used\" counter for the %s CRM resource.", crmResTypeNameMap.at(resource).c_str());
-        return;
+        checkCrmResThresholds(resource);
     }
 }
 
@@ -317,6 +320,8 @@ void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_resourcesMutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter++;
@@ -332,6 +337,8 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_resourcesMutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter--;
@@ -364,6 +371,8 @@ void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_resourcesMutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter++;
@@ -380,6 +389,8 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_resourcesMutex);
+
     try
     {
         m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter--;
@@ -395,7 +406,10 @@ void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_resourcesMutex);
+
     getResAvailableCounters();
+    syncUsedCounters();
     updateCrmCountersTable();
     checkCrmThresholds();
 
@@ -408,6 +422,11 @@ void CrmOrch::getResAvailableCounters()
 {
     SWSS_LOG_ENTER();
 
+    if (m_bulkAvailable)
+    {
+        m_bulkAvailable = getSwitchAvailableCounters();
+    }
+
     for (auto &res : m_resourcesMap)
     {
         sai_attribute_t attr;
@@ -425,6 +444,11 @@ void CrmOrch::getResAvailableCounters()
             case SAI_SWITCH_ATTR_AVAILABLE_NEXT_HOP_GROUP_ENTRY:
             case SAI_SWITCH_ATTR_AVAILABLE_FDB_ENTRY:
             {
+                if (m_bulkAvailable)
+                {
+                    break;
+                }
+
                 sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
                 if (status != SAI_STATUS_SUCCESS)
                 {
@@ -440,6 +464,11 @@ void CrmOrch::getResAvailableCounters()
             case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE:
             case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE_GROUP:
             {
+                if (m_bulkAvailable)
+                {
+                    break;
+                }
+
                 vector<sai_acl_resource_t> resources(CRM_ACL_RESOURCE_COUNT);
 
                 attr.value.aclresource.count = CRM_ACL_RESOURCE_COUNT;
@@ -469,54 +498,231 @@ void CrmOrch::getResAvailableCounters()
 
             case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY:
             case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER:
-            {
-                for (auto &cnt : res.second.countersMap)
-                {
-                    sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
-                    if (status != SAI_STATUS_SUCCESS)
-                    {
-                        SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
-                        break;
-                    }
-
-                    cnt.second.availableCounter = attr.value.u32;
-                }
-
+                // Got per ACL table below
                 break;
-            }
 
             default:
                 SWSS_LOG_ERROR("Failed to get CRM attribute %u. Unknown attribute.\n", attr.id);
                 return;
         }
     }
+
+    getAclTableAvailableCounters();
+}
+
+bool CrmOrch::getSwitchAvailableCounters()
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_attribute_t> attrs;
+    vector<CrmResourceType> resources;
+    // ACL resource lists by attribute index
+    map<size_t, vector<sai_acl_resource_t>> aclResources;
+
+    for (const auto &res : m_resourcesMap)
+    {
+        sai_attribute_t attr;
+        attr.id = crmResSaiAvailAttrMap.at(res.first);
+
+        if (attr.id == SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY || attr.id == SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER)
+        {
+            continue;
+        }
+
+        if (attr.id == SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE || attr.id == SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE_GROUP)
+        {
+            aclResources[attrs.size()].resize(CRM_ACL_RESOURCE_COUNT);
+        }
+
+        attrs.push_back(attr);
+        resources.push_back(res.first);
+    }
+
+    for (auto &list : aclResources)
+    {
+        attrs[list.first].value.aclresource.count = (uint32_t)list.second.size();
+        attrs[list.first].value.aclresource.list = list.second.data();
+    }
+
+    sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    if (status == SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        for (auto &list : aclResources)
+        {
+            list.second.resize(max((size_t)attrs[list.first].value.aclresource.count, list.second.size()));
+            attrs[list.first].value.aclresource.count = (uint32_t)list.second.size();
+            attrs[list.first].value.aclresource.list = list.second.data();
+        }
+        status = sai_switch_api->get_switch_attribute(gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    }
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_NOTICE("Failed to get the CRM available counters at once, rv:%d, getting them one by one", status);
+        return false;
+    }
+
+    for (size_t i = 0; i < attrs.size(); i++)
+    {
+        auto &res = m_resourcesMap.at(resources[i]);
+
+        if (aclResources.find(i) == aclResources.end())
+        {
+            res.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = attrs[i].value.u32;
+            continue;
+        }
+
+        for (uint32_t j = 0; j < attrs[i].value.aclresource.count; j++)
+        {
+            const auto &aclResource = attrs[i].value.aclresource.list[j];
+            res.countersMap[getCrmAclKey(aclResource.stage, aclResource.bind_point)].availableCounter = aclResource.avail_num;
+        }
+    }
+
+    return true;
+}
+
+void CrmOrch::getAclTableAvailableCounters()
+{
+    SWSS_LOG_ENTER();
+
+    auto &entries = m_resourcesMap.at(CrmResourceType::CRM_ACL_ENTRY).countersMap;
+    auto &counters = m_resourcesMap.at(CrmResourceType::CRM_ACL_COUNTER).countersMap;
+
+    // Both are kept per ACL table, get them with one call for each table
+    set<string> keys;
+    for (const auto &cnt : entries)
+    {
+        keys.insert(cnt.first);
+    }
+    for (const auto &cnt : counters)
+    {
+        keys.insert(cnt.first);
+    }
+
+    for (const auto &key : keys)
+    {
+        auto entry = entries.find(key);
+        auto counter = counters.find(key);
+
+        sai_object_id_t tableId = SAI_NULL_OBJECT_ID;
+        if (entry != entries.end())
+        {
+            tableId = entry->second.id;
+        }
+        if (tableId == SAI_NULL_OBJECT_ID && counter != counters.end())
+        {
+            tableId = counter->second.id;
+        }
+        if (tableId == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        sai_attribute_t attrs[2];
+        attrs[0].id = SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY;
+        attrs[1].id = SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER;
+
+        sai_status_t status = sai_acl_api->get_acl_table_attribute(tableId, 2, attrs);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get ACL table 0x%lx available counters, rv:%d", tableId, status);
+            continue;
+        }
+
+        if (entry != entries.end())
+        {
+            entry->second.availableCounter = attrs[0].value.u32;
+        }
+        if (counter != counters.end())
+        {
+            counter->second.availableCounter = attrs[1].value.u32;
+        }
+    }
+}
+
+void CrmOrch::syncUsedCounters()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &res : m_resourcesMap)
+    {
+        uint32_t used = getUsedCounter(res.first).get();
+
+        auto it = res.second.countersMap.find(CRM_COUNTERS_TABLE_KEY);
+        if (it == res.second.countersMap.end())
+        {
+            if (used == 0)
+            {
+                continue;
+            }
+            it = res.second.countersMap.emplace(CRM_COUNTERS_TABLE_KEY, CrmResourceCounter()).first;
+        }
+
+        it->second.usedCounter = used;
+        setUsedThresholds(res.first);
+    }
+}
+
+void CrmOrch::setUsedThresholds(CrmResourceType resource)
+{
+    SWSS_LOG_ENTER();
+
+    const auto &res = m_resourcesMap.at(resource);
+
+    uint64_t total = 0;
+    auto it = res.countersMap.find(CRM_COUNTERS_TABLE_KEY);
+    if (it != res.countersMap.end())
+    {
+        total = (uint64_t)it->second.usedCounter + it->second.availableCounter;
+    }
+
+    getUsedCounter(resource).setThresholds(res.thresholdType, res.lowThreshold, res.highThreshold, total);
 }
 
 void CrmOrch::updateCrmCountersTable()
 {
     SWSS_LOG_ENTER();
 
+    // Only the counters which changed are written, with one write per key
+    map<string, vector<FieldValueTuple>> changes;
+
     // Update CRM used counters in COUNTERS_DB
     for (const auto &i : crmUsedCntsTableMap)
     {
-        for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
+        for (auto &cnt : m_resourcesMap.at(i.second).countersMap)
         {
-            FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
-            vector<FieldValueTuple> attrs = { attr };
-            m_countersCrmTable->set(cnt.first, attrs);
+            if (cnt.second.usedPublished && cnt.second.publishedUsed == cnt.second.usedCounter)
+            {
+                continue;
+            }
+
+            changes[cnt.first].emplace_back(i.first, to_string(cnt.second.usedCounter));
+            cnt.second.usedPublished = true;
+            cnt.second.publishedUsed = cnt.second.usedCounter;
         }
     }
 
     // Update CRM available counters in COUNTERS_DB
     for (const auto &i : crmAvailCntsTableMap)
     {
-        for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
+        for (auto &cnt : m_resourcesMap.at(i.second).countersMap)
         {
-            FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
-            vector<FieldValueTuple> attrs = { attr };
-            m_countersCrmTable->set(cnt.first, attrs);
+            if (cnt.second.availablePublished && cnt.second.publishedAvailable == cnt.second.availableCounter)
+            {
+                continue;
+            }
+
+            changes[cnt.first].emplace_back(i.first, to_string(cnt.second.availableCounter));
+            cnt.second.availablePublished = true;
+            cnt.second.publishedAvailable = cnt.second.availableCounter;
         }
     }
+
+    for (const auto &change : changes)
+    {
+        m_countersCrmTable->set(change.first, change.second);
+    }
 }
 
 void CrmOrch::checkCrmThresholds()
@@ -525,54 +731,79 @@ void CrmOrch::checkCrmThresholds()
 
     for (auto &i : m_resourcesMap)
     {
-        auto &res = i.second;
-
         for (const auto &j : i.second.countersMap)
         {
-            auto &cnt = j.second;
-            uint64_t utilization = 0;
-            uint32_t percentageUtil = 0;
-            string threshType = "";
+            checkCrmThreshold(i.second, j.second.usedCounter, j.second.availableCounter);
+        }
+    }
+}
 
-            if (cnt.usedCounter != 0)
-            {
-                percentageUtil = (cnt.usedCounter * 100) / (cnt.usedCounter + cnt.availableCounter);
-            }
+void CrmOrch::checkCrmResThresholds(CrmResourceType resource)
+{
+    SWSS_LOG_ENTER();
 
-            switch (res.thresholdType)
-            {
-                case CrmThresholdType::CRM_PERCENTAGE:
-                    utilization = percentageUtil;
-                    threshType = "TH_PERCENTAGE";
-                    break;
-                case CrmThresholdType::CRM_USED:
-                    utilization = cnt.usedCounter;
-                    threshType = "TH_USED";
-                    break;
-                case CrmThresholdType::CRM_FREE:
-                    utilization = cnt.availableCounter;
-                    threshType = "TH_FREE";
-                    break;
-                default:
-                    throw runtime_error("Unknown threshold type for CRM resource");
-            }
+    lock_guard<mutex> lock(m_resourcesMutex);
 
-            if ((utilization >= res.highThreshold) && (res.exceededLogCounter < CRM_EXCEEDED_MSG_MAX))
-            {
-                SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    auto &res = m_resourcesMap.at(resource);
+    auto it = res.countersMap.find(CRM_COUNTERS_TABLE_KEY);
+    if (it == res.countersMap.end())
+    {
+        return;
+    }
 
-                res.exceededLogCounter++;
-            }
-            else if ((utilization <= res.lowThreshold) && (res.exceededLogCounter > 0))
-            {
-                SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    // The available counter is estimated from the total of the last poll
+    uint32_t used = getUsedCounter(resource).get();
+    uint64_t total = (uint64_t)it->second.usedCounter + it->second.availableCounter;
+    uint32_t available = total > used ? (uint32_t)(total - used) : 0;
 
-                res.exceededLogCounter = 0;
-            }
-        } // end of counters loop
-    } // end of resources loop
+    checkCrmThreshold(res, used, available);
+}
+
+void CrmOrch::checkCrmThreshold(CrmResourceEntry &res, uint32_t used, uint32_t available)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t utilization = 0;
+    uint32_t percentageUtil = 0;
+    string threshType = "";
+
+    if (used != 0)
+    {
+        percentageUtil = (used * 100) / (used + available);
+    }
+
+    switch (res.thresholdType)
+    {
+        case CrmThresholdType::CRM_PERCENTAGE:
+            utilization = percentageUtil;
+            threshType = "TH_PERCENTAGE";
+            break;
+        case CrmThresholdType::CRM_USED:
+            utilization = used;
+            threshType = "TH_USED";
+            break;
+        case CrmThresholdType::CRM_FREE:
+            utilization = available;
+            threshType = "TH_FREE";
+            break;
+        default:
+            throw runtime_error("Unknown threshold type for CRM resource");
+    }
+
+    if ((utilization >= res.highThreshold) && (res.exceededLogCounter < CRM_EXCEEDED_MSG_MAX))
+    {
+        SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, used, available);
+
+        res.exceededLogCounter++;
+    }
+    else if ((utilization <= res.lowThreshold) && (res.exceededLogCounter > 0))
+    {
+        SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, used, available);
+
+        res.exceededLogCounter = 0;
+    }
 }
 
 
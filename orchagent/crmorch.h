@@ -3,8 +3,11 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <memory>
+#include <mutex>
 #include "orch.h"
 #include "port.h"
+#include "crmcounter.h"
 
 extern "C" {
 #include "sai.h"
@@ -27,13 +30,6 @@ enum class CrmResourceType
     CRM_FDB_ENTRY,
 };
 
-enum class CrmThresholdType
-{
-    CRM_PERCENTAGE,
-    CRM_USED,
-    CRM_FREE,
-};
-
 class CrmOrch : public Orch
 {
 public:
@@ -59,6 +55,12 @@ private:
         sai_object_id_t id = 0;
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
+
+        // Values last written to COUNTERS_DB
+        bool usedPublished = false;
+        bool availablePublished = false;
+        uint32_t publishedUsed = 0;
+        uint32_t publishedAvailable = 0;
     };
 
     struct CrmResourceEntry
@@ -79,13 +81,26 @@ private:
     chrono::seconds m_pollingInterval;
 
     map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
+    /* Counters are updated by the orchs of every execution domain */
+    mutex m_resourcesMutex;
+    /* "used" counters of the STATS key, by resource type, updated without m_resourcesMutex */
+    unique_ptr<CrmUsedCounter[]> m_usedCounters;
+    /* Get all the switch available counters at once until the SAI fails to */
+    bool m_bulkAvailable = true;
 
     void doTask(Consumer &consumer);
     void handleSetCommand(const string& key, const vector<FieldValueTuple>& data);
     void doTask(SelectableTimer &timer);
+    CrmUsedCounter &getUsedCounter(CrmResourceType resource);
     void getResAvailableCounters();
+    bool getSwitchAvailableCounters();
+    void getAclTableAvailableCounters();
+    void syncUsedCounters();
     void updateCrmCountersTable();
     void checkCrmThresholds();
+    void checkCrmThreshold(CrmResourceEntry &res, uint32_t used, uint32_t available);
+    void checkCrmResThresholds(CrmResourceType resource);
+    void setUsedThresholds(CrmResourceType resource);
     string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
     string getCrmAclTableKey(sai_object_id_t id);
 };
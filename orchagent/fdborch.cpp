@@ -1,4 +1,7 @@
 #include <assert.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <unordered_map>
@@ -19,11 +22,18 @@ extern CrmOrch *        gCrmOrch;
 
 const int fdborch_pri = 20;
 
+/* Maximum number of switch FDB events coalesced in a batch */
+#define FDB_EVENT_BATCH_SIZE 8192
+/* Interval between two reports of the FDB event counters */
+#define FDB_EVENT_STATS_INTERVAL_SEC 10
+
 FdbOrch::FdbOrch(TableConnector applDbConnector, TableConnector stateDbConnector, PortsOrch *port) :
     Orch(applDbConnector.first, applDbConnector.second, fdborch_pri),
     m_portsOrch(port),
     m_table(applDbConnector.first, applDbConnector.second),
-    m_fdbStateTable(stateDbConnector.first, stateDbConnector.second)
+    m_stateDbPipeline(new RedisPipeline(stateDbConnector.first)),
+    m_fdbStateTable(m_stateDbPipeline.get(), stateDbConnector.second, true),
+    m_lastFdbStats(chrono::steady_clock::now())
 {
     m_portsOrch->attach(this);
     m_flushNotificationsConsumer = new NotificationConsumer(applDbConnector.first, "FLUSHFDBREQUEST");
@@ -53,60 +63,51 @@ bool FdbOrch::bake()
     return true;
 }
 
-bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
+FdbOrch::FdbEventState &FdbOrch::getFdbEventState(const FdbEntry& entry)
 {
-    const FdbEntry& entry = update.entry;
-    const Port& port = update.port;
-    const MacAddress& mac = entry.mac;
-    string portName = port.m_alias;
-    Port vlan;
-
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    auto inserted = m_fdbEventIndex.emplace(entry, m_fdbEvents.size());
+    if (inserted.second)
     {
-        SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port from bv_id 0x%lx", entry.bv_id);
-        return false;
+        bool stored = m_entries.contains(entry);
+        m_fdbEvents.push_back({entry, stored, false, false, false, nullptr});
     }
 
-    // ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + mac.to_string();
+    return m_fdbEvents[inserted.first->second];
+}
 
-    if (update.add)
-    {
-        auto inserted = m_entries.insert(entry);
+/*
+ * Update m_entries right away, the STATE_DB table, the CRM counter and the
+ * observers are only updated by flushFdbEvents() with the resulting state.
+ */
+void FdbOrch::queueFdbEntryState(const FdbEntry& entry, const Port *port, bool add)
+{
+    FdbEventState &state = getFdbEventState(entry);
+
+    state.notify = true;
+    state.add = add;
+    state.port = port;
 
-        SWSS_LOG_DEBUG("FdbOrch notification: mac %s was inserted into bv_id 0x%lx",
-                        entry.mac.to_string().c_str(), entry.bv_id);
+    if (m_portsOrch->findPort(entry.bv_id) == nullptr)
+    {
+        SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port from bv_id 0x%lx", entry.bv_id);
+        return;
+    }
 
-        if (!inserted.second)
+    if (add)
+    {
+        if (m_entries.insert(entry, { port->m_bridge_port_id, "dynamic" }))
         {
-            SWSS_LOG_INFO("FdbOrch notification: mac %s is duplicate", entry.mac.to_string().c_str());
-            return false;
+            SWSS_LOG_DEBUG("FdbOrch notification: mac %s was inserted into bv_id 0x%lx",
+                            entry.mac.to_string().c_str(), entry.bv_id);
+            state.changed = true;
+            m_fdbCrmDelta++;
         }
-
-        // Write to StateDb
-        std::vector<FieldValueTuple> fvs;
-        fvs.push_back(FieldValueTuple("port", portName));
-        fvs.push_back(FieldValueTuple("type", "dynamic"));
-        m_fdbStateTable.set(key, fvs);
-
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
-        return true;
     }
-    else
+    else if (m_entries.erase(entry))
     {
-        size_t erased = m_entries.erase(entry);
         SWSS_LOG_DEBUG("FdbOrch notification: mac %s was removed from bv_id 0x%lx", entry.mac.to_string().c_str(), entry.bv_id);
-
-        if (erased == 0)
-        {
-            return false;
-        }
-
-        // Remove in StateDb
-        m_fdbStateTable.del(key);
-
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
-        return true;
+        state.changed = true;
+        m_fdbCrmDelta--;
     }
 }
 
@@ -114,93 +115,178 @@ void FdbOrch::update(sai_fdb_event_t type, const sai_fdb_entry_t* entry, sai_obj
 {
     SWSS_LOG_ENTER();
 
-    FdbUpdate update;
-    update.entry.mac = entry->mac_address;
-    update.entry.bv_id = entry->bv_id;
+    queueFdbEvent(type, entry, bridge_port_id);
+    flushFdbEvents();
+}
+
+void FdbOrch::queueFdbEvent(sai_fdb_event_t type, const sai_fdb_entry_t* entry, sai_object_id_t bridge_port_id)
+{
+    SWSS_LOG_ENTER();
+
+    FdbEntry fdbEntry;
+    fdbEntry.mac = entry->mac_address;
+    fdbEntry.bv_id = entry->bv_id;
+
+    m_fdbEventCount++;
 
     switch (type)
     {
     case SAI_FDB_EVENT_LEARNED:
-        if (!m_portsOrch->getPortByBridgePortId(bridge_port_id, update.port))
+    {
+        const Port *port = m_portsOrch->findPortByBridgePortId(bridge_port_id);
+        if (port == nullptr)
         {
             SWSS_LOG_ERROR("Failed to get port by bridge port ID 0x%lx", bridge_port_id);
             return;
         }
 
         // we already have such entries
-        if (m_entries.find(update.entry) != m_entries.end())
+        if (m_entries.contains(fdbEntry))
         {
              SWSS_LOG_INFO("FdbOrch notification: mac %s is already in bv_id 0x%lx",
-                    update.entry.mac.to_string().c_str(), entry->bv_id);
+                    fdbEntry.mac.to_string().c_str(), entry->bv_id);
              break;
         }
 
-        update.add = true;
-        storeFdbEntryState(update);
-
-        for (auto observer: m_observers)
-        {
-            observer->update(SUBJECT_TYPE_FDB_CHANGE, &update);
-        }
-
+        queueFdbEntryState(fdbEntry, port, true);
         break;
+    }
 
     case SAI_FDB_EVENT_AGED:
     case SAI_FDB_EVENT_MOVE:
-        update.add = false;
-        storeFdbEntryState(update);
-
-        for (auto observer: m_observers)
-        {
-            observer->update(SUBJECT_TYPE_FDB_CHANGE, &update);
-        }
-
+        queueFdbEntryState(fdbEntry, nullptr, false);
         break;
 
     case SAI_FDB_EVENT_FLUSHED:
-        if (bridge_port_id == SAI_NULL_OBJECT_ID && entry->bv_id == SAI_NULL_OBJECT_ID)
+        /* Flush of all the entries, of a bridge port, of a VLAN or of both */
+        queueFlushedFdbEntries(bridge_port_id, entry->bv_id);
+        break;
+    }
+
+    return;
+}
+
+/* Remove the dynamic entries flushed from the switch */
+void FdbOrch::queueFlushedFdbEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &flushed : m_entries.getEntries(bridge_port_id, bv_id, true))
+    {
+        queueFdbEntryState(flushed, nullptr, false);
+
+        SWSS_LOG_DEBUG("FdbOrch notification: mac %s was removed", flushed.mac.to_string().c_str());
+    }
+}
+
+/*
+ * Write the resulting state of the queued entries to STATE_DB through the
+ * pipeline, update the CRM counter and notify the observers once.
+ */
+void FdbOrch::flushFdbEvents()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_fdbEvents.empty())
+    {
+        return;
+    }
+
+    FdbBatchUpdate batch;
+    batch.updates.reserve(m_fdbEvents.size());
+
+    for (const auto &state : m_fdbEvents)
+    {
+        const FdbEntry &entry = state.entry;
+
+        if (state.changed)
         {
-            for (auto itr = m_entries.begin(); itr != m_entries.end();)
+            const Port *vlan = m_portsOrch->findPort(entry.bv_id);
+            if (vlan == nullptr)
             {
-                /*
-                   TODO: here should only delete the dynamic fdb entries,
-                   but unfortunately in structure FdbEntry currently have
-                   no member to indicate the fdb entry type,
-                   if there is static mac added, here will have issue.
-                */
-                update.entry.mac = itr->mac;
-                update.entry.bv_id = itr->bv_id;
-                update.add = false;
-                itr++;
-
-                storeFdbEntryState(update);
-
-                SWSS_LOG_DEBUG("FdbOrch notification: mac %s was removed", update.entry.mac.to_string().c_str());
-
-                for (auto observer: m_observers)
+                SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port from bv_id 0x%lx", entry.bv_id);
+            }
+            else
+            {
+                // ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
+                string key = "Vlan" + to_string(vlan->m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+
+                if (m_entries.contains(entry))
                 {
-                    observer->update(SUBJECT_TYPE_FDB_CHANGE, &update);
+                    // Write to StateDb
+                    std::vector<FieldValueTuple> fvs;
+                    fvs.push_back(FieldValueTuple("port", state.port->m_alias));
+                    fvs.push_back(FieldValueTuple("type", "dynamic"));
+                    m_fdbStateTable.set(key, fvs);
+                    m_fdbEntryUpdateCount++;
+                }
+                else if (state.stored)
+                {
+                    // Remove in StateDb
+                    m_fdbStateTable.del(key);
+                    m_fdbEntryUpdateCount++;
                 }
             }
         }
-        else if (bridge_port_id && entry->bv_id == SAI_NULL_OBJECT_ID)
-        {
-            /*this is a placeholder for flush port fdb case, not supported yet.*/
-            SWSS_LOG_ERROR("FdbOrch notification: not supported flush port fdb action, port_id = 0x%lx, bv_id = 0x%lx.", bridge_port_id, entry->bv_id);
-        }
-        else if (bridge_port_id == SAI_NULL_OBJECT_ID && entry->bv_id != SAI_NULL_OBJECT_ID)
+
+        if (state.notify)
         {
-            /*this is a placeholder for flush vlan fdb case, not supported yet.*/
-            SWSS_LOG_ERROR("FdbOrch notification: not supported flush vlan fdb action, port_id = 0x%lx, bv_id = 0x%lx.", bridge_port_id, entry->bv_id);
+            FdbUpdate update;
+            update.entry = entry;
+            update.add = state.add;
+            if (state.add)
+            {
+                update.port = *state.port;
+            }
+            batch.updates.push_back(update);
         }
-        else
+    }
+    m_fdbStateTable.flush();
+
+    for (; m_fdbCrmDelta > 0; m_fdbCrmDelta--)
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
+    }
+    for (; m_fdbCrmDelta < 0; m_fdbCrmDelta++)
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
+    }
+
+    m_fdbEvents.clear();
+    m_fdbEventIndex.clear();
+    m_fdbBatchCount++;
+
+    if (!batch.updates.empty())
+    {
+        for (auto observer: m_observers)
         {
-            SWSS_LOG_ERROR("FdbOrch notification: not supported flush fdb action, port_id = 0x%lx, bv_id = 0x%lx.", bridge_port_id, entry->bv_id);
+            observer->update(SUBJECT_TYPE_FDB_BATCH_CHANGE, &batch);
         }
-        break;
     }
 
-    return;
+    logFdbEventStats();
+}
+
+void FdbOrch::logFdbEventStats()
+{
+    auto now = chrono::steady_clock::now();
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - m_lastFdbStats).count();
+    if (elapsed < FDB_EVENT_STATS_INTERVAL_SEC * 1000)
+    {
+        return;
+    }
+
+    uint64_t events = m_fdbEventCount - m_lastFdbEventCount;
+    uint64_t updates = m_fdbEntryUpdateCount - m_lastFdbEntryUpdateCount;
+
+    SWSS_LOG_NOTICE("FDB events: %" PRIu64 " events (%" PRIu64 "/s) in %" PRIu64 " batches, "
+                    "%" PRIu64 " STATE_DB updates, coalescing ratio %.2f",
+                    m_fdbEventCount, events * 1000 / (uint64_t)elapsed, m_fdbBatchCount,
+                    m_fdbEntryUpdateCount, updates ? (double)events / (double)updates : 0.0);
+
+    m_lastFdbStats = now;
+    m_lastFdbEventCount = m_fdbEventCount;
+    m_lastFdbEntryUpdateCount = m_fdbEntryUpdateCount;
 }
 
 void FdbOrch::update(SubjectType type, void *cntx)
@@ -233,6 +319,18 @@ bool FdbOrch::getPort(const MacAddress& mac, uint16_t vlan, Port& port)
         return false;
     }
 
+    /* Entries learned or added by FdbOrch are known without asking the switch */
+    const FdbData *data = m_entries.find({mac, port.m_vlan_info.vlan_oid});
+    if (data != nullptr)
+    {
+        const Port *member = m_portsOrch->findPortByBridgePortId(data->bridge_port_id);
+        if (member != nullptr)
+        {
+            port = *member;
+            return true;
+        }
+    }
+
     sai_fdb_entry_t entry;
     entry.switch_id = gSwitchId;
     memcpy(entry.mac_address, mac.getMac(), sizeof(sai_mac_t));
@@ -347,84 +445,194 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
         return;
     }
 
-    sai_status_t status;
     std::string op;
     std::string data;
     std::vector<swss::FieldValueTuple> values;
 
+    /* The whole queue may have been drained by the previous call */
+    if (!consumer.hasData())
+    {
+        return;
+    }
+
     consumer.pop(op, data, values);
 
     if (&consumer == m_flushNotificationsConsumer)
     {
-        if (op == "ALL")
+        handleFlushRequest(op, data);
+        return;
+    }
+    else if (&consumer == m_fdbNotificationConsumer)
+    {
+        /*
+         * Coalesce the events of all the notifications already received, up
+         * to the batch size, and apply them at once.
+         */
+        while (true)
         {
-            /*
-             * so far only support flush all the FDB entris
-             * flush per port and flush per vlan will be added later.
-             */
-            status = sai_fdb_api->flush_fdb_entries(gSwitchId, 0, NULL);
-            if (status != SAI_STATUS_SUCCESS)
+            if (op == "fdb_event")
             {
-                SWSS_LOG_ERROR("Flush fdb failed, return code %x", status);
+                uint32_t count;
+                sai_fdb_event_notification_data_t *fdbevent = nullptr;
+
+                sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+
+                    for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+                    {
+                        if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
+                        {
+                            oid = fdbevent[i].attr[j].value.oid;
+                            break;
+                        }
+                    }
+
+                    queueFdbEvent(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid);
+                }
+
+                sai_deserialize_free_fdb_event_ntf(count, fdbevent);
             }
 
-            return;
+            if (m_fdbEvents.size() >= FDB_EVENT_BATCH_SIZE || !consumer.hasData())
+            {
+                break;
+            }
+            consumer.pop(op, data, values);
         }
-        else if (op == "PORT")
+
+        flushFdbEvents();
+    }
+}
+
+/*
+ * Flush request, op is ALL, PORT with the name of a port or LAG, or VLAN
+ * with the name or the id of a VLAN.
+ */
+void FdbOrch::handleFlushRequest(const string &op, const string &data)
+{
+    SWSS_LOG_ENTER();
+
+    if (op == "ALL")
+    {
+        flushFdbEntries(SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID);
+    }
+    else if (op == "PORT")
+    {
+        Port port;
+        if (!m_portsOrch->getPort(data, port))
         {
-            /*place holder for flush port fdb*/
-            SWSS_LOG_ERROR("Received unsupported flush port fdb request");
+            SWSS_LOG_ERROR("Received flush fdb request for unknown port %s", data.c_str());
             return;
         }
-        else if (op == "VLAN")
+
+        if (port.m_bridge_port_id == SAI_NULL_OBJECT_ID)
         {
-            /*place holder for flush vlan fdb*/
-            SWSS_LOG_ERROR("Received unsupported flush vlan fdb request");
+            SWSS_LOG_INFO("Port %s is not a bridge port, no fdb to flush", data.c_str());
             return;
         }
+
+        flushFdbEntries(port.m_bridge_port_id, SAI_NULL_OBJECT_ID);
+    }
+    else if (op == "VLAN")
+    {
+        Port vlan;
+        bool found;
+
+        if (!data.empty() && data.size() <= 4 && all_of(data.begin(), data.end(), ::isdigit))
+        {
+            found = m_portsOrch->getVlanByVlanId(static_cast<sai_vlan_id_t>(stoul(data)), vlan);
+        }
         else
         {
-            SWSS_LOG_ERROR("Received unknown flush fdb request");
+            found = m_portsOrch->getPort(data, vlan) && vlan.m_type == Port::VLAN;
+        }
+
+        if (!found)
+        {
+            SWSS_LOG_ERROR("Received flush fdb request for unknown vlan %s", data.c_str());
             return;
         }
+
+        flushFdbEntries(SAI_NULL_OBJECT_ID, vlan.m_vlan_info.vlan_oid);
     }
-    else if (&consumer == m_fdbNotificationConsumer && op == "fdb_event")
+    else
     {
-        uint32_t count;
-        sai_fdb_event_notification_data_t *fdbevent = nullptr;
+        SWSS_LOG_ERROR("Received unknown flush fdb request");
+    }
+}
 
-        sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+/*
+ * Flush the dynamic entries of a bridge port, of a VLAN or of both from the
+ * switch, SAI_NULL_OBJECT_ID matches any. The flushed entries are removed
+ * right away as the switch may not notify them.
+ */
+bool FdbOrch::flushFdbEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id)
+{
+    SWSS_LOG_ENTER();
 
-        for (uint32_t i = 0; i < count; ++i)
-        {
-            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+    sai_attribute_t attr;
+    vector<sai_attribute_t> attrs;
 
-            for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
-            {
-                if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
-                {
-                    oid = fdbevent[i].attr[j].value.oid;
-                    break;
-                }
-            }
+    if (bridge_port_id != SAI_NULL_OBJECT_ID)
+    {
+        attr.id = SAI_FDB_FLUSH_ATTR_BRIDGE_PORT_ID;
+        attr.value.oid = bridge_port_id;
+        attrs.push_back(attr);
+    }
 
-            this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid);
-        }
+    if (bv_id != SAI_NULL_OBJECT_ID)
+    {
+        attr.id = SAI_FDB_FLUSH_ATTR_BV_ID;
+        attr.value.oid = bv_id;
+        attrs.push_back(attr);
+    }
 
-        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+    if (!attrs.empty())
+    {
+        attr.id = SAI_FDB_FLUSH_ATTR_ENTRY_TYPE;
+        attr.value.s32 = SAI_FDB_FLUSH_ENTRY_TYPE_DYNAMIC;
+        attrs.push_back(attr);
+    }
+
+    sai_status_t status = sai_fdb_api->flush_fdb_entries(gSwitchId, (uint32_t)attrs.size(),
+                                                         attrs.empty() ? NULL : attrs.data());
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Flush fdb failed, bridge port 0x%lx, bv_id 0x%lx, return code %x",
+                       bridge_port_id, bv_id, status);
+        return false;
     }
+
+    SWSS_LOG_NOTICE("Flushed fdb, bridge port 0x%lx, bv_id 0x%lx", bridge_port_id, bv_id);
+
+    queueFlushedFdbEntries(bridge_port_id, bv_id);
+    flushFdbEvents();
+
+    return true;
 }
 
 void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 {
     SWSS_LOG_ENTER();
 
+    string port_name = update.member.m_alias;
+
     if (!update.add)
     {
-        return; // we need additions only
+        /* Flush what was learned on the member in this VLAN */
+        sai_object_id_t bridge_port_id = update.member.m_bridge_port_id;
+        sai_object_id_t bv_id = update.vlan.m_vlan_info.vlan_oid;
+
+        if (bridge_port_id != SAI_NULL_OBJECT_ID && m_entries.hasEntries(bridge_port_id, bv_id, true))
+        {
+            flushFdbEntries(bridge_port_id, bv_id);
+        }
+        return;
     }
 
-    string port_name = update.member.m_alias;
     auto fdb_list = std::move(saved_fdb_entries[port_name]);
     if(!fdb_list.empty())
     {
@@ -441,7 +649,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name, const
 {
     SWSS_LOG_ENTER();
 
-    if (m_entries.count(entry) != 0) // we already have such entries
+    if (m_entries.contains(entry)) // we already have such entries
     {
         // FIXME: should we check that the entry are moving to another port?
         // FIXME: should we check that the entry are changing its type?
@@ -499,7 +707,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name, const
 
     SWSS_LOG_NOTICE("Create %s FDB %s on %s", type.c_str(), entry.mac.to_string().c_str(), port_name.c_str());
 
-    (void) m_entries.insert(entry);
+    (void) m_entries.insert(entry, { port.m_bridge_port_id, type });
 
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
 
@@ -516,7 +724,7 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry)
 {
     SWSS_LOG_ENTER();
 
-    if (m_entries.count(entry) == 0)
+    if (!m_entries.contains(entry))
     {
         SWSS_LOG_ERROR("FDB entry isn't found. mac=%s bv_id=0x%lx", entry.mac.to_string().c_str(), entry.bv_id);
         return true;
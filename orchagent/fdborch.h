@@ -1,20 +1,13 @@
 #ifndef SWSS_FDBORCH_H
 #define SWSS_FDBORCH_H
 
+#include <chrono>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
-
-struct FdbEntry
-{
-    MacAddress mac;
-    sai_object_id_t bv_id;
-
-    bool operator<(const FdbEntry& other) const
-    {
-        return tie(mac, bv_id) < tie(other.mac, other.bv_id);
-    }
-};
+#include "fdbstore.h"
+#include "redispipeline.h"
 
 struct FdbUpdate
 {
@@ -23,6 +16,12 @@ struct FdbUpdate
     bool add;
 };
 
+/* FDB entries learned or removed by a batch of switch FDB events */
+struct FdbBatchUpdate
+{
+    vector<FdbUpdate> updates;
+};
+
 struct SavedFdbEntry
 {
     FdbEntry entry;
@@ -48,10 +47,25 @@ public:
     bool getPort(const MacAddress&, uint16_t, Port&);
 
 private:
+    /*
+     * Switch FDB event of a batch, the events of an entry are coalesced and
+     * only the resulting state is written and notified.
+     */
+    struct FdbEventState
+    {
+        FdbEntry entry;
+        bool stored;        // entry was in the STATE_DB table before the batch
+        bool changed;       // entry was learned or removed by the batch
+        bool notify;        // observers are notified with the last update
+        bool add;
+        const Port *port;   // port of the last learn
+    };
+
     PortsOrch *m_portsOrch;
-    set<FdbEntry> m_entries;
+    FdbStore m_entries;
     fdb_entries_by_port_t saved_fdb_entries;
     Table m_table;
+    unique_ptr<RedisPipeline> m_stateDbPipeline;
     Table m_fdbStateTable;
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
@@ -62,8 +76,27 @@ private:
     void updateVlanMember(const VlanMemberUpdate&);
     bool addFdbEntry(const FdbEntry&, const string&, const string&);
     bool removeFdbEntry(const FdbEntry&);
+    bool flushFdbEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id);
+    void handleFlushRequest(const string &op, const string &data);
+
+    vector<FdbEventState> m_fdbEvents;
+    map<FdbEntry, size_t> m_fdbEventIndex;
+    int m_fdbCrmDelta = 0;
+
+    /* Counters of the switch FDB events */
+    uint64_t m_fdbEventCount = 0;
+    uint64_t m_fdbEntryUpdateCount = 0;
+    uint64_t m_fdbBatchCount = 0;
+    uint64_t m_lastFdbEventCount = 0;
+    uint64_t m_lastFdbEntryUpdateCount = 0;
+    chrono::steady_clock::time_point m_lastFdbStats;
 
-    bool storeFdbEntryState(const FdbUpdate& update);
+    void queueFdbEvent(sai_fdb_event_t, const sai_fdb_entry_t *, sai_object_id_t);
+    FdbEventState &getFdbEventState(const FdbEntry& entry);
+    void queueFdbEntryState(const FdbEntry& entry, const Port *port, bool add);
+    void queueFlushedFdbEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id);
+    void flushFdbEvents();
+    void logFdbEventStats();
 };
 
 #endif /* SWSS_FDBORCH_H */
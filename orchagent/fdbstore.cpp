@@ -0,0 +1,145 @@
+#include "fdbstore.h"
+
+static void addToIndex(unordered_map<sai_object_id_t, set<FdbEntry>> &index, sai_object_id_t id, const FdbEntry &entry)
+{
+    index[id].insert(entry);
+}
+
+static void removeFromIndex(unordered_map<sai_object_id_t, set<FdbEntry>> &index, sai_object_id_t id, const FdbEntry &entry)
+{
+    auto it = index.find(id);
+    if (it == index.end())
+    {
+        return;
+    }
+
+    it->second.erase(entry);
+    if (it->second.empty())
+    {
+        index.erase(it);
+    }
+}
+
+bool FdbStore::insert(const FdbEntry &entry, const FdbData &data)
+{
+    if (!m_entries.emplace(entry, data).second)
+    {
+        return false;
+    }
+
+    addToIndex(m_byBridgePort, data.bridge_port_id, entry);
+    addToIndex(m_byBvId, entry.bv_id, entry);
+    return true;
+}
+
+bool FdbStore::erase(const FdbEntry &entry)
+{
+    auto it = m_entries.find(entry);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    removeFromIndex(m_byBridgePort, it->second.bridge_port_id, entry);
+    removeFromIndex(m_byBvId, entry.bv_id, entry);
+    m_entries.erase(it);
+    return true;
+}
+
+bool FdbStore::contains(const FdbEntry &entry) const
+{
+    return m_entries.find(entry) != m_entries.end();
+}
+
+const FdbData *FdbStore::find(const FdbEntry &entry) const
+{
+    auto it = m_entries.find(entry);
+    if (it == m_entries.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+size_t FdbStore::size() const
+{
+    return m_entries.size();
+}
+
+bool FdbStore::matches(const FdbEntry &entry, const FdbData &data, sai_object_id_t bridge_port_id,
+                       sai_object_id_t bv_id, bool dynamicOnly) const
+{
+    return (bridge_port_id == SAI_NULL_OBJECT_ID || data.bridge_port_id == bridge_port_id) &&
+           (bv_id == SAI_NULL_OBJECT_ID || entry.bv_id == bv_id) &&
+           (!dynamicOnly || data.type == "dynamic");
+}
+
+/* Call f on the matching entries until it returns false, through the smallest index */
+template <typename F>
+void FdbStore::forEachEntry(sai_object_id_t bridge_port_id, sai_object_id_t bv_id, bool dynamicOnly, F f) const
+{
+    const set<FdbEntry> *candidates = nullptr;
+
+    for (auto &lookup : { make_pair(&m_byBridgePort, bridge_port_id), make_pair(&m_byBvId, bv_id) })
+    {
+        if (lookup.second == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        auto it = lookup.first->find(lookup.second);
+        if (it == lookup.first->end())
+        {
+            return;
+        }
+        if (candidates == nullptr || it->second.size() < candidates->size())
+        {
+            candidates = &it->second;
+        }
+    }
+
+    if (candidates == nullptr)
+    {
+        for (const auto &it : m_entries)
+        {
+            if (matches(it.first, it.second, bridge_port_id, bv_id, dynamicOnly) && !f(it.first))
+            {
+                return;
+            }
+        }
+        return;
+    }
+
+    for (const auto &entry : *candidates)
+    {
+        if (matches(entry, m_entries.at(entry), bridge_port_id, bv_id, dynamicOnly) && !f(entry))
+        {
+            return;
+        }
+    }
+}
+
+vector<FdbEntry> FdbStore::getEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id, bool dynamicOnly) const
+{
+    vector<FdbEntry> entries;
+
+    forEachEntry(bridge_port_id, bv_id, dynamicOnly, [&entries](const FdbEntry &entry) {
+        entries.push_back(entry);
+        return true;
+    });
+
+    return entries;
+}
+
+bool FdbStore::hasEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id, bool dynamicOnly) const
+{
+    bool found = false;
+
+    forEachEntry(bridge_port_id, bv_id, dynamicOnly, [&found](const FdbEntry &) {
+        found = true;
+        return false;
+    });
+
+    return found;
+}
@@ -0,0 +1,76 @@
+#ifndef SWSS_FDBSTORE_H
+#define SWSS_FDBSTORE_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "macaddress.h"
+
+using namespace std;
+using namespace swss;
+
+struct FdbEntry
+{
+    MacAddress mac;
+    sai_object_id_t bv_id;
+
+    bool operator<(const FdbEntry& other) const
+    {
+        return tie(mac, bv_id) < tie(other.mac, other.bv_id);
+    }
+};
+
+struct FdbData
+{
+    sai_object_id_t bridge_port_id;
+    string type;                        // "dynamic" or "static"
+};
+
+/*
+ * FdbStore: FDB entries known by FdbOrch, indexed by bridge port and by
+ * bv_id so that the entries of a port or of a VLAN are found without
+ * scanning the whole table.
+ */
+class FdbStore
+{
+public:
+    /* Return false if the entry already exists, it is left unchanged */
+    bool insert(const FdbEntry &entry, const FdbData &data);
+    /* Return false if the entry does not exist */
+    bool erase(const FdbEntry &entry);
+
+    bool contains(const FdbEntry &entry) const;
+    /* Return nullptr if the entry does not exist */
+    const FdbData *find(const FdbEntry &entry) const;
+    size_t size() const;
+
+    /*
+     * Entries of a bridge port and of a bv_id, SAI_NULL_OBJECT_ID matches any
+     * bridge port or bv_id. Only the dynamic entries if dynamicOnly is set.
+     */
+    vector<FdbEntry> getEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id, bool dynamicOnly) const;
+    /* Return true if getEntries() would return some entries */
+    bool hasEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id, bool dynamicOnly) const;
+
+private:
+    typedef unordered_map<sai_object_id_t, set<FdbEntry>> FdbIndex;
+
+    map<FdbEntry, FdbData> m_entries;
+    FdbIndex m_byBridgePort;
+    FdbIndex m_byBvId;
+
+    bool matches(const FdbEntry &entry, const FdbData &data, sai_object_id_t bridge_port_id,
+                 sai_object_id_t bv_id, bool dynamicOnly) const;
+    template <typename F>
+    void forEachEntry(sai_object_id_t bridge_port_id, sai_object_id_t bv_id, bool dynamicOnly, F f) const;
+};
+
+#endif /* SWSS_FDBSTORE_H */
@@ -12,6 +12,9 @@ extern sai_port_api_t *sai_port_api;
 extern PortsOrch *gPortsOrch;
 extern IntfsOrch *gIntfsOrch;
 
+#define FLEX_COUNTER_REGISTRATION_CHUNK 512
+#define FLEX_COUNTER_REGISTRATION_MSECS 10
+
 unordered_map<string, string> flexCounterGroupMap =
 {
     {"PORT", PORT_STAT_COUNTER_FLEX_COUNTER_GROUP},
@@ -26,9 +29,16 @@ unordered_map<string, string> flexCounterGroupMap =
 FlexCounterOrch::FlexCounterOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
     m_flexCounterDb(new DBConnector(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0)),
-    m_flexCounterGroupTable(new ProducerTable(m_flexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE))
+    m_flexCounterGroupTable(new ProducerTable(m_flexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE)),
+    m_flexCounterPipeline(new RedisPipeline(m_flexCounterDb.get())),
+    m_flexCounterTable(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE, true))
 {
     SWSS_LOG_ENTER();
+
+    auto intervT = timespec { .tv_sec = 0, .tv_nsec = FLEX_COUNTER_REGISTRATION_MSECS * 1000000 };
+    m_registrationTimer = new SelectableTimer(intervT);
+    auto executorT = new ExecutableTimer(m_registrationTimer, this, "FLEX_COUNTER_REGISTRATION_TIMER");
+    Orch::addExecutor(executorT);
 }
 
 FlexCounterOrch::~FlexCounterOrch(void)
@@ -77,10 +87,26 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                 else if(field == FLEX_COUNTER_STATUS_FIELD)
                 {
                     // Currently the counters are disabled by default
-                    // The queue maps will be generated as soon as counters are enabled
-                    gPortsOrch->generateQueueMap();
-                    gPortsOrch->generatePriorityGroupMap();
-                    gIntfsOrch->generateInterfaceMap();
+                    // The maps of a group will be generated as soon as its counters are enabled
+                    if (value == "enable")
+                    {
+                        // The PFC watchdog plugins look the queues up in the queue maps
+                        if (key == "QUEUE" || key == "QUEUE_WATERMARK" || key == "PFCWD")
+                        {
+                            gPortsOrch->generateQueueMap();
+                        }
+                        else if (key == "PG_WATERMARK")
+                        {
+                            gPortsOrch->generatePriorityGroupMap();
+                        }
+                        else if (key == "RIF")
+                        {
+                            gIntfsOrch->generateInterfaceMap();
+                        }
+
+                        m_registrar.enableGroup(flexCounterGroupMap[key]);
+                        scheduleRegistrations();
+                    }
 
                     vector<FieldValueTuple> fieldValues;
                     fieldValues.emplace_back(FLEX_COUNTER_STATUS_FIELD, value);
@@ -96,3 +122,64 @@ void FlexCounterOrch::doTask(Consumer &consumer)
         consumer.m_toSync.erase(it++);
     }
 }
+
+void FlexCounterOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    auto registrations = m_registrar.getPending(FLEX_COUNTER_REGISTRATION_CHUNK);
+    for (const auto &r : registrations)
+    {
+        vector<FieldValueTuple> fieldValues;
+        fieldValues.emplace_back(r.field, r.value);
+        m_flexCounterTable->set(r.key, fieldValues);
+    }
+    m_flexCounterTable->flush();
+
+    SWSS_LOG_DEBUG("Registered %zu flex counter objects", registrations.size());
+
+    if (!m_registrar.hasPending())
+    {
+        m_registrationTimer->stop();
+        m_registrationScheduled = false;
+    }
+}
+
+void FlexCounterOrch::setGroupCounters(const string &group, const string &field, const vector<string> &stats)
+{
+    m_registrar.setGroupCounters(group, field, stats);
+    scheduleRegistrations();
+}
+
+void FlexCounterOrch::addCounterObject(const string &group, const string &id)
+{
+    m_registrar.addObject(group, id);
+    scheduleRegistrations();
+}
+
+void FlexCounterOrch::removeCounterObject(const string &group, const string &id)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounterRegistration unregistration;
+    if (!m_registrar.removeObject(group, id, unregistration))
+    {
+        return;
+    }
+
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back(unregistration.field, unregistration.value);
+    m_flexCounterTable->set(unregistration.key, fieldValues);
+    m_flexCounterTable->flush();
+}
+
+void FlexCounterOrch::scheduleRegistrations()
+{
+    if (m_registrationScheduled || !m_registrar.hasPending())
+    {
+        return;
+    }
+
+    m_registrationTimer->start();
+    m_registrationScheduled = true;
+}
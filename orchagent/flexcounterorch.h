@@ -4,6 +4,8 @@
 #include "orch.h"
 #include "port.h"
 #include "producertable.h"
+#include "timer.h"
+#include "flexcounterregistrar.h"
 
 extern "C" {
 #include "sai.h"
@@ -13,12 +15,31 @@ class FlexCounterOrch: public Orch
 {
 public:
     void doTask(Consumer &consumer);
+    void doTask(SelectableTimer &timer);
     FlexCounterOrch(DBConnector *db, vector<string> &tableNames);
     virtual ~FlexCounterOrch(void);
+
+    /*
+     * The objects counters are registered in FLEX_COUNTER_TABLE once their
+     * group is enabled, a chunk at a time from the registration timer.
+     */
+    void setGroupCounters(const string &group, const string &field, const vector<string> &stats);
+    void addCounterObject(const string &group, const string &id);
+    /* Unregistered right away, before the object is removed */
+    void removeCounterObject(const string &group, const string &id);
  
 private:
     shared_ptr<DBConnector> m_flexCounterDb = nullptr;
     shared_ptr<ProducerTable> m_flexCounterGroupTable = nullptr;
+
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
+    unique_ptr<ProducerTable> m_flexCounterTable;
+
+    FlexCounterRegistrar m_registrar;
+    SelectableTimer *m_registrationTimer = nullptr;
+    bool m_registrationScheduled = false;
+
+    void scheduleRegistrations();
 };
 
 #endif
@@ -0,0 +1,126 @@
+#include "flexcounterregistrar.h"
+
+using namespace std;
+
+void FlexCounterRegistrar::setGroupCounters(const string &group, const string &field, const vector<string> &stats)
+{
+    auto &g = m_groups[group];
+
+    string counters;
+    for (const auto &stat : stats)
+    {
+        if (!counters.empty())
+        {
+            counters += ",";
+        }
+        counters += stat;
+    }
+
+    if (g.field == field && g.counters == counters)
+    {
+        return;
+    }
+
+    g.field = field;
+    g.counters = counters;
+
+    /* Registered objects are written again with the new list */
+    g.registered.clear();
+    for (const auto &id : g.objects)
+    {
+        queue(group, id);
+    }
+}
+
+void FlexCounterRegistrar::enableGroup(const string &group)
+{
+    auto &g = m_groups[group];
+    if (g.enabled)
+    {
+        return;
+    }
+
+    g.enabled = true;
+    for (const auto &id : g.objects)
+    {
+        queue(group, id);
+    }
+}
+
+bool FlexCounterRegistrar::isGroupEnabled(const string &group) const
+{
+    auto it = m_groups.find(group);
+    return it != m_groups.end() && it->second.enabled;
+}
+
+void FlexCounterRegistrar::addObject(const string &group, const string &id)
+{
+    auto &g = m_groups[group];
+    if (!g.objects.insert(id).second)
+    {
+        return;
+    }
+
+    queue(group, id);
+}
+
+bool FlexCounterRegistrar::removeObject(const string &group, const string &id, FlexCounterRegistration &unregistration)
+{
+    auto it = m_groups.find(group);
+    if (it == m_groups.end())
+    {
+        return false;
+    }
+
+    it->second.objects.erase(id);
+    if (!it->second.registered.erase(id))
+    {
+        return false;
+    }
+
+    unregistration = { getKey(group, id), it->second.field, "" };
+    return true;
+}
+
+vector<FlexCounterRegistration> FlexCounterRegistrar::getPending(size_t max)
+{
+    vector<FlexCounterRegistration> registrations;
+
+    while (!m_pending.empty() && registrations.size() < max)
+    {
+        const auto &group = m_pending.front().first;
+        const auto &id = m_pending.front().second;
+        auto &g = m_groups[group];
+
+        /* Objects removed or already registered since they were queued are skipped */
+        if (g.enabled && !g.field.empty() && g.objects.count(id) && g.registered.insert(id).second)
+        {
+            registrations.push_back({ getKey(group, id), g.field, g.counters });
+        }
+
+        m_pending.pop_front();
+    }
+
+    return registrations;
+}
+
+bool FlexCounterRegistrar::hasPending() const
+{
+    return !m_pending.empty();
+}
+
+string FlexCounterRegistrar::getKey(const string &group, const string &id)
+{
+    return group + ":" + id;
+}
+
+void FlexCounterRegistrar::queue(const string &group, const string &id)
+{
+    const auto &g = m_groups[group];
+    if (!g.enabled || g.field.empty())
+    {
+        return;
+    }
+
+    m_pending.emplace_back(group, id);
+}
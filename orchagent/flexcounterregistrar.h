@@ -0,0 +1,65 @@
+#ifndef SWSS_FLEXCOUNTERREGISTRAR_H
+#define SWSS_FLEXCOUNTERREGISTRAR_H
+
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+struct FlexCounterRegistration
+{
+    std::string key;
+    std::string field;
+    /* Empty list to unregister the object */
+    std::string value;
+};
+
+/*
+ * FlexCounterRegistrar: FLEX_COUNTER_TABLE registrations of the objects of
+ * the flex counter groups.
+ *
+ * The stat id list of a group is joined once. Objects are known to their
+ * group as soon as they are added, but are only registered once the group is
+ * enabled. The registrations are handed out in bounded chunks, an object
+ * added then removed before being registered is never written.
+ */
+class FlexCounterRegistrar
+{
+public:
+    void setGroupCounters(const std::string &group, const std::string &field, const std::vector<std::string> &stats);
+
+    /* Register all the objects of the group, and the objects added later */
+    void enableGroup(const std::string &group);
+    bool isGroupEnabled(const std::string &group) const;
+
+    void addObject(const std::string &group, const std::string &id);
+    /* Return true, with the unregistration to write now, if the object was registered */
+    bool removeObject(const std::string &group, const std::string &id, FlexCounterRegistration &unregistration);
+
+    /* Return up to max registrations to write, in the order they were queued */
+    std::vector<FlexCounterRegistration> getPending(size_t max);
+    bool hasPending() const;
+
+    static std::string getKey(const std::string &group, const std::string &id);
+
+private:
+    struct Group
+    {
+        std::string field;
+        std::string counters;
+        bool enabled = false;
+        std::unordered_set<std::string> objects;
+        std::unordered_set<std::string> registered;
+    };
+
+    typedef std::pair<std::string, std::string> GroupObject;
+
+    std::map<std::string, Group> m_groups;
+    std::deque<GroupObject> m_pending;
+
+    void queue(const std::string &group, const std::string &id);
+};
+
+#endif /* SWSS_FLEXCOUNTERREGISTRAR_H */
@@ -0,0 +1,188 @@
+#include <stdexcept>
+#include "flushpolicy.h"
+#include "logger.h"
+#include "tokenize.h"
+
+#define DEFAULT_FLUSH_INTERVAL_USEC     1000
+
+/* Select the timer before the events, it bounds their latency */
+#define FLUSH_TIMER_PRI                 100
+
+#define OPS_PER_FLUSH_BUCKETS           17      // up to 64K events
+#define FLUSH_LATENCY_BUCKETS           21      // up to 1s
+
+using namespace std::chrono;
+
+Histogram::Histogram(size_t buckets) :
+        m_buckets(buckets, 0)
+{
+}
+
+void Histogram::add(uint64_t value)
+{
+    size_t bucket = 0;
+    while (bucket + 1 < m_buckets.size() && (1ULL << bucket) < value)
+    {
+        bucket++;
+    }
+
+    m_buckets[bucket]++;
+}
+
+void Histogram::dump(const string &name, vector<FieldValueTuple> &fvs) const
+{
+    for (size_t i = 0; i < m_buckets.size(); i++)
+    {
+        string bound = i + 1 < m_buckets.size() ? to_string(1ULL << i) : "inf";
+        fvs.emplace_back(name + "_le_" + bound, to_string(m_buckets[i]));
+    }
+}
+
+static timespec toTimespec(uint64_t us)
+{
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(us / 1000000);
+    ts.tv_nsec = static_cast<long>((us % 1000000) * 1000);
+    return ts;
+}
+
+FlushPolicy::FlushPolicy(Hook flush, const FlushPolicyConfig &config) :
+        m_flush(flush),
+        m_config(config),
+        m_timer(toTimespec(config.interval ? config.interval : DEFAULT_FLUSH_INTERVAL_USEC), FLUSH_TIMER_PRI),
+        m_pendingOps(0),
+        m_flushes(),
+        m_opsPerFlush(OPS_PER_FLUSH_BUCKETS),
+        m_flushLatency(FLUSH_LATENCY_BUCKETS),
+        m_holdTime(FLUSH_LATENCY_BUCKETS)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("Flush after %zu events, %lu us at most%s", m_config.ops, m_config.interval,
+                    m_config.idle ? " or when idle" : "");
+}
+
+bool FlushPolicy::parse(const string &policy, FlushPolicyConfig &config)
+{
+    config.ops = 1;
+    config.interval = 0;
+    config.idle = false;
+
+    if (policy.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        for (const auto &item : tokenize(policy, ','))
+        {
+            if (item == "idle")
+            {
+                config.idle = true;
+            }
+            else if (item.compare(0, 4, "ops=") == 0)
+            {
+                config.ops = stoul(item.substr(4));
+            }
+            else if (item.compare(0, 5, "time=") == 0)
+            {
+                config.interval = stoull(item.substr(5));
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+    catch (const exception &)
+    {
+        return false;
+    }
+
+    /* An idle or time only policy does not flush on a number of events */
+    if (policy.find("ops=") == string::npos && (config.idle || config.interval))
+    {
+        config.ops = 0;
+    }
+
+    if (config.ops != 1 && !config.interval)
+    {
+        config.interval = DEFAULT_FLUSH_INTERVAL_USEC;
+    }
+
+    return true;
+}
+
+void FlushPolicy::opDone()
+{
+    if (m_pendingOps++ == 0)
+    {
+        m_firstPendingOp = steady_clock::now();
+        if (m_config.ops != 1)
+        {
+            m_timer.start();
+        }
+    }
+
+    if (m_config.ops && m_pendingOps >= m_config.ops)
+    {
+        flush(REASON_OPS);
+    }
+}
+
+bool FlushPolicy::waitsForIdle() const
+{
+    return m_config.idle && m_pendingOps;
+}
+
+void FlushPolicy::onIdle()
+{
+    flush(REASON_IDLE);
+}
+
+void FlushPolicy::onTimer()
+{
+    flush(REASON_TIME);
+}
+
+void FlushPolicy::flush()
+{
+    flush(REASON_FORCED);
+}
+
+void FlushPolicy::flush(Reason reason)
+{
+    if (!m_pendingOps)
+    {
+        return;
+    }
+
+    if (m_config.ops != 1)
+    {
+        m_timer.stop();
+    }
+
+    auto start = steady_clock::now();
+    m_flush();
+    auto end = steady_clock::now();
+
+    m_flushes[reason]++;
+    m_opsPerFlush.add(m_pendingOps);
+    m_flushLatency.add((uint64_t)duration_cast<microseconds>(end - start).count());
+    m_holdTime.add((uint64_t)duration_cast<microseconds>(start - m_firstPendingOp).count());
+
+    m_pendingOps = 0;
+}
+
+void FlushPolicy::getStats(vector<FieldValueTuple> &fvs) const
+{
+    fvs.emplace_back("flushes_ops", to_string(m_flushes[REASON_OPS]));
+    fvs.emplace_back("flushes_time", to_string(m_flushes[REASON_TIME]));
+    fvs.emplace_back("flushes_idle", to_string(m_flushes[REASON_IDLE]));
+    fvs.emplace_back("flushes_forced", to_string(m_flushes[REASON_FORCED]));
+
+    m_opsPerFlush.dump("ops_per_flush", fvs);
+    m_flushLatency.dump("flush_latency_us", fvs);
+    m_holdTime.dump("hold_time_us", fvs);
+}
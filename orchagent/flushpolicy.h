@@ -0,0 +1,98 @@
+#ifndef SWSS_FLUSHPOLICY_H
+#define SWSS_FLUSHPOLICY_H
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "selectabletimer.h"
+#include "table.h"
+
+using namespace std;
+using namespace swss;
+
+/* Histogram with power of two buckets, bucket i counts the values up to 2^i */
+class Histogram
+{
+public:
+    Histogram(size_t buckets);
+
+    void add(uint64_t value);
+    void dump(const string &name, vector<FieldValueTuple> &fvs) const;
+
+private:
+    vector<uint64_t> m_buckets;
+};
+
+struct FlushPolicyConfig
+{
+    size_t      ops;        // flush after this many events, 1 to flush after each event
+    uint64_t    interval;   // us, flush at most this long after the first event not flushed
+    bool        idle;       // flush as soon as no event is ready
+};
+
+/*
+ * FlushPolicy: coalescing of the sairedis pipeline flushes.
+ *
+ * Events executed since the last flush are flushed when the configured
+ * number of events is reached, when no event is ready in idle mode, and in
+ * any case when the timer fires. The timer bounds how long a SAI request is
+ * held in the pipeline.
+ *
+ * The policy is given as a comma separated list of "ops=<events>",
+ * "time=<us>" and "idle". Without a time, coalescing policies use
+ * DEFAULT_FLUSH_INTERVAL_USEC. The empty policy flushes after each event.
+ */
+class FlushPolicy
+{
+public:
+    typedef std::function<void()> Hook;
+
+    FlushPolicy(Hook flush, const FlushPolicyConfig &config);
+
+    FlushPolicy(const FlushPolicy&) = delete;
+    FlushPolicy& operator=(const FlushPolicy&) = delete;
+
+    static bool parse(const string &policy, FlushPolicyConfig &config);
+
+    /* To be selected with the events */
+    SelectableTimer *getTimer() { return &m_timer; }
+
+    /* An event was executed */
+    void opDone();
+    /* Whether to look for ready events before blocking on them */
+    bool waitsForIdle() const;
+    void onIdle();
+    void onTimer();
+    /* Flush the events pending, if any */
+    void flush();
+
+    void getStats(vector<FieldValueTuple> &fvs) const;
+
+private:
+    enum Reason
+    {
+        REASON_OPS,
+        REASON_TIME,
+        REASON_IDLE,
+        REASON_FORCED,
+        REASON_COUNT
+    };
+
+    Hook m_flush;
+    FlushPolicyConfig m_config;
+    SelectableTimer m_timer;
+
+    size_t m_pendingOps;
+    std::chrono::steady_clock::time_point m_firstPendingOp;
+
+    uint64_t m_flushes[REASON_COUNT];
+    Histogram m_opsPerFlush;
+    Histogram m_flushLatency;           // us
+    Histogram m_holdTime;               // us, from the first event flushed
+
+    void flush(Reason reason);
+};
+
+#endif /* SWSS_FLUSHPOLICY_H */
@@ -15,6 +15,7 @@
 #include "bufferorch.h"
 #include "directory.h"
 #include "vnetorch.h"
+#include "flexcounterorch.h"
 
 extern sai_object_id_t gVirtualRouterId;
 extern Directory<Orch*> gDirectory;
@@ -28,6 +29,7 @@ extern PortsOrch *gPortsOrch;
 extern RouteOrch *gRouteOrch;
 extern CrmOrch *gCrmOrch;
 extern BufferOrch *gBufferOrch;
+extern FlexCounterOrch *gFlexCounterOrch;
 
 const int intfsorch_pri = 35;
 
@@ -65,7 +67,6 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch) :
     auto executorT = new ExecutableTimer(m_updateMapsTimer, this, "UPDATE_MAPS_TIMER");
     Orch::addExecutor(executorT);
     /* Initialize FLEX_COUNTER_DB tables */
-    m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
     vector<FieldValueTuple> fieldValues;
@@ -299,6 +300,7 @@ void IntfsOrch::doTask(Consumer &consumer)
         {
             if (!m_vrfOrch->isVRFexists(vrf_name))
             {
+                consumer.waitFor(it->first, OBJECT_TYPE_VRF, vrf_name);
                 it++;
                 continue;
             }
@@ -350,6 +352,7 @@ void IntfsOrch::doTask(Consumer &consumer)
             if (!gPortsOrch->getPort(alias, port))
             {
                 /* TODO: Resolve the dependency relationship and add ref_count to port */
+                consumer.waitFor(it->first, OBJECT_TYPE_PORT, alias);
                 it++;
                 continue;
             }
@@ -546,6 +549,7 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port)
 
     SWSS_LOG_NOTICE("Create router interface %s MTU %u", port.m_alias.c_str(), port.m_mtu);
 
+    notifyObjectReady(OBJECT_TYPE_ROUTER_INTF, port.m_alias);
     return true;
 }
 
@@ -801,21 +805,7 @@ void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const
     m_rifTypeTable->set("", rifTypeVector);
 
     /* update RIF in FLEX_COUNTER_DB */
-    string key = getRifFlexCounterTableKey(id);
-
-
-    std::ostringstream counters_stream;
-    for (const auto& it: rifStatIds)
-    {
-        counters_stream << sai_serialize_router_interface_stat(it) << comma;
-    }
-
-    /* check the state of intf, if registering the intf to FC will result in runtime error */
-    vector<FieldValueTuple> fvt;
-    vector<FieldValueTuple> fieldValues;
-    fieldValues.emplace_back(RIF_COUNTER_ID_LIST, counters_stream.str());
-
-    m_flexCounterTable->set(key, fieldValues);
+    gFlexCounterOrch->addCounterObject(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, id);
     SWSS_LOG_DEBUG("Registered interface %s to Flex counter", name.c_str());
 }
 
@@ -827,22 +817,19 @@ void IntfsOrch::removeRifFromFlexCounter(const string &id, const string &name)
     m_rifTypeTable->hdel("", id);
 
     /* remove it from FLEX_COUNTER_DB */
-    string key = getRifFlexCounterTableKey(id);
-
-    vector<FieldValueTuple> fieldValues;
-    fieldValues.emplace_back(RIF_COUNTER_ID_LIST, "");
-
-    m_flexCounterTable->set(key, fieldValues);
+    gFlexCounterOrch->removeCounterObject(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, id);
     SWSS_LOG_DEBUG("Unregistered interface %s from Flex counter", name.c_str());
 }
 
-string IntfsOrch::getRifFlexCounterTableKey(string key)
-{
-    return string(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
 void IntfsOrch::generateInterfaceMap()
 {
+    vector<string> stats;
+    for (const auto& it: rifStatIds)
+    {
+        stats.push_back(sai_serialize_router_interface_stat(it));
+    }
+    gFlexCounterOrch->setGroupCounters(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, RIF_COUNTER_ID_LIST, stats);
+
     m_updateMapsTimer->start();
 }
 
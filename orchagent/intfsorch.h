@@ -71,11 +71,8 @@ private:
     unique_ptr<Table> m_rifNameTable;
     unique_ptr<Table> m_rifTypeTable;
     unique_ptr<Table> m_vidToRidTable;
-    unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
-    std::string getRifFlexCounterTableKey(std::string s);
-
     int getRouterIntfsRefCount(const string&);
 
     bool addRouterIntfs(sai_object_id_t vrf_id, Port &port);
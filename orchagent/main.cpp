@@ -3,6 +3,7 @@ extern "C" {
 #include "saistatus.h"
 }
 
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <unordered_map>
@@ -24,6 +25,7 @@ extern "C" {
 #include "notifications.h"
 #include <signal.h>
 #include "warm_restart.h"
+#include "swssrecorder.h"
 
 using namespace std;
 using namespace swss;
@@ -43,15 +45,24 @@ MacAddress gVxlanMacAddress;
 #define DEFAULT_BATCH_SIZE  128
 int gBatchSize = DEFAULT_BATCH_SIZE;
 
+#define DEFAULT_MAX_BULK_SIZE  0
+int gMaxBulkSize = DEFAULT_MAX_BULK_SIZE;
+
+bool gMultiThreadedMode = false;
+
+FlushPolicyConfig gFlushPolicy = { 1, 0, false };
+
+bool gWatermarkAggregation = false;
+bool gPfcWdNativeDetect = false;
+
 bool gSairedisRecord = true;
 bool gSwssRecord = true;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
+SwssRecorder gSwssRecorder;
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-b batch_size] [-m MAC]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-s record_options] [-b batch_size] [-m MAC] [-k max_bulk_size] [-t] [-f flush_policy] [-w] [-p]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    0: do not record logs" << endl;
@@ -59,8 +70,26 @@ void usage()
     cout << "                    2: record SwSS task sequence as swss.rec" << endl;
     cout << "                    3: enable both above two records" << endl;
     cout << "    -d record_location: set record logs folder location (default .)" << endl;
+    cout << "    -s record_options: swss.rec recording options (default: text, not rotated)" << endl;
+    cout << "                       comma separated list of:" << endl;
+    cout << "                       binary: record in the binary format, as swss.rec.bin" << endl;
+    cout << "                       gzip: compress the recording, with a .gz suffix" << endl;
+    cout << "                       size=N: rotate the recording every N MB" << endl;
+    cout << "                       files=N: number of rotated recordings kept (default 5)" << endl;
+    cout << "                       records are queued in memory and written by a background thread," << endl;
+    cout << "                       they are written out on exit, exceptions, std::terminate and SIGABRT," << endl;
+    cout << "                       up to " << SWSS_RECORDER_RING_SIZE << " queued records are lost on SIGKILL or other crashes" << endl;
     cout << "    -b batch_size: set consumer table pop operation batch size (default 128)" << endl;
     cout << "    -m MAC: set switch MAC address" << endl;
+    cout << "    -k max_bulk_size: program routes through SAI bulk API with the max bulk size (default 0, bulk disabled)" << endl;
+    cout << "    -t: run independent orchs on their own worker threads" << endl;
+    cout << "    -f flush_policy: coalesce the SAI pipeline flushes (default: flush after each event)" << endl;
+    cout << "                     comma separated list of:" << endl;
+    cout << "                     ops=N: flush after N events" << endl;
+    cout << "                     time=T: flush at most T us after an event (default 1000)" << endl;
+    cout << "                     idle: flush when no event is ready" << endl;
+    cout << "    -w: aggregate queue and PG watermarks in orchagent instead of counters DB plugins" << endl;
+    cout << "    -p: detect PFC storms in orchagent instead of counters DB plugins" << endl;
 }
 
 void sighup_handler(int signo)
@@ -80,6 +109,28 @@ void sighup_handler(int signo)
     }
 }
 
+/*
+ * Write out the queued swss.rec records before dying. Not async-signal-safe,
+ * but the process is about to abort anyway.
+ */
+void sigabrt_handler(int signo)
+{
+    gSwssRecorder.close();
+
+    signal(SIGABRT, SIG_DFL);
+    raise(SIGABRT);
+}
+
+static terminate_handler gDefaultTerminateHandler;
+
+void terminate_recorder()
+{
+    gSwssRecorder.recordMessage("terminated");
+    gSwssRecorder.close();
+
+    gDefaultTerminateHandler();
+}
+
 void syncd_apply_view()
 {
     SWSS_LOG_NOTICE("Notify syncd APPLY_VIEW");
@@ -112,12 +163,21 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    if (signal(SIGABRT, sigabrt_handler) == SIG_ERR)
+    {
+        SWSS_LOG_ERROR("failed to setup SIGABRT action");
+        exit(1);
+    }
+
+    gDefaultTerminateHandler = set_terminate(terminate_recorder);
+
     int opt;
     sai_status_t status;
 
     string record_location = ".";
+    SwssRecorderOptions record_options;
 
-    while ((opt = getopt(argc, argv, "b:m:r:d:h")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:d:s:k:tf:wph")) != -1)
     {
         switch (opt)
         {
@@ -127,6 +187,30 @@ int main(int argc, char **argv)
         case 'm':
             gMacAddress = MacAddress(optarg);
             break;
+        case 'k':
+            gMaxBulkSize = atoi(optarg);
+            if (gMaxBulkSize < 0)
+            {
+                usage();
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 't':
+            gMultiThreadedMode = true;
+            break;
+        case 'f':
+            if (!FlushPolicy::parse(optarg, gFlushPolicy))
+            {
+                usage();
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'w':
+            gWatermarkAggregation = true;
+            break;
+        case 'p':
+            gPfcWdNativeDetect = true;
+            break;
         case 'r':
             if (!strcmp(optarg, "0"))
             {
@@ -159,6 +243,13 @@ int main(int argc, char **argv)
                 exit(EXIT_FAILURE);
             }
             break;
+        case 's':
+            if (!SwssRecorder::parseOptions(optarg, record_options))
+            {
+                usage();
+                exit(EXIT_FAILURE);
+            }
+            break;
         case 'h':
             usage();
             exit(EXIT_SUCCESS);
@@ -186,14 +277,13 @@ int main(int argc, char **argv)
     /* Disable/enable SwSS recording */
     if (gSwssRecord)
     {
-        gRecordFile = record_location + "/" + "swss.rec";
-        gRecordOfs.open(gRecordFile, std::ofstream::out | std::ofstream::app);
-        if (!gRecordOfs.is_open())
+        string record_file = SwssRecorder::getFileName(record_location, record_options);
+        if (!gSwssRecorder.open(record_file, record_options))
         {
-            SWSS_LOG_ERROR("Failed to open SwSS recording file %s", gRecordFile.c_str());
+            SWSS_LOG_ERROR("Failed to open SwSS recording file %s", record_file.c_str());
             exit(EXIT_FAILURE);
         }
-        gRecordOfs << getTimestamp() << "|recording started" << endl;
+        gSwssRecorder.recordMessage("recording started");
     }
 
     attr.id = SAI_SWITCH_ATTR_PORT_STATE_CHANGE_NOTIFY;
@@ -298,11 +388,15 @@ int main(int argc, char **argv)
     catch (char const *e)
     {
         SWSS_LOG_ERROR("Exception: %s", e);
+        gSwssRecorder.recordMessage(string("exception: ") + e);
     }
     catch (exception& e)
     {
         SWSS_LOG_ERROR("Failed due to exception: %s", e.what());
+        gSwssRecorder.recordMessage(string("exception: ") + e.what());
     }
 
+    gSwssRecorder.close();
+
     return 0;
 }
@@ -98,6 +98,12 @@ void MirrorOrch::update(SubjectType type, void *cntx)
         updateFdb(*update);
         break;
     }
+    case SUBJECT_TYPE_FDB_BATCH_CHANGE:
+    {
+        FdbBatchUpdate *batch = static_cast<FdbBatchUpdate *>(cntx);
+        updateFdbBatch(*batch);
+        break;
+    }
     case SUBJECT_TYPE_LAG_MEMBER_CHANGE:
     {
         LagMemberUpdate *update = static_cast<LagMemberUpdate *>(cntx);
@@ -786,6 +792,36 @@ void MirrorOrch::updateNeighbor(const NeighborUpdate& update)
     }
 }
 
+// The function is called when SUBJECT_TYPE_FDB_BATCH_CHANGE is received.
+// Only the updates of the FDB entries the sessions point to are applied.
+void MirrorOrch::updateFdbBatch(const FdbBatchUpdate& batch)
+{
+    SWSS_LOG_ENTER();
+
+    set<FdbEntry> monitored;
+    for (const auto& it : m_syncdMirrors)
+    {
+        const auto& session = it.second;
+        if (session.neighborInfo.port.m_type == Port::VLAN)
+        {
+            monitored.insert({session.neighborInfo.mac, session.neighborInfo.port.m_vlan_info.vlan_oid});
+        }
+    }
+
+    if (monitored.empty())
+    {
+        return;
+    }
+
+    for (const auto& update : batch.updates)
+    {
+        if (monitored.find(update.entry) != monitored.end())
+        {
+            updateFdb(update);
+        }
+    }
+}
+
 // The function is called when SUBJECT_TYPE_FDB_CHANGE is received.
 // This function will handle the case when new FDB enty is learned/added in the VLAN,
 // or when the old FDB entry gets removed. Only when the neighbor is VLAN will the case
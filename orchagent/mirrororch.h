@@ -104,6 +104,7 @@ private:
     void updateNextHop(const NextHopUpdate&);
     void updateNeighbor(const NeighborUpdate&);
     void updateFdb(const FdbUpdate&);
+    void updateFdbBatch(const FdbBatchUpdate&);
     void updateLagMember(const LagMemberUpdate&);
     void updateVlanMember(const VlanMemberUpdate&);
 
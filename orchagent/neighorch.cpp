@@ -98,6 +98,8 @@ bool NeighOrch::addNextHop(IpAddress ipAddress, string alias)
                 ipAddress.to_string().c_str(), alias.c_str());
         }
     }
+
+    notifyObjectReady(OBJECT_TYPE_NEXTHOP, ipAddress.to_string());
     return true;
 }
 
@@ -308,6 +310,7 @@ void NeighOrch::doTask(Consumer &consumer)
         if (!gPortsOrch->getPort(alias, p))
         {
             SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
+            consumer.waitFor(key, OBJECT_TYPE_PORT, alias);
             it++;
             continue;
         }
@@ -315,6 +318,7 @@ void NeighOrch::doTask(Consumer &consumer)
         if (!p.m_rif_id)
         {
             SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
+            consumer.waitFor(key, OBJECT_TYPE_ROUTER_INTF, alias);
             it++;
             continue;
         }
@@ -0,0 +1,111 @@
+#include <assert.h>
+#include "nexthopgroup.h"
+
+#define FNV_OFFSET_BASIS_64     0xcbf29ce484222325ULL
+#define FNV_PRIME_64            0x100000001b3ULL
+
+uint64_t hashNextHops(const IpAddresses &nexthops)
+{
+    uint64_t hash = FNV_OFFSET_BASIS_64;
+
+    for (const auto &nexthop : nexthops.getIpAddresses())
+    {
+        ip_addr_t ip = nexthop.getIp();
+
+        const uint8_t *bytes;
+        size_t len;
+        if (ip.family == AF_INET)
+        {
+            bytes = reinterpret_cast<const uint8_t *>(&ip.ip_addr.ipv4_addr);
+            len = sizeof(ip.ip_addr.ipv4_addr);
+        }
+        else
+        {
+            bytes = ip.ip_addr.ipv6_addr;
+            len = sizeof(ip.ip_addr.ipv6_addr);
+        }
+
+        hash = (hash ^ ip.family) * FNV_PRIME_64;
+        for (size_t i = 0; i < len; i++)
+        {
+            hash = (hash ^ bytes[i]) * FNV_PRIME_64;
+        }
+    }
+
+    return hash;
+}
+
+NextHopGroupHandle NextHopGroupTable::find(const IpAddresses &nexthops)
+{
+    auto it = m_groups.find(nexthops);
+    if (it == m_groups.end())
+    {
+        return NextHopGroupHandle();
+    }
+
+    return NextHopGroupHandle(&*it);
+}
+
+bool NextHopGroupTable::contains(const IpAddresses &nexthops) const
+{
+    return m_groups.find(nexthops) != m_groups.end();
+}
+
+int NextHopGroupTable::refCount(const IpAddresses &nexthops) const
+{
+    auto it = m_groups.find(nexthops);
+    return it != m_groups.end() ? it->second.ref_count : 0;
+}
+
+NextHopGroupHandle NextHopGroupTable::insert(const IpAddresses &nexthops, const NextHopGroupEntry &entry)
+{
+    auto res = m_groups.emplace(nexthops, entry);
+    assert(res.second);
+
+    Node *node = &*res.first;
+    for (const auto &nexthop : nexthops.getIpAddresses())
+    {
+        m_memberIndex[nexthop].insert(node);
+    }
+
+    return NextHopGroupHandle(node);
+}
+
+void NextHopGroupTable::erase(NextHopGroupHandle handle)
+{
+    assert(handle.valid());
+
+    /* Look the node up rather than erase by key, the key lives in the node */
+    auto it = m_groups.find(handle.nexthops());
+    assert(it != m_groups.end());
+
+    for (const auto &nexthop : it->first.getIpAddresses())
+    {
+        auto groups = m_memberIndex.find(nexthop);
+        assert(groups != m_memberIndex.end());
+
+        groups->second.erase(handle.m_node);
+        if (groups->second.empty())
+        {
+            m_memberIndex.erase(groups);
+        }
+    }
+
+    m_groups.erase(it);
+}
+
+vector<NextHopGroupHandle> NextHopGroupTable::groupsWith(const IpAddress &nexthop) const
+{
+    vector<NextHopGroupHandle> handles;
+
+    auto groups = m_memberIndex.find(nexthop);
+    if (groups != m_memberIndex.end())
+    {
+        for (auto node : groups->second)
+        {
+            handles.push_back(NextHopGroupHandle(node));
+        }
+    }
+
+    return handles;
+}
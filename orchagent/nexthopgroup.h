@@ -0,0 +1,120 @@
+#ifndef SWSS_NEXTHOPGROUP_H
+#define SWSS_NEXTHOPGROUP_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ipaddress.h"
+#include "ipaddresses.h"
+
+using namespace std;
+using namespace swss;
+
+typedef std::map<IpAddress, sai_object_id_t> NextHopGroupMembers;
+
+struct NextHopGroupEntry
+{
+    sai_object_id_t         next_hop_group_id;      // next hop group id
+    int                     ref_count;              // reference count
+    NextHopGroupMembers     nhopgroup_members;      // ids of members indexed by ip address
+};
+
+/* 64-bit FNV-1a hash of the member addresses, taken in their sorted order */
+uint64_t hashNextHops(const IpAddresses &nexthops);
+
+struct NextHopsHash
+{
+    size_t operator()(const IpAddresses &nexthops) const
+    {
+        return (size_t)hashNextHops(nexthops);
+    }
+};
+
+/*
+ * NextHopGroupHandle: reference to a next hop group of a NextHopGroupTable.
+ *
+ * A handle stays valid until its group is erased from the table, whatever
+ * the other insertions and erasures. It gives access to the member set and
+ * the group entry without looking the member set up again. The reference
+ * count of the routes and rules using the group is kept in the entry itself.
+ */
+class NextHopGroupHandle
+{
+public:
+    NextHopGroupHandle() : m_node(NULL) {}
+
+    bool valid() const { return m_node != NULL; }
+
+    const IpAddresses &nexthops() const { return m_node->first; }
+    NextHopGroupEntry &entry() const { return m_node->second; }
+    sai_object_id_t id() const { return m_node->second.next_hop_group_id; }
+
+    int refCount() const { return m_node->second.ref_count; }
+    int ref() const { return ++m_node->second.ref_count; }
+    int unref() const { return --m_node->second.ref_count; }
+
+    bool operator==(const NextHopGroupHandle &o) const { return m_node == o.m_node; }
+    bool operator!=(const NextHopGroupHandle &o) const { return m_node != o.m_node; }
+
+private:
+    friend class NextHopGroupTable;
+
+    typedef pair<const IpAddresses, NextHopGroupEntry> Node;
+
+    explicit NextHopGroupHandle(Node *node) : m_node(node) {}
+
+    Node *m_node;
+};
+
+/*
+ * NextHopGroupTable: next hop group IP addresses, NextHopGroupEntry
+ *
+ * Groups are interned by member set in a hash table keyed by hashNextHops(),
+ * so a lookup hashes the set once and only compares member sets on a hash
+ * match. A reverse index from each next hop to the groups it is a member of
+ * lets next hop state changes only visit the groups concerned.
+ */
+class NextHopGroupTable
+{
+    typedef unordered_map<IpAddresses, NextHopGroupEntry, NextHopsHash> GroupMap;
+    typedef GroupMap::value_type Node;
+
+public:
+    typedef GroupMap::iterator iterator;
+    typedef GroupMap::const_iterator const_iterator;
+
+    iterator begin() { return m_groups.begin(); }
+    iterator end() { return m_groups.end(); }
+    const_iterator begin() const { return m_groups.begin(); }
+    const_iterator end() const { return m_groups.end(); }
+
+    size_t size() const { return m_groups.size(); }
+    bool empty() const { return m_groups.empty(); }
+
+    /* Returns an invalid handle if there is no group with these members */
+    NextHopGroupHandle find(const IpAddresses &nexthops);
+    bool contains(const IpAddresses &nexthops) const;
+
+    /* Reference count of the group, 0 if there is no group with these members */
+    int refCount(const IpAddresses &nexthops) const;
+
+    /* Insert a new group, the members must not be in the table yet */
+    NextHopGroupHandle insert(const IpAddresses &nexthops, const NextHopGroupEntry &entry);
+    void erase(NextHopGroupHandle handle);
+
+    /* Groups having the next hop among their members */
+    vector<NextHopGroupHandle> groupsWith(const IpAddress &nexthop) const;
+
+private:
+    GroupMap m_groups;
+    map<IpAddress, set<Node *>> m_memberIndex;
+};
+
+#endif /* SWSS_NEXTHOPGROUP_H */
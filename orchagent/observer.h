@@ -16,6 +16,7 @@ enum SubjectType
     SUBJECT_TYPE_MIRROR_SESSION_CHANGE,
     SUBJECT_TYPE_INT_SESSION_CHANGE,
     SUBJECT_TYPE_PORT_CHANGE,
+    SUBJECT_TYPE_FDB_BATCH_CHANGE,
 };
 
 class Observer
@@ -1,7 +1,8 @@
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <sys/time.h>
-#include "timestamp.h"
 #include "orch.h"
 
 #include "subscriberstatetable.h"
@@ -9,15 +10,147 @@
 #include "tokenize.h"
 #include "logger.h"
 #include "consumerstatetable.h"
+#include "swssrecorder.h"
 
 using namespace swss;
 
 extern int gBatchSize;
 
 extern bool gSwssRecord;
-extern ofstream gRecordOfs;
 extern bool gLogRotate;
-extern string gRecordFile;
+extern SwssRecorder gSwssRecorder;
+
+/* Parked consumers are still drained at this interval, as a safety net */
+#define PARKED_RETRY_INTERVAL_MSEC 1000
+
+/* Parked consumers indexed by the object they wait for, "type:name" */
+static mutex gParkedMutex;
+static map<string, set<Consumer *>> gParkedConsumers;
+
+static atomic<uint64_t> gRetryScans(0);
+static atomic<uint64_t> gSkippedRetryScans(0);
+static atomic<uint64_t> gSkippedRetryTasks(0);
+
+/* Consumers by table name, with the batch configuration set for the table */
+static mutex gConsumersMutex;
+static map<string, set<Consumer *>> gConsumers;
+static map<string, ConsumerBatchConfig> gBatchConfigs;
+
+/* Latency sensitive consumers with tasks pending */
+static atomic<int> gLatencySensitivePending(0);
+
+/* Batching of the tables without configuration: a single pop batch per execution */
+static const ConsumerBatchConfig gSingleBatchConfig = { 0, 0, false };
+
+Consumer::Consumer(ConsumerTableBase *select, Orch *orch, const string &name) :
+        Executor(select, orch, name),
+        m_parked(false),
+        m_maxBatchRounds(1),
+        m_batchBudget(0),
+        m_latencySensitive(false),
+        m_latencySensitivePending(false)
+{
+    lock_guard<mutex> lock(gConsumersMutex);
+
+    auto config = gBatchConfigs.find(name);
+    applyBatchConfig(config != gBatchConfigs.end() ? config->second : gSingleBatchConfig);
+    gConsumers[name].insert(this);
+}
+
+Consumer::~Consumer()
+{
+    unpark();
+
+    if (m_latencySensitivePending)
+    {
+        gLatencySensitivePending--;
+    }
+
+    lock_guard<mutex> lock(gConsumersMutex);
+
+    auto consumers = gConsumers.find(getName());
+    if (consumers != gConsumers.end())
+    {
+        consumers->second.erase(this);
+        if (consumers->second.empty())
+        {
+            gConsumers.erase(consumers);
+        }
+    }
+}
+
+/* Batching of a table configured in CONSUMER_BATCH, before its fields are applied */
+ConsumerBatchConfig Consumer::getDefaultBatchConfig(const string &tableName)
+{
+    ConsumerBatchConfig config;
+
+    config.maxBatchSize = DEFAULT_CONSUMER_MAX_BATCH_SIZE;
+    config.budget = DEFAULT_CONSUMER_BATCH_BUDGET_USEC;
+    config.latencySensitive = tableName == APP_PORT_TABLE_NAME || tableName == APP_NEIGH_TABLE_NAME;
+
+    return config;
+}
+
+void Consumer::setBatchConfig(const string &tableName, const ConsumerBatchConfig &config)
+{
+    SWSS_LOG_ENTER();
+
+    lock_guard<mutex> lock(gConsumersMutex);
+
+    gBatchConfigs[tableName] = config;
+
+    auto consumers = gConsumers.find(tableName);
+    if (consumers == gConsumers.end())
+    {
+        return;
+    }
+
+    for (Consumer *consumer : consumers->second)
+    {
+        consumer->applyBatchConfig(config);
+    }
+}
+
+void Consumer::resetBatchConfig(const string &tableName)
+{
+    SWSS_LOG_ENTER();
+
+    setBatchConfig(tableName, gSingleBatchConfig);
+
+    lock_guard<mutex> lock(gConsumersMutex);
+    gBatchConfigs.erase(tableName);
+}
+
+void Consumer::applyBatchConfig(const ConsumerBatchConfig &config)
+{
+    m_maxBatchRounds = max<size_t>(config.maxBatchSize / getPopBatchSize(), 1);
+    m_batchBudget = config.budget;
+    m_latencySensitive = config.latencySensitive;
+}
+
+size_t Consumer::getPopBatchSize() const
+{
+    return getConsumerTable()->POP_BATCH_SIZE > 0 ? (size_t)getConsumerTable()->POP_BATCH_SIZE : 1;
+}
+
+size_t Consumer::getBatchSize() const
+{
+    return m_batchRounds.get() * getPopBatchSize();
+}
+
+void Consumer::getBatchSizes(map<string, size_t> &batchSizes)
+{
+    lock_guard<mutex> lock(gConsumersMutex);
+
+    for (const auto &it : gConsumers)
+    {
+        size_t &batch_size = batchSizes[it.first];
+        for (const Consumer *consumer : it.second)
+        {
+            batch_size = max(batch_size, consumer->getBatchSize());
+        }
+    }
+}
 
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
@@ -50,10 +183,6 @@ Orch::Orch(const vector<TableConnector>& tables)
 
 Orch::~Orch()
 {
-    if (gRecordOfs.is_open())
-    {
-        gRecordOfs.close();
-    }
 }
 
 vector<Selectable *> Orch::getSelectables()
@@ -76,49 +205,18 @@ size_t Consumer::addToSync(std::deque<KeyOpFieldsValuesTuple> &entries)
         return 0;
     }
 
+    /* New tasks may not wait for anything */
+    unpark();
+
     for (auto& entry: entries)
     {
-        string key = kfvKey(entry);
-        string op  = kfvOp(entry);
-
         /* Record incoming tasks */
         if (gSwssRecord)
         {
             Orch::recordTuple(*this, entry);
         }
 
-        /* If a new task comes or if a DEL task comes, we directly put it into getConsumerTable().m_toSync map */
-        if (m_toSync.find(key) == m_toSync.end() || op == DEL_COMMAND)
-        {
-           m_toSync[key] = entry;
-        }
-        /* If an old task is still there, we combine the old task with new task */
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = m_toSync[key];
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
-
-
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
-
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
-            }
-            m_toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
-        }
+        mergeToSync(m_toSync, std::move(entry));
     }
     return entries.size();
 }
@@ -167,22 +265,163 @@ size_t Consumer::refillToSync()
     }
 }
 
+/*
+ * Pop up to m_batchRounds batches while there is a backlog, within the time
+ * budget of the table, so that a table download is processed in a few large
+ * batches rather than in one doTask() per batch. The time spent in doTask()
+ * counts in the budget.
+ */
 void Consumer::execute()
 {
     SWSS_LOG_ENTER();
 
-    std::deque<KeyOpFieldsValuesTuple> entries;
-    getConsumerTable()->pops(entries);
+    auto start = chrono::steady_clock::now();
+    uint64_t budget = m_batchBudget;
+    uint64_t pop_time;
+    size_t rounds = 0;
+    bool backlog;
+
+    do
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        getConsumerTable()->pops(entries);
 
-    addToSync(entries);
+        backlog = entries.size() >= getPopBatchSize();
+        addToSync(entries);
+        rounds++;
+
+        pop_time = (uint64_t)chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    }
+    while (backlog && m_batchRounds.canPop(rounds, pop_time, budget));
 
     drain();
+
+    uint64_t task_time = (uint64_t)chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() - pop_time;
+    bool yield = !m_latencySensitive && gLatencySensitivePending > 0;
+    size_t batch_rounds = m_batchRounds.get();
+
+    m_batchRounds.adapt(rounds, backlog, pop_time, task_time, budget, m_maxBatchRounds, yield);
+
+    if (m_batchRounds.get() != batch_rounds)
+    {
+        SWSS_LOG_DEBUG("%s pops %zu batches per execution", getName().c_str(), m_batchRounds.get());
+    }
+}
+
+void Consumer::updateLatencySensitivePending()
+{
+    bool pending = m_latencySensitive && !m_toSync.empty() && !m_parked;
+    if (pending == m_latencySensitivePending)
+    {
+        return;
+    }
+
+    m_latencySensitivePending = pending;
+    if (pending)
+    {
+        gLatencySensitivePending++;
+    }
+    else
+    {
+        gLatencySensitivePending--;
+    }
 }
 
 void Consumer::drain()
 {
-    if (!m_toSync.empty())
+    if (!m_toSync.empty() && !skipParked())
+    {
+        gRetryScans++;
+
+        m_waitingTasks.clear();
         m_orch->doTask(*this);
+
+        parkIfBlocked();
+    }
+
+    updateLatencySensitivePending();
+}
+
+bool Consumer::skipParked()
+{
+    if (!m_parked)
+    {
+        return false;
+    }
+
+    if (chrono::steady_clock::now() - m_parkedSince < chrono::milliseconds(PARKED_RETRY_INTERVAL_MSEC))
+    {
+        gSkippedRetryScans++;
+        gSkippedRetryTasks += m_toSync.size();
+        return true;
+    }
+
+    unpark();
+    return false;
+}
+
+void Consumer::waitFor(const string &key, const string &objectType, const string &objectName)
+{
+    m_waitingTasks[key] = objectType + delimiter + objectName;
+}
+
+void Consumer::parkIfBlocked()
+{
+    if (m_toSync.empty() || m_waitingTasks.size() < m_toSync.size())
+    {
+        return;
+    }
+
+    for (const auto &task : m_toSync)
+    {
+        if (m_waitingTasks.find(task.first) == m_waitingTasks.end())
+        {
+            return;
+        }
+    }
+
+    lock_guard<mutex> lock(gParkedMutex);
+
+    for (const auto &task : m_waitingTasks)
+    {
+        gParkedConsumers[task.second].insert(this);
+    }
+
+    m_parkedSince = chrono::steady_clock::now();
+    m_parked = true;
+
+    SWSS_LOG_INFO("Parked %zu tasks of %s", m_toSync.size(), getName().c_str());
+}
+
+void Consumer::unpark()
+{
+    if (!m_parked)
+    {
+        return;
+    }
+
+    lock_guard<mutex> lock(gParkedMutex);
+    unparkLocked();
+}
+
+void Consumer::unparkLocked()
+{
+    for (const auto &task : m_waitingTasks)
+    {
+        auto consumers = gParkedConsumers.find(task.second);
+        if (consumers == gParkedConsumers.end())
+        {
+            continue;
+        }
+
+        consumers->second.erase(this);
+        if (consumers->second.empty())
+        {
+            gParkedConsumers.erase(consumers);
+        }
+    }
+
+    m_parked = false;
 }
 
 string Consumer::dumpTuple(KeyOpFieldsValuesTuple &tuple)
@@ -387,28 +626,19 @@ void Orch::dumpPendingTasks(vector<string> &ts)
 
 void Orch::logfileReopen()
 {
-    gRecordOfs.close();
-
     /*
      * On log rotate we will use the same file name, we are assuming that
-     * logrotate deamon move filename to filename.1 and we will create new
-     * empty file here.
+     * logrotate deamon move filename to filename.1 and the recorder thread
+     * will create new empty file.
      */
-
-    gRecordOfs.open(gRecordFile);
-
-    if (!gRecordOfs.is_open())
-    {
-        SWSS_LOG_ERROR("failed to open gRecordOfs file %s: %s", gRecordFile.c_str(), strerror(errno));
-        return;
-    }
+    gSwssRecorder.reopen();
 }
 
 void Orch::recordTuple(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
-    string s = consumer.dumpTuple(tuple);
-
-    gRecordOfs << getTimestamp() << "|" << s << endl;
+    /* Only queued here, formatted and written by the recorder thread */
+    gSwssRecorder.record(consumer.getTableName(), consumer.getConsumerTable()->getTableNameSeparator(),
+                         kfvKey(tuple), kfvOp(tuple), kfvFieldsValues(tuple));
 
     if (gLogRotate)
     {
@@ -418,6 +648,34 @@ void Orch::recordTuple(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
     }
 }
 
+void Orch::notifyObjectReady(const string &objectType, const string &objectName)
+{
+    lock_guard<mutex> lock(gParkedMutex);
+
+    auto consumers = gParkedConsumers.find(objectType + delimiter + objectName);
+    if (consumers == gParkedConsumers.end())
+    {
+        return;
+    }
+
+    auto waking = consumers->second;
+    gParkedConsumers.erase(consumers);
+
+    for (Consumer *consumer : waking)
+    {
+        SWSS_LOG_INFO("Object %s:%s ready, unparking %s", objectType.c_str(),
+                      objectName.c_str(), consumer->getName().c_str());
+        consumer->unparkLocked();
+    }
+}
+
+void Orch::getRetryStats(uint64_t &scans, uint64_t &skippedScans, uint64_t &skippedTasks)
+{
+    scans = gRetryScans;
+    skippedScans = gSkippedRetryScans;
+    skippedTasks = gSkippedRetryTasks;
+}
+
 string Orch::dumpTuple(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
 {
     string s = consumer.dumpTuple(tuple);
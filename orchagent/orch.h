@@ -6,6 +6,8 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <atomic>
+#include <chrono>
 
 extern "C" {
 #include "sai.h"
@@ -19,6 +21,8 @@ extern "C" {
 #include "notificationconsumer.h"
 #include "selectabletimer.h"
 #include "macaddress.h"
+#include "syncmap.h"
+#include "batchrounds.h"
 
 using namespace std;
 using namespace swss;
@@ -57,7 +61,6 @@ typedef pair<string, sai_object_id_t> object_map_pair;
 
 typedef map<string, object_map*> type_map;
 typedef pair<string, object_map*> type_map_pair;
-typedef map<string, KeyOpFieldsValuesTuple> SyncMap;
 
 typedef pair<string, int> table_name_with_pri_t;
 
@@ -110,12 +113,33 @@ protected:
     Selectable *getSelectable() const { return m_selectable; }
 };
 
+/*
+ * Types of the objects consumer tasks can wait for, see Consumer::waitFor().
+ * Objects referenced through a type_map use their table name as type.
+ */
+#define OBJECT_TYPE_PORT            "PORT"
+#define OBJECT_TYPE_ROUTER_INTF     "ROUTER_INTF"
+#define OBJECT_TYPE_NEXTHOP         "NEXTHOP"
+#define OBJECT_TYPE_VRF             "VRF"
+
+#define DEFAULT_CONSUMER_MAX_BATCH_SIZE     8192
+#define DEFAULT_CONSUMER_BATCH_BUDGET_USEC  50000
+
+/*
+ * Pop batching of the consumers of a table, see Consumer::execute(). Tables
+ * without CONSUMER_BATCH configuration pop a single batch per execution.
+ */
+struct ConsumerBatchConfig
+{
+    size_t      maxBatchSize;       // entries popped per execution at most
+    uint64_t    budget;             // us spent popping and in doTask() per execution at most
+    bool        latencySensitive;   // the other tables yield while it has pending tasks
+};
+
 class Consumer : public Executor {
 public:
-    Consumer(ConsumerTableBase *select, Orch *orch, const string &name)
-        : Executor(select, orch, name)
-    {
-    }
+    Consumer(ConsumerTableBase *select, Orch *orch, const string &name);
+    ~Consumer();
 
     ConsumerTableBase *getConsumerTable() const
     {
@@ -140,6 +164,25 @@ public:
     void execute();
     void drain();
 
+    /*
+     * Called by doTask() when leaving a task for retry because an object it
+     * needs does not exist yet. Once every task left in m_toSync waits for
+     * an object, the consumer is parked: drain() skips it until one of these
+     * objects is notified ready through Orch::notifyObjectReady(), new tasks
+     * come in, or the parked retry interval elapses.
+     */
+    void waitFor(const string &key, const string &objectType, const string &objectName);
+    void unpark();
+
+    /* Apply to the current and future consumers of the table */
+    static void setBatchConfig(const string &tableName, const ConsumerBatchConfig &config);
+    static void resetBatchConfig(const string &tableName);
+    static ConsumerBatchConfig getDefaultBatchConfig(const string &tableName);
+
+    size_t getBatchSize() const;
+    /* Current batch size by table, the largest one of its consumers */
+    static void getBatchSizes(map<string, size_t> &batchSizes);
+
     /* Store the latest 'golden' status */
     // TODO: hide?
     SyncMap m_toSync;
@@ -147,6 +190,30 @@ public:
 protected:
     // Returns: the number of entries added to m_toSync
     size_t addToSync(std::deque<KeyOpFieldsValuesTuple> &entries);
+
+private:
+    /* Tasks left for retry by the last doTask(), with the object they wait for */
+    map<string, string> m_waitingTasks;
+    /* Set from the thread of the producer in multi-threaded mode */
+    std::atomic<bool> m_parked;
+    std::chrono::steady_clock::time_point m_parkedSince;
+
+    /* Batches popped per execution, adapted to the backlog */
+    BatchRounds m_batchRounds;
+    /* Set from the thread of the config consumer in multi-threaded mode */
+    std::atomic<size_t> m_maxBatchRounds;
+    std::atomic<uint64_t> m_batchBudget;
+    std::atomic<bool> m_latencySensitive;
+    bool m_latencySensitivePending;
+
+    bool skipParked();
+    void parkIfBlocked();
+    void unparkLocked();
+    size_t getPopBatchSize() const;
+    void applyBatchConfig(const ConsumerBatchConfig &config);
+    void updateLatencySensitivePending();
+
+    friend class Orch;
 };
 
 typedef map<string, std::shared_ptr<Executor>> ConsumerMap;
@@ -194,6 +261,11 @@ public:
     /* TODO: refactor recording */
     static void recordTuple(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
 
+    /* Wake up the consumers parked on the object, called by its producer */
+    static void notifyObjectReady(const string &objectType, const string &objectName);
+    /* Drains done, and drains and task visits skipped on parked consumers */
+    static void getRetryStats(uint64_t &scans, uint64_t &skippedScans, uint64_t &skippedTasks);
+
     void dumpPendingTasks(vector<string> &ts);
 protected:
     ConsumerMap m_consumerMap;
@@ -16,9 +16,19 @@ using namespace swss;
 #define SELECT_TIMEOUT 1000
 #define PFC_WD_POLL_MSECS 100
 
+/* Interval between two publications of the retry and flush statistics */
+#define STATS_PUBLISH_INTERVAL_SEC 10
+
+#define ORCH_RETRY_STATS_TABLE "ORCH_RETRY_STATS"
+#define ORCH_FLUSH_STATS_TABLE "ORCH_FLUSH_STATS"
+#define ORCH_BATCH_STATS_TABLE "ORCH_BATCH_STATS"
+
 extern sai_switch_api_t*           sai_switch_api;
 extern sai_object_id_t             gSwitchId;
 
+extern bool gMultiThreadedMode;
+extern FlushPolicyConfig gFlushPolicy;
+
 extern void syncd_apply_view();
 /*
  * Global orch daemon variables
@@ -32,12 +42,19 @@ AclOrch *gAclOrch;
 CrmOrch *gCrmOrch;
 BufferOrch *gBufferOrch;
 SwitchOrch *gSwitchOrch;
+FlexCounterOrch *gFlexCounterOrch;
 Directory<Orch*> gDirectory;
 
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb) :
         m_applDb(applDb),
         m_configDb(configDb),
-        m_stateDb(stateDb)
+        m_stateDb(stateDb),
+        m_scheduler(NULL),
+        m_flushPolicy(NULL),
+        m_countersDb(NULL),
+        m_retryStatsTable(NULL),
+        m_flushStatsTable(NULL),
+        m_batchStatsTable(NULL)
 {
     SWSS_LOG_ENTER();
 }
@@ -45,8 +62,32 @@ OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *
 OrchDaemon::~OrchDaemon()
 {
     SWSS_LOG_ENTER();
+    delete m_scheduler;
     for (Orch *o : m_orchList)
         delete(o);
+    for (DBConnector *db : m_domainDbs)
+        delete db;
+    delete m_flushPolicy;
+    delete m_batchStatsTable;
+    delete m_flushStatsTable;
+    delete m_retryStatsTable;
+    delete m_countersDb;
+}
+
+/*
+ * In multi-threaded mode, orchs running off the main execution domain get
+ * their own connector, a DBConnector must not be used by two threads.
+ */
+DBConnector *OrchDaemon::getDomainDb(DBConnector *db)
+{
+    if (!gMultiThreadedMode)
+    {
+        return db;
+    }
+
+    DBConnector *domain_db = new DBConnector(db->getDbId(), DBConnector::DEFAULT_UNIXSOCKET, 0);
+    m_domainDbs.push_back(domain_db);
+    return domain_db;
 }
 
 bool OrchDaemon::init()
@@ -67,10 +108,10 @@ bool OrchDaemon::init()
         { APP_LAG_MEMBER_TABLE_NAME,  portsorch_base_pri     }
     };
 
-    gCrmOrch = new CrmOrch(m_configDb, CFG_CRM_TABLE_NAME);
+    gCrmOrch = new CrmOrch(getDomainDb(m_configDb), CFG_CRM_TABLE_NAME);
     gPortsOrch = new PortsOrch(m_applDb, ports_tables);
-    TableConnector applDbFdb(m_applDb, APP_FDB_TABLE_NAME);
-    TableConnector stateDbFdb(m_stateDb, STATE_FDB_TABLE_NAME);
+    TableConnector applDbFdb(getDomainDb(m_applDb), APP_FDB_TABLE_NAME);
+    TableConnector stateDbFdb(getDomainDb(m_stateDb), STATE_FDB_TABLE_NAME);
     gFdbOrch = new FdbOrch(applDbFdb, stateDbFdb, gPortsOrch);
 
     vector<string> vnet_tables = {
@@ -94,7 +135,7 @@ bool OrchDaemon::init()
 
     gIntfsOrch = new IntfsOrch(m_applDb, APP_INTF_TABLE_NAME, vrf_orch);
     gNeighOrch = new NeighOrch(m_applDb, APP_NEIGH_TABLE_NAME, gIntfsOrch);
-    gRouteOrch = new RouteOrch(m_applDb, APP_ROUTE_TABLE_NAME, gNeighOrch);
+    gRouteOrch = new RouteOrch(getDomainDb(m_applDb), APP_ROUTE_TABLE_NAME, gNeighOrch);
     CoppOrch  *copp_orch  = new CoppOrch(m_applDb, APP_COPP_TABLE_NAME);
     TunnelDecapOrch *tunnel_decap_orch = new TunnelDecapOrch(m_applDb, APP_TUNNEL_DECAP_TABLE_NAME);
 
@@ -132,8 +173,9 @@ bool OrchDaemon::init()
     TableConnector confDbMirrorSession(m_configDb, CFG_MIRROR_SESSION_TABLE_NAME);
     MirrorOrch *mirror_orch = new MirrorOrch(stateDbMirrorSession, confDbMirrorSession, gPortsOrch, gRouteOrch, gNeighOrch, gFdbOrch);
 
-    TableConnector confDbAclTable(m_configDb, CFG_ACL_TABLE_NAME);
-    TableConnector confDbAclRuleTable(m_configDb, CFG_ACL_RULE_TABLE_NAME);
+    DBConnector *acl_config_db = getDomainDb(m_configDb);
+    TableConnector confDbAclTable(acl_config_db, CFG_ACL_TABLE_NAME);
+    TableConnector confDbAclRuleTable(acl_config_db, CFG_ACL_RULE_TABLE_NAME);
 
     vector<TableConnector> acl_table_connectors = {
         confDbAclTable,
@@ -153,7 +195,7 @@ bool OrchDaemon::init()
         CFG_FLEX_COUNTER_TABLE_NAME
     };
 
-    WatermarkOrch *wm_orch = new WatermarkOrch(m_configDb, wm_tables);
+    WatermarkOrch *wm_orch = new WatermarkOrch(getDomainDb(m_configDb), wm_tables);
 
     /*
      * The order of the orch list is important for state restore of warm start and
@@ -196,7 +238,7 @@ bool OrchDaemon::init()
         dtel_orch = new DTelOrch(m_configDb, dtel_tables, gPortsOrch);
         m_orchList.push_back(dtel_orch);
     }
-    TableConnector stateDbSwitchTable(m_stateDb, "SWITCH_CAPABILITY");
+    TableConnector stateDbSwitchTable(getDomainDb(m_stateDb), "SWITCH_CAPABILITY");
     gAclOrch = new AclOrch(acl_table_connectors, stateDbSwitchTable, gPortsOrch, mirror_orch, gNeighOrch, gRouteOrch, dtel_orch);
 
     m_orchList.push_back(gFdbOrch);
@@ -215,11 +257,15 @@ bool OrchDaemon::init()
         CFG_FLEX_COUNTER_TABLE_NAME
     };
 
-    m_orchList.push_back(new FlexCounterOrch(m_configDb, flex_counter_tables));
+    gFlexCounterOrch = new FlexCounterOrch(m_configDb, flex_counter_tables);
+    m_orchList.push_back(gFlexCounterOrch);
+
+    m_orchList.push_back(new ConsumerBatchOrch(m_configDb, CFG_CONSUMER_BATCH_TABLE_NAME));
 
     vector<string> pfc_wd_tables = {
         CFG_PFC_WD_TABLE_NAME
     };
+    Orch *pfc_wd_orch = NULL;
 
     if (platform == MLNX_PLATFORM_SUBSTRING
         || platform == NPS_PLATFORM_SUBSTRING)
@@ -253,13 +299,14 @@ bool OrchDaemon::init()
 
         static const vector<sai_queue_attr_t> queueAttrIds;
 
-        m_orchList.push_back(new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
-                    m_configDb,
+        pfc_wd_orch = new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
+                    getDomainDb(m_configDb),
                     pfc_wd_tables,
                     portStatIds,
                     queueStatIds,
                     queueAttrIds,
-                    PFC_WD_POLL_MSECS));
+                    PFC_WD_POLL_MSECS);
+        m_orchList.push_back(pfc_wd_orch);
     }
     else if (platform == BRCM_PLATFORM_SUBSTRING)
     {
@@ -294,13 +341,14 @@ bool OrchDaemon::init()
             SAI_QUEUE_ATTR_PAUSE_STATUS,
         };
 
-        m_orchList.push_back(new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
-                    m_configDb,
+        pfc_wd_orch = new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
+                    getDomainDb(m_configDb),
                     pfc_wd_tables,
                     portStatIds,
                     queueStatIds,
                     queueAttrIds,
-                    PFC_WD_POLL_MSECS));
+                    PFC_WD_POLL_MSECS);
+        m_orchList.push_back(pfc_wd_orch);
     }
 
     m_orchList.push_back(&CounterCheckOrch::getInstance(m_configDb));
@@ -314,9 +362,91 @@ bool OrchDaemon::init()
         }
     }
 
+    if (gMultiThreadedMode)
+    {
+        initScheduler(wm_orch, pfc_wd_orch);
+    }
+
     return true;
 }
 
+/*
+ * Split the orchs in execution domains for multi-threaded mode.
+ *
+ * Orchs off the main domain declare the state of other domains they touch:
+ * - ports: port table and readiness, modified by the main domain, by ACL
+ *   table bindings and by PFC watchdog actions
+ * - nexthop: interfaces, neighbors and next hops, NeighOrch calls into
+ *   RouteOrch and ACL rules redirect to next hops and next hop groups
+ * - observers: MirrorOrch and AclOrch, notified of route, neighbor and FDB
+ *   changes
+ * - fdb: FDB entries, read by MirrorOrch
+ * - acl: ACL tables and rules, also programmed by the PFC watchdog
+ * The main domain holds all of them. CrmOrch protects its own counters and
+ * gDirectory is only read once the orchs are created.
+ */
+void OrchDaemon::initScheduler(WatermarkOrch *wm_orch, Orch *pfc_wd_orch)
+{
+    SWSS_LOG_ENTER();
+
+    m_scheduler = new OrchScheduler([this]() { flush(); });
+
+    map<Orch *, string> domains = {
+        { gRouteOrch,   "route" },
+        { gFdbOrch,     "fdb" },
+        { gAclOrch,     "acl" },
+        { gCrmOrch,     "crm" },
+        { wm_orch,      "watermark" }
+    };
+    if (pfc_wd_orch != NULL)
+    {
+        domains[pfc_wd_orch] = "pfcwd";
+    }
+
+    /* The main domain is the first one, it runs on the orchagent thread */
+    for (Orch *o : m_orchList)
+    {
+        if (domains.find(o) == domains.end())
+        {
+            m_scheduler->addOrch("main", o);
+        }
+    }
+    for (Orch *o : m_orchList)
+    {
+        auto it = domains.find(o);
+        if (it != domains.end())
+        {
+            m_scheduler->addOrch(it->second, o);
+        }
+    }
+
+    for (auto lock : { "ports", "nexthop", "observers", "fdb", "acl" })
+    {
+        m_scheduler->addDependency("main", lock);
+    }
+
+    m_scheduler->addDependency("route", "ports", true);
+    m_scheduler->addDependency("route", "nexthop");
+    m_scheduler->addDependency("route", "observers");
+
+    m_scheduler->addDependency("fdb", "ports", true);
+    m_scheduler->addDependency("fdb", "fdb");
+    m_scheduler->addDependency("fdb", "observers");
+
+    m_scheduler->addDependency("acl", "ports");
+    m_scheduler->addDependency("acl", "nexthop");
+    m_scheduler->addDependency("acl", "observers");
+    m_scheduler->addDependency("acl", "acl");
+
+    m_scheduler->addDependency("watermark", "ports", true);
+
+    if (pfc_wd_orch != NULL)
+    {
+        m_scheduler->addDependency("pfcwd", "ports");
+        m_scheduler->addDependency("pfcwd", "acl");
+    }
+}
+
 /* Flush redis through sairedis interface */
 void OrchDaemon::flush()
 {
@@ -336,17 +466,49 @@ void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
 
+    m_countersDb = new DBConnector(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+    m_retryStatsTable = new Table(m_countersDb, ORCH_RETRY_STATS_TABLE);
+    m_flushStatsTable = new Table(m_countersDb, ORCH_FLUSH_STATS_TABLE);
+    m_batchStatsTable = new Table(m_countersDb, ORCH_BATCH_STATS_TABLE);
+    m_lastStatsPublish = chrono::steady_clock::now();
+
+    if (m_scheduler != NULL)
+    {
+        m_scheduler->run([this]()
+        {
+            checkRestartReady();
+            publishStats();
+        });
+        return;
+    }
+
+    m_flushPolicy = new FlushPolicy([this]() { flush(); }, gFlushPolicy);
+
     for (Orch *o : m_orchList)
     {
         m_select->addSelectables(o->getSelectables());
     }
+    m_select->addSelectable(m_flushPolicy->getTimer());
 
     while (true)
     {
         Selectable *s;
-        int ret;
+        int ret = Select::TIMEOUT;
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        /* Flush as soon as no event is ready rather than before blocking on them */
+        if (m_flushPolicy->waitsForIdle())
+        {
+            ret = m_select->select(&s, 0);
+            if (ret == Select::TIMEOUT)
+            {
+                m_flushPolicy->onIdle();
+            }
+        }
+
+        if (ret == Select::TIMEOUT)
+        {
+            ret = m_select->select(&s, SELECT_TIMEOUT);
+        }
 
         if (ret == Select::ERROR)
         {
@@ -356,6 +518,14 @@ void OrchDaemon::start()
 
         if (ret == Select::TIMEOUT)
         {
+            m_flushPolicy->flush();
+            publishStats();
+            continue;
+        }
+
+        if (s == m_flushPolicy->getTimer())
+        {
+            m_flushPolicy->onTimer();
             continue;
         }
 
@@ -372,44 +542,105 @@ void OrchDaemon::start()
         /* Let sairedis to flush all SAI function call to ASIC DB.
          * Normally the redis pipeline will flush when enough request
          * accumulated. Still it is possible that small amount of
-         * requests live in it. When the daemon has finished events/tasks, it
-         * is a good chance to flush the pipeline before next select happened.
+         * requests live in it. The flush policy decides whether to flush
+         * after this event or to coalesce it with the next ones.
          */
-        flush();
+        m_flushPolicy->opDone();
 
-        /*
-         * Asked to check warm restart readiness.
-         * Not doing this under Select::TIMEOUT condition because of
-         * the existence of finer granularity ExecutableTimer with select
-         */
-        if (gSwitchOrch->checkRestartReady())
+        checkRestartReady();
+
+        publishStats();
+    }
+}
+
+/*
+ * Publish how many drains of the pending tasks were done, and how many were
+ * skipped because all the tasks of the consumer wait for objects which did
+ * not show up since the previous drain. Also publish the flush histograms
+ * and, in single threaded mode, the pop batch size of each table: the
+ * scheduler publishes it with its executor statistics otherwise.
+ */
+void OrchDaemon::publishStats()
+{
+    auto now = chrono::steady_clock::now();
+    if (now - m_lastStatsPublish < chrono::seconds(STATS_PUBLISH_INTERVAL_SEC))
+    {
+        return;
+    }
+    m_lastStatsPublish = now;
+
+    uint64_t scans, skipped_scans, skipped_tasks;
+    Orch::getRetryStats(scans, skipped_scans, skipped_tasks);
+
+    vector<FieldValueTuple> fvs = {
+        { "retry_scans", to_string(scans) },
+        { "skipped_retry_scans", to_string(skipped_scans) },
+        { "skipped_retry_tasks", to_string(skipped_tasks) }
+    };
+    m_retryStatsTable->set("orchagent", fvs);
+
+    if (m_flushPolicy != NULL)
+    {
+        fvs.clear();
+        m_flushPolicy->getStats(fvs);
+        m_flushStatsTable->set("orchagent", fvs);
+
+        map<string, size_t> batch_sizes;
+        Consumer::getBatchSizes(batch_sizes);
+        for (const auto &it : batch_sizes)
         {
-            bool ret = warmRestartCheck();
-            if (ret)
+            m_batchStatsTable->set(it.first, { { "batch_size", to_string(it.second) } });
+        }
+    }
+}
+
+/*
+ * Asked to check warm restart readiness.
+ * Not doing this under Select::TIMEOUT condition because of
+ * the existence of finer granularity ExecutableTimer with select
+ */
+void OrchDaemon::checkRestartReady()
+{
+    if (!gSwitchOrch->checkRestartReady())
+    {
+        return;
+    }
+
+    /* Keep the other execution domains still while checking their tasks */
+    if (m_scheduler != NULL)
+    {
+        m_scheduler->pause();
+    }
+
+    bool ret = warmRestartCheck();
+    if (ret)
+    {
+        // Orchagent is ready to perform warm restart, stop processing any new db data.
+        // Should sleep here or continue handling timers and etc.??
+        if (!gSwitchOrch->checkRestartNoFreeze())
+        {
+            // Disable FDB aging
+            gSwitchOrch->setAgingFDB(0);
+
+            // Disable FDB learning on all bridge ports
+            for (const auto& pair: gPortsOrch->getAllPorts())
             {
-                // Orchagent is ready to perform warm restart, stop processing any new db data.
-                // Should sleep here or continue handling timers and etc.??
-                if (!gSwitchOrch->checkRestartNoFreeze())
-                {
-                    // Disable FDB aging
-                    gSwitchOrch->setAgingFDB(0);
-
-                    // Disable FDB learning on all bridge ports
-                    for (auto& pair: gPortsOrch->getAllPorts())
-                    {
-                        auto& port = pair.second;
-                        gPortsOrch->setBridgePortLearningFDB(port, SAI_BRIDGE_PORT_FDB_LEARNING_MODE_DISABLE);
-                    }
-
-                    // Flush sairedis's redis pipeline
-                    flush();
-
-                    SWSS_LOG_WARN("Orchagent is frozen for warm restart!");
-                    sleep(UINT_MAX);
-                }
+                const auto& port = pair.second;
+                gPortsOrch->setBridgePortLearningFDB(port, SAI_BRIDGE_PORT_FDB_LEARNING_MODE_DISABLE);
             }
+
+            // Flush sairedis's redis pipeline
+            flush();
+
+            SWSS_LOG_WARN("Orchagent is frozen for warm restart!");
+            sleep(UINT_MAX);
         }
     }
+
+    if (m_scheduler != NULL)
+    {
+        m_scheduler->resume();
+    }
 }
 
 /*
@@ -26,7 +26,10 @@
 #include "countercheckorch.h"
 #include "flexcounterorch.h"
 #include "watermarkorch.h"
+#include "consumerbatchorch.h"
 #include "directory.h"
+#include "orchscheduler.h"
+#include "flushpolicy.h"
 
 using namespace swss;
 
@@ -51,7 +54,26 @@ private:
     std::vector<Orch *> m_orchList;
     Select *m_select;
 
+    /* Multi-threaded mode only */
+    OrchScheduler *m_scheduler;
+    std::vector<DBConnector *> m_domainDbs;
+
+    DBConnector *getDomainDb(DBConnector *db);
+    void initScheduler(WatermarkOrch *wm_orch, Orch *pfc_wd_orch);
+
+    /* Single threaded mode only */
+    FlushPolicy *m_flushPolicy;
+
+    /* Retry, flush and batch statistics, published by the main loop only */
+    DBConnector *m_countersDb;
+    Table *m_retryStatsTable;
+    Table *m_flushStatsTable;
+    Table *m_batchStatsTable;
+    std::chrono::steady_clock::time_point m_lastStatsPublish;
+
     void flush();
+    void checkRestartReady();
+    void publishStats();
 };
 
 #endif /* SWSS_ORCHDAEMON_H */
@@ -0,0 +1,289 @@
+#include <string.h>
+#include <errno.h>
+#include <stdexcept>
+#include "orchscheduler.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+/* select() function timeout retry time */
+#define SELECT_TIMEOUT 1000
+
+/* Interval between two publications of the domain statistics */
+#define STATS_PUBLISH_INTERVAL_SEC 10
+
+#define ORCH_SCHEDULER_STATS_TABLE "ORCH_SCHEDULER_STATS"
+
+OrchDependencyLock::OrchDependencyLock()
+{
+    pthread_rwlockattr_t attr;
+
+    pthread_rwlockattr_init(&attr);
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    pthread_rwlock_init(&m_lock, &attr);
+    pthread_rwlockattr_destroy(&attr);
+}
+
+OrchDependencyLock::~OrchDependencyLock()
+{
+    pthread_rwlock_destroy(&m_lock);
+}
+
+void OrchDependencyLock::lock(bool shared)
+{
+    if (shared)
+    {
+        pthread_rwlock_rdlock(&m_lock);
+    }
+    else
+    {
+        pthread_rwlock_wrlock(&m_lock);
+    }
+}
+
+void OrchDependencyLock::unlock()
+{
+    pthread_rwlock_unlock(&m_lock);
+}
+
+OrchScheduler::OrchScheduler(Hook flush) :
+        m_flush(flush)
+{
+    SWSS_LOG_ENTER();
+}
+
+OrchScheduler::Domain &OrchScheduler::getDomain(const string &name)
+{
+    for (auto &domain : m_domains)
+    {
+        if (domain->name == name)
+        {
+            return *domain;
+        }
+    }
+
+    m_domains.emplace_back(new Domain());
+    m_domains.back()->name = name;
+    return *m_domains.back();
+}
+
+void OrchScheduler::addOrch(const string &domain, Orch *orch)
+{
+    SWSS_LOG_ENTER();
+
+    getDomain(domain).orchs.push_back(orch);
+}
+
+void OrchScheduler::addDependency(const string &domain, const string &lock, bool shared)
+{
+    SWSS_LOG_ENTER();
+
+    /* An exclusive dependency wins over a shared one on the same lock */
+    auto &dependencies = getDomain(domain).dependencies;
+    auto it = dependencies.find(lock);
+    if (it == dependencies.end())
+    {
+        dependencies[lock] = shared;
+    }
+    else
+    {
+        it->second = it->second && shared;
+    }
+
+    if (m_locks.find(lock) == m_locks.end())
+    {
+        m_locks[lock] = unique_ptr<OrchDependencyLock>(new OrchDependencyLock());
+    }
+}
+
+void OrchScheduler::run(Hook idle)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_domains.empty())
+    {
+        throw runtime_error("Orch scheduler started without execution domain");
+    }
+
+    for (auto &domain : m_domains)
+    {
+        /* The dependencies map is ordered by lock name */
+        for (const auto &dependency : domain->dependencies)
+        {
+            domain->locks.push_back(make_pair(m_locks.at(dependency.first).get(), dependency.second));
+        }
+
+        domain->countersDb = unique_ptr<DBConnector>(new DBConnector(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
+        domain->statsTable = unique_ptr<Table>(new Table(domain->countersDb.get(), ORCH_SCHEDULER_STATS_TABLE));
+        domain->lastPublish = chrono::steady_clock::now();
+
+        SWSS_LOG_NOTICE("Orch execution domain %s with %zu orchs and %zu dependencies",
+                        domain->name.c_str(), domain->orchs.size(), domain->locks.size());
+    }
+
+    /* Workers run as long as the daemon does */
+    for (size_t i = 1; i < m_domains.size(); i++)
+    {
+        std::thread(&OrchScheduler::runDomain, this, std::ref(*m_domains[i]), Hook()).detach();
+    }
+
+    runDomain(*m_domains.front(), idle);
+}
+
+void OrchScheduler::pause()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &domain : m_domains)
+    {
+        domain->execMutex.lock();
+    }
+}
+
+void OrchScheduler::resume()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto it = m_domains.rbegin(); it != m_domains.rend(); ++it)
+    {
+        (*it)->execMutex.unlock();
+    }
+}
+
+void OrchScheduler::runDomain(Domain &domain, Hook idle)
+{
+    SWSS_LOG_ENTER();
+
+    Select select;
+
+    for (Orch *o : domain.orchs)
+    {
+        select.addSelectables(o->getSelectables());
+    }
+    select.addSelectable(&domain.retryEvent);
+
+    while (true)
+    {
+        Selectable *s;
+        int ret;
+
+        ret = select.select(&s, SELECT_TIMEOUT);
+
+        if (ret == Select::ERROR)
+        {
+            SWSS_LOG_NOTICE("Error: %s!\n", strerror(errno));
+            continue;
+        }
+
+        if (ret == Select::TIMEOUT)
+        {
+            lock_guard<mutex> guard(domain.execMutex);
+            publishStats(domain);
+            continue;
+        }
+
+        execute(domain, s);
+
+        /* Let the other domains retry the tasks waiting on this one */
+        if (s != &domain.retryEvent)
+        {
+            for (auto &other : m_domains)
+            {
+                if (other.get() != &domain)
+                {
+                    other->retryEvent.notify();
+                }
+            }
+        }
+
+        if (idle)
+        {
+            idle();
+        }
+    }
+}
+
+void OrchScheduler::execute(Domain &domain, Selectable *s)
+{
+    lock_guard<mutex> guard(domain.execMutex);
+
+    auto start = chrono::steady_clock::now();
+    for (auto &lock : domain.locks)
+    {
+        lock.first->lock(lock.second);
+    }
+
+    auto locked = chrono::steady_clock::now();
+    uint64_t wait = (uint64_t)chrono::duration_cast<chrono::microseconds>(locked - start).count();
+    domain.iterations++;
+    domain.totalLockWait += wait;
+    domain.maxLockWait = max(domain.maxLockWait, wait);
+
+    if (s != &domain.retryEvent)
+    {
+        auto *c = (Executor *)s;
+        c->execute();
+
+        uint64_t latency = (uint64_t)chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - locked).count();
+        auto &stats = domain.executorStats[c];
+        stats.executions++;
+        stats.totalLatency += latency;
+        stats.maxLatency = max(stats.maxLatency, latency);
+    }
+
+    for (Orch *o : domain.orchs)
+    {
+        o->doTask();
+    }
+
+    m_flush();
+
+    for (auto it = domain.locks.rbegin(); it != domain.locks.rend(); ++it)
+    {
+        it->first->unlock();
+    }
+
+    publishStats(domain);
+}
+
+void OrchScheduler::publishStats(Domain &domain)
+{
+    auto now = chrono::steady_clock::now();
+    if (now - domain.lastPublish < chrono::seconds(STATS_PUBLISH_INTERVAL_SEC))
+    {
+        return;
+    }
+    domain.lastPublish = now;
+
+    vector<FieldValueTuple> fvs = {
+        { "iterations", to_string(domain.iterations) },
+        { "lock_wait_total_us", to_string(domain.totalLockWait) },
+        { "lock_wait_max_us", to_string(domain.maxLockWait) }
+    };
+    domain.statsTable->set(domain.name, fvs);
+
+    for (const auto &it : domain.executorStats)
+    {
+        /* Tasks left in m_toSync are the queue depth of a consumer */
+        auto *consumer = dynamic_cast<Consumer *>(it.first);
+        size_t pending = consumer != NULL ? consumer->m_toSync.size() : 0;
+        size_t batch_size = consumer != NULL ? consumer->getBatchSize() : 0;
+
+        vector<FieldValueTuple> executor_fvs = {
+            { "pending", to_string(pending) },
+            { "batch_size", to_string(batch_size) },
+            { "executions", to_string(it.second.executions) },
+            { "latency_total_us", to_string(it.second.totalLatency) },
+            { "latency_max_us", to_string(it.second.maxLatency) }
+        };
+        domain.statsTable->set(domain.name + ":" + it.first->getName(), executor_fvs);
+    }
+
+    domain.maxLockWait = 0;
+    for (auto &it : domain.executorStats)
+    {
+        it.second.maxLatency = 0;
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef SWSS_ORCHSCHEDULER_H
+#define SWSS_ORCHSCHEDULER_H
+
+#include <pthread.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "orch.h"
+#include "select.h"
+#include "selectableevent.h"
+#include "table.h"
+
+/*
+ * OrchDependencyLock: reader/writer lock on state shared by several
+ * execution domains. Writers are preferred so that a domain modifying the
+ * state is not starved by domains continuously reading it.
+ */
+class OrchDependencyLock
+{
+public:
+    OrchDependencyLock();
+    ~OrchDependencyLock();
+
+    OrchDependencyLock(const OrchDependencyLock&) = delete;
+    OrchDependencyLock& operator=(const OrchDependencyLock&) = delete;
+
+    void lock(bool shared);
+    void unlock();
+
+private:
+    pthread_rwlock_t m_lock;
+};
+
+/*
+ * OrchScheduler: multi-threaded execution of the orchs.
+ *
+ * Orchs are grouped in execution domains, each domain runs its own select
+ * loop on its own worker thread. Domains touching state of another domain
+ * declare it as a dependency on a named lock, exclusive if they modify the
+ * state and shared if they only read it. A domain holds all its dependency
+ * locks while executing, so two domains only run concurrently when none of
+ * their dependencies conflict. Dependency locks are always taken in name
+ * order.
+ *
+ * After a domain executed an event, the other domains are woken up to retry
+ * their pending tasks, as the single threaded loop does for all orchs.
+ *
+ * The first domain added is the main domain. It runs on the thread calling
+ * run(), which also calls the idle hook after each iteration.
+ *
+ * Every domain publishes its lock contention and, per executor, the number
+ * of pending tasks and the execution latency in COUNTERS_DB.
+ */
+class OrchScheduler
+{
+public:
+    typedef std::function<void()> Hook;
+
+    OrchScheduler(Hook flush);
+
+    OrchScheduler(const OrchScheduler&) = delete;
+    OrchScheduler& operator=(const OrchScheduler&) = delete;
+
+    /* Add an orch to a domain, the domain is created on first use */
+    void addOrch(const string &domain, Orch *orch);
+    void addDependency(const string &domain, const string &lock, bool shared = false);
+
+    /* Start the worker threads and run the main domain, never returns */
+    void run(Hook idle);
+
+    /* Wait for all domains to be between two iterations and keep them there */
+    void pause();
+    void resume();
+
+private:
+    struct ExecutorStats
+    {
+        uint64_t executions = 0;
+        uint64_t totalLatency = 0;      // us
+        uint64_t maxLatency = 0;        // us
+    };
+
+    struct Domain
+    {
+        string name;
+        vector<Orch *> orchs;
+        map<string, bool> dependencies;         // lock name, shared
+        vector<pair<OrchDependencyLock *, bool>> locks;
+
+        /* Held while the domain executes, taken by pause() */
+        mutex execMutex;
+        SelectableEvent retryEvent;
+
+        uint64_t iterations = 0;
+        uint64_t totalLockWait = 0;             // us
+        uint64_t maxLockWait = 0;               // us
+        map<Executor *, ExecutorStats> executorStats;
+        std::chrono::steady_clock::time_point lastPublish;
+
+        unique_ptr<DBConnector> countersDb;
+        unique_ptr<Table> statsTable;
+    };
+
+    Hook m_flush;
+    vector<unique_ptr<Domain>> m_domains;
+    map<string, unique_ptr<OrchDependencyLock>> m_locks;
+
+    Domain &getDomain(const string &name);
+    void runDomain(Domain &domain, Hook idle);
+    void execute(Domain &domain, Selectable *s);
+    void publishStats(Domain &domain);
+};
+
+#endif /* SWSS_ORCHSCHEDULER_H */
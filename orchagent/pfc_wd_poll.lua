@@ -0,0 +1,9 @@
+-- KEYS - queue IDs
+-- ARGV[1] - counters db index
+-- ARGV[2] - counters table name
+-- ARGV[3] - poll time interval
+-- notify PfcWdSwOrch that the PFC watchdog counters of a poll are in COUNTERS, return nothing
+
+redis.call('PUBLISH', 'PFC_WD_POLL', '["PFC_WD",""]')
+
+return {}
@@ -0,0 +1,34 @@
+-- KEYS - queue IDs followed by port IDs
+-- ARGV[1] - counters db index
+-- ARGV[2] - counters table name
+-- ARGV[3] - number of queue IDs
+-- ARGV[4] - number of queue fields
+-- ARGV[5..n] - queue fields followed by port fields
+-- return the queue fields of each queue then the port fields of each port, false if absent
+
+local counters_db = ARGV[1]
+local counters_table_name = ARGV[2]
+local queue_num = tonumber(ARGV[3])
+local queue_field_num = tonumber(ARGV[4])
+
+local rets = {}
+
+redis.call('SELECT', counters_db)
+
+local n = table.getn(KEYS)
+local m = table.getn(ARGV)
+for i = 1, n do
+    local first = 5 + queue_field_num
+    local last = m
+    if i <= queue_num then
+        first = 5
+        last = 4 + queue_field_num
+    end
+
+    local values = redis.call('HMGET', counters_table_name .. ':' .. KEYS[i], unpack(ARGV, first, last))
+    for j = 1, last - first + 1 do
+        table.insert(rets, values[j])
+    end
+end
+
+return rets
@@ -387,14 +387,14 @@ bool PfcWdLossyHandler::getHwCounters(PfcWdHwStats& counters)
     }
 
     // PG counters not yet supported in Mellanox platform
-    Port portInstance;
-    if (!gPortsOrch->getPort(getPort(), portInstance))
+    const Port *portInstance = gPortsOrch->findPort(getPort());
+    if (portInstance == nullptr)
     {
         SWSS_LOG_ERROR("Cannot get port by ID 0x%lx", getPort());
         return false;
     }
 
-    sai_object_id_t pg = portInstance.m_priority_group_ids[getQueueId()];
+    sai_object_id_t pg = portInstance->m_priority_group_ids[getQueueId()];
     vector<uint64_t> pgStats;
     pgStats.resize(pgStatIds.size());
 
@@ -452,14 +452,14 @@ PfcWdZeroBufferHandler::PfcWdZeroBufferHandler(sai_object_id_t port,
     m_originalQueueBufferProfile = oldQueueProfileId;
 
     // Get PG
-    Port portInstance;
-    if (!gPortsOrch->getPort(port, portInstance))
+    const Port *portInstance = gPortsOrch->findPort(port);
+    if (portInstance == nullptr)
     {
         SWSS_LOG_ERROR("Cannot get port by ID 0x%lx", port);
         return;
     }
 
-    sai_object_id_t pg = portInstance.m_priority_group_ids[queueId];
+    sai_object_id_t pg = portInstance->m_priority_group_ids[queueId];
 
     attr.id = SAI_INGRESS_PRIORITY_GROUP_ATTR_BUFFER_PROFILE;
 
@@ -504,14 +504,14 @@ PfcWdZeroBufferHandler::~PfcWdZeroBufferHandler(void)
         return;
     }
 
-    Port portInstance;
-    if (!gPortsOrch->getPort(getPort(), portInstance))
+    const Port *portInstance = gPortsOrch->findPort(getPort());
+    if (portInstance == nullptr)
     {
         SWSS_LOG_ERROR("Cannot get port by ID 0x%lx", getPort());
         return;
     }
 
-    sai_object_id_t pg = portInstance.m_priority_group_ids[getQueueId()];
+    sai_object_id_t pg = portInstance->m_priority_group_ids[getQueueId()];
 
     attr.id = SAI_INGRESS_PRIORITY_GROUP_ATTR_BUFFER_PROFILE;
     attr.value.oid = m_originalPgBufferProfile;
@@ -0,0 +1,238 @@
+#include "pfcwddetector.h"
+
+/* Queue flags */
+#define PFC_WD_QUEUE_ALERT              0x01    // alert action, the queue is also detected while stormed
+#define PFC_WD_QUEUE_PACKETS_LAST       0x02    // packetsLast and the last pause status are set
+#define PFC_WD_QUEUE_PFC_RX_LAST        0x04    // pfcRxPacketsLast is set
+#define PFC_WD_QUEUE_PFC_PAUSE_LAST     0x08    // pfcPauseLast is set
+#define PFC_WD_QUEUE_PAUSE_STATUS_LAST  0x10    // last pause status
+
+/* Share of the poll interval the queue must be paused for, in usecs per msec */
+#define PFC_WD_PAUSE_DURATION_RATIO     800
+
+PfcWdDetector::PfcWdDetector(PfcWdDetectMode mode) :
+    m_mode(mode)
+{
+}
+
+void PfcWdDetector::addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+                             uint32_t detectionTime, uint32_t restorationTime, bool alert)
+{
+    auto it = m_queueIndex.find(queueId);
+    if (it == m_queueIndex.end())
+    {
+        Queue queue = {};
+        queue.queueId = queueId;
+
+        it = m_queueIndex.emplace(queueId, m_queues.size()).first;
+        m_queues.push_back(queue);
+    }
+
+    Queue &queue = m_queues[it->second];
+    queue.portId = portId;
+    queue.index = index;
+
+    /* Changed times apply from the next period */
+    if (queue.detectionTime != detectionTime)
+    {
+        queue.detectionTime = detectionTime;
+        queue.detectionTimeLeft = detectionTime;
+    }
+    if (queue.restorationTime != restorationTime)
+    {
+        queue.restorationTime = restorationTime;
+        queue.restorationTimeLeft = restorationTime;
+    }
+    if (alert)
+    {
+        queue.flags = (uint8_t)(queue.flags | PFC_WD_QUEUE_ALERT);
+    }
+    else
+    {
+        queue.flags = (uint8_t)(queue.flags & ~PFC_WD_QUEUE_ALERT);
+    }
+}
+
+void PfcWdDetector::removeQueue(sai_object_id_t queueId)
+{
+    auto it = m_queueIndex.find(queueId);
+    if (it == m_queueIndex.end())
+    {
+        return;
+    }
+
+    size_t index = it->second;
+    m_queueIndex.erase(it);
+
+    if (index != m_queues.size() - 1)
+    {
+        m_queues[index] = m_queues.back();
+        m_queueIndex[m_queues[index].queueId] = index;
+    }
+    m_queues.pop_back();
+}
+
+vector<PfcWdDetectorEvent> PfcWdDetector::poll(const vector<PfcWdQueueSample> &samples, uint32_t pollInterval)
+{
+    vector<PfcWdDetectorEvent> events;
+
+    for (size_t i = 0; i < m_queues.size() && i < samples.size(); i++)
+    {
+        Queue &queue = m_queues[i];
+        const PfcWdQueueSample &sample = samples[i];
+
+        if (!sample.valid)
+        {
+            continue;
+        }
+
+        /* Queues in storm are only detected with the alert action, which has nothing to restore */
+        bool alert = (queue.flags & PFC_WD_QUEUE_ALERT) != 0;
+        if (!sample.stormed || alert)
+        {
+            PfcWdDetectEvent event;
+            if (detect(queue, sample, pollInterval, event))
+            {
+                events.push_back({ queue.queueId, event });
+            }
+        }
+        else if (queue.restorationTime != 0)
+        {
+            if (restore(queue, sample, pollInterval))
+            {
+                events.push_back({ queue.queueId, PFC_WD_EVENT_RESTORE });
+            }
+        }
+    }
+
+    return events;
+}
+
+bool PfcWdDetector::detect(Queue &queue, const PfcWdQueueSample &sample, uint32_t pollInterval,
+                           PfcWdDetectEvent &event)
+{
+    const uint8_t lastFlags = PFC_WD_QUEUE_PACKETS_LAST | PFC_WD_QUEUE_PFC_RX_LAST | PFC_WD_QUEUE_PFC_PAUSE_LAST;
+    bool deadlock = false;
+    bool restored = false;
+
+    /* Nothing to compare with on the first sample */
+    if ((queue.flags & lastFlags) == lastFlags)
+    {
+        bool noTx = sample.packets == queue.packetsLast;
+        bool pfcRx = sample.pfcRxPackets > queue.pfcRxPacketsLast;
+        bool storm = (sample.occupancyBytes > 0 && noTx && pfcRx) || sample.debugStorm;
+
+        if (!storm && sample.occupancyBytes == 0)
+        {
+            if (m_mode == PFC_WD_DETECT_ON2OFF)
+            {
+                bool pausedLast = (queue.flags & PFC_WD_QUEUE_PAUSE_STATUS_LAST) != 0;
+                storm = pfcRx && sample.pfcPause == queue.pfcPauseLast && pausedLast && sample.pauseStatus;
+            }
+            else
+            {
+                storm = noTx && sample.pfcPause > queue.pfcPauseLast &&
+                        sample.pfcPause - queue.pfcPauseLast > (uint64_t)pollInterval * PFC_WD_PAUSE_DURATION_RATIO;
+            }
+        }
+
+        if (storm)
+        {
+            if (queue.detectionTimeLeft <= pollInterval)
+            {
+                deadlock = true;
+                queue.detectionTimeLeft = queue.detectionTime;
+            }
+            else
+            {
+                queue.detectionTimeLeft -= pollInterval;
+            }
+        }
+        else
+        {
+            /* An alert queue in storm is restored as soon as the storm stops */
+            restored = (queue.flags & PFC_WD_QUEUE_ALERT) && sample.stormed;
+            queue.detectionTimeLeft = queue.detectionTime;
+        }
+    }
+
+    /* Save values for the next sample */
+    queue.packetsLast = sample.packets;
+    queue.flags = (uint8_t)(queue.flags | PFC_WD_QUEUE_PACKETS_LAST);
+    if (sample.pauseStatus)
+    {
+        queue.flags = (uint8_t)(queue.flags | PFC_WD_QUEUE_PAUSE_STATUS_LAST);
+    }
+    else
+    {
+        queue.flags = (uint8_t)(queue.flags & ~PFC_WD_QUEUE_PAUSE_STATUS_LAST);
+    }
+
+    if (deadlock && m_mode == PFC_WD_DETECT_PAUSE_DURATION)
+    {
+        /* Start over from the next sample, as the pause duration plugin did */
+        queue.flags = (uint8_t)(queue.flags & ~(PFC_WD_QUEUE_PFC_RX_LAST | PFC_WD_QUEUE_PFC_PAUSE_LAST));
+    }
+    else
+    {
+        queue.pfcRxPacketsLast = sample.pfcRxPackets;
+        queue.pfcPauseLast = sample.pfcPause;
+        queue.flags = (uint8_t)(queue.flags | PFC_WD_QUEUE_PFC_RX_LAST | PFC_WD_QUEUE_PFC_PAUSE_LAST);
+    }
+
+    if (deadlock)
+    {
+        event = PFC_WD_EVENT_STORM;
+    }
+    else if (restored)
+    {
+        event = PFC_WD_EVENT_RESTORE;
+    }
+
+    return deadlock || restored;
+}
+
+bool PfcWdDetector::restore(Queue &queue, const PfcWdQueueSample &sample, uint32_t pollInterval)
+{
+    bool restored = false;
+
+    if (queue.flags & PFC_WD_QUEUE_PFC_RX_LAST)
+    {
+        if (sample.pfcRxPackets == queue.pfcRxPacketsLast && !sample.debugStorm)
+        {
+            if (queue.restorationTimeLeft <= pollInterval)
+            {
+                restored = true;
+                queue.restorationTimeLeft = queue.restorationTime;
+            }
+            else
+            {
+                queue.restorationTimeLeft -= pollInterval;
+            }
+        }
+        else
+        {
+            queue.restorationTimeLeft = queue.restorationTime;
+        }
+    }
+
+    queue.pfcRxPacketsLast = sample.pfcRxPackets;
+    queue.flags = (uint8_t)(queue.flags | PFC_WD_QUEUE_PFC_RX_LAST);
+
+    return restored;
+}
+
+string PfcWdDetector::getPfcRxField(uint8_t index)
+{
+    return "SAI_PORT_STAT_PFC_" + to_string(index) + "_RX_PKTS";
+}
+
+string PfcWdDetector::getPfcPauseField(uint8_t index) const
+{
+    if (m_mode == PFC_WD_DETECT_ON2OFF)
+    {
+        return "SAI_PORT_STAT_PFC_" + to_string(index) + "_ON2OFF_RX_PKTS";
+    }
+
+    return "SAI_PORT_STAT_PFC_" + to_string(index) + "_RX_PAUSE_DURATION";
+}
@@ -0,0 +1,104 @@
+#ifndef SWSS_PFCWDDETECTOR_H
+#define SWSS_PFCWDDETECTOR_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+enum PfcWdDetectMode
+{
+    PFC_WD_DETECT_ON2OFF,           // PFC XON transitions and queue pause status, as pfc_detect_broadcom.lua
+    PFC_WD_DETECT_PAUSE_DURATION,   // PFC pause duration, as pfc_detect_mellanox.lua
+};
+
+enum PfcWdDetectEvent
+{
+    PFC_WD_EVENT_STORM,
+    PFC_WD_EVENT_RESTORE,
+};
+
+struct PfcWdQueueSample
+{
+    uint64_t occupancyBytes;
+    uint64_t packets;
+    uint64_t pfcRxPackets;
+    uint64_t pfcPause;              // ON2OFF RX packets or RX pause duration (usecs) of the queue TC
+    bool pauseStatus;
+    bool debugStorm;
+    bool stormed;                   // an action handler is installed on the queue
+    bool valid;                     // all the counters of the detect mode were read
+};
+
+struct PfcWdDetectorEvent
+{
+    sai_object_id_t queueId;
+    PfcWdDetectEvent event;
+};
+
+/*
+ * PfcWdDetector: the PFC storm detection and restoration state machines of
+ * the pfc_detect_<platform>.lua and pfc_restore.lua plugins, run in
+ * orchagent on counters read in bulk from COUNTERS.
+ *
+ * The last counter values and the time left of each queue are kept in a
+ * compact array instead of the *_last and *_TIME_LEFT fields of COUNTERS.
+ * Times are in milliseconds.
+ */
+class PfcWdDetector
+{
+public:
+    struct Queue
+    {
+        sai_object_id_t queueId;
+        sai_object_id_t portId;
+        uint32_t detectionTime;
+        uint32_t restorationTime;   // 0 if the queue is not restored automatically
+        uint32_t detectionTimeLeft;
+        uint32_t restorationTimeLeft;
+        uint64_t packetsLast;
+        uint64_t pfcRxPacketsLast;
+        uint64_t pfcPauseLast;
+        uint8_t index;
+        uint8_t flags;
+    };
+
+    PfcWdDetector(PfcWdDetectMode mode);
+
+    PfcWdDetectMode getMode() const
+    {
+        return m_mode;
+    }
+
+    /* Add a queue, or update its times and action keeping its state */
+    void addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+                  uint32_t detectionTime, uint32_t restorationTime, bool alert);
+    void removeQueue(sai_object_id_t queueId);
+
+    const vector<Queue> &getQueues() const
+    {
+        return m_queues;
+    }
+
+    /* Run the state machines on one sample per queue, in getQueues() order */
+    vector<PfcWdDetectorEvent> poll(const vector<PfcWdQueueSample> &samples, uint32_t pollInterval);
+
+    /* COUNTERS fields of the port counters used for a TC */
+    static string getPfcRxField(uint8_t index);
+    string getPfcPauseField(uint8_t index) const;
+
+private:
+    PfcWdDetectMode m_mode;
+    vector<Queue> m_queues;
+    unordered_map<sai_object_id_t, size_t> m_queueIndex;
+
+    bool detect(Queue &queue, const PfcWdQueueSample &sample, uint32_t pollInterval, PfcWdDetectEvent &event);
+    bool restore(Queue &queue, const PfcWdQueueSample &sample, uint32_t pollInterval);
+};
+
+#endif /* SWSS_PFCWDDETECTOR_H */
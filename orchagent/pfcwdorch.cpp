@@ -1,4 +1,5 @@
 #include <limits.h>
+#include <algorithm>
 #include <unordered_map>
 #include "pfcwdorch.h"
 #include "sai_serialize.h"
@@ -8,6 +9,7 @@
 #include "select.h"
 #include "notifier.h"
 #include "redisclient.h"
+#include "redisreply.h"
 #include "schema.h"
 #include "subscriberstatetable.h"
 
@@ -26,11 +28,15 @@
 #define SAI_PORT_STAT_PFC_PREFIX        "SAI_PORT_STAT_PFC_"
 #define PFC_WD_TC_MAX 8
 #define COUNTER_CHECK_POLL_TIMEOUT_SEC  1
+#define PFC_WD_DEBUG_STORM              "DEBUG_STORM"
+/* Published by the pfc_wd_poll.lua plugin after each poll of the PFC watchdog group */
+#define PFC_WD_POLL_CHANNEL             "PFC_WD_POLL"
 
 extern sai_port_api_t *sai_port_api;
 extern sai_queue_api_t *sai_queue_api;
 
 extern PortsOrch *gPortsOrch;
+extern bool gPfcWdNativeDetect;
 
 template <typename DropHandler, typename ForwardHandler>
 PfcWdOrch<DropHandler, ForwardHandler>::PfcWdOrch(DBConnector *db, vector<string> &tableNames):
@@ -307,6 +313,7 @@ task_process_status PfcWdSwOrch<DropHandler, ForwardHandler>::createEntry(const
                 vector<FieldValueTuple> fieldValues;
                 fieldValues.emplace_back(POLL_INTERVAL_FIELD, value);
                 m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+                setPollInterval(value);
             }
             else if (field == BIG_RED_SWITCH_FIELD)
             {
@@ -383,9 +390,9 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::enableBigRedSwitchMode()
 
     m_bigRedSwitchFlag =  true;
     // Write to database that each queue enables BIG_RED_SWITCH
-    auto allPorts = gPortsOrch->getAllPorts();
+    const auto &allPorts = gPortsOrch->getAllPorts();
 
-    for (auto &it: allPorts)
+    for (const auto &it: allPorts)
     {
         Port port = it.second;
         uint8_t pfcMask = 0;
@@ -429,7 +436,7 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::enableBigRedSwitchMode()
     }
 
     // Create pfcwdaction hanlder on all the ports.
-    for (auto & it: allPorts)
+    for (const auto &it: allPorts)
     {
         Port port = it.second;
         uint8_t pfcMask = 0;
@@ -555,6 +562,12 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
         // Create internal entry
         m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias));
 
+        if (m_detector)
+        {
+            m_detector->addQueue(queueId, port.m_port_id, i, detectionTime, restorationTime,
+                    action == PfcWdAction::PFC_WD_ACTION_ALERT);
+        }
+
         string key = getFlexCounterTableKey(queueIdStr);
         m_flexCounterTable->set(key, queueFieldValues);
 
@@ -639,6 +652,11 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
 
         m_entryMap.erase(queueId);
 
+        if (m_detector)
+        {
+            m_detector->removeQueue(queueId);
+        }
+
         // Clean up
         RedisClient redisClient(this->getCountersDb().get());
         string countersKey = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator() + sai_serialize_object_id(queueId);
@@ -680,27 +698,39 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
     string detectPluginName = "pfc_detect_" + platform + ".lua";
     string restorePluginName = "pfc_restore.lua";
 
-    try
+    if (gPfcWdNativeDetect && initDetector())
     {
-        string detectLuaScript = swss::loadLuaScript(detectPluginName);
-        detectSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                detectLuaScript);
-
-        string restoreLuaScript = swss::loadLuaScript(restorePluginName);
-        restoreSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                restoreLuaScript);
-
+        // Counters are still polled by syncd, its plugin only notifies each poll
         vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
+        fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, m_detectPollSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
         m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
     }
-    catch (...)
+    else
     {
-        SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        try
+        {
+            string detectLuaScript = swss::loadLuaScript(detectPluginName);
+            detectSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    detectLuaScript);
+
+            string restoreLuaScript = swss::loadLuaScript(restorePluginName);
+            restoreSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    restoreLuaScript);
+
+            vector<FieldValueTuple> fieldValues;
+            fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
+            fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
+            fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
+            m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+        }
+        catch (...)
+        {
+            SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        }
     }
 
     auto consumer = new swss::NotificationConsumer(
@@ -845,6 +875,23 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(swss::NotificationConsumer
     string event;
     vector<swss::FieldValueTuple> values;
 
+    if (&wdNotification == m_pollNotificationConsumer)
+    {
+        /* Polls notified meanwhile are detected at once, on the last counters */
+        uint32_t polls = 0;
+        while (wdNotification.hasData())
+        {
+            wdNotification.pop(queueIdStr, event, values);
+            polls++;
+        }
+
+        if (polls > 0)
+        {
+            pollDetector(polls);
+        }
+        return;
+    }
+
     wdNotification.pop(queueIdStr, event, values);
 
     sai_object_id_t queueId = SAI_NULL_OBJECT_ID;
@@ -871,6 +918,233 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 
 }
 
+template <typename DropHandler, typename ForwardHandler>
+bool PfcWdSwOrch<DropHandler, ForwardHandler>::initDetector(void)
+{
+    SWSS_LOG_ENTER();
+
+    // Detect with the PFC pause counters polled on this platform
+    PfcWdDetectMode mode;
+    if (find(c_portStatIds.begin(), c_portStatIds.end(), SAI_PORT_STAT_PFC_0_ON2OFF_RX_PKTS) != c_portStatIds.end())
+    {
+        mode = PFC_WD_DETECT_ON2OFF;
+    }
+    else if (find(c_portStatIds.begin(), c_portStatIds.end(), SAI_PORT_STAT_PFC_0_RX_PAUSE_DURATION) != c_portStatIds.end())
+    {
+        mode = PFC_WD_DETECT_PAUSE_DURATION;
+    }
+    else
+    {
+        SWSS_LOG_WARN("No PFC pause counter polled, using the PFC watchdog plugins");
+        return false;
+    }
+
+    try
+    {
+        string pollLuaScript = swss::loadLuaScript("pfc_wd_poll.lua");
+        m_detectPollSha = swss::loadRedisScript(this->getCountersDb().get(), pollLuaScript);
+
+        string readLuaScript = swss::loadLuaScript("pfc_wd_read.lua");
+        m_detectReadSha = swss::loadRedisScript(this->getCountersDb().get(), readLuaScript);
+    }
+    catch (...)
+    {
+        SWSS_LOG_WARN("Failed to load pfc_wd_poll.lua or pfc_wd_read.lua, using the PFC watchdog plugins");
+        return false;
+    }
+
+    m_detector = unique_ptr<PfcWdDetector>(new PfcWdDetector(mode));
+
+    // Detect once per poll of syncd, on the counters it has just written
+    m_pollNotificationConsumer = new swss::NotificationConsumer(this->getCountersDb().get(), PFC_WD_POLL_CHANNEL);
+    auto pollNotifier = new Notifier(m_pollNotificationConsumer, this, "PFC_WD_POLL_NOTIFIER");
+    Orch::addExecutor(pollNotifier);
+
+    SWSS_LOG_NOTICE("PFC storms are detected by orchagent");
+    return true;
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::setPollInterval(const string &value)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_detector)
+    {
+        return;
+    }
+
+    try
+    {
+        m_pollInterval = (int)to_uint<uint32_t>(value, 1, INT_MAX);
+    }
+    catch (...)
+    {
+        SWSS_LOG_ERROR("Invalid PFC watchdog poll interval %s", value.c_str());
+    }
+}
+
+template <typename DropHandler, typename ForwardHandler>
+bool PfcWdSwOrch<DropHandler, ForwardHandler>::readDetectorCounters(
+        const vector<sai_object_id_t> &portIds, vector<string> &values)
+{
+    SWSS_LOG_ENTER();
+
+    const auto &queues = m_detector->getQueues();
+
+    // Queue fields, then the RX and pause counters of each TC of the ports
+    vector<string> fields = {
+        "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES",
+        "SAI_QUEUE_STAT_PACKETS",
+        "SAI_QUEUE_ATTR_PAUSE_STATUS",
+        PFC_WD_DEBUG_STORM,
+    };
+    size_t queueFieldNum = fields.size();
+    for (uint8_t i = 0; i < PFC_WD_TC_MAX; i++)
+    {
+        fields.push_back(PfcWdDetector::getPfcRxField(i));
+    }
+    for (uint8_t i = 0; i < PFC_WD_TC_MAX; i++)
+    {
+        fields.push_back(m_detector->getPfcPauseField(i));
+    }
+
+    vector<string> args = { "EVALSHA", m_detectReadSha, to_string(queues.size() + portIds.size()) };
+    for (const auto &queue : queues)
+    {
+        args.push_back(sai_serialize_object_id(queue.queueId));
+    }
+    for (sai_object_id_t portId : portIds)
+    {
+        args.push_back(sai_serialize_object_id(portId));
+    }
+    args.push_back(to_string(this->getCountersDb()->getDbId()));
+    args.push_back(COUNTERS_TABLE);
+    args.push_back(to_string(queues.size()));
+    args.push_back(to_string(queueFieldNum));
+    args.insert(args.end(), fields.begin(), fields.end());
+
+    vector<const char *> argv;
+    vector<size_t> argvlen;
+    for (const auto &arg : args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    try
+    {
+        RedisCommand command;
+        command.formatArgv((int)argv.size(), argv.data(), argvlen.data());
+        RedisReply r(this->getCountersDb().get(), command, REDIS_REPLY_ARRAY);
+        redisReply *reply = r.getContext();
+
+        size_t expected = queues.size() * queueFieldNum + portIds.size() * (fields.size() - queueFieldNum);
+        if (reply->elements != expected)
+        {
+            SWSS_LOG_ERROR("Unexpected PFC watchdog counters reply, %zu elements", reply->elements);
+            return false;
+        }
+
+        values.clear();
+        for (size_t i = 0; i < reply->elements; i++)
+        {
+            redisReply *element = reply->element[i];
+            values.emplace_back(element->type == REDIS_REPLY_STRING ? element->str : "");
+        }
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Failed to read PFC watchdog counters: %s", e.what());
+        return false;
+    }
+
+    return true;
+}
+
+static bool parsePfcWdCounter(const string &str, uint64_t &value)
+{
+    if (str.empty())
+    {
+        return false;
+    }
+
+    try
+    {
+        value = to_uint<uint64_t>(str);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::pollDetector(uint32_t polls)
+{
+    SWSS_LOG_ENTER();
+
+    const auto &queues = m_detector->getQueues();
+
+    // Queues are not detected in BIG_RED_SWITCH mode
+    if (m_bigRedSwitchFlag || queues.empty())
+    {
+        return;
+    }
+
+    vector<sai_object_id_t> portIds;
+    unordered_map<sai_object_id_t, size_t> portIndex;
+    for (const auto &queue : queues)
+    {
+        if (portIndex.emplace(queue.portId, portIds.size()).second)
+        {
+            portIds.push_back(queue.portId);
+        }
+    }
+
+    vector<string> values;
+    if (!readDetectorCounters(portIds, values))
+    {
+        return;
+    }
+
+    const size_t queueFieldNum = 4;
+    const size_t portFieldNum = 2 * PFC_WD_TC_MAX;
+    const size_t portBase = queues.size() * queueFieldNum;
+
+    vector<PfcWdQueueSample> samples(queues.size());
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        const auto &queue = queues[i];
+        const string *queueValues = &values[i * queueFieldNum];
+        const string *portValues = &values[portBase + portIndex[queue.portId] * portFieldNum];
+        PfcWdQueueSample &sample = samples[i];
+
+        sample.valid = parsePfcWdCounter(queueValues[0], sample.occupancyBytes) &&
+                parsePfcWdCounter(queueValues[1], sample.packets) &&
+                parsePfcWdCounter(portValues[queue.index], sample.pfcRxPackets) &&
+                parsePfcWdCounter(portValues[PFC_WD_TC_MAX + queue.index], sample.pfcPause) &&
+                (m_detector->getMode() != PFC_WD_DETECT_ON2OFF || !queueValues[2].empty());
+        sample.pauseStatus = queueValues[2] == "true";
+        sample.debugStorm = queueValues[3] == "enabled";
+
+        auto entry = m_entryMap.find(queue.queueId);
+        sample.stormed = entry != m_entryMap.end() && entry->second.handler != nullptr;
+    }
+
+    for (const auto &event : m_detector->poll(samples, polls * (uint32_t)m_pollInterval))
+    {
+        string eventStr = event.event == PFC_WD_EVENT_STORM ? "storm" : "restore";
+        if (!startWdActionOnQueue(eventStr, event.queueId))
+        {
+            SWSS_LOG_ERROR("Failed to start PFC watchdog %s event action on queue 0x%lx",
+                    eventStr.c_str(), event.queueId);
+        }
+    }
+}
+
 template <typename DropHandler, typename ForwardHandler>
 bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string &event, sai_object_id_t queueId)
 {
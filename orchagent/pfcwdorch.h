@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "port.h"
 #include "pfcactionhandler.h"
+#include "pfcwddetector.h"
 #include "producertable.h"
 #include "notificationconsumer.h"
 #include "timer.h"
@@ -111,6 +112,11 @@ private:
     void unregisterFromWdDb(const Port& port);
     void doTask(swss::NotificationConsumer &wdNotification);
 
+    bool initDetector(void);
+    void pollDetector(uint32_t polls);
+    bool readDetectorCounters(const vector<sai_object_id_t> &portIds, vector<string> &values);
+    void setPollInterval(const string &value);
+
     string filterPfcCounters(string counters, set<uint8_t>& losslessTc);
     string getFlexCounterTableKey(string s);
 
@@ -132,6 +138,12 @@ private:
     bool m_bigRedSwitchFlag = false;
     int m_pollInterval;
 
+    // Native storm detection, instead of the detect and restore plugins
+    unique_ptr<PfcWdDetector> m_detector = nullptr;
+    string m_detectPollSha;
+    string m_detectReadSha;
+    swss::NotificationConsumer *m_pollNotificationConsumer = nullptr;
+
     shared_ptr<DBConnector> m_applDb = nullptr;
     // Track queues in storm
     shared_ptr<Table> m_applTable = nullptr;
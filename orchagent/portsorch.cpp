@@ -21,6 +21,7 @@
 #include "sai_serialize.h"
 #include "crmorch.h"
 #include "countercheckorch.h"
+#include "flexcounterorch.h"
 #include "notifier.h"
 
 extern sai_switch_api_t *sai_switch_api;
@@ -36,6 +37,8 @@ extern IntfsOrch *gIntfsOrch;
 extern NeighOrch *gNeighOrch;
 extern CrmOrch *gCrmOrch;
 extern BufferOrch *gBufferOrch;
+extern FlexCounterOrch *gFlexCounterOrch;
+extern bool gWatermarkAggregation;
 
 #define VLAN_PREFIX         "Vlan"
 #define DEFAULT_VLAN_ID     1
@@ -164,6 +167,8 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
     m_flex_db = shared_ptr<DBConnector>(new DBConnector(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0));
     m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
+    m_flexCounterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_flex_db.get()));
+    m_flexCounterBufferedTable = unique_ptr<ProducerTable>(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE, true));
 
     vector<FieldValueTuple> fields;
     fields.emplace_back(POLL_INTERVAL_FIELD, PORT_FLEX_STAT_COUNTER_POLL_MSECS);
@@ -178,15 +183,23 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
     string queueWmPluginName = "watermark_queue.lua";
     string pgWmPluginName = "watermark_pg.lua";
 
+    /* The watermarks are aggregated by WatermarkOrch, the plugin only notifies it of each poll */
+    if (gWatermarkAggregation)
+    {
+        queueWmPluginName = "watermark_poll.lua";
+        pgWmPluginName = "watermark_poll.lua";
+    }
+
     try
     {
+        vector<FieldValueTuple> fieldValues;
+
         string queueLuaScript = swss::loadLuaScript(queueWmPluginName);
         queueWmSha = swss::loadRedisScript(m_counter_db.get(), queueLuaScript);
 
         string pgLuaScript = swss::loadLuaScript(pgWmPluginName);
         pgWmSha = swss::loadRedisScript(m_counter_db.get(), pgLuaScript);
 
-        vector<FieldValueTuple> fieldValues;
         fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, queueWmSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ_AND_CLEAR);
@@ -219,7 +232,7 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
 
     m_cpuPort = Port("CPU", Port::CPU);
     m_cpuPort.m_port_id = attr.value.oid;
-    m_portList[m_cpuPort.m_alias] = m_cpuPort;
+    setPort(m_cpuPort.m_alias, m_cpuPort);
 
     /* Get port number */
     attr.id = SAI_SWITCH_ATTR_PORT_NUMBER;
@@ -392,6 +405,22 @@ bool PortsOrch::isPortReady()
     return m_initDone && m_pendingPortSet.empty();
 }
 
+/* Report the port bring-up once, when PortInitDone came and no port is pending */
+void PortsOrch::reportBootTimeline()
+{
+    if (m_bootTimelineReported || !isPortReady())
+    {
+        return;
+    }
+
+    m_bootTimeline.mark("ports ready");
+    for (const auto &line : m_bootTimeline.report())
+    {
+        SWSS_LOG_NOTICE("Port bring-up: %s", line.c_str());
+    }
+    m_bootTimelineReported = true;
+}
+
 /* Upon receiving PortInitDone, all the configured ports have been created*/
 bool PortsOrch::isInitDone()
 {
@@ -399,7 +428,7 @@ bool PortsOrch::isInitDone()
 }
 
 
-map<string, Port>& PortsOrch::getAllPorts()
+const map<string, Port>& PortsOrch::getAllPorts()
 {
     return m_portList;
 }
@@ -408,13 +437,14 @@ bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
     {
         return false;
     }
     else
     {
-        p = m_portList[alias];
+        p = it->second;
         return true;
     }
 }
@@ -423,53 +453,115 @@ bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto& portIter: m_portList)
+    const Port *p = findPort(id);
+    if (p == nullptr)
     {
-        switch (portIter.second.m_type)
-        {
-        case Port::PHY:
-            if(portIter.second.m_port_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::LAG:
-            if(portIter.second.m_lag_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::VLAN:
-            if (portIter.second.m_vlan_info.vlan_oid == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        default:
-            continue;
-        }
+        return false;
     }
 
-    return false;
+    port = *p;
+    return true;
 }
 
 bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    const Port *p = findPortByBridgePortId(bridge_port_id);
+    if (p == nullptr)
     {
-        if (it.second.m_bridge_port_id == bridge_port_id)
+        return false;
+    }
+
+    port = *p;
+    return true;
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id) const
+{
+    return findIndexedPort(m_portOidIndex, id);
+}
+
+const Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id) const
+{
+    return findIndexedPort(m_bridgePortOidIndex, bridge_port_id);
+}
+
+const Port *PortsOrch::findIndexedPort(const PortOidIndex &index, sai_object_id_t id) const
+{
+    if (id == SAI_NULL_OBJECT_ID)
+    {
+        return nullptr;
+    }
+
+    auto it = index.find(id);
+    if (it == index.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second->second;
+}
+
+/*
+ * Object id of a port entry as looked up by getPort(sai_object_id_t): the
+ * port id of a physical port, the LAG id of a LAG and the VLAN object id of
+ * a VLAN.
+ */
+static sai_object_id_t getPortOid(const Port &port)
+{
+    switch (port.m_type)
+    {
+    case Port::PHY:
+        return port.m_port_id;
+    case Port::LAG:
+        return port.m_lag_id;
+    case Port::VLAN:
+        return port.m_vlan_info.vlan_oid;
+    default:
+        return SAI_NULL_OBJECT_ID;
+    }
+}
+
+void PortsOrch::indexPort(PortMap::iterator it)
+{
+    sai_object_id_t oid = getPortOid(it->second);
+    if (oid != SAI_NULL_OBJECT_ID)
+    {
+        m_portOidIndex[oid] = it;
+    }
+
+    if (it->second.m_bridge_port_id != SAI_NULL_OBJECT_ID)
+    {
+        m_bridgePortOidIndex[it->second.m_bridge_port_id] = it;
+    }
+}
+
+void PortsOrch::unindexPort(PortMap::iterator it)
+{
+    auto unindex = [&it](PortOidIndex &index, sai_object_id_t oid)
+    {
+        auto found = index.find(oid);
+        if (found != index.end() && found->second == it)
         {
-            port = it.second;
-            return true;
+            index.erase(found);
         }
+    };
+
+    unindex(m_portOidIndex, getPortOid(it->second));
+    unindex(m_bridgePortOidIndex, it->second.m_bridge_port_id);
+}
+
+void PortsOrch::removePort(const string &alias)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return;
     }
 
-    return false;
+    unindexPort(it);
+    m_portList.erase(it);
 }
 
 // TODO: move this into AclOrch
@@ -512,9 +604,20 @@ bool PortsOrch::getAclBindPortId(string alias, sai_object_id_t &port_id)
     }
 }
 
-void PortsOrch::setPort(string alias, Port p)
+void PortsOrch::setPort(const string &alias, const Port &p)
 {
-    m_portList[alias] = p;
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        it = m_portList.emplace(alias, p).first;
+    }
+    else
+    {
+        unindexPort(it);
+        it->second = p;
+    }
+
+    indexPort(it);
 }
 
 void PortsOrch::getCpuPort(Port &port)
@@ -605,15 +708,14 @@ bool PortsOrch::getPortPfc(sai_object_id_t portId, uint8_t *pfc_bitmask)
 {
     SWSS_LOG_ENTER();
 
-    Port p;
-
-    if (!getPort(portId, p))
+    const Port *p = findPort(portId);
+    if (p == nullptr)
     {
         SWSS_LOG_ERROR("Failed to get port object for port id 0x%lx", portId);
         return false;
     }
 
-    *pfc_bitmask = p.m_pfc_bitmask;
+    *pfc_bitmask = p->m_pfc_bitmask;
 
     return true;
 }
@@ -657,7 +759,7 @@ bool PortsOrch::setPortPfc(sai_object_id_t portId, uint8_t pfc_bitmask)
     if (p.m_pfc_bitmask != pfc_bitmask)
     {
         p.m_pfc_bitmask = pfc_bitmask;
-        m_portList[p.m_alias] = p;
+        setPort(p.m_alias, p);
     }
 
     return true;
@@ -690,7 +792,7 @@ bool PortsOrch::setPortPfcAsym(Port &port, string pfc_asym)
     }
 
     port.m_pfc_asym = new_pfc_asym;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
 
     attr.id = SAI_PORT_ATTR_PRIORITY_FLOW_CONTROL_MODE;
     attr.value.s32 = (int32_t) port.m_pfc_asym;
@@ -1324,84 +1426,98 @@ string PortsOrch::getPortFlexCounterTableKey(string key)
     return string(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
 }
 
-string PortsOrch::getQueueFlexCounterTableKey(string key)
-{
-    return string(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
-string PortsOrch::getQueueWatermarkFlexCounterTableKey(string key)
-{
-    return string(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
-string PortsOrch::getPriorityGroupWatermarkFlexCounterTableKey(string key)
-{
-    return string(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
-}
-
-bool PortsOrch::initPort(const string &alias, const set<int> &lane_set)
+/*
+ * Initialize the ports created in the switch for the port configuration.
+ * The ports are brought up together, one step at a time for all of them,
+ * so that the counters DB writes go in one round trip and syncd creates
+ * the host interfaces while the ports states are read.
+ */
+bool PortsOrch::initPorts(const vector<pair<string, set<int>>> &ports)
 {
     SWSS_LOG_ENTER();
 
-    /* Determine if the lane combination exists in switch */
-    if (m_portListLaneMap.find(lane_set) != m_portListLaneMap.end())
+    vector<Port> newPorts;
+
+    for (const auto &i : ports)
     {
-        sai_object_id_t id = m_portListLaneMap[lane_set];
+        const string &alias = i.first;
+
+        /* Determine if the lane combination exists in switch */
+        auto lanes = m_portListLaneMap.find(i.second);
+        if (lanes == m_portListLaneMap.end())
+        {
+            SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", alias.c_str());
+            return false;
+        }
 
         /* Determine if the port has already been initialized before */
-        if (m_portList.find(alias) != m_portList.end() && m_portList[alias].m_port_id == id)
+        auto found = m_portList.find(alias);
+        if (found != m_portList.end() && found->second.m_port_id == lanes->second)
         {
             SWSS_LOG_INFO("Port has already been initialized before alias:%s", alias.c_str());
+            continue;
         }
-        else
-        {
-            Port p(alias, Port::PHY);
 
-            p.m_index = static_cast<int32_t>(m_portList.size()); // TODO: Assume no deletion of physical port
-            p.m_port_id = id;
+        Port p(alias, Port::PHY);
 
-            /* Initialize the port and create corresponding host interface */
-            if (initializePort(p))
-            {
-                /* Add port to port list */
-                m_portList[alias] = p;
-                /* Add port name map to counter table */
-                FieldValueTuple tuple(p.m_alias, sai_serialize_object_id(p.m_port_id));
-                vector<FieldValueTuple> fields;
-                fields.push_back(tuple);
-                m_counterTable->set("", fields);
-
-                /* Add port to flex_counter for updating stat counters  */
-                string key = getPortFlexCounterTableKey(sai_serialize_object_id(p.m_port_id));
-                std::string delimiter = "";
-                std::ostringstream counters_stream;
-                for (const auto &id: portStatIds)
-                {
-                    counters_stream << delimiter << sai_serialize_port_stat(id);
-                    delimiter = comma;
-                }
+        p.m_index = static_cast<int32_t>(m_portList.size() + newPorts.size()); // TODO: Assume no deletion of physical port
+        p.m_port_id = lanes->second;
+        newPorts.push_back(p);
+    }
 
-                fields.clear();
-                fields.emplace_back(PORT_COUNTER_ID_LIST, counters_stream.str());
+    if (newPorts.empty())
+    {
+        return true;
+    }
 
-                m_flexCounterTable->set(key, fields);
+    /* Initialize the ports and create corresponding host interfaces */
+    if (!initializePorts(newPorts))
+    {
+        return false;
+    }
 
-                PortUpdate update = {p, true };
-                notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+    {
+        BootTimeline::ScopedPhase phase(m_bootTimeline, "counter db", newPorts.size());
 
-                SWSS_LOG_NOTICE("Initialized port %s", alias.c_str());
-            }
-            else
-            {
-                SWSS_LOG_ERROR("Failed to initialize port %s", alias.c_str());
-                return false;
-            }
+        std::string delimiter = "";
+        std::ostringstream counters_stream;
+        for (const auto &id: portStatIds)
+        {
+            counters_stream << delimiter << sai_serialize_port_stat(id);
+            delimiter = comma;
+        }
+
+        vector<FieldValueTuple> nameMap;
+        vector<FieldValueTuple> fields;
+        fields.emplace_back(PORT_COUNTER_ID_LIST, counters_stream.str());
+
+        for (auto &p : newPorts)
+        {
+            /* Add port to port list */
+            setPort(p.m_alias, p);
+            nameMap.emplace_back(p.m_alias, sai_serialize_object_id(p.m_port_id));
+
+            /* Add port to flex_counter for updating stat counters  */
+            string key = getPortFlexCounterTableKey(sai_serialize_object_id(p.m_port_id));
+            m_flexCounterBufferedTable->set(key, fields);
         }
+
+        /* Add port name map to counter table */
+        m_counterTable->set("", nameMap);
+        m_flexCounterBufferedTable->flush();
     }
-    else
+
     {
-        SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", alias.c_str());
-        return false;
+        BootTimeline::ScopedPhase phase(m_bootTimeline, "port notifications", newPorts.size());
+
+        for (auto &p : newPorts)
+        {
+            PortUpdate update = {p, true };
+            notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+            notifyObjectReady(OBJECT_TYPE_PORT, p.m_alias);
+
+            SWSS_LOG_NOTICE("Initialized port %s", p.m_alias.c_str());
+        }
     }
 
     return true;
@@ -1484,6 +1600,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
             }
 
             m_portConfigDone = true;
+            m_bootTimeline.mark("PortConfigDone");
 
             for (auto i : kfvFieldsValues(t))
             {
@@ -1508,6 +1625,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
             if (!m_initDone)
             {
                 m_initDone = true;
+                m_bootTimeline.mark("PortInitDone");
                 SWSS_LOG_INFO("Get PortInitDone notification from portsyncd.");
             }
 
@@ -1586,7 +1704,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
             // TODO:
             // Fix the issue below
             // After PortConfigDone, while waiting for "PortInitDone" and the first gBufferOrch->isPortReady(alias),
-            // the complete m_lanesAliasSpeedMap may be populated again, so initPort() will be called more than once
+            // the complete m_lanesAliasSpeedMap may be populated again, so initPorts() will be called more than once
             // for the same port.
 
             /* Once all ports received, go through the each port and perform appropriate actions:
@@ -1621,6 +1739,8 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
+                vector<pair<string, set<int>>> ports;
+
                 for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
                 {
                     bool port_created = false;
@@ -1651,14 +1771,17 @@ void PortsOrch::doPortTask(Consumer &consumer)
 
                     if (port_created)
                     {
-                        if (!initPort(get<0>(it->second), it->first))
-                        {
-                            throw runtime_error("PortsOrch initialization failure.");
-                        }
+                        ports.emplace_back(get<0>(it->second), it->first);
                     }
 
                     it = m_lanesAliasSpeedMap.erase(it);
                 }
+
+                if (!initPorts(ports))
+                {
+                    throw runtime_error("PortsOrch initialization failure.");
+                }
+                m_bootTimeline.mark("ports initialized");
             }
 
             if (!m_portConfigDone)
@@ -1699,7 +1822,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     {
                         SWSS_LOG_NOTICE("Set port %s AutoNeg to %u", alias.c_str(), an);
                         p.m_autoneg = an;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
 
                         // Once AN is changed
                         // - no speed specified: need to reapply the port speed or port adv speed accordingly
@@ -1735,7 +1858,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                  */
                 if (speed != 0 && speed != p.m_speed)
                 {
-                    m_portList[alias] = p;
+                    setPort(alias, p);
 
                     if (p.m_autoneg)
                     {
@@ -1769,7 +1892,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                             }
 
                             p.m_admin_state_up = false;
-                            m_portList[alias] = p;
+                            setPort(alias, p);
 
                             if (!setPortSpeed(p.m_port_id, speed))
                             {
@@ -1791,7 +1914,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                         SWSS_LOG_NOTICE("Set port %s speed to %u", alias.c_str(), speed);
                     }
                     p.m_speed = speed;
-                    m_portList[alias] = p;
+                    setPort(alias, p);
                 }
 
                 if (mtu != 0 && mtu != p.m_mtu)
@@ -1799,7 +1922,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     if (setPortMtu(p.m_port_id, mtu))
                     {
                         p.m_mtu = mtu;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
                         SWSS_LOG_NOTICE("Set port %s MTU to %u", alias.c_str(), mtu);
                         if (p.m_rif_id)
                         {
@@ -1824,7 +1947,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                             p.m_fec_mode = fec_mode_map[fec_mode];
                             if (setPortFec(p.m_port_id, p.m_fec_mode))
                             {
-                                m_portList[alias] = p;
+                                setPort(alias, p);
                                 SWSS_LOG_NOTICE("Set port %s fec to %s", alias.c_str(), fec_mode.c_str());
                             }
                             else
@@ -1861,7 +1984,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     if (setPortAdminStatus(p.m_port_id, admin_status == "up"))
                     {
                         p.m_admin_state_up = (admin_status == "up");
-                        m_portList[alias] = p;
+                        setPort(alias, p);
                         SWSS_LOG_NOTICE("Set port %s admin status to %s", alias.c_str(), admin_status.c_str());
                     }
                     else
@@ -1945,7 +2068,7 @@ void PortsOrch::doVlanTask(Consumer &consumer)
                 if (mtu != 0)
                 {
                     vl.m_mtu = mtu;
-                    m_portList[vlan_alias] = vl;
+                    setPort(vlan_alias, vl);
                     if (vl.m_rif_id)
                     {
                         gIntfsOrch->setRouterIntfsMtu(vl);
@@ -2135,7 +2258,7 @@ void PortsOrch::doLagTask(Consumer &consumer)
                 if (mtu != 0)
                 {
                     l.m_mtu = mtu;
-                    m_portList[alias] = l;
+                    setPort(alias, l);
                     if (l.m_rif_id)
                     {
                         gIntfsOrch->setRouterIntfsMtu(l);
@@ -2287,6 +2410,7 @@ void PortsOrch::doTask(Consumer &consumer)
     if (table_name == APP_PORT_TABLE_NAME)
     {
         doPortTask(consumer);
+        reportBootTimeline();
     }
     else
     {
@@ -2384,80 +2508,175 @@ void PortsOrch::initializePriorityGroups(Port &port)
     SWSS_LOG_INFO("Get priority groups for port %s", port.m_alias.c_str());
 }
 
-bool PortsOrch::initializePort(Port &port)
+/*
+ * Read the queue and priority group lists, admin status and speed of a port.
+ * The counts, admin status and speed are read in one call and both lists in
+ * a second one, falling back to one call per attribute if the SAI rejects
+ * the combined get.
+ */
+bool PortsOrch::discoverPortAttributes(Port &port)
 {
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_NOTICE("Initializing port alias:%s pid:%lx", port.m_alias.c_str(), port.m_port_id);
-
-    initializePriorityGroups(port);
-    initializeQueues(port);
+    sai_attribute_t attrs[4];
+    attrs[0].id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
+    attrs[1].id = SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES;
+    attrs[2].id = SAI_PORT_ATTR_ADMIN_STATE;
+    attrs[3].id = SAI_PORT_ATTR_SPEED;
 
-    /* Create host interface */
-    if (!addHostIntfs(port, port.m_alias, port.m_hif_id))
+    sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 4, attrs);
+    if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Failed to create host interface for port %s", port.m_alias.c_str());
-        return false;
-    }
+        SWSS_LOG_INFO("Failed to get attributes of port %s in one call rv:%d", port.m_alias.c_str(), status);
 
-    /* Check warm start states */
-    vector<FieldValueTuple> tuples;
-    bool exist = m_portTable->get(port.m_alias, tuples);
-    string operStatus;
-    if (exist)
-    {
-        for (auto i : tuples)
+        initializePriorityGroups(port);
+        initializeQueues(port);
+
+        /* initialize port admin status */
+        if (!getPortAdminStatus(port.m_port_id, port.m_admin_state_up))
         {
-            if (fvField(i) == "oper_status")
-            {
-                operStatus = fvValue(i);
-            }
+            SWSS_LOG_ERROR("Failed to get initial port admin status %s", port.m_alias.c_str());
+            return false;
         }
-    }
-    SWSS_LOG_DEBUG("initializePort %s with oper %s", port.m_alias.c_str(), operStatus.c_str());
 
-    /**
-     * Create database port oper status as DOWN if attr missing
-     * This status will be updated upon receiving port_oper_status_notification.
-     */
-    if (operStatus == "up")
-    {
-        port.m_oper_status = SAI_PORT_OPER_STATUS_UP;
+        /* initialize port admin speed */
+        if (!getPortSpeed(port.m_port_id, port.m_speed))
+        {
+            SWSS_LOG_ERROR("Failed to get initial port admin speed %d", port.m_speed);
+            return false;
+        }
+
+        return true;
     }
-    else if (operStatus.empty())
+
+    SWSS_LOG_INFO("Get %d priority groups and %d queues for port %s",
+                  attrs[0].value.u32, attrs[1].value.u32, port.m_alias.c_str());
+
+    port.m_priority_group_ids.resize(attrs[0].value.u32);
+    port.m_queue_ids.resize(attrs[1].value.u32);
+    port.m_admin_state_up = attrs[2].value.booldata;
+    port.m_speed = attrs[3].value.u32;
+
+    uint32_t count = 0;
+    if (!port.m_priority_group_ids.empty())
     {
-        port.m_oper_status = SAI_PORT_OPER_STATUS_DOWN;
-        /* Fill oper_status in db with default value "down" */
-        m_portTable->hset(port.m_alias, "oper_status", "down");
+        attrs[count].id = SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST;
+        attrs[count].value.objlist.count = (uint32_t)port.m_priority_group_ids.size();
+        attrs[count].value.objlist.list = port.m_priority_group_ids.data();
+        count++;
     }
-    else
+    if (!port.m_queue_ids.empty())
     {
-        port.m_oper_status = SAI_PORT_OPER_STATUS_DOWN;
+        attrs[count].id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
+        attrs[count].value.objlist.count = (uint32_t)port.m_queue_ids.size();
+        attrs[count].value.objlist.list = port.m_queue_ids.data();
+        count++;
     }
 
-    /* initialize port admin status */
-    if (!getPortAdminStatus(port.m_port_id, port.m_admin_state_up))
+    if (count == 0)
     {
-        SWSS_LOG_ERROR("Failed to get initial port admin status %s", port.m_alias.c_str());
-        return false;
+        return true;
     }
 
-    /* initialize port admin speed */
-    if (!getPortSpeed(port.m_port_id, port.m_speed))
+    status = sai_port_api->get_port_attribute(port.m_port_id, count, attrs);
+    if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Failed to get initial port admin speed %d", port.m_speed);
-        return false;
+        SWSS_LOG_INFO("Failed to get queue and priority group lists of port %s in one call rv:%d",
+                      port.m_alias.c_str(), status);
+
+        initializePriorityGroups(port);
+        initializeQueues(port);
     }
 
+    SWSS_LOG_INFO("Get queues and priority groups for port %s", port.m_alias.c_str());
+
+    return true;
+}
+
+bool PortsOrch::initializePorts(vector<Port> &ports)
+{
+    SWSS_LOG_ENTER();
+
     /*
-     * always initialize Port SAI_HOSTIF_ATTR_OPER_STATUS based on oper_status value in appDB.
+     * The host interfaces only need the port object ids: create them first,
+     * the creates are not waited for and are handled by syncd while the APP DB
+     * states are read. The attribute reads that follow are synchronous.
      */
-    bool isUp = port.m_oper_status == SAI_PORT_OPER_STATUS_UP;
-    if (!setHostIntfsOperStatus(port, isUp))
     {
-        SWSS_LOG_WARN("Failed to set operation status %s to host interface %s",
-                      operStatus.c_str(), port.m_alias.c_str());
-        return false;
+        BootTimeline::ScopedPhase phase(m_bootTimeline, "host interfaces", ports.size());
+
+        for (auto &port : ports)
+        {
+            SWSS_LOG_NOTICE("Initializing port alias:%s pid:%lx", port.m_alias.c_str(), port.m_port_id);
+
+            /* Create host interface */
+            if (!addHostIntfs(port, port.m_alias, port.m_hif_id))
+            {
+                SWSS_LOG_ERROR("Failed to create host interface for port %s", port.m_alias.c_str());
+                return false;
+            }
+        }
+    }
+
+    {
+        BootTimeline::ScopedPhase phase(m_bootTimeline, "warm start states", ports.size());
+
+        for (auto &port : ports)
+        {
+            /* Check warm start states */
+            string operStatus;
+            m_portTable->hget(port.m_alias, "oper_status", operStatus);
+            SWSS_LOG_DEBUG("initializePorts %s with oper %s", port.m_alias.c_str(), operStatus.c_str());
+
+            /**
+             * Create database port oper status as DOWN if attr missing
+             * This status will be updated upon receiving port_oper_status_notification.
+             */
+            if (operStatus == "up")
+            {
+                port.m_oper_status = SAI_PORT_OPER_STATUS_UP;
+            }
+            else if (operStatus.empty())
+            {
+                port.m_oper_status = SAI_PORT_OPER_STATUS_DOWN;
+                /* Fill oper_status in db with default value "down" */
+                m_portTable->hset(port.m_alias, "oper_status", "down");
+            }
+            else
+            {
+                port.m_oper_status = SAI_PORT_OPER_STATUS_DOWN;
+            }
+        }
+    }
+
+    {
+        BootTimeline::ScopedPhase phase(m_bootTimeline, "attribute discovery", ports.size());
+
+        for (auto &port : ports)
+        {
+            if (!discoverPortAttributes(port))
+            {
+                return false;
+            }
+        }
+    }
+
+    {
+        BootTimeline::ScopedPhase phase(m_bootTimeline, "host interface status", ports.size());
+
+        for (auto &port : ports)
+        {
+            /*
+             * always initialize Port SAI_HOSTIF_ATTR_OPER_STATUS based on oper_status value in appDB.
+             */
+            bool isUp = port.m_oper_status == SAI_PORT_OPER_STATUS_UP;
+            if (!setHostIntfsOperStatus(port, isUp))
+            {
+                SWSS_LOG_WARN("Failed to set operation status %s to host interface %s",
+                              isUp ? "up" : "down", port.m_alias.c_str());
+                return false;
+            }
+        }
     }
 
     return true;
@@ -2494,7 +2713,7 @@ bool PortsOrch::addHostIntfs(Port &port, string alias, sai_object_id_t &host_int
     return true;
 }
 
-bool PortsOrch::setBridgePortLearningFDB(Port &port, sai_bridge_port_fdb_learning_mode_t mode)
+bool PortsOrch::setBridgePortLearningFDB(const Port &port, sai_bridge_port_fdb_learning_mode_t mode)
 {
     // TODO: how to support 1D bridge?
     if (port.m_type != Port::PHY) return false;
@@ -2572,7 +2791,7 @@ bool PortsOrch::addBridgePort(Port &port)
                 hostif_vlan_tag[SAI_HOSTIF_VLAN_TAG_KEEP], port.m_alias.c_str());
         return false;
     }
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     SWSS_LOG_NOTICE("Add bridge port %s to default 1Q bridge", port.m_alias.c_str());
 
     return true;
@@ -2622,7 +2841,7 @@ bool PortsOrch::removeBridgePort(Port &port)
 
     SWSS_LOG_NOTICE("Remove bridge port %s from default 1Q bridge", port.m_alias.c_str());
 
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     return true;
 }
 
@@ -2650,7 +2869,9 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_vlan_info.vlan_oid = vlan_oid;
     vlan.m_vlan_info.vlan_id = vlan_id;
     vlan.m_members = set<string>();
-    m_portList[vlan_alias] = vlan;
+    setPort(vlan_alias, vlan);
+
+    notifyObjectReady(OBJECT_TYPE_PORT, vlan_alias);
 
     return true;
 }
@@ -2679,7 +2900,7 @@ bool PortsOrch::removeVlan(Port vlan)
     SWSS_LOG_NOTICE("Remove VLAN %s vid:%hu", vlan.m_alias.c_str(),
             vlan.m_vlan_info.vlan_id);
 
-    m_portList.erase(vlan.m_alias);
+    removePort(vlan.m_alias);
 
     return true;
 }
@@ -2750,9 +2971,9 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode)
     /* a physical port may join multiple vlans */
     VlanMemberEntry vme = {vlan_member_id, sai_tagging_mode};
     port.m_vlan_members[vlan.m_vlan_info.vlan_id] = vme;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     vlan.m_members.insert(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    setPort(vlan.m_alias, vlan);
 
     VlanMemberUpdate update = { vlan, port, true };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -2793,9 +3014,9 @@ bool PortsOrch::removeVlanMember(Port &vlan, Port &port)
         }
     }
 
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     vlan.m_members.erase(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    setPort(vlan.m_alias, vlan);
 
     VlanMemberUpdate update = { vlan, port, false };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -2821,10 +3042,11 @@ bool PortsOrch::addLag(string lag_alias)
     Port lag(lag_alias, Port::LAG);
     lag.m_lag_id = lag_id;
     lag.m_members = set<string>();
-    m_portList[lag_alias] = lag;
+    setPort(lag_alias, lag);
 
     PortUpdate update = { lag, true };
     notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+    notifyObjectReady(OBJECT_TYPE_PORT, lag_alias);
 
     return true;
 }
@@ -2856,7 +3078,7 @@ bool PortsOrch::removeLag(Port lag)
 
     SWSS_LOG_NOTICE("Remove LAG %s lid:%lx", lag.m_alias.c_str(), lag.m_lag_id);
 
-    m_portList.erase(lag.m_alias);
+    removePort(lag.m_alias);
 
     PortUpdate update = { lag, false };
     notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
@@ -2915,10 +3137,10 @@ bool PortsOrch::addLagMember(Port &lag, Port &port)
 
     port.m_lag_id = lag.m_lag_id;
     port.m_lag_member_id = lag_member_id;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.insert(port.m_alias);
 
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     if (lag.m_bridge_port_id > 0)
     {
@@ -2952,9 +3174,9 @@ bool PortsOrch::removeLagMember(Port &lag, Port &port)
 
     port.m_lag_id = 0;
     port.m_lag_member_id = 0;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.erase(port.m_alias);
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     if (lag.m_bridge_port_id > 0)
     {
@@ -2978,6 +3200,20 @@ void PortsOrch::generateQueueMap()
         return;
     }
 
+    vector<string> stats;
+    for (const auto& it: queueStatIds)
+    {
+        stats.push_back(sai_serialize_queue_stat(it));
+    }
+    gFlexCounterOrch->setGroupCounters(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, QUEUE_COUNTER_ID_LIST, stats);
+
+    stats.clear();
+    for (const auto& it: queueWatermarkStatIds)
+    {
+        stats.push_back(sai_serialize_queue_stat(it));
+    }
+    gFlexCounterOrch->setGroupCounters(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, QUEUE_COUNTER_ID_LIST, stats);
+
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
@@ -3016,37 +3252,9 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
             queueIndexVector.emplace_back(id, to_string(queueRealIndex));
         }
 
-        /* add ordinary Queue stat counters */
-        string key = getQueueFlexCounterTableKey(id);
-
-        std::string delimiter = "";
-        std::ostringstream counters_stream;
-        for (const auto& it: queueStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_queue_stat(it);
-            delimiter = comma;
-        }
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
-
-        m_flexCounterTable->set(key, fieldValues);
-
-        /* add watermark queue counters */
-        key = getQueueWatermarkFlexCounterTableKey(id);
-
-        delimiter = "";
-        counters_stream.str("");
-        for (const auto& it: queueWatermarkStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_queue_stat(it);
-            delimiter = comma;
-        }
-
-        fieldValues.clear();
-        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
-
-        m_flexCounterTable->set(key, fieldValues);
+        /* add ordinary Queue stat counters and watermark queue counters */
+        gFlexCounterOrch->addCounterObject(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, id);
+        gFlexCounterOrch->addCounterObject(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, id);
     }
 
     m_queueTable->set("", queueVector);
@@ -3064,6 +3272,13 @@ void PortsOrch::generatePriorityGroupMap()
         return;
     }
 
+    vector<string> stats;
+    for (const auto& it: ingressPriorityGroupWatermarkStatIds)
+    {
+        stats.push_back(sai_serialize_ingress_priority_group_stat(it));
+    }
+    gFlexCounterOrch->setGroupCounters(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, PG_COUNTER_ID_LIST, stats);
+
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
@@ -3094,21 +3309,8 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port)
         pgPortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
         pgIndexVector.emplace_back(id, to_string(pgIndex));
 
-        string key = getPriorityGroupWatermarkFlexCounterTableKey(id);
-
-        std::string delimiter = "";
-        std::ostringstream counters_stream;
         /* Add watermark counters to flex_counter */
-        for (const auto& it: ingressPriorityGroupWatermarkStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_ingress_priority_group_stat(it);
-            delimiter = comma;
-        }
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(PG_COUNTER_ID_LIST, counters_stream.str());
-
-        m_flexCounterTable->set(key, fieldValues);
+        gFlexCounterOrch->addCounterObject(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, id);
     }
 
     m_pgTable->set("", pgVector);
@@ -3164,7 +3366,7 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
             updatePortOperStatus(port, status);
 
             /* update m_portList */
-            m_portList[port.m_alias] = port;
+            setPort(port.m_alias, port);
         }
 
         sai_deserialize_free_port_oper_status_ntf(count, portoperstatus);
@@ -2,6 +2,7 @@
 #define SWSS_PORTSORCH_H
 
 #include <map>
+#include <unordered_map>
 
 #include "acltable.h"
 #include "orch.h"
@@ -9,6 +10,7 @@
 #include "observer.h"
 #include "macaddress.h"
 #include "producertable.h"
+#include "boottimeline.h"
 
 #define FCS_LEN 4
 #define VLAN_TAG_LEN 4
@@ -19,6 +21,7 @@
 
 
 typedef std::vector<sai_uint32_t> PortSupportedSpeeds;
+typedef std::map<std::string, Port> PortMap;
 
 
 static const map<sai_port_oper_status_t, string> oper_status_strings =
@@ -58,15 +61,21 @@ public:
     bool isPortReady();
     bool isInitDone();
 
-    map<string, Port>& getAllPorts();
+    const map<string, Port>& getAllPorts();
     bool bake() override;
     void cleanPortTable(const vector<string>& keys);
     bool getBridgePort(sai_object_id_t id, Port &port);
-    bool setBridgePortLearningFDB(Port &port, sai_bridge_port_fdb_learning_mode_t mode);
+    bool setBridgePortLearningFDB(const Port &port, sai_bridge_port_fdb_learning_mode_t mode);
     bool getPort(string alias, Port &port);
     bool getPort(sai_object_id_t id, Port &port);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
-    void setPort(string alias, Port port);
+    /*
+     * Lookups without copy, return nullptr if not found. The entry remains
+     * valid until the port is removed, it reflects the updates done in between.
+     */
+    const Port *findPort(sai_object_id_t id) const;
+    const Port *findPortByBridgePortId(sai_object_id_t bridge_port_id) const;
+    void setPort(const string &alias, const Port &port);
     void getCpuPort(Port &port);
     bool getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan);
     bool getAclBindPortId(string alias, sai_object_id_t &port_id);
@@ -97,10 +106,11 @@ private:
     unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
-    std::string getQueueFlexCounterTableKey(std::string s);
-    std::string getQueueWatermarkFlexCounterTableKey(std::string s);
+    /* Buffered FLEX_COUNTER_TABLE, to register the ports in one round trip at bring-up */
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
+    unique_ptr<ProducerTable> m_flexCounterBufferedTable;
+
     std::string getPortFlexCounterTableKey(std::string s);
-    std::string getPriorityGroupWatermarkFlexCounterTableKey(std::string s);
 
     shared_ptr<DBConnector> m_counter_db;
     shared_ptr<DBConnector> m_flex_db;
@@ -117,10 +127,26 @@ private:
     sai_uint32_t m_portCount;
     map<set<int>, sai_object_id_t> m_portListLaneMap;
     map<set<int>, tuple<string, uint32_t, int, string>> m_lanesAliasSpeedMap;
-    map<string, Port> m_portList;
+    /* Only updated through setPort() and removePort(), which maintain the indexes */
+    PortMap m_portList;
+
+    /* Port, LAG and VLAN object id, and bridge port id, to the m_portList entry */
+    typedef unordered_map<sai_object_id_t, PortMap::iterator> PortOidIndex;
+    PortOidIndex m_portOidIndex;
+    PortOidIndex m_bridgePortOidIndex;
+
+    const Port *findIndexedPort(const PortOidIndex &index, sai_object_id_t id) const;
+    void indexPort(PortMap::iterator it);
+    void unindexPort(PortMap::iterator it);
+    void removePort(const string &alias);
 
     unordered_set<string> m_pendingPortSet;
 
+    /* Time spent in the port bring-up, reported once all ports are ready */
+    BootTimeline m_bootTimeline;
+    bool m_bootTimelineReported = false;
+    void reportBootTimeline();
+
     NotificationConsumer* m_portStatusNotificationConsumer;
 
     void doTask(Consumer &consumer);
@@ -135,7 +161,8 @@ private:
     void removeDefaultVlanMembers();
     void removeDefaultBridgePorts();
 
-    bool initializePort(Port &port);
+    bool initializePorts(vector<Port> &ports);
+    bool discoverPortAttributes(Port &port);
     void initializePriorityGroups(Port &port);
     void initializeQueues(Port &port);
 
@@ -158,7 +185,7 @@ private:
 
     bool addPort(const set<int> &lane_set, uint32_t speed, int an=0, string fec="");
     bool removePort(sai_object_id_t port_id);
-    bool initPort(const string &alias, const set<int> &lane_set);
+    bool initPorts(const vector<pair<string, set<int>>> &ports);
 
     bool setPortAdminStatus(sai_object_id_t id, bool up);
     bool getPortAdminStatus(sai_object_id_t id, bool& up);
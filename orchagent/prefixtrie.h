@@ -0,0 +1,354 @@
+#ifndef SWSS_PREFIXTRIE_H
+#define SWSS_PREFIXTRIE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <memory>
+#include <vector>
+
+/*
+ * PrefixTrie: path-compressed binary (Patricia) trie of prefixes of up to
+ * N bytes, keyed by the prefix bits in network byte order.
+ *
+ * Nodes are only created for stored prefixes and for the branch points
+ * between them, so a trie of n prefixes holds at most 2n - 1 nodes. Nodes
+ * are carved from chunks of NODE_CHUNK_SIZE to avoid one heap allocation
+ * per prefix, and are recycled through a free list.
+ *
+ * Erasing a prefix never moves the node of another prefix, so node pointers
+ * stay valid until their own prefix is erased.
+ */
+template <size_t N, typename T>
+class PrefixTrie
+{
+public:
+    struct Node
+    {
+        uint8_t     key[N];         // prefix bits, zeroed beyond len
+        uint8_t     len;            // prefix length in bits
+        bool        has_value;      // false for branch only nodes
+        T           value;
+        Node       *parent;
+        Node       *child[2];
+    };
+
+    PrefixTrie() : m_root(NULL), m_size(0), m_freeList(NULL)
+    {
+    }
+
+    PrefixTrie(PrefixTrie &&o)
+        : m_root(o.m_root), m_size(o.m_size), m_chunks(std::move(o.m_chunks)), m_freeList(o.m_freeList)
+    {
+        o.m_root = NULL;
+        o.m_size = 0;
+        o.m_freeList = NULL;
+    }
+
+    PrefixTrie(const PrefixTrie&) = delete;
+    PrefixTrie& operator=(const PrefixTrie&) = delete;
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void clear()
+    {
+        m_root = NULL;
+        m_size = 0;
+        m_freeList = NULL;
+        m_chunks.clear();
+    }
+
+    /* Exact match lookup, returns NULL if the prefix is not stored */
+    Node *find(const uint8_t *key, uint8_t len) const
+    {
+        Node *node = m_root;
+        while (node != NULL && node->len <= len)
+        {
+            if (commonLength(node->key, key, node->len) < node->len)
+            {
+                return NULL;
+            }
+            if (node->len == len)
+            {
+                return node->has_value ? node : NULL;
+            }
+            node = node->child[bit(key, node->len)];
+        }
+        return NULL;
+    }
+
+    /* Longest stored prefix covering the first len bits of key */
+    Node *longestMatch(const uint8_t *key, uint8_t len) const
+    {
+        Node *best = NULL;
+        Node *node = m_root;
+        while (node != NULL && node->len <= len)
+        {
+            if (commonLength(node->key, key, node->len) < node->len)
+            {
+                break;
+            }
+            if (node->has_value)
+            {
+                best = node;
+            }
+            if (node->len == len)
+            {
+                break;
+            }
+            node = node->child[bit(key, node->len)];
+        }
+        return best;
+    }
+
+    /* Call f(node) for every stored prefix covering the first len bits of key, shortest first */
+    template <typename F>
+    void forEachMatch(const uint8_t *key, uint8_t len, F f) const
+    {
+        Node *node = m_root;
+        while (node != NULL && node->len <= len)
+        {
+            if (commonLength(node->key, key, node->len) < node->len)
+            {
+                break;
+            }
+            if (node->has_value)
+            {
+                f(node);
+            }
+            if (node->len == len)
+            {
+                break;
+            }
+            node = node->child[bit(key, node->len)];
+        }
+    }
+
+    /*
+     * Insert the prefix if it is not stored yet. Returns the node of the
+     * prefix, inserted tells whether it was newly inserted with value.
+     */
+    Node *insert(const uint8_t *key, uint8_t len, const T &value, bool &inserted)
+    {
+        uint8_t masked[N];
+        maskKey(masked, key, len);
+
+        Node *parent = NULL;
+        Node **link = &m_root;
+        while (*link != NULL)
+        {
+            Node *node = *link;
+            uint8_t common = commonLength(node->key, masked, node->len < len ? node->len : len);
+
+            if (common == node->len)
+            {
+                if (node->len == len)
+                {
+                    inserted = !node->has_value;
+                    if (inserted)
+                    {
+                        node->has_value = true;
+                        node->value = value;
+                        m_size++;
+                    }
+                    return node;
+                }
+
+                /* node covers the prefix, keep walking down */
+                parent = node;
+                link = &node->child[bit(masked, node->len)];
+                continue;
+            }
+
+            Node *leaf = allocNode(masked, len, parent);
+            leaf->has_value = true;
+            leaf->value = value;
+
+            if (common == len)
+            {
+                /* The prefix covers node, insert it above node */
+                leaf->child[bit(node->key, len)] = node;
+                node->parent = leaf;
+                *link = leaf;
+            }
+            else
+            {
+                /* Branch at the first bit where the prefix and node differ */
+                Node *branch = allocNode(masked, common, parent);
+                branch->child[bit(node->key, common)] = node;
+                branch->child[bit(masked, common)] = leaf;
+                node->parent = branch;
+                leaf->parent = branch;
+                *link = branch;
+            }
+
+            inserted = true;
+            m_size++;
+            return leaf;
+        }
+
+        Node *leaf = allocNode(masked, len, parent);
+        leaf->has_value = true;
+        leaf->value = value;
+        *link = leaf;
+
+        inserted = true;
+        m_size++;
+        return leaf;
+    }
+
+    /* Erase the prefix stored in node, node must not be used afterwards */
+    void erase(Node *node)
+    {
+        node->has_value = false;
+        node->value = T();
+        m_size--;
+
+        /* Remove nodes that no longer hold a prefix nor branch */
+        while (node != NULL && !node->has_value
+               && (node->child[0] == NULL || node->child[1] == NULL))
+        {
+            Node *child = node->child[0] != NULL ? node->child[0] : node->child[1];
+            Node *parent = node->parent;
+
+            *linkOf(node) = child;
+            if (child != NULL)
+            {
+                child->parent = parent;
+            }
+            freeNode(node);
+
+            /* The parent still has the same number of children */
+            if (child != NULL)
+            {
+                break;
+            }
+            node = parent;
+        }
+    }
+
+    /* Pre-order traversal of the stored prefixes */
+    Node *first() const
+    {
+        Node *node = m_root;
+        while (node != NULL && !node->has_value)
+        {
+            node = preorderNext(node);
+        }
+        return node;
+    }
+
+    Node *next(Node *node) const
+    {
+        do
+        {
+            node = preorderNext(node);
+        } while (node != NULL && !node->has_value);
+        return node;
+    }
+
+private:
+    static const size_t NODE_CHUNK_SIZE = 1024;
+
+    Node *m_root;
+    size_t m_size;
+
+    std::vector<std::unique_ptr<Node[]>> m_chunks;
+    Node *m_freeList;
+
+    static uint8_t bit(const uint8_t *key, uint8_t pos)
+    {
+        return (uint8_t)((key[pos >> 3] >> (7 - (pos & 7))) & 1);
+    }
+
+    /* Number of leading bits, up to maxlen, that a and b have in common */
+    static uint8_t commonLength(const uint8_t *a, const uint8_t *b, uint8_t maxlen)
+    {
+        for (uint8_t i = 0; i * 8 < maxlen; i++)
+        {
+            uint8_t diff = (uint8_t)(a[i] ^ b[i]);
+            if (diff != 0)
+            {
+                uint8_t len = (uint8_t)(i * 8 + __builtin_clz(diff) - 24);
+                return len < maxlen ? len : maxlen;
+            }
+        }
+        return maxlen;
+    }
+
+    static void maskKey(uint8_t *dst, const uint8_t *src, uint8_t len)
+    {
+        memset(dst, 0, N);
+        memcpy(dst, src, len / 8);
+        if (len % 8 != 0)
+        {
+            dst[len / 8] = (uint8_t)(src[len / 8] & (0xff << (8 - len % 8)));
+        }
+    }
+
+    Node **linkOf(Node *node)
+    {
+        Node *parent = node->parent;
+        if (parent == NULL)
+        {
+            return &m_root;
+        }
+        return parent->child[0] == node ? &parent->child[0] : &parent->child[1];
+    }
+
+    static Node *preorderNext(Node *node)
+    {
+        if (node->child[0] != NULL)
+        {
+            return node->child[0];
+        }
+        if (node->child[1] != NULL)
+        {
+            return node->child[1];
+        }
+        while (node->parent != NULL)
+        {
+            Node *parent = node->parent;
+            if (parent->child[0] == node && parent->child[1] != NULL)
+            {
+                return parent->child[1];
+            }
+            node = parent;
+        }
+        return NULL;
+    }
+
+    Node *allocNode(const uint8_t *key, uint8_t len, Node *parent)
+    {
+        if (m_freeList == NULL)
+        {
+            Node *chunk = new Node[NODE_CHUNK_SIZE];
+            m_chunks.emplace_back(chunk);
+            for (size_t i = 0; i < NODE_CHUNK_SIZE; i++)
+            {
+                chunk[i].child[0] = m_freeList;
+                m_freeList = &chunk[i];
+            }
+        }
+
+        Node *node = m_freeList;
+        m_freeList = node->child[0];
+
+        maskKey(node->key, key, len);
+        node->len = len;
+        node->has_value = false;
+        node->value = T();
+        node->parent = parent;
+        node->child[0] = NULL;
+        node->child[1] = NULL;
+        return node;
+    }
+
+    void freeNode(Node *node)
+    {
+        node->child[0] = m_freeList;
+        m_freeList = node;
+    }
+};
+
+#endif /* SWSS_PREFIXTRIE_H */
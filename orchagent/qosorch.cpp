@@ -730,9 +730,9 @@ sai_object_id_t QosOrch::initSystemAclTable()
 
     gCrmOrch->incCrmAclUsedCounter(CrmResourceType::CRM_ACL_TABLE, SAI_ACL_STAGE_INGRESS, SAI_ACL_BIND_POINT_TYPE_PORT);
 
-    for (auto& pair: gPortsOrch->getAllPorts())
+    for (const auto& pair: gPortsOrch->getAllPorts())
     {
-        auto& port = pair.second;
+        const auto& port = pair.second;
         if (port.m_type != Port::PHY) continue;
 
         sai_object_id_t group_member_oid;
@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <chrono>
 #include "routeorch.h"
 #include "logger.h"
 #include "swssnet.h"
@@ -15,17 +16,26 @@ extern PortsOrch *gPortsOrch;
 extern IntfsOrch *gIntfsOrch;
 extern CrmOrch *gCrmOrch;
 
+extern int gMaxBulkSize;
+
 /* Default maximum number of next hop groups */
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
 
+/* Next hop group member bulk size on next hop state changes without route bulk mode */
+#define DEFAULT_NEXTHOP_GROUP_MEMBER_BULK_SIZE  1000
+
 const int routeorch_pri = 5;
 
 RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
         Orch(db, tableName, routeorch_pri),
         m_neighOrch(neighOrch),
         m_nextHopGroupCount(0),
-        m_resync(false)
+        m_resync(false),
+        m_bulkMode(gMaxBulkSize > 0),
+        m_routeBulker(sai_route_api, (size_t)gMaxBulkSize),
+        m_nextHopGroupMemberBulker(sai_next_hop_group_api, gSwitchId,
+                                   gMaxBulkSize > 0 ? (size_t)gMaxBulkSize : DEFAULT_NEXTHOP_GROUP_MEMBER_BULK_SIZE)
 {
     SWSS_LOG_ENTER();
 
@@ -81,7 +91,7 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
 
     /* Add default IPv4 route into the m_syncdRoutes */
-    m_syncdRoutes[default_ip_prefix] = IpAddresses();
+    m_syncdRoutes.set(default_ip_prefix, IpAddresses());
 
     SWSS_LOG_NOTICE("Create IPv4 default route with packet action drop");
 
@@ -100,20 +110,26 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
 
     /* Add default IPv6 route into the m_syncdRoutes */
-    m_syncdRoutes[v6_default_ip_prefix] = IpAddresses();
+    m_syncdRoutes.set(v6_default_ip_prefix, IpAddresses());
 
     SWSS_LOG_NOTICE("Create IPv6 default route with packet action drop");
+
+    if (m_bulkMode)
+    {
+        SWSS_LOG_NOTICE("Route bulk mode enabled with maximum bulk size %d", gMaxBulkSize);
+    }
 }
 
 bool RouteOrch::hasNextHopGroup(const IpAddresses& ipAddresses) const
 {
-    return m_syncdNextHopGroups.find(ipAddresses) != m_syncdNextHopGroups.end();
+    return m_syncdNextHopGroups.contains(ipAddresses);
 }
 
 sai_object_id_t RouteOrch::getNextHopGroupId(const IpAddresses& ipAddresses)
 {
-    assert(hasNextHopGroup(ipAddresses));
-    return m_syncdNextHopGroups[ipAddresses].next_hop_group_id;
+    auto nhg = m_syncdNextHopGroups.find(ipAddresses);
+    assert(nhg.valid());
+    return nhg.id();
 }
 
 void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
@@ -130,16 +146,12 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
         observerEntry = m_nextHopObservers.find(dstAddr);
 
         /* Find the prefixes that cover the destination IP */
-        for (auto route : m_syncdRoutes)
+        m_syncdRoutes.forEachMatch(dstAddr, [&](RouteTable::iterator route)
         {
-            if (route.first.isAddressInSubnet(dstAddr))
-            {
-                SWSS_LOG_INFO("Prefix %s covers destination address",
-                        route.first.to_string().c_str());
-                observerEntry->second.routeTable.emplace(
-                        route.first, route.second);
-            }
-        }
+            SWSS_LOG_INFO("Prefix %s covers destination address",
+                    route->first.to_string().c_str());
+            observerEntry->second.routeTable.insert(route->first, route->second);
+        });
 
         /* Find the subnets that cover the destination IP
          * The next hop of the subnet routes is left empty */
@@ -147,22 +159,21 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
         {
             if (prefix.isAddressInSubnet(dstAddr))
             {
-                observerEntry->second.routeTable.emplace(
-                        prefix, IpAddresses());
+                observerEntry->second.routeTable.insert(prefix, IpAddresses());
             }
         }
     }
 
     observerEntry->second.observers.push_back(observer);
 
-    SWSS_LOG_NOTICE("Attached next hop observer of route %s for destination IP %s",
-            observerEntry->second.routeTable.rbegin()->first.to_string().c_str(),
-            dstAddr.to_string().c_str());
-
     // Trigger next hop change for the first time the observer is attached
-    auto route = observerEntry->second.routeTable.rbegin();
-    if (route != observerEntry->second.routeTable.rend())
+    auto route = observerEntry->second.routeTable.longestMatch(dstAddr);
+    if (route != observerEntry->second.routeTable.end())
     {
+        SWSS_LOG_NOTICE("Attached next hop observer of route %s for destination IP %s",
+                route->first.to_string().c_str(),
+                dstAddr.to_string().c_str());
+
         NextHopUpdate update = { dstAddr, route->first, route->second };
         observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
     }
@@ -193,77 +204,87 @@ bool RouteOrch::validnexthopinNextHopGroup(const IpAddress &ipaddr)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    auto start = chrono::steady_clock::now();
+    bool rc = true;
 
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
-    {
+    /* Re-add the next hop to every group it belongs to in one bulk */
+    auto nhgs = m_syncdNextHopGroups.groupsWith(ipaddr);
+    sai_object_id_t nexthop_id = m_neighOrch->getNextHopId(ipaddr);
 
-        if (!(nhopgroup->first.contains(ipaddr)))
-        {
-            continue;
-        }
+    vector<sai_object_id_t> member_ids(nhgs.size());
+    vector<sai_status_t> statuses(nhgs.size());
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        sai_attribute_t nhgm_attrs[2];
 
-        vector<sai_attribute_t> nhgm_attrs;
-        sai_attribute_t nhgm_attr;
+        nhgm_attrs[0].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        nhgm_attrs[0].value.oid = nhgs[i].id();
 
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = nhopgroup->second.next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
+        nhgm_attrs[1].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attrs[1].value.oid = nexthop_id;
 
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = m_neighOrch->getNextHopId(ipaddr);
-        nhgm_attrs.push_back(nhgm_attr);
-
-        status = sai_next_hop_group_api->create_next_hop_group_member(&nexthop_id, gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
+        m_nextHopGroupMemberBulker.createEntry(&member_ids[i], &statuses[i], 2, nhgm_attrs);
+    }
+    m_nextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to add next hop member to group %lx: %d\n",
-                           nhopgroup->second.next_hop_group_id, status);
-            return false;
+                           nhgs[i].id(), statuses[i]);
+            rc = false;
+            continue;
         }
 
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhopgroup->second.nhopgroup_members[ipaddr] = nexthop_id;
+        nhgs[i].entry().nhopgroup_members[ipaddr] = member_ids[i];
     }
 
-    return true;
+    auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+    SWSS_LOG_NOTICE("Restored next hop %s in %zu next hop groups in %ld us",
+                    ipaddr.to_string().c_str(), nhgs.size(), (long)duration.count());
+
+    return rc;
 }
 
 bool RouteOrch::invalidnexthopinNextHopGroup(const IpAddress &ipaddr)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    auto start = chrono::steady_clock::now();
+    bool rc = true;
 
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
-    {
+    /* Remove the next hop from every group it belongs to in one bulk */
+    auto nhgs = m_syncdNextHopGroups.groupsWith(ipaddr);
 
-        if (!(nhopgroup->first.contains(ipaddr)))
-        {
-            continue;
-        }
-
-        nexthop_id = nhopgroup->second.nhopgroup_members[ipaddr];
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nexthop_id);
+    vector<sai_object_id_t> member_ids(nhgs.size());
+    vector<sai_status_t> statuses(nhgs.size());
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        member_ids[i] = nhgs[i].entry().nhopgroup_members[ipaddr];
+        m_nextHopGroupMemberBulker.removeEntry(&statuses[i], member_ids[i]);
+    }
+    m_nextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to remove next hop member %lx from group %lx: %d\n",
-                           nexthop_id, nhopgroup->second.next_hop_group_id, status);
-            return false;
+                           member_ids[i], nhgs[i].id(), statuses[i]);
+            rc = false;
+            continue;
         }
 
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
     }
 
-    return true;
+    auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+    SWSS_LOG_NOTICE("Invalidated next hop %s in %zu next hop groups in %ld us",
+                    ipaddr.to_string().c_str(), nhgs.size(), (long)duration.count());
+
+    return rc;
 }
 
 void RouteOrch::doTask(Consumer& consumer)
@@ -275,9 +296,18 @@ void RouteOrch::doTask(Consumer& consumer)
         return;
     }
 
+    /* Route operations queued in bulk mode, committed by flushRouteBulk() */
+    list<RouteBulkContext> ctxs;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
+        /* Bound the number of routes held in the bulker */
+        if (ctxs.size() >= m_routeBulker.getMaxBulkSize())
+        {
+            flushRouteBulk(consumer, ctxs);
+        }
+
         KeyOpFieldsValuesTuple t = it->second;
 
         string key = kfvKey(t);
@@ -295,6 +325,9 @@ void RouteOrch::doTask(Consumer& consumer)
         {
             if (op == "SET")
             {
+                /* Commit the queued route operations before their tasks are overwritten */
+                flushRouteBulk(consumer, ctxs);
+
                 /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
                 SWSS_LOG_NOTICE("Start resync routes\n");
                 for (auto i : m_syncdRoutes)
@@ -352,7 +385,14 @@ void RouteOrch::doTask(Consumer& consumer)
                  * above interfaces, remove them from the ASIC. */
                 if (m_syncdRoutes.find(ip_prefix) != m_syncdRoutes.end())
                 {
-                    if (removeRoute(ip_prefix))
+                    if (m_bulkMode)
+                    {
+                        ctxs.emplace_back(it, ip_prefix, IpAddresses(), true);
+                        if (!removeRoute(ctxs.back()))
+                            ctxs.pop_back();
+                        it++;
+                    }
+                    else if (removeRoute(ip_prefix))
                         it = consumer.m_toSync.erase(it);
                     else
                         it++;
@@ -362,12 +402,26 @@ void RouteOrch::doTask(Consumer& consumer)
                 continue;
             }
 
-            if (m_syncdRoutes.find(ip_prefix) == m_syncdRoutes.end() || m_syncdRoutes[ip_prefix] != ip_addresses)
+            auto it_route = m_syncdRoutes.find(ip_prefix);
+            if (it_route == m_syncdRoutes.end() || it_route->second != ip_addresses)
             {
-                if (addRoute(ip_prefix, ip_addresses))
+                if (m_bulkMode)
+                {
+                    ctxs.emplace_back(it, ip_prefix, ip_addresses, false);
+                    if (!addRoute(ctxs.back()))
+                    {
+                        ctxs.pop_back();
+                        waitForNextHops(consumer, key, ip_addresses);
+                    }
+                    it++;
+                }
+                else if (addRoute(ip_prefix, ip_addresses))
                     it = consumer.m_toSync.erase(it);
                 else
+                {
+                    waitForNextHops(consumer, key, ip_addresses);
                     it++;
+                }
             }
             else
                 /* Duplicate entry */
@@ -377,7 +431,14 @@ void RouteOrch::doTask(Consumer& consumer)
         {
             if (m_syncdRoutes.find(ip_prefix) != m_syncdRoutes.end())
             {
-                if (removeRoute(ip_prefix))
+                if (m_bulkMode)
+                {
+                    ctxs.emplace_back(it, ip_prefix, IpAddresses(), true);
+                    if (!removeRoute(ctxs.back()))
+                        ctxs.pop_back();
+                    it++;
+                }
+                else if (removeRoute(ip_prefix))
                     it = consumer.m_toSync.erase(it);
                 else
                     it++;
@@ -392,6 +453,73 @@ void RouteOrch::doTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushRouteBulk(consumer, ctxs);
+}
+
+/*
+ * Let the route task wait for the first of its next hops that is not resolved
+ * yet. Routes failing for another reason are not waiting for any object and
+ * keep being retried.
+ */
+void RouteOrch::waitForNextHops(Consumer& consumer, const string& key, const IpAddresses& ipAddresses)
+{
+    for (const auto& ip : ipAddresses.getIpAddresses())
+    {
+        if (!m_neighOrch->hasNextHop(ip))
+        {
+            consumer.waitFor(key, OBJECT_TYPE_NEXTHOP, ip.to_string());
+            return;
+        }
+    }
+}
+
+/*
+ * Commit the route operations queued in the bulker, then complete the
+ * bookkeeping of each route according to its bulk statuses. Tasks of the
+ * routes programmed successfully are removed from m_toSync, the others are
+ * left there to be retried.
+ *
+ * Next hop groups are only removed after all the routes of the batch have
+ * been processed, since a group released by one route may have been picked
+ * up by another route of the same batch.
+ */
+void RouteOrch::flushRouteBulk(Consumer& consumer, list<RouteBulkContext>& ctxs)
+{
+    SWSS_LOG_ENTER();
+
+    if (ctxs.empty())
+    {
+        return;
+    }
+
+    m_routeBulker.flush();
+
+    size_t failed = 0;
+    for (auto& ctx : ctxs)
+    {
+        bool done = ctx.is_remove ? removeRoutePost(ctx) : addRoutePost(ctx);
+        if (done)
+        {
+            consumer.m_toSync.erase(ctx.task);
+        }
+        else
+        {
+            failed++;
+        }
+    }
+
+    SWSS_LOG_INFO("Flushed %zu route operations in bulk, %zu failed", ctxs.size(), failed);
+    ctxs.clear();
+
+    for (const auto& nhg : m_bulkUnusedNextHopGroups)
+    {
+        if (hasNextHopGroup(nhg) && isRefCounterZero(nhg))
+        {
+            removeNextHopGroup(nhg);
+        }
+    }
+    m_bulkUnusedNextHopGroups.clear();
 }
 
 void RouteOrch::notifyNextHopChangeObservers(IpPrefix prefix, IpAddresses nexthops, bool add)
@@ -405,40 +533,26 @@ void RouteOrch::notifyNextHopChangeObservers(IpPrefix prefix, IpAddresses nextho
             continue;
         }
 
+        RouteTable& routeTable = entry.second.routeTable;
+
         if (add)
         {
-            bool update_required = false;
-            NextHopUpdate update = { entry.first, prefix, nexthops };
-
             /* Table should not be empty. Default route should always exists. */
-            assert(!entry.second.routeTable.empty());
+            assert(!routeTable.empty());
 
-            auto route = entry.second.routeTable.find(prefix);
-            if (route == entry.second.routeTable.end())
+            auto route = routeTable.find(prefix);
+            if (route != routeTable.end() && route->second == nexthops)
             {
-                /* If added route is best match update observers */
-                if (entry.second.routeTable.rbegin()->first < prefix)
-                {
-                    update_required = true;
-                }
-
-                entry.second.routeTable.emplace(prefix, nexthops);
-            }
-            else
-            {
-                if (route->second != nexthops)
-                {
-                    route->second = nexthops;
-                    /* If changed route is best match update observers */
-                    if (entry.second.routeTable.rbegin()->first == route->first)
-                    {
-                        update_required = true;
-                    }
-                }
+                continue;
             }
 
-            if (update_required)
+            routeTable.set(prefix, nexthops);
+
+            /* If added or changed route is best match update observers */
+            if (routeTable.longestMatch(entry.first)->first == prefix)
             {
+                NextHopUpdate update = { entry.first, prefix, nexthops };
+
                 for (auto observer : entry.second.observers)
                 {
                     observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
@@ -447,35 +561,34 @@ void RouteOrch::notifyNextHopChangeObservers(IpPrefix prefix, IpAddresses nextho
         }
         else
         {
-            auto route = entry.second.routeTable.find(prefix);
-            if (route != entry.second.routeTable.end())
+            auto route = routeTable.find(prefix);
+            if (route == routeTable.end())
             {
-                /* If removed route was best match find another best match route */
-                if (route->first == entry.second.routeTable.rbegin()->first)
-                {
-                    entry.second.routeTable.erase(route);
+                continue;
+            }
 
-                    /* Table should not be empty. Default route should always exists. */
-                    assert(!entry.second.routeTable.empty());
+            bool best_match = routeTable.longestMatch(entry.first) == route;
+            routeTable.erase(route);
 
-                    auto route = entry.second.routeTable.rbegin();
-                    NextHopUpdate update = { entry.first, route->first, route->second };
+            /* If removed route was best match find another best match route */
+            if (best_match)
+            {
+                /* Table should not be empty. Default route should always exists. */
+                assert(!routeTable.empty());
 
-                    for (auto observer : entry.second.observers)
-                    {
-                        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                    }
-                }
-                else
+                auto best = routeTable.longestMatch(entry.first);
+                NextHopUpdate update = { entry.first, best->first, best->second };
+
+                for (auto observer : entry.second.observers)
                 {
-                    entry.second.routeTable.erase(route);
+                    observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
                 }
             }
         }
     }
 }
 
-void RouteOrch::increaseNextHopRefCount(IpAddresses ipAddresses)
+void RouteOrch::increaseNextHopRefCount(const IpAddresses& ipAddresses)
 {
     /* Return when there is no next hop (dropped) */
     if (ipAddresses.getSize() == 0)
@@ -484,15 +597,17 @@ void RouteOrch::increaseNextHopRefCount(IpAddresses ipAddresses)
     }
     else if (ipAddresses.getSize() == 1)
     {
-        IpAddress ip_address(ipAddresses.to_string());
+        IpAddress ip_address = *ipAddresses.getIpAddresses().begin();
         m_neighOrch->increaseNextHopRefCount(ip_address);
     }
     else
     {
-        m_syncdNextHopGroups[ipAddresses].ref_count ++;
+        auto nhg = m_syncdNextHopGroups.find(ipAddresses);
+        assert(nhg.valid());
+        nhg.ref();
     }
 }
-void RouteOrch::decreaseNextHopRefCount(IpAddresses ipAddresses)
+void RouteOrch::decreaseNextHopRefCount(const IpAddresses& ipAddresses)
 {
     /* Return when there is no next hop (dropped) */
     if (ipAddresses.getSize() == 0)
@@ -501,27 +616,24 @@ void RouteOrch::decreaseNextHopRefCount(IpAddresses ipAddresses)
     }
     else if (ipAddresses.getSize() == 1)
     {
-        IpAddress ip_address(ipAddresses.to_string());
+        IpAddress ip_address = *ipAddresses.getIpAddresses().begin();
 
         m_neighOrch->decreaseNextHopRefCount(ip_address);
     }
     else
     {
-        m_syncdNextHopGroups[ipAddresses].ref_count --;
+        auto nhg = m_syncdNextHopGroups.find(ipAddresses);
+        assert(nhg.valid());
+        nhg.unref();
     }
 }
 
 bool RouteOrch::isRefCounterZero(const IpAddresses& ipAddresses) const
 {
-    if (!hasNextHopGroup(ipAddresses))
-    {
-        return true;
-    }
-
-    return m_syncdNextHopGroups.at(ipAddresses).ref_count == 0;
+    return m_syncdNextHopGroups.refCount(ipAddresses) == 0;
 }
 
-bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
+bool RouteOrch::addNextHopGroup(const IpAddresses& ipAddresses)
 {
     SWSS_LOG_ENTER();
 
@@ -631,39 +743,40 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
      * count will increase once the route is successfully syncd.
      */
     next_hop_group_entry.ref_count = 0;
-    m_syncdNextHopGroups[ipAddresses] = next_hop_group_entry;
+    m_syncdNextHopGroups.insert(ipAddresses, next_hop_group_entry);
 
 
     return true;
 }
 
-bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
+bool RouteOrch::removeNextHopGroup(const IpAddresses& ipAddresses)
 {
     SWSS_LOG_ENTER();
 
     sai_object_id_t next_hop_group_id;
-    auto next_hop_group_entry = m_syncdNextHopGroups.find(ipAddresses);
+    auto nhg = m_syncdNextHopGroups.find(ipAddresses);
     sai_status_t status;
 
-    assert(next_hop_group_entry != m_syncdNextHopGroups.end());
+    assert(nhg.valid());
 
-    if (next_hop_group_entry->second.ref_count != 0)
+    if (nhg.refCount() != 0)
     {
         return true;
     }
 
-    next_hop_group_id = next_hop_group_entry->second.next_hop_group_id;
+    NextHopGroupEntry *next_hop_group_entry = &nhg.entry();
+    next_hop_group_id = next_hop_group_entry->next_hop_group_id;
     SWSS_LOG_NOTICE("Delete next hop group %s", ipAddresses.to_string().c_str());
 
-    for (auto nhop = next_hop_group_entry->second.nhopgroup_members.begin();
-         nhop != next_hop_group_entry->second.nhopgroup_members.end();)
+    for (auto nhop = next_hop_group_entry->nhopgroup_members.begin();
+         nhop != next_hop_group_entry->nhopgroup_members.end();)
     {
 
         if (m_neighOrch->isNextHopFlagSet(nhop->first, NHFLAGS_IFDOWN))
         {
             SWSS_LOG_WARN("NHFLAGS_IFDOWN set for next hop group member %s with next_hop_id %lx",
                            nhop->first.to_string().c_str(), nhop->second);
-            nhop = next_hop_group_entry->second.nhopgroup_members.erase(nhop);
+            nhop = next_hop_group_entry->nhopgroup_members.erase(nhop);
             continue;
         }
         status = sai_next_hop_group_api->remove_next_hop_group_member(nhop->second);
@@ -675,7 +788,7 @@ bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
         }
 
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhop = next_hop_group_entry->second.nhopgroup_members.erase(nhop);
+        nhop = next_hop_group_entry->nhopgroup_members.erase(nhop);
     }
 
     status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
@@ -688,12 +801,11 @@ bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
     m_nextHopGroupCount --;
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
 
-    set<IpAddress> ip_address_set = ipAddresses.getIpAddresses();
-    for (auto it : ip_address_set)
+    for (const auto& it : nhg.nexthops().getIpAddresses())
     {
         m_neighOrch->decreaseNextHopRefCount(it);
     }
-    m_syncdNextHopGroups.erase(ipAddresses);
+    m_syncdNextHopGroups.erase(nhg);
 
     return true;
 }
@@ -730,18 +842,21 @@ void RouteOrch::addTempRoute(IpPrefix ipPrefix, IpAddresses nextHops)
     addRoute(ipPrefix, tmp_next_hop);
 }
 
-bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
+/*
+ * Get the next hop id or next hop group id the route should point to,
+ * creating the next hop group if needed. Returns false if the next hop(s)
+ * cannot be resolved yet.
+ */
+bool RouteOrch::getNextHopIdForRoute(const IpPrefix& ipPrefix, const IpAddresses& nextHops, sai_object_id_t& next_hop_id)
 {
     SWSS_LOG_ENTER();
 
-    /* next_hop_id indicates the next hop id or next hop group id of this route */
-    sai_object_id_t next_hop_id;
     auto it_route = m_syncdRoutes.find(ipPrefix);
 
     /* The route is pointing to a next hop */
     if (nextHops.getSize() == 1)
     {
-        IpAddress ip_address(nextHops.to_string());
+        IpAddress ip_address = *nextHops.getIpAddresses().begin();
         if (m_neighOrch->hasNextHop(ip_address))
         {
             next_hop_id = m_neighOrch->getNextHopId(ip_address);
@@ -757,7 +872,8 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
     else
     {
         /* Check if there is already an existing next hop group */
-        if (!hasNextHopGroup(nextHops))
+        auto nhg = m_syncdNextHopGroups.find(nextHops);
+        if (!nhg.valid())
         {
             /* Try to create a new next hop group */
             if (!addNextHopGroup(nextHops))
@@ -768,7 +884,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
                  * then return false and no need to add another temporary route. */
                 if (it_route != m_syncdRoutes.end() && it_route->second.getSize() == 1)
                 {
-                    IpAddress ip_address(it_route->second.to_string());
+                    IpAddress ip_address = *it_route->second.getIpAddresses().begin();
                     if (nextHops.contains(ip_address))
                     {
                         return false;
@@ -782,9 +898,27 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
                 /* Return false since the original route is not successfully added */
                 return false;
             }
+
+            nhg = m_syncdNextHopGroups.find(nextHops);
         }
 
-        next_hop_id = m_syncdNextHopGroups[nextHops].next_hop_group_id;
+        next_hop_id = nhg.id();
+    }
+
+    return true;
+}
+
+bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
+{
+    SWSS_LOG_ENTER();
+
+    /* next_hop_id indicates the next hop id or next hop group id of this route */
+    sai_object_id_t next_hop_id;
+    auto it_route = m_syncdRoutes.find(ipPrefix);
+
+    if (!getNextHopIdForRoute(ipPrefix, nextHops, next_hop_id))
+    {
+        return false;
     }
 
     /* Sync the route entry */
@@ -870,7 +1004,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
 
         decreaseNextHopRefCount(it_route->second);
         if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
+            && isRefCounterZero(it_route->second))
         {
             removeNextHopGroup(it_route->second);
         }
@@ -878,7 +1012,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
                 ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
     }
 
-    m_syncdRoutes[ipPrefix] = nextHops;
+    m_syncdRoutes.set(ipPrefix, nextHops);
 
     notifyNextHopChangeObservers(ipPrefix, nextHops, true);
     return true;
@@ -954,7 +1088,7 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
          */
         decreaseNextHopRefCount(it_route->second);
         if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
+            && isRefCounterZero(it_route->second))
         {
             removeNextHopGroup(it_route->second);
         }
@@ -964,10 +1098,10 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
 
     if (ipPrefix.isDefaultRoute())
     {
-        m_syncdRoutes[ipPrefix] = IpAddresses();
+        m_syncdRoutes.set(ipPrefix, IpAddresses());
 
         /* Notify about default route next hop change */
-        notifyNextHopChangeObservers(ipPrefix, m_syncdRoutes[ipPrefix], true);
+        notifyNextHopChangeObservers(ipPrefix, IpAddresses(), true);
     }
     else
     {
@@ -979,3 +1113,228 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
 
     return true;
 }
+
+/*
+ * Queue the route entry create or set operations of the route in the route
+ * bulker. The next hop group, if any, is created synchronously. Returns false
+ * if the route cannot be queued and needs to be retried.
+ */
+bool RouteOrch::addRoute(RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpPrefix& ipPrefix = ctx.ip_prefix;
+    const IpAddresses& nextHops = ctx.nhops;
+
+    sai_object_id_t next_hop_id;
+    if (!getNextHopIdForRoute(ipPrefix, nextHops, next_hop_id))
+    {
+        return false;
+    }
+
+    sai_route_entry_t route_entry;
+    route_entry.vr_id = gVirtualRouterId;
+    route_entry.switch_id = gSwitchId;
+    copy(route_entry.destination, ipPrefix);
+
+    sai_attribute_t route_attr;
+
+    auto it_route = m_syncdRoutes.find(ipPrefix);
+    if (it_route == m_syncdRoutes.end())
+    {
+        route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        route_attr.value.oid = next_hop_id;
+
+        ctx.is_create = true;
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.createEntry(&ctx.object_statuses.back(), route_entry, 1, &route_attr);
+    }
+    else
+    {
+        /* Set the packet action to forward when there was no next hop (dropped) */
+        if (it_route->second.getSize() == 0)
+        {
+            route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+            route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+            ctx.object_statuses.emplace_back();
+            m_routeBulker.setEntryAttribute(&ctx.object_statuses.back(), route_entry, route_attr);
+        }
+
+        route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        route_attr.value.oid = next_hop_id;
+
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.setEntryAttribute(&ctx.object_statuses.back(), route_entry, route_attr);
+    }
+
+    return true;
+}
+
+bool RouteOrch::addRoutePost(const RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpPrefix& ipPrefix = ctx.ip_prefix;
+    const IpAddresses& nextHops = ctx.nhops;
+
+    for (auto status : ctx.object_statuses)
+    {
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        if (ctx.is_create)
+        {
+            SWSS_LOG_ERROR("Failed to create route %s with next hop(s) %s, rv:%d",
+                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str(), status);
+            /* Clean up the newly created next hop group entry */
+            if (nextHops.getSize() > 1)
+            {
+                m_bulkUnusedNextHopGroups.insert(nextHops);
+            }
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to set route %s with next hop(s) %s, rv:%d",
+                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str(), status);
+        }
+        return false;
+    }
+
+    if (ctx.is_create)
+    {
+        if (ipPrefix.isV4())
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        }
+        else
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        }
+
+        /* Increase the ref_count for the next hop (group) entry */
+        increaseNextHopRefCount(nextHops);
+        SWSS_LOG_INFO("Create route %s with next hop(s) %s",
+                ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+    }
+    else
+    {
+        auto it_route = m_syncdRoutes.find(ipPrefix);
+        assert(it_route != m_syncdRoutes.end());
+
+        /* Increase the ref_count for the next hop (group) entry */
+        increaseNextHopRefCount(nextHops);
+
+        decreaseNextHopRefCount(it_route->second);
+        if (it_route->second.getSize() > 1
+            && isRefCounterZero(it_route->second))
+        {
+            m_bulkUnusedNextHopGroups.insert(it_route->second);
+        }
+        SWSS_LOG_INFO("Set route %s with next hop(s) %s",
+                ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+    }
+
+    m_syncdRoutes.set(ipPrefix, nextHops);
+
+    notifyNextHopChangeObservers(ipPrefix, nextHops, true);
+    return true;
+}
+
+/*
+ * Queue the route entry remove operation of the route in the route bulker.
+ * The default route is never removed but set to drop.
+ */
+bool RouteOrch::removeRoute(RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    sai_route_entry_t route_entry;
+    route_entry.vr_id = gVirtualRouterId;
+    route_entry.switch_id = gSwitchId;
+    copy(route_entry.destination, ctx.ip_prefix);
+
+    if (ctx.ip_prefix.isDefaultRoute())
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+        attr.value.s32 = SAI_PACKET_ACTION_DROP;
+
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.setEntryAttribute(&ctx.object_statuses.back(), route_entry, attr);
+
+        attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        attr.value.oid = SAI_NULL_OBJECT_ID;
+
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.setEntryAttribute(&ctx.object_statuses.back(), route_entry, attr);
+    }
+    else
+    {
+        ctx.object_statuses.emplace_back();
+        m_routeBulker.removeEntry(&ctx.object_statuses.back(), route_entry);
+    }
+
+    return true;
+}
+
+bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpPrefix& ipPrefix = ctx.ip_prefix;
+
+    for (auto status : ctx.object_statuses)
+    {
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove route prefix:%s, rv:%d",
+                    ipPrefix.to_string().c_str(), status);
+            return false;
+        }
+    }
+
+    if (!ipPrefix.isDefaultRoute())
+    {
+        if (ipPrefix.isV4())
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        }
+    }
+
+    auto it_route = m_syncdRoutes.find(ipPrefix);
+    assert(it_route != m_syncdRoutes.end());
+
+    /* Next hop groups are removed at the end of the bulk flush */
+    decreaseNextHopRefCount(it_route->second);
+    if (it_route->second.getSize() > 1
+        && isRefCounterZero(it_route->second))
+    {
+        m_bulkUnusedNextHopGroups.insert(it_route->second);
+    }
+    SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
+            ipPrefix.to_string().c_str(), it_route->second.to_string().c_str());
+
+    if (ipPrefix.isDefaultRoute())
+    {
+        m_syncdRoutes.set(ipPrefix, IpAddresses());
+
+        /* Notify about default route next hop change */
+        notifyNextHopChangeObservers(ipPrefix, IpAddresses(), true);
+    }
+    else
+    {
+        m_syncdRoutes.erase(it_route);
+
+        /* Notify about the route next hop removal */
+        notifyNextHopChangeObservers(ipPrefix, IpAddresses(), false);
+    }
+
+    return true;
+}
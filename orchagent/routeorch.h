@@ -9,21 +9,17 @@
 #include "ipaddress.h"
 #include "ipaddresses.h"
 #include "ipprefix.h"
+#include "bulker.h"
+#include "routetable.h"
+#include "nexthopgroup.h"
 
 #include <map>
+#include <list>
+#include <deque>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
 
-typedef std::map<IpAddress, sai_object_id_t> NextHopGroupMembers;
-
-struct NextHopGroupEntry
-{
-    sai_object_id_t         next_hop_group_id;      // next hop group id
-    int                     ref_count;              // reference count
-    NextHopGroupMembers     nhopgroup_members;      // ids of members indexed by ip address
-};
-
 struct NextHopUpdate
 {
     IpAddress destination;
@@ -33,10 +29,6 @@ struct NextHopUpdate
 
 struct NextHopObserverEntry;
 
-/* NextHopGroupTable: next hop group IP addersses, NextHopGroupEntry */
-typedef std::map<IpAddresses, NextHopGroupEntry> NextHopGroupTable;
-/* RouteTable: destination network, next hop IP address(es) */
-typedef std::map<IpPrefix, IpAddresses> RouteTable;
 /* NextHopObserverTable: Destination IP address, next hop observer entry */
 typedef std::map<IpAddress, NextHopObserverEntry> NextHopObserverTable;
 
@@ -46,6 +38,22 @@ struct NextHopObserverEntry
     list<Observer *> observers;
 };
 
+/* RouteBulkContext: route task queued in the route bulker, pending flush */
+struct RouteBulkContext
+{
+    SyncMap::iterator           task;               // pending task in consumer m_toSync
+    IpPrefix                    ip_prefix;          // destination network
+    IpAddresses                 nhops;              // next hop IP address(es) to program
+    bool                        is_remove;          // remove operation
+    bool                        is_create;          // create operation, set otherwise
+    std::deque<sai_status_t>    object_statuses;    // statuses of the queued bulk operations
+
+    RouteBulkContext(SyncMap::iterator t, const IpPrefix &prefix, const IpAddresses &addresses, bool remove)
+        : task(t), ip_prefix(prefix), nhops(addresses), is_remove(remove), is_create(false)
+    {
+    }
+};
+
 class RouteOrch : public Orch, public Subject
 {
 public:
@@ -57,12 +65,12 @@ public:
     void attach(Observer *, const IpAddress&);
     void detach(Observer *, const IpAddress&);
 
-    void increaseNextHopRefCount(IpAddresses);
-    void decreaseNextHopRefCount(IpAddresses);
+    void increaseNextHopRefCount(const IpAddresses&);
+    void decreaseNextHopRefCount(const IpAddresses&);
     bool isRefCounterZero(const IpAddresses&) const;
 
-    bool addNextHopGroup(IpAddresses);
-    bool removeNextHopGroup(IpAddresses);
+    bool addNextHopGroup(const IpAddresses&);
+    bool removeNextHopGroup(const IpAddresses&);
 
     bool validnexthopinNextHopGroup(const IpAddress &);
     bool invalidnexthopinNextHopGroup(const IpAddress &);
@@ -80,10 +88,24 @@ private:
 
     NextHopObserverTable m_nextHopObservers;
 
+    bool m_bulkMode;
+    RouteBulker m_routeBulker;
+    NextHopGroupMemberBulker m_nextHopGroupMemberBulker;
+    /* Next hop groups whose reference count dropped to zero during a bulk flush */
+    set<IpAddresses> m_bulkUnusedNextHopGroups;
+
     void addTempRoute(IpPrefix, IpAddresses);
+    bool getNextHopIdForRoute(const IpPrefix&, const IpAddresses&, sai_object_id_t&);
     bool addRoute(IpPrefix, IpAddresses);
     bool removeRoute(IpPrefix);
 
+    bool addRoute(RouteBulkContext&);
+    bool addRoutePost(const RouteBulkContext&);
+    bool removeRoute(RouteBulkContext&);
+    bool removeRoutePost(const RouteBulkContext&);
+    void flushRouteBulk(Consumer&, list<RouteBulkContext>&);
+    void waitForNextHops(Consumer&, const string&, const IpAddresses&);
+
     void doTask(Consumer& consumer);
 };
 
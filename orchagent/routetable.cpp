@@ -0,0 +1,214 @@
+#include <assert.h>
+#include "routetable.h"
+
+const uint32_t NextHopSetTable::EMPTY_NEXTHOP_SET_ID;
+
+NextHopSetTable::NextHopSetTable()
+{
+    /* Reserve the id of the empty set, it is never released */
+    m_entries.push_back({ IpAddresses(), 0 });
+}
+
+uint32_t NextHopSetTable::acquire(const IpAddresses &nexthops)
+{
+    if (nexthops.getSize() == 0)
+    {
+        return EMPTY_NEXTHOP_SET_ID;
+    }
+
+    auto it = m_index.find(nexthops);
+    if (it != m_index.end())
+    {
+        m_entries[it->second].ref_count++;
+        return it->second;
+    }
+
+    uint32_t id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_entries[id] = { nexthops, 1 };
+    }
+    else
+    {
+        id = (uint32_t)m_entries.size();
+        m_entries.push_back({ nexthops, 1 });
+    }
+
+    m_index.emplace(nexthops, id);
+    return id;
+}
+
+void NextHopSetTable::release(uint32_t id)
+{
+    if (id == EMPTY_NEXTHOP_SET_ID)
+    {
+        return;
+    }
+
+    assert(m_entries[id].ref_count > 0);
+
+    if (--m_entries[id].ref_count == 0)
+    {
+        m_index.erase(m_entries[id].nexthops);
+        m_entries[id].nexthops = IpAddresses();
+        m_freeIds.push_back(id);
+    }
+}
+
+RouteTable::value_type RouteTable::iterator::operator*() const
+{
+    ip_addr_t ip;
+    memset(&ip, 0, sizeof(ip));
+
+    if (m_v4 != NULL)
+    {
+        ip.family = AF_INET;
+        memcpy(&ip.ip_addr.ipv4_addr, m_v4->key, sizeof(m_v4->key));
+        return value_type(IpPrefix(ip, m_v4->len), m_table->m_nextHopSets.get(m_v4->value));
+    }
+
+    ip.family = AF_INET6;
+    memcpy(ip.ip_addr.ipv6_addr, m_v6->key, sizeof(m_v6->key));
+    return value_type(IpPrefix(ip, m_v6->len), m_table->m_nextHopSets.get(m_v6->value));
+}
+
+RouteTable::iterator& RouteTable::iterator::operator++()
+{
+    if (m_v4 != NULL)
+    {
+        m_v4 = m_table->m_v4Routes.next(m_v4);
+        if (m_v4 == NULL)
+        {
+            m_v6 = m_table->m_v6Routes.first();
+        }
+    }
+    else if (m_v6 != NULL)
+    {
+        m_v6 = m_table->m_v6Routes.next(m_v6);
+    }
+    return *this;
+}
+
+RouteTable::iterator RouteTable::iterator::operator++(int)
+{
+    iterator it = *this;
+    ++(*this);
+    return it;
+}
+
+RouteTable::iterator RouteTable::begin() const
+{
+    auto v4 = m_v4Routes.first();
+    if (v4 != NULL)
+    {
+        return iterator(this, v4, NULL);
+    }
+
+    auto v6 = m_v6Routes.first();
+    if (v6 != NULL)
+    {
+        return iterator(this, NULL, v6);
+    }
+
+    return end();
+}
+
+RouteTable::iterator RouteTable::find(const IpPrefix &prefix) const
+{
+    ip_addr_t ip = prefix.getIp().getIp();
+    uint8_t len = (uint8_t)prefix.getMaskLength();
+
+    if (ip.family == AF_INET)
+    {
+        auto node = m_v4Routes.find(reinterpret_cast<const uint8_t *>(&ip.ip_addr.ipv4_addr), len);
+        return node != NULL ? iterator(this, node, NULL) : end();
+    }
+
+    auto node = m_v6Routes.find(ip.ip_addr.ipv6_addr, len);
+    return node != NULL ? iterator(this, NULL, node) : end();
+}
+
+pair<RouteTable::iterator, bool> RouteTable::insert(const IpPrefix &prefix, const IpAddresses &nexthops)
+{
+    ip_addr_t ip = prefix.getIp().getIp();
+    uint8_t len = (uint8_t)prefix.getMaskLength();
+    bool inserted = false;
+
+    if (ip.family == AF_INET)
+    {
+        auto node = m_v4Routes.insert(reinterpret_cast<const uint8_t *>(&ip.ip_addr.ipv4_addr), len,
+                                      NextHopSetTable::EMPTY_NEXTHOP_SET_ID, inserted);
+        if (inserted)
+        {
+            node->value = m_nextHopSets.acquire(nexthops);
+        }
+        return make_pair(iterator(this, node, NULL), inserted);
+    }
+
+    auto node = m_v6Routes.insert(ip.ip_addr.ipv6_addr, len,
+                                  NextHopSetTable::EMPTY_NEXTHOP_SET_ID, inserted);
+    if (inserted)
+    {
+        node->value = m_nextHopSets.acquire(nexthops);
+    }
+    return make_pair(iterator(this, NULL, node), inserted);
+}
+
+RouteTable::iterator RouteTable::set(const IpPrefix &prefix, const IpAddresses &nexthops)
+{
+    auto res = insert(prefix, nexthops);
+    if (res.second)
+    {
+        return res.first;
+    }
+
+    /* Acquire first, the new set may be the current one */
+    uint32_t id = m_nextHopSets.acquire(nexthops);
+    uint32_t &value = res.first.m_v4 != NULL ? res.first.m_v4->value : res.first.m_v6->value;
+    m_nextHopSets.release(value);
+    value = id;
+
+    return res.first;
+}
+
+void RouteTable::erase(iterator it)
+{
+    if (it.m_v4 != NULL)
+    {
+        m_nextHopSets.release(it.m_v4->value);
+        m_v4Routes.erase(it.m_v4);
+    }
+    else if (it.m_v6 != NULL)
+    {
+        m_nextHopSets.release(it.m_v6->value);
+        m_v6Routes.erase(it.m_v6);
+    }
+}
+
+size_t RouteTable::erase(const IpPrefix &prefix)
+{
+    auto it = find(prefix);
+    if (it == end())
+    {
+        return 0;
+    }
+
+    erase(it);
+    return 1;
+}
+
+RouteTable::iterator RouteTable::longestMatch(const IpAddress &address) const
+{
+    ip_addr_t ip = address.getIp();
+
+    if (ip.family == AF_INET)
+    {
+        auto node = m_v4Routes.longestMatch(reinterpret_cast<const uint8_t *>(&ip.ip_addr.ipv4_addr), 32);
+        return node != NULL ? iterator(this, node, NULL) : end();
+    }
+
+    auto node = m_v6Routes.longestMatch(ip.ip_addr.ipv6_addr, 128);
+    return node != NULL ? iterator(this, NULL, node) : end();
+}
@@ -0,0 +1,164 @@
+#ifndef SWSS_ROUTETABLE_H
+#define SWSS_ROUTETABLE_H
+
+#include <deque>
+#include <map>
+#include <vector>
+#include <utility>
+
+#include "ipaddress.h"
+#include "ipaddresses.h"
+#include "ipprefix.h"
+
+#include "prefixtrie.h"
+#include "nexthopgroup.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * NextHopSetTable: interned next hop IP address sets.
+ *
+ * Each distinct set of next hops is stored once and referred to by a small
+ * id. Ids are reference counted and recycled once no route uses them. Id 0
+ * is reserved for the empty set (route without next hop). Entries are kept
+ * in a deque so that a reference returned by get() survives the interning
+ * of new sets.
+ */
+class NextHopSetTable
+{
+public:
+    static const uint32_t EMPTY_NEXTHOP_SET_ID = 0;
+
+    NextHopSetTable();
+
+    /* Get the id of the set, interning it if needed, and take a reference */
+    uint32_t acquire(const IpAddresses &nexthops);
+    /* Drop a reference, the set is released when no reference is left */
+    void release(uint32_t id);
+
+    const IpAddresses &get(uint32_t id) const { return m_entries[id].nexthops; }
+
+    /* Number of distinct sets currently interned, including the empty set */
+    size_t size() const { return m_index.size() + 1; }
+
+private:
+    struct NextHopSetEntry
+    {
+        IpAddresses nexthops;
+        uint32_t    ref_count;
+    };
+
+    deque<NextHopSetEntry> m_entries;
+    vector<uint32_t> m_freeIds;
+    unordered_map<IpAddresses, uint32_t, NextHopsHash> m_index;
+};
+
+/*
+ * RouteTable: destination network, next hop IP address(es)
+ *
+ * Prefixes are kept in one path-compressed trie per address family and map
+ * to an interned next hop set id. The interface follows the subset of
+ * std::map<IpPrefix, IpAddresses> used by RouteOrch; dereferencing an
+ * iterator yields a (prefix, next hops) pair built on the fly, next hops
+ * being a reference to the interned set. Iterators stay valid until their
+ * own route is erased. The next hops reference stays valid while the route
+ * keeps these next hops: once the route is erased or set to other next hops,
+ * the set may be released and its slot reused for another set.
+ *
+ * Unlike std::map, iteration is not in sorted prefix order: IPv4 routes come
+ * first, then IPv6 routes, each in the pre-order of their trie.
+ */
+class RouteTable
+{
+public:
+    typedef pair<IpPrefix, const IpAddresses&> value_type;
+
+    class iterator
+    {
+    public:
+        struct ArrowProxy
+        {
+            value_type value;
+            const value_type *operator->() const { return &value; }
+        };
+
+        iterator() : m_table(NULL), m_v4(NULL), m_v6(NULL) {}
+
+        value_type operator*() const;
+        ArrowProxy operator->() const { return ArrowProxy{ **this }; }
+
+        iterator& operator++();
+        iterator operator++(int);
+
+        bool operator==(const iterator &o) const { return m_v4 == o.m_v4 && m_v6 == o.m_v6; }
+        bool operator!=(const iterator &o) const { return !(*this == o); }
+
+    private:
+        friend class RouteTable;
+
+        typedef PrefixTrie<4, uint32_t>::Node V4Node;
+        typedef PrefixTrie<16, uint32_t>::Node V6Node;
+
+        iterator(const RouteTable *table, V4Node *v4, V6Node *v6)
+            : m_table(table), m_v4(v4), m_v6(v6) {}
+
+        const RouteTable *m_table;
+        V4Node *m_v4;
+        V6Node *m_v6;
+    };
+
+    RouteTable() = default;
+    RouteTable(RouteTable&&) = default;
+    RouteTable(const RouteTable&) = delete;
+    RouteTable& operator=(const RouteTable&) = delete;
+
+    iterator begin() const;
+    iterator end() const { return iterator(); }
+
+    size_t size() const { return m_v4Routes.size() + m_v6Routes.size(); }
+    bool empty() const { return size() == 0; }
+
+    iterator find(const IpPrefix &prefix) const;
+
+    /* Insert the route if the prefix is not in the table yet */
+    pair<iterator, bool> insert(const IpPrefix &prefix, const IpAddresses &nexthops);
+    /* Insert the route or replace the next hops of an existing route */
+    iterator set(const IpPrefix &prefix, const IpAddresses &nexthops);
+
+    void erase(iterator it);
+    size_t erase(const IpPrefix &prefix);
+
+    /* Longest prefix match, returns end() if no route covers the address */
+    iterator longestMatch(const IpAddress &address) const;
+
+    /* Call f(iterator) for every route covering the address, shortest prefix first */
+    template <typename F>
+    void forEachMatch(const IpAddress &address, F f) const;
+
+    /* Number of distinct next hop sets used by the routes */
+    size_t nextHopSetCount() const { return m_nextHopSets.size(); }
+
+private:
+    PrefixTrie<4, uint32_t> m_v4Routes;
+    PrefixTrie<16, uint32_t> m_v6Routes;
+    NextHopSetTable m_nextHopSets;
+};
+
+template <typename F>
+void RouteTable::forEachMatch(const IpAddress &address, F f) const
+{
+    ip_addr_t ip = address.getIp();
+    if (ip.family == AF_INET)
+    {
+        m_v4Routes.forEachMatch(reinterpret_cast<const uint8_t *>(&ip.ip_addr.ipv4_addr), 32,
+                [&](iterator::V4Node *node) { f(iterator(this, node, NULL)); });
+    }
+    else
+    {
+        m_v6Routes.forEachMatch(ip.ip_addr.ipv6_addr, 128,
+                [&](iterator::V6Node *node) { f(iterator(this, NULL, node)); });
+    }
+}
+
+#endif /* SWSS_ROUTETABLE_H */
@@ -45,8 +45,6 @@ sai_bmtor_api_t*            sai_bmtor_api;
 extern sai_object_id_t gSwitchId;
 extern bool gSairedisRecord;
 extern bool gSwssRecord;
-extern ofstream gRecordOfs;
-extern string gRecordFile;
 
 map<string, string> gProfileMap;
 
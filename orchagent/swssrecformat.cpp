@@ -0,0 +1,237 @@
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "swssrecformat.h"
+
+using namespace std;
+
+namespace
+{
+    /* Larger records are taken for corruption */
+    const uint32_t MAX_RECORD_SIZE = 64 * 1024 * 1024;
+
+    void putU32(string &out, uint32_t v)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            out.push_back((char)((v >> (8 * i)) & 0xff));
+        }
+    }
+
+    void putU64(string &out, uint64_t v)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            out.push_back((char)((v >> (8 * i)) & 0xff));
+        }
+    }
+
+    void putString(string &out, const string &s)
+    {
+        putU32(out, (uint32_t)s.size());
+        out.append(s);
+    }
+
+    class Reader
+    {
+    public:
+        Reader(const char *data, size_t size) :
+            m_data(data),
+            m_size(size),
+            m_pos(0)
+        {
+        }
+
+        bool getU8(uint8_t &v)
+        {
+            if (m_size - m_pos < 1)
+            {
+                return false;
+            }
+            v = (uint8_t)m_data[m_pos++];
+            return true;
+        }
+
+        bool getU32(uint32_t &v)
+        {
+            if (m_size - m_pos < 4)
+            {
+                return false;
+            }
+            v = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                v |= (uint32_t)(uint8_t)m_data[m_pos++] << (8 * i);
+            }
+            return true;
+        }
+
+        bool getU64(uint64_t &v)
+        {
+            if (m_size - m_pos < 8)
+            {
+                return false;
+            }
+            v = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                v |= (uint64_t)(uint8_t)m_data[m_pos++] << (8 * i);
+            }
+            return true;
+        }
+
+        bool getString(string &s)
+        {
+            uint32_t len;
+            if (!getU32(len) || m_size - m_pos < len)
+            {
+                return false;
+            }
+            s.assign(m_data + m_pos, len);
+            m_pos += len;
+            return true;
+        }
+
+        bool done() const
+        {
+            return m_pos == m_size;
+        }
+
+    private:
+        const char *m_data;
+        size_t m_size;
+        size_t m_pos;
+    };
+}
+
+string formatSwssRecordText(const SwssRecord &record)
+{
+    /* Same timestamp as swss::getTimestamp() */
+    time_t secs = (time_t)(record.time / 1000000);
+    long usecs = (long)(record.time % 1000000);
+    struct tm tm;
+    char buffer[64];
+
+    localtime_r(&secs, &tm);
+    size_t size = strftime(buffer, 32, "%Y-%m-%d.%T.", &tm);
+    snprintf(&buffer[size], 32, "%06ld", usecs);
+
+    string s(buffer);
+    s += "|";
+
+    if (record.type == SWSS_REC_MESSAGE)
+    {
+        return s + record.table;
+    }
+
+    s += record.table + record.key + "|" + record.op;
+    for (const auto &fv : record.values)
+    {
+        s += "|" + fv.first + ":" + fv.second;
+    }
+
+    return s;
+}
+
+void encodeSwssRecord(const SwssRecord &record, string &out)
+{
+    size_t start = out.size();
+    putU32(out, 0);
+
+    out.push_back((char)record.type);
+    putU64(out, (uint64_t)record.time);
+    putString(out, record.table);
+
+    if (record.type == SWSS_REC_TUPLE)
+    {
+        putString(out, record.key);
+        putString(out, record.op);
+        putU32(out, (uint32_t)record.values.size());
+        for (const auto &fv : record.values)
+        {
+            putString(out, fv.first);
+            putString(out, fv.second);
+        }
+    }
+
+    uint32_t length = (uint32_t)(out.size() - start - 4);
+    for (int i = 0; i < 4; i++)
+    {
+        out[start + i] = (char)((length >> (8 * i)) & 0xff);
+    }
+}
+
+bool decodeSwssRecord(const char *data, size_t size, size_t &offset, SwssRecord &record, bool &error)
+{
+    error = false;
+
+    size_t pos = offset;
+    while (isSwssRecordBinary(data + pos, size - pos))
+    {
+        pos += SWSS_REC_MAGIC_SIZE;
+    }
+
+    /* Start of a magic header */
+    if (size - pos < SWSS_REC_MAGIC_SIZE && memcmp(data + pos, SWSS_REC_MAGIC, size - pos) == 0)
+    {
+        return false;
+    }
+
+    Reader header(data + pos, size - pos);
+    uint32_t length;
+    if (!header.getU32(length))
+    {
+        return false;
+    }
+    if (length > MAX_RECORD_SIZE)
+    {
+        error = true;
+        return false;
+    }
+    if (size - pos - 4 < length)
+    {
+        return false;
+    }
+
+    Reader reader(data + pos + 4, length);
+    uint8_t type = 0;
+    uint64_t time = 0;
+
+    bool ok = reader.getU8(type) && reader.getU64(time) && reader.getString(record.table);
+    record.type = (SwssRecType)type;
+    record.time = (int64_t)time;
+    record.key.clear();
+    record.op.clear();
+    record.values.clear();
+
+    if (ok && type == SWSS_REC_TUPLE)
+    {
+        uint32_t count;
+        ok = reader.getString(record.key) && reader.getString(record.op) && reader.getU32(count);
+        for (uint32_t i = 0; ok && i < count; i++)
+        {
+            string field, value;
+            ok = reader.getString(field) && reader.getString(value);
+            record.values.emplace_back(move(field), move(value));
+        }
+    }
+    else if (ok && type != SWSS_REC_MESSAGE)
+    {
+        ok = false;
+    }
+
+    if (!ok || !reader.done())
+    {
+        error = true;
+        return false;
+    }
+
+    offset = pos + 4 + length;
+    return true;
+}
+
+bool isSwssRecordBinary(const char *data, size_t size)
+{
+    return size >= SWSS_REC_MAGIC_SIZE && memcmp(data, SWSS_REC_MAGIC, SWSS_REC_MAGIC_SIZE) == 0;
+}
@@ -0,0 +1,64 @@
+#ifndef SWSS_SWSSRECFORMAT_H
+#define SWSS_SWSSRECFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * swss.rec records.
+ *
+ * The text format is one line per record:
+ *   <timestamp>|<table><separator><key>|<op>|<field>:<value>|...
+ *   <timestamp>|<message>
+ *
+ * The binary format starts with SWSS_REC_MAGIC, written again each time the
+ * recording is opened, followed by length-prefixed records. Integers are
+ * little endian:
+ *   u32 length of the rest of the record
+ *   u8  type, SWSS_REC_TUPLE or SWSS_REC_MESSAGE
+ *   i64 time, usecs since the epoch
+ *   tuple: table, key and op strings, u32 count, count field and value strings
+ *   message: text string
+ * where a string is a u32 length followed by the bytes.
+ */
+
+#define SWSS_REC_MAGIC "SWSSREC\x01"
+#define SWSS_REC_MAGIC_SIZE 8
+
+enum SwssRecType
+{
+    SWSS_REC_TUPLE = 0,
+    SWSS_REC_MESSAGE = 1,
+};
+
+struct SwssRecord
+{
+    SwssRecType type = SWSS_REC_TUPLE;
+    /* usecs since the epoch */
+    int64_t time = 0;
+    /* Table name with its key separator, or the message text */
+    std::string table;
+    std::string key;
+    std::string op;
+    std::vector<std::pair<std::string, std::string>> values;
+};
+
+/* Format the record as a swss.rec text line, without the newline */
+std::string formatSwssRecordText(const SwssRecord &record);
+
+/* Append the binary record to out */
+void encodeSwssRecord(const SwssRecord &record, std::string &out);
+
+/*
+ * Decode the binary record at offset and advance offset past it, skipping a
+ * magic header in front of it. Return false, without moving offset, if the
+ * data does not hold a complete record yet; set error if it is corrupted.
+ */
+bool decodeSwssRecord(const char *data, size_t size, size_t &offset, SwssRecord &record, bool &error);
+
+bool isSwssRecordBinary(const char *data, size_t size);
+
+#endif /* SWSS_SWSSRECFORMAT_H */
@@ -0,0 +1,429 @@
+#include <chrono>
+#include <cstdio>
+#include <sys/stat.h>
+
+#include "logger.h"
+#include "tokenize.h"
+#include "swssrecorder.h"
+
+using namespace std;
+using namespace swss;
+
+/* Records formatted before each write to the file */
+#define SWSS_RECORDER_DRAIN_SIZE 1024
+/* The writer wakes up at least this often when the ring is empty */
+#define SWSS_RECORDER_IDLE_MSECS 100
+#define SWSS_RECORDER_BUFFER_SIZE (128 * 1024)
+#define SWSS_RECORDER_DEFAULT_FILES 5
+
+SwssRecorder::SwssRecorder(size_t ringSize) :
+    m_enqueuePos(0),
+    m_dequeuePos(0),
+    m_gz(nullptr),
+    m_fileBytes(0),
+    m_running(false),
+    m_stop(false),
+    m_reopen(false),
+    m_idle(false),
+    m_writtenPos(0)
+{
+    size_t size = 2;
+    while (size < ringSize)
+    {
+        size <<= 1;
+    }
+
+    m_ring.reset(new Slot[size]);
+    m_mask = size - 1;
+    for (size_t i = 0; i < size; i++)
+    {
+        m_ring[i].sequence.store(i, memory_order_relaxed);
+    }
+}
+
+SwssRecorder::~SwssRecorder()
+{
+    close();
+}
+
+bool SwssRecorder::parseOptions(const string &options, SwssRecorderOptions &config)
+{
+    config = SwssRecorderOptions();
+
+    if (options.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        for (const auto &item : tokenize(options, ','))
+        {
+            if (item == "binary")
+            {
+                config.binary = true;
+            }
+            else if (item == "gzip")
+            {
+                config.compress = true;
+            }
+            else if (item.compare(0, 5, "size=") == 0)
+            {
+                config.maxFileSize = stoull(item.substr(5)) * 1024 * 1024;
+            }
+            else if (item.compare(0, 6, "files=") == 0)
+            {
+                config.maxFiles = (uint32_t)stoul(item.substr(6));
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+    catch (const exception &)
+    {
+        return false;
+    }
+
+    if (config.maxFileSize && options.find("files=") == string::npos)
+    {
+        config.maxFiles = SWSS_RECORDER_DEFAULT_FILES;
+    }
+
+    return true;
+}
+
+string SwssRecorder::getFileName(const string &location, const SwssRecorderOptions &options)
+{
+    string file = location + "/" + "swss.rec";
+
+    if (options.binary)
+    {
+        file += ".bin";
+    }
+    if (options.compress)
+    {
+        file += ".gz";
+    }
+
+    return file;
+}
+
+bool SwssRecorder::open(const string &file, const SwssRecorderOptions &options)
+{
+    SWSS_LOG_ENTER();
+
+    close();
+
+    m_file = file;
+    m_options = options;
+
+    if (!openFile())
+    {
+        return false;
+    }
+
+    m_running = true;
+    m_writer = thread(&SwssRecorder::run, this);
+
+    return true;
+}
+
+void SwssRecorder::close()
+{
+    /* The writer cannot wait for itself, e.g. when it aborts */
+    if (m_writer.get_id() == this_thread::get_id())
+    {
+        return;
+    }
+
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    m_writer.join();
+
+    m_stop = false;
+}
+
+bool SwssRecorder::isOpen() const
+{
+    return m_running;
+}
+
+void SwssRecorder::record(const string &table, const string &separator, const string &key,
+                          const string &op, const vector<pair<string, string>> &values)
+{
+    if (!m_running.load(memory_order_relaxed))
+    {
+        return;
+    }
+
+    auto now = chrono::system_clock::now().time_since_epoch();
+
+    size_t pos;
+    Slot &slot = acquire(pos);
+
+    /* Assigned in place, the slot strings keep their capacity */
+    slot.record.type = SWSS_REC_TUPLE;
+    slot.record.time = chrono::duration_cast<chrono::microseconds>(now).count();
+    slot.record.table.assign(table);
+    slot.record.table.append(separator);
+    slot.record.key.assign(key);
+    slot.record.op.assign(op);
+    slot.record.values = values;
+
+    publish(slot, pos);
+}
+
+void SwssRecorder::recordMessage(const string &message)
+{
+    if (!m_running.load(memory_order_relaxed))
+    {
+        return;
+    }
+
+    auto now = chrono::system_clock::now().time_since_epoch();
+
+    size_t pos;
+    Slot &slot = acquire(pos);
+
+    slot.record.type = SWSS_REC_MESSAGE;
+    slot.record.time = chrono::duration_cast<chrono::microseconds>(now).count();
+    slot.record.table.assign(message);
+    slot.record.key.clear();
+    slot.record.op.clear();
+    slot.record.values.clear();
+
+    publish(slot, pos);
+}
+
+void SwssRecorder::reopen()
+{
+    m_reopen = true;
+    m_wakeup.notify_one();
+}
+
+void SwssRecorder::flush()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    size_t target = m_enqueuePos.load();
+
+    unique_lock<mutex> lock(m_mutex);
+    m_wakeup.notify_one();
+    m_flushed.wait(lock, [&] { return m_writtenPos >= target || !m_running; });
+}
+
+/*
+ * Bounded multi-producer queue: a slot is free for the producer at pos when
+ * its sequence is pos, and ready for the writer when it is pos + 1.
+ */
+SwssRecorder::Slot &SwssRecorder::acquire(size_t &pos)
+{
+    pos = m_enqueuePos.load(memory_order_relaxed);
+
+    while (true)
+    {
+        Slot &slot = m_ring[pos & m_mask];
+        size_t sequence = slot.sequence.load(memory_order_acquire);
+        auto diff = (intptr_t)sequence - (intptr_t)pos;
+
+        if (diff == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+            {
+                return slot;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* Full, wait for the writer */
+            m_wakeup.notify_one();
+            this_thread::yield();
+            pos = m_enqueuePos.load(memory_order_relaxed);
+        }
+        else
+        {
+            pos = m_enqueuePos.load(memory_order_relaxed);
+        }
+    }
+}
+
+void SwssRecorder::publish(Slot &slot, size_t pos)
+{
+    slot.sequence.store(pos + 1, memory_order_release);
+
+    if (m_idle.load(memory_order_relaxed))
+    {
+        m_wakeup.notify_one();
+    }
+}
+
+void SwssRecorder::run()
+{
+    bool unflushed = false;
+
+    while (true)
+    {
+        size_t count = drain();
+
+        if (!m_buffer.empty())
+        {
+            if (m_gz && gzwrite(m_gz, m_buffer.data(), (unsigned)m_buffer.size()) <= 0)
+            {
+                SWSS_LOG_ERROR("Failed to write SwSS recording file %s", m_file.c_str());
+            }
+            m_fileBytes += m_buffer.size();
+            m_buffer.clear();
+            unflushed = true;
+
+            if (m_options.maxFileSize && m_fileBytes >= m_options.maxFileSize)
+            {
+                rotate();
+            }
+        }
+
+        if (count)
+        {
+            continue;
+        }
+
+        /* Drained, the file is kept up to date for its readers */
+        if (unflushed && m_gz)
+        {
+            gzflush(m_gz, Z_SYNC_FLUSH);
+        }
+        unflushed = false;
+
+        if (m_reopen.exchange(false))
+        {
+            closeFile();
+            openFile();
+        }
+
+        unique_lock<mutex> lock(m_mutex);
+
+        m_writtenPos = m_dequeuePos;
+        m_flushed.notify_all();
+
+        auto ready = [&] {
+            return m_ring[m_dequeuePos & m_mask].sequence.load(memory_order_acquire) == m_dequeuePos + 1;
+        };
+
+        if (m_stop && !ready())
+        {
+            break;
+        }
+
+        m_idle = true;
+        m_wakeup.wait_for(lock, chrono::milliseconds(SWSS_RECORDER_IDLE_MSECS),
+                          [&] { return m_stop || m_reopen || ready(); });
+        m_idle = false;
+    }
+
+    closeFile();
+
+    lock_guard<mutex> lock(m_mutex);
+    m_flushed.notify_all();
+}
+
+size_t SwssRecorder::drain()
+{
+    size_t count = 0;
+
+    while (count < SWSS_RECORDER_DRAIN_SIZE)
+    {
+        Slot &slot = m_ring[m_dequeuePos & m_mask];
+        if (slot.sequence.load(memory_order_acquire) != m_dequeuePos + 1)
+        {
+            break;
+        }
+
+        if (m_options.binary)
+        {
+            encodeSwssRecord(slot.record, m_buffer);
+        }
+        else
+        {
+            m_buffer += formatSwssRecordText(slot.record);
+            m_buffer += '\n';
+        }
+
+        slot.sequence.store(m_dequeuePos + m_mask + 1, memory_order_release);
+        m_dequeuePos++;
+        count++;
+    }
+
+    return count;
+}
+
+bool SwssRecorder::openFile()
+{
+    SWSS_LOG_ENTER();
+
+    struct stat st;
+    m_fileBytes = stat(m_file.c_str(), &st) == 0 ? (uint64_t)st.st_size : 0;
+
+    /* T: appended without compression, still read back through zlib */
+    m_gz = gzopen(m_file.c_str(), m_options.compress ? "ab" : "abT");
+    if (!m_gz)
+    {
+        SWSS_LOG_ERROR("Failed to open SwSS recording file %s", m_file.c_str());
+        return false;
+    }
+
+    gzbuffer(m_gz, SWSS_RECORDER_BUFFER_SIZE);
+
+    if (m_options.binary)
+    {
+        gzwrite(m_gz, SWSS_REC_MAGIC, SWSS_REC_MAGIC_SIZE);
+        m_fileBytes += SWSS_REC_MAGIC_SIZE;
+    }
+
+    return true;
+}
+
+void SwssRecorder::closeFile()
+{
+    if (m_gz)
+    {
+        gzclose(m_gz);
+        m_gz = nullptr;
+    }
+}
+
+void SwssRecorder::rotate()
+{
+    SWSS_LOG_ENTER();
+
+    closeFile();
+
+    if (m_options.maxFiles)
+    {
+        for (uint32_t i = m_options.maxFiles; i > 1; i--)
+        {
+            rename((m_file + "." + to_string(i - 1)).c_str(), (m_file + "." + to_string(i)).c_str());
+        }
+        rename(m_file.c_str(), (m_file + ".1").c_str());
+    }
+    else
+    {
+        remove(m_file.c_str());
+    }
+
+    if (!openFile())
+    {
+        SWSS_LOG_ERROR("SwSS recording stopped, failed to rotate %s", m_file.c_str());
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef SWSS_SWSSRECORDER_H
+#define SWSS_SWSSRECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
+
+#include "swssrecformat.h"
+
+#define SWSS_RECORDER_RING_SIZE 16384
+
+struct SwssRecorderOptions
+{
+    bool binary = false;
+    bool compress = false;
+    /* Rotate the recording once this many bytes were recorded, 0 to never rotate */
+    uint64_t maxFileSize = 0;
+    /* Rotated recordings kept as file.1 to file.N */
+    uint32_t maxFiles = 0;
+};
+
+/*
+ * SwssRecorder: swss.rec written by a background thread.
+ *
+ * record() only copies the task into a slot of a bounded lock-free ring,
+ * which can be filled from several threads. The writer thread formats the
+ * records, as text or in the binary format of swssrecformat.h, optionally
+ * gzip compressed, and flushes the file when the ring is drained. When the
+ * ring is full, record() waits for the writer: recordings are not lossy.
+ */
+class SwssRecorder
+{
+public:
+    explicit SwssRecorder(size_t ringSize = SWSS_RECORDER_RING_SIZE);
+    ~SwssRecorder();
+
+    SwssRecorder(const SwssRecorder&) = delete;
+    SwssRecorder& operator=(const SwssRecorder&) = delete;
+
+    /*
+     * Comma separated list of:
+     *   binary: record in the binary format
+     *   gzip: compress the recording
+     *   size=N: rotate the recording every N MB
+     *   files=N: number of rotated recordings kept (default 5)
+     */
+    static bool parseOptions(const std::string &options, SwssRecorderOptions &config);
+    /* swss.rec, with a .bin suffix for the binary format and .gz when compressed */
+    static std::string getFileName(const std::string &location, const SwssRecorderOptions &options);
+
+    bool open(const std::string &file, const SwssRecorderOptions &options);
+    /*
+     * Write out the queued records and close the file. Also called on the
+     * fatal paths of orchagent: std::terminate, SIGABRT and exceptions.
+     */
+    void close();
+    bool isOpen() const;
+
+    void record(const std::string &table, const std::string &separator, const std::string &key,
+                const std::string &op, const std::vector<std::pair<std::string, std::string>> &values);
+    void recordMessage(const std::string &message);
+
+    /* Reopen the file, after it was moved away by logrotate */
+    void reopen();
+    /* Wait until the records queued so far are written to the file */
+    void flush();
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        SwssRecord record;
+    };
+
+    std::unique_ptr<Slot[]> m_ring;
+    size_t m_mask;
+    std::atomic<size_t> m_enqueuePos;
+    size_t m_dequeuePos;
+
+    std::string m_file;
+    SwssRecorderOptions m_options;
+    gzFile m_gz;
+    uint64_t m_fileBytes;
+    std::string m_buffer;
+
+    std::thread m_writer;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_reopen;
+    std::atomic<bool> m_idle;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_flushed;
+    size_t m_writtenPos;
+
+    Slot &acquire(size_t &pos);
+    void publish(Slot &slot, size_t pos);
+
+    void run();
+    size_t drain();
+    bool openFile();
+    void closeFile();
+    void rotate();
+};
+
+#endif /* SWSS_SWSSRECORDER_H */
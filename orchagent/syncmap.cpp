@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <unordered_map>
+#include "syncmap.h"
+
+using namespace std;
+using namespace swss;
+
+/* Updates with at least this many fields index them, smaller ones are scanned */
+#define FIELD_INDEX_MIN_SIZE 16
+
+namespace
+{
+    /*
+     * Position of the last value of each field of an update, only the last
+     * value of a field set several times in the same update is kept.
+     */
+    class FieldIndex
+    {
+    public:
+        FieldIndex(const vector<FieldValueTuple> &values) :
+                m_values(values)
+        {
+            if (values.size() < FIELD_INDEX_MIN_SIZE)
+            {
+                return;
+            }
+
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                m_index[fvField(values[i])] = i;
+            }
+        }
+
+        /* Returns the number of values if the field is not set */
+        size_t last(const string &field) const
+        {
+            if (m_values.size() < FIELD_INDEX_MIN_SIZE)
+            {
+                for (size_t i = m_values.size(); i-- > 0;)
+                {
+                    if (fvField(m_values[i]) == field)
+                    {
+                        return i;
+                    }
+                }
+                return m_values.size();
+            }
+
+            auto it = m_index.find(field);
+            return it != m_index.end() ? it->second : m_values.size();
+        }
+
+    private:
+        const vector<FieldValueTuple> &m_values;
+        unordered_map<string, size_t> m_index;
+    };
+}
+
+void mergeToSync(SyncMap &toSync, KeyOpFieldsValuesTuple &&entry)
+{
+    const string &key = kfvKey(entry);
+
+    /* A new task or a DEL task replaces the pending task */
+    auto it = toSync.lower_bound(key);
+    if (it == toSync.end() || it->first != key)
+    {
+        toSync.emplace_hint(it, key, std::move(entry));
+        return;
+    }
+
+    if (kfvOp(entry) == DEL_COMMAND)
+    {
+        it->second = std::move(entry);
+        return;
+    }
+
+    /* Merge the fields in place, in a single pass over each side */
+    auto &existing = kfvFieldsValues(it->second);
+    auto &values = kfvFieldsValues(entry);
+    FieldIndex index(values);
+
+    existing.erase(remove_if(existing.begin(), existing.end(),
+                             [&](const FieldValueTuple &fv) { return index.last(fvField(fv)) != values.size(); }),
+                   existing.end());
+
+    /* Values moved from are before i, the scan of the last value stops at i */
+    existing.reserve(existing.size() + values.size());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (index.last(fvField(values[i])) == i)
+        {
+            existing.push_back(std::move(values[i]));
+        }
+    }
+
+    kfvOp(it->second) = std::move(kfvOp(entry));
+}
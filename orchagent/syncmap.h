@@ -0,0 +1,22 @@
+#ifndef SWSS_SYNCMAP_H
+#define SWSS_SYNCMAP_H
+
+#include <map>
+#include <string>
+
+#include "table.h"
+
+/* Pending tasks of a consumer, by key */
+typedef std::map<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
+
+/*
+ * Add a task to the pending tasks. The task replaces the pending task of the
+ * same key if it is a DEL, otherwise its fields are merged into it: fields
+ * set again take their new value and move to the end, as if the pending task
+ * had been updated field by field. The task is moved from: its fields and
+ * values are moved into the pending task, never copied. Only the key string
+ * is copied, once, when a new key is inserted in the map.
+ */
+void mergeToSync(SyncMap &toSync, swss::KeyOpFieldsValuesTuple &&entry);
+
+#endif /* SWSS_SYNCMAP_H */
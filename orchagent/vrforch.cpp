@@ -80,6 +80,8 @@ bool VRFOrch::addOperation(const Request& request)
 
         vrf_table_[vrf_name] = router_id;
         SWSS_LOG_NOTICE("VRF '%s' was added", vrf_name.c_str());
+
+        notifyObjectReady(OBJECT_TYPE_VRF, vrf_name);
     }
     else
     {
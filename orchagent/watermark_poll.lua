@@ -0,0 +1,23 @@
+-- KEYS - queue or PG IDs
+-- ARGV[1] - counters db index
+-- ARGV[2] - counters table name
+-- ARGV[3] - poll time interval
+-- notify WatermarkOrch that the watermarks of a poll are in COUNTERS, return nothing
+
+local counters_db = ARGV[1]
+local counters_table_name = ARGV[2]
+
+redis.call('SELECT', counters_db)
+
+if table.getn(KEYS) == 0 then
+    return {}
+end
+
+local group = 'PG_WATERMARK'
+if redis.call('HEXISTS', counters_table_name .. ':' .. KEYS[1], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES') == 1 then
+    group = 'QUEUE_WATERMARK'
+end
+
+redis.call('PUBLISH', 'WATERMARK_POLL', '["' .. group .. '",""]')
+
+return {}
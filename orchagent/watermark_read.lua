@@ -0,0 +1,23 @@
+-- KEYS - queue or PG IDs
+-- ARGV[1] - counters db index
+-- ARGV[2] - table name, e.g. COUNTERS or PERSISTENT_WATERMARKS
+-- ARGV[3..n] - watermark stat names
+-- return the stat values of each ID in order, KEYS x stats, false if absent
+
+local counters_db = ARGV[1]
+local table_name = ARGV[2]
+
+local rets = {}
+
+redis.call('SELECT', counters_db)
+
+local n = table.getn(KEYS)
+local m = table.getn(ARGV)
+for i = 1, n do
+    local values = redis.call('HMGET', table_name .. ':' .. KEYS[i], unpack(ARGV, 3, m))
+    for j = 1, m - 2 do
+        table.insert(rets, values[j])
+    end
+end
+
+return rets
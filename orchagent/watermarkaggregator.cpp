@@ -0,0 +1,119 @@
+#include "watermarkaggregator.h"
+
+WatermarkAggregator::Watermark &WatermarkAggregator::getWatermark(const WatermarkKey &key)
+{
+    auto it = m_watermarks.find(key);
+    if (it == m_watermarks.end())
+    {
+        Watermark wm = {};
+        it = m_watermarks.emplace(key, wm).first;
+    }
+    return it->second;
+}
+
+void WatermarkAggregator::setValue(const WatermarkKey &key, Watermark &wm, WatermarkType type, uint64_t value)
+{
+    if (wm.known[type] && wm.value[type] == value)
+    {
+        return;
+    }
+
+    wm.value[type] = value;
+    wm.known[type] = true;
+    wm.dirty[type] = true;
+    m_dirty.insert(key);
+}
+
+void WatermarkAggregator::update(sai_object_id_t id, const string &stat, uint64_t value)
+{
+    WatermarkKey key(id, stat);
+    Watermark &wm = getWatermark(key);
+    bool stale = wm.sampled && wm.sample == value;
+
+    wm.sample = value;
+    wm.sampled = true;
+
+    for (int type = 0; type < WM_TYPE_COUNT; type++)
+    {
+        if (wm.cleared[type])
+        {
+            if (stale)
+            {
+                continue;
+            }
+            wm.cleared[type] = false;
+        }
+
+        if (!wm.known[type] || value > wm.value[type])
+        {
+            setValue(key, wm, (WatermarkType)type, value);
+        }
+    }
+}
+
+void WatermarkAggregator::load(WatermarkType type, sai_object_id_t id, const string &stat, uint64_t value)
+{
+    Watermark &wm = getWatermark(WatermarkKey(id, stat));
+    if (wm.known[type])
+    {
+        return;
+    }
+
+    wm.value[type] = value;
+    wm.known[type] = true;
+}
+
+void WatermarkAggregator::clear(WatermarkType type, const string &stat, const vector<sai_object_id_t> &ids)
+{
+    for (sai_object_id_t id : ids)
+    {
+        WatermarkKey key(id, stat);
+        Watermark &wm = getWatermark(key);
+
+        /* Cleared watermarks are always published, as by the table write it replaces */
+        wm.value[type] = 0;
+        wm.known[type] = true;
+        wm.dirty[type] = true;
+        wm.cleared[type] = wm.sampled;
+        m_dirty.insert(key);
+    }
+}
+
+vector<WatermarkUpdate> WatermarkAggregator::getUpdates()
+{
+    vector<WatermarkUpdate> updates;
+
+    for (const auto &key : m_dirty)
+    {
+        Watermark &wm = m_watermarks.at(key);
+
+        for (int type = 0; type < WM_TYPE_COUNT; type++)
+        {
+            if (wm.dirty[type])
+            {
+                updates.push_back({ (WatermarkType)type, key.first, key.second, wm.value[type] });
+                wm.dirty[type] = false;
+            }
+        }
+    }
+
+    m_dirty.clear();
+    return updates;
+}
+
+bool WatermarkAggregator::hasUpdates() const
+{
+    return !m_dirty.empty();
+}
+
+bool WatermarkAggregator::get(WatermarkType type, sai_object_id_t id, const string &stat, uint64_t &value) const
+{
+    auto it = m_watermarks.find(WatermarkKey(id, stat));
+    if (it == m_watermarks.end() || !it->second.known[type])
+    {
+        return false;
+    }
+
+    value = it->second.value[type];
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef SWSS_WATERMARKAGGREGATOR_H
+#define SWSS_WATERMARKAGGREGATOR_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+enum WatermarkType
+{
+    WM_PERIODIC,
+    WM_PERSISTENT,
+    WM_USER,
+    WM_TYPE_COUNT
+};
+
+struct WatermarkUpdate
+{
+    WatermarkType type;
+    sai_object_id_t id;
+    string stat;
+    uint64_t value;
+};
+
+/*
+ * WatermarkAggregator: periodic, persistent and user watermarks kept in
+ * memory, as an alternative to the watermark_queue.lua and watermark_pg.lua
+ * counters DB plugins.
+ *
+ * Each sample read from COUNTERS is folded into the three maxima, the values
+ * which changed since the last getUpdates() are then published in one batch.
+ *
+ * COUNTERS keeps the value of the last poll until the next one. A sample
+ * equal to the last one is taken as the same poll read again: it is not
+ * folded into the watermarks cleared since that poll.
+ */
+class WatermarkAggregator
+{
+public:
+    /* Fold a sample of a stat read from COUNTERS into the maxima */
+    void update(sai_object_id_t id, const string &stat, uint64_t value);
+    /* Set a watermark to the value already published, ignored if already known */
+    void load(WatermarkType type, sai_object_id_t id, const string &stat, uint64_t value);
+    /* Reset a watermark of some objects to zero */
+    void clear(WatermarkType type, const string &stat, const vector<sai_object_id_t> &ids);
+
+    /* Return the watermarks changed since the last call and mark them published */
+    vector<WatermarkUpdate> getUpdates();
+    bool hasUpdates() const;
+
+    /* Return false if the watermark is not known */
+    bool get(WatermarkType type, sai_object_id_t id, const string &stat, uint64_t &value) const;
+
+private:
+    typedef pair<sai_object_id_t, string> WatermarkKey;
+
+    struct Watermark
+    {
+        uint64_t value[WM_TYPE_COUNT];
+        bool known[WM_TYPE_COUNT];
+        bool dirty[WM_TYPE_COUNT];
+        /* Cleared since the last sample */
+        bool cleared[WM_TYPE_COUNT];
+        uint64_t sample;
+        bool sampled;
+    };
+
+    map<WatermarkKey, Watermark> m_watermarks;
+    set<WatermarkKey> m_dirty;
+
+    Watermark &getWatermark(const WatermarkKey &key);
+    void setValue(const WatermarkKey &key, Watermark &wm, WatermarkType type, uint64_t value);
+};
+
+#endif /* SWSS_WATERMARKAGGREGATOR_H */
@@ -3,15 +3,28 @@
 #include "portsorch.h"
 #include "notifier.h"
 #include "converter.h"
+#include "redisreply.h"
 
 #define DEFAULT_TELEMETRY_INTERVAL 120
+#define WM_PIPELINE_SIZE 4096
+
+#define PG_XOFF_ROOM_WM "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"
+#define PG_SHARED_WM "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"
+#define QUEUE_SHARED_WM "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"
 
 #define CLEAR_PG_HEADROOM_REQUEST "PG_HEADROOM"
 #define CLEAR_PG_SHARED_REQUEST "PG_SHARED"
 #define CLEAR_QUEUE_SHARED_UNI_REQUEST "Q_SHARED_UNI"
 #define CLEAR_QUEUE_SHARED_MULTI_REQUEST "Q_SHARED_MULTI"
 
+/* Published by the watermark_poll.lua plugin after each poll of a watermark group */
+#define WM_POLL_CHANNEL "WATERMARK_POLL"
+
 extern PortsOrch *gPortsOrch;
+extern bool gWatermarkAggregation;
+
+static const vector<string> queueWmNames = { QUEUE_SHARED_WM };
+static const vector<string> pgWmNames = { PG_XOFF_ROOM_WM, PG_SHARED_WM };
 
 
 WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
@@ -22,9 +35,10 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_countersDb = make_shared<DBConnector>(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     m_appDb = make_shared<DBConnector>(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     m_countersTable = make_shared<Table>(m_countersDb.get(), COUNTERS_TABLE);
-    m_periodicWatermarkTable = make_shared<Table>(m_countersDb.get(), PERIODIC_WATERMARKS_TABLE);
-    m_persistentWatermarkTable = make_shared<Table>(m_countersDb.get(), PERSISTENT_WATERMARKS_TABLE);
-    m_userWatermarkTable = make_shared<Table>(m_countersDb.get(), USER_WATERMARKS_TABLE);
+    m_countersPipeline = make_shared<RedisPipeline>(m_countersDb.get(), WM_PIPELINE_SIZE);
+    m_periodicWatermarkTable = make_shared<Table>(m_countersPipeline.get(), PERIODIC_WATERMARKS_TABLE, true);
+    m_persistentWatermarkTable = make_shared<Table>(m_countersPipeline.get(), PERSISTENT_WATERMARKS_TABLE, true);
+    m_userWatermarkTable = make_shared<Table>(m_countersPipeline.get(), USER_WATERMARKS_TABLE, true);
 
     m_clearNotificationConsumer = new swss::NotificationConsumer(
             m_appDb.get(),
@@ -36,6 +50,31 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_telemetryTimer = new SelectableTimer(intervT);
     auto executorT = new ExecutableTimer(m_telemetryTimer, this, "WM_TELEMETRY_TIMER");
     Orch::addExecutor(executorT);
+
+    if (gWatermarkAggregation)
+    {
+        try
+        {
+            string readLuaScript = swss::loadLuaScript("watermark_read.lua");
+            m_readWmSha = swss::loadRedisScript(m_countersDb.get(), readLuaScript);
+        }
+        catch (...)
+        {
+            SWSS_LOG_ERROR("Failed to load watermark_read.lua, watermarks will not be updated");
+        }
+
+        m_aggregator = unique_ptr<WatermarkAggregator>(new WatermarkAggregator());
+
+        /*
+         * The watermark stats are read and cleared at each poll, COUNTERS
+         * is sampled once per poll when the plugin notifies it.
+         */
+        m_pollNotificationConsumer = new swss::NotificationConsumer(m_countersDb.get(), WM_POLL_CHANNEL);
+        auto pollNotifier = new Notifier(m_pollNotificationConsumer, this, "WM_POLL_NOTIFIER");
+        Orch::addExecutor(pollNotifier);
+
+        SWSS_LOG_NOTICE("Watermarks are aggregated in orchagent");
+    }
 }
 
 WatermarkOrch::~WatermarkOrch()
@@ -138,6 +177,42 @@ void WatermarkOrch::handleFcConfigUpdate(const std::string &key, const std::vect
 void WatermarkOrch::doTask(NotificationConsumer &consumer)
 {
     SWSS_LOG_ENTER();
+
+    if (&consumer == m_pollNotificationConsumer)
+    {
+        std::string op;
+        std::string data;
+        std::vector<swss::FieldValueTuple> values;
+
+        consumer.pop(op, data, values);
+
+        auto group = groupToMask.find(op);
+        if (group == groupToMask.end())
+        {
+            SWSS_LOG_WARN("Unknown watermark poll notification: %s", op.c_str());
+            return;
+        }
+
+        if (!gPortsOrch->isPortReady())
+        {
+            return;
+        }
+
+        if (m_pg_ids.empty())
+        {
+            init_pg_ids();
+        }
+
+        if (m_multicast_queue_ids.empty() and m_unicast_queue_ids.empty())
+        {
+            init_queue_ids();
+        }
+
+        sampleWm(group->second);
+        publishWm();
+        return;
+    }
+
     if (!gPortsOrch->isPortReady())
     {
         return;
@@ -159,15 +234,15 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
 
     consumer.pop(op, data, values);
 
-    Table * table = NULL;
+    WatermarkType type;
 
     if (op == "PERSISTENT")
     {
-        table = m_persistentWatermarkTable.get();
+        type = WM_PERSISTENT;
     }
     else if (op == "USER")
     {
-        table = m_userWatermarkTable.get();
+        type = WM_USER;
     }
     else
     {
@@ -177,33 +252,27 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
 
     if(data == CLEAR_PG_HEADROOM_REQUEST)
     {
-        clearSingleWm(table,
-        "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
-        m_pg_ids);
+        clearWm(type, PG_XOFF_ROOM_WM, m_pg_ids);
     }
     else if(data == CLEAR_PG_SHARED_REQUEST)
     {
-        clearSingleWm(table,
-        "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
-        m_pg_ids);
+        clearWm(type, PG_SHARED_WM, m_pg_ids);
     }
     else if(data == CLEAR_QUEUE_SHARED_UNI_REQUEST)
     {
-        clearSingleWm(table,
-        "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-        m_unicast_queue_ids);
+        clearWm(type, QUEUE_SHARED_WM, m_unicast_queue_ids);
     }
     else if(data == CLEAR_QUEUE_SHARED_MULTI_REQUEST)
     {
-        clearSingleWm(table,
-        "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-        m_multicast_queue_ids);
+        clearWm(type, QUEUE_SHARED_WM, m_multicast_queue_ids);
     }
     else
     {
         SWSS_LOG_WARN("Unknown watermark clear request data: %s", data.c_str());
         return;
     }
+
+    publishWm();
 }
 
 void WatermarkOrch::doTask(SelectableTimer &timer)
@@ -232,10 +301,17 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
             m_telemetryTimer->stop();
         }
 
-        clearSingleWm(m_periodicWatermarkTable.get(), "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES", m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(), "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(), "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", m_unicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(), "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", m_multicast_queue_ids);
+        if (m_aggregator)
+        {
+            // close the period with the latest samples
+            sampleWm(queue_wm_status_mask | pg_wm_status_mask);
+        }
+
+        clearWm(WM_PERIODIC, PG_XOFF_ROOM_WM, m_pg_ids);
+        clearWm(WM_PERIODIC, PG_SHARED_WM, m_pg_ids);
+        clearWm(WM_PERIODIC, QUEUE_SHARED_WM, m_unicast_queue_ids);
+        clearWm(WM_PERIODIC, QUEUE_SHARED_WM, m_multicast_queue_ids);
+        publishWm();
         SWSS_LOG_DEBUG("Periodic watermark cleared by timer!");
     }
 }
@@ -275,9 +351,12 @@ void WatermarkOrch::init_queue_ids()
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_object_id_t> &obj_ids)
+void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const vector<sai_object_id_t> &obj_ids)
 {
-    /* Zero-out some WM in some table for some vector of object ids*/
+    /*
+     * Zero-out some WM in some table for some vector of object ids.
+     * The watermark tables are buffered, the writes are sent by publishWm()
+     */
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %ld obj ids", wm_name.c_str(), obj_ids.size());
 
@@ -288,3 +367,189 @@ void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_objec
         table->set(sai_serialize_object_id(id), vfvt);
     }
 }
+
+void WatermarkOrch::clearWm(WatermarkType type, const string &wm_name, const vector<sai_object_id_t> &obj_ids)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_aggregator)
+    {
+        m_aggregator->clear(type, wm_name, obj_ids);
+    }
+    else
+    {
+        clearSingleWm(getWmTable(type), wm_name, obj_ids);
+    }
+}
+
+void WatermarkOrch::publishWm()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_aggregator && m_aggregator->hasUpdates())
+    {
+        auto updates = m_aggregator->getUpdates();
+        for (const auto &update: updates)
+        {
+            vector<FieldValueTuple> vfvt = {{update.stat, to_string(update.value)}};
+            getWmTable(update.type)->set(sai_serialize_object_id(update.id), vfvt);
+        }
+        SWSS_LOG_DEBUG("Publish %zu watermarks", updates.size());
+    }
+
+    /* Send all the buffered watermark writes at once */
+    m_countersPipeline->flush();
+}
+
+void WatermarkOrch::sampleWm(uint8_t groups)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_aggregator || m_readWmSha.empty())
+    {
+        return;
+    }
+
+    auto update = [this](sai_object_id_t id, const string &wm_name, uint64_t value)
+    {
+        m_aggregator->update(id, wm_name, value);
+    };
+
+    groups = (uint8_t)(groups & m_wmStatus);
+
+    if (groups & queue_wm_status_mask)
+    {
+        vector<sai_object_id_t> queue_ids(m_unicast_queue_ids);
+        queue_ids.insert(queue_ids.end(), m_multicast_queue_ids.begin(), m_multicast_queue_ids.end());
+
+        if (!m_queueWmLoaded && !queue_ids.empty())
+        {
+            loadWm(queue_ids, queueWmNames);
+            m_queueWmLoaded = true;
+        }
+        readWm(COUNTERS_TABLE, queue_ids, queueWmNames, update);
+    }
+
+    if (groups & pg_wm_status_mask)
+    {
+        if (!m_pgWmLoaded && !m_pg_ids.empty())
+        {
+            loadWm(m_pg_ids, pgWmNames);
+            m_pgWmLoaded = true;
+        }
+        readWm(COUNTERS_TABLE, m_pg_ids, pgWmNames, update);
+    }
+}
+
+void WatermarkOrch::loadWm(const vector<sai_object_id_t> &obj_ids, const vector<string> &wm_names)
+{
+    /* Start from the watermarks already published, e.g. before an orchagent restart */
+    SWSS_LOG_ENTER();
+
+    const vector<pair<WatermarkType, string>> tables =
+    {
+        { WM_PERIODIC, PERIODIC_WATERMARKS_TABLE },
+        { WM_PERSISTENT, PERSISTENT_WATERMARKS_TABLE },
+        { WM_USER, USER_WATERMARKS_TABLE }
+    };
+
+    for (const auto &table: tables)
+    {
+        WatermarkType type = table.first;
+        readWm(table.second, obj_ids, wm_names,
+            [this, type](sai_object_id_t id, const string &wm_name, uint64_t value)
+            {
+                m_aggregator->load(type, id, wm_name, value);
+            });
+    }
+}
+
+bool WatermarkOrch::readWm(const string &table, const vector<sai_object_id_t> &obj_ids, const vector<string> &wm_names,
+                           const function<void(sai_object_id_t, const string &, uint64_t)> &handler)
+{
+    /* Read some WMs of some object ids in one script call, absent WMs are skipped */
+    SWSS_LOG_ENTER();
+
+    if (obj_ids.empty())
+    {
+        return true;
+    }
+
+    vector<string> args = { "EVALSHA", m_readWmSha, to_string(obj_ids.size()) };
+    for (sai_object_id_t id: obj_ids)
+    {
+        args.push_back(sai_serialize_object_id(id));
+    }
+    args.push_back(to_string(m_countersDb->getDbId()));
+    args.push_back(table);
+    args.insert(args.end(), wm_names.begin(), wm_names.end());
+
+    vector<const char *> argv;
+    vector<size_t> argvlen;
+    for (const auto &arg: args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    try
+    {
+        RedisCommand command;
+        command.formatArgv((int)argv.size(), argv.data(), argvlen.data());
+        RedisReply r(m_countersDb.get(), command, REDIS_REPLY_ARRAY);
+        redisReply *reply = r.getContext();
+
+        if (reply->elements != obj_ids.size() * wm_names.size())
+        {
+            SWSS_LOG_ERROR("Unexpected watermark read reply from %s, %zu elements",
+                    table.c_str(), reply->elements);
+            return false;
+        }
+
+        size_t index = 0;
+        for (sai_object_id_t id: obj_ids)
+        {
+            for (const auto &wm_name: wm_names)
+            {
+                redisReply *element = reply->element[index++];
+                if (element->type != REDIS_REPLY_STRING)
+                {
+                    continue;
+                }
+
+                try
+                {
+                    handler(id, wm_name, to_uint<uint64_t>(element->str));
+                }
+                catch (const invalid_argument &e)
+                {
+                    SWSS_LOG_DEBUG("Skip invalid %s value %s", wm_name.c_str(), element->str);
+                }
+                catch (const out_of_range &e)
+                {
+                    SWSS_LOG_DEBUG("Skip invalid %s value %s", wm_name.c_str(), element->str);
+                }
+            }
+        }
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Failed to read watermarks from %s: %s", table.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
+Table *WatermarkOrch::getWmTable(WatermarkType type)
+{
+    switch (type)
+    {
+        case WM_PERIODIC:
+            return m_periodicWatermarkTable.get();
+        case WM_PERSISTENT:
+            return m_persistentWatermarkTable.get();
+        default:
+            return m_userWatermarkTable.get();
+    }
+}
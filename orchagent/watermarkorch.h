@@ -1,13 +1,17 @@
 #ifndef WATERMARKORCH_H
 #define WATERMARKORCH_H
 
+#include <functional>
 #include <map>
+#include <memory>
 
 #include "orch.h"
 #include "port.h"
 
 #include "notificationconsumer.h"
+#include "redispipeline.h"
 #include "timer.h"
+#include "watermarkaggregator.h"
 
 const uint8_t queue_wm_status_mask = 1 << 0;
 const uint8_t pg_wm_status_mask = 1 << 1;
@@ -34,7 +38,12 @@ public:
     void handleWmConfigUpdate(const std::string &key, const std::vector<FieldValueTuple> &fvt);
     void handleFcConfigUpdate(const std::string &key, const std::vector<FieldValueTuple> &fvt);
 
-    void clearSingleWm(Table *table, string wm_name, vector<sai_object_id_t> &obj_ids);
+    void clearSingleWm(Table *table, string wm_name, const vector<sai_object_id_t> &obj_ids);
+    void clearWm(WatermarkType type, const string &wm_name, const vector<sai_object_id_t> &obj_ids);
+    void publishWm();
+
+    /* Fold the latest polls of the watermark groups in the mask into the aggregator */
+    void sampleWm(uint8_t groups);
 
     shared_ptr<Table> getCountersTable(void)
     {
@@ -58,6 +67,8 @@ private:
     shared_ptr<DBConnector> m_countersDb = nullptr;
     shared_ptr<DBConnector> m_appDb = nullptr;
     shared_ptr<Table> m_countersTable = nullptr;
+    /* Watermark table writes are buffered and sent in one batch */
+    shared_ptr<RedisPipeline> m_countersPipeline = nullptr;
     shared_ptr<Table> m_periodicWatermarkTable = nullptr;
     shared_ptr<Table> m_persistentWatermarkTable = nullptr;
     shared_ptr<Table> m_userWatermarkTable = nullptr;
@@ -65,9 +76,21 @@ private:
     NotificationConsumer* m_clearNotificationConsumer = nullptr;
     SelectableTimer* m_telemetryTimer = nullptr;
 
+    /* In-process watermark aggregation, null when done by the counters DB plugins */
+    unique_ptr<WatermarkAggregator> m_aggregator;
+    NotificationConsumer* m_pollNotificationConsumer = nullptr;
+    string m_readWmSha;
+    bool m_queueWmLoaded = false;
+    bool m_pgWmLoaded = false;
+
     vector<sai_object_id_t> m_unicast_queue_ids;
     vector<sai_object_id_t> m_multicast_queue_ids;
     vector<sai_object_id_t> m_pg_ids;
+
+    Table *getWmTable(WatermarkType type);
+    bool readWm(const string &table, const vector<sai_object_id_t> &obj_ids, const vector<string> &wm_names,
+                const function<void(sai_object_id_t, const string &, uint64_t)> &handler);
+    void loadWm(const vector<sai_object_id_t> &obj_ids, const vector<string> &wm_names);
 };
 
 #endif // WATERMARKORCH_H
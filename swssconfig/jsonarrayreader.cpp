@@ -0,0 +1,186 @@
+#include <ctype.h>
+#include <stdexcept>
+#include "jsonarrayreader.h"
+
+using namespace std;
+using namespace swss;
+
+JsonArrayReader::JsonArrayReader(istream &in) :
+    m_buf(in.rdbuf()),
+    m_started(false),
+    m_done(false),
+    m_bytes(0),
+    m_elements(0)
+{
+}
+
+size_t JsonArrayReader::getBytesRead() const
+{
+    return m_bytes;
+}
+
+size_t JsonArrayReader::getElementsRead() const
+{
+    return m_elements;
+}
+
+int JsonArrayReader::peek()
+{
+    return m_buf->sgetc();
+}
+
+int JsonArrayReader::get()
+{
+    int c = m_buf->sbumpc();
+    if (c != char_traits<char>::eof())
+    {
+        m_bytes++;
+    }
+    return c;
+}
+
+int JsonArrayReader::skipSpaces()
+{
+    int c = peek();
+    while (c != char_traits<char>::eof() && isspace(c))
+    {
+        get();
+        c = peek();
+    }
+    return c;
+}
+
+void JsonArrayReader::error(const string &message) const
+{
+    throw runtime_error("JSON syntax error at offset " + to_string(m_bytes) + ": " + message);
+}
+
+bool JsonArrayReader::next(string &element)
+{
+    if (m_done)
+    {
+        return false;
+    }
+
+    if (!m_started)
+    {
+        if (skipSpaces() != '[')
+        {
+            error("root element must be an array");
+        }
+        get();
+        m_started = true;
+
+        if (skipSpaces() == ']')
+        {
+            get();
+            expectEnd();
+            return false;
+        }
+    }
+    else
+    {
+        int c = skipSpaces();
+        if (c == ']')
+        {
+            get();
+            expectEnd();
+            return false;
+        }
+        if (c != ',')
+        {
+            error("expected ',' or ']' after array element");
+        }
+        get();
+    }
+
+    readElement(element);
+    m_elements++;
+    return true;
+}
+
+void JsonArrayReader::readElement(string &element)
+{
+    element.clear();
+
+    int c = skipSpaces();
+    if (c == char_traits<char>::eof())
+    {
+        error("unexpected end of file");
+    }
+    if (c == ',' || c == ']')
+    {
+        error("missing array element");
+    }
+
+    /* Scalar element, up to the next separator */
+    if (c != '{' && c != '[' && c != '"')
+    {
+        while (c != char_traits<char>::eof() && c != ',' && c != ']' && !isspace(c))
+        {
+            element.push_back((char)get());
+            c = peek();
+        }
+        return;
+    }
+
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+
+    while (true)
+    {
+        c = get();
+        if (c == char_traits<char>::eof())
+        {
+            error("unexpected end of file");
+        }
+        element.push_back((char)c);
+
+        if (inString)
+        {
+            if (escaped)
+            {
+                escaped = false;
+            }
+            else if (c == '\\')
+            {
+                escaped = true;
+            }
+            else if (c == '"')
+            {
+                inString = false;
+                if (depth == 0)
+                {
+                    return;
+                }
+            }
+            continue;
+        }
+
+        if (c == '"')
+        {
+            inString = true;
+        }
+        else if (c == '{' || c == '[')
+        {
+            depth++;
+        }
+        else if (c == '}' || c == ']')
+        {
+            if (--depth == 0)
+            {
+                return;
+            }
+        }
+    }
+}
+
+void JsonArrayReader::expectEnd()
+{
+    m_done = true;
+    if (skipSpaces() != char_traits<char>::eof())
+    {
+        error("unexpected data after the root array");
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef __JSONARRAYREADER__
+#define __JSONARRAYREADER__
+
+#include <istream>
+#include <string>
+
+namespace swss {
+
+/*
+ * JsonArrayReader: incremental reader of a JSON document whose root element
+ * is an array.
+ *
+ * The elements of the root array are returned one by one as JSON text, so
+ * only one element has to be held in memory and parsed at a time. The reader
+ * only checks the structure of the root array and balances the nested
+ * brackets, each element must still be parsed by the caller. Throws
+ * std::runtime_error on malformed input.
+ */
+class JsonArrayReader
+{
+public:
+    JsonArrayReader(std::istream &in);
+
+    /* Read the next element of the root array, return false after the last one */
+    bool next(std::string &element);
+
+    /* Number of bytes consumed so far */
+    size_t getBytesRead() const;
+
+    /* Number of elements returned so far */
+    size_t getElementsRead() const;
+
+private:
+    std::streambuf *m_buf;
+    bool m_started;
+    bool m_done;
+    size_t m_bytes;
+    size_t m_elements;
+
+    int peek();
+    int get();
+    int skipSpaces();
+    void readElement(std::string &element);
+    void expectEnd();
+    void error(const std::string &message) const;
+};
+
+}
+
+#endif
@@ -1,15 +1,22 @@
 #include <dirent.h>
+#include <getopt.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "logger.h"
 #include "dbconnector.h"
+#include "redispipeline.h"
 #include "producerstatetable.h"
 #include "json.hpp"
+#include "jsonarrayreader.h"
 
 using namespace std;
 using namespace swss;
@@ -21,12 +28,22 @@ const char* const op_name            = "OP";
 const char* const name_delimiter     = ":";
 const int el_count = 2;
 
+/* Default number of operations sent to redis at once in streaming mode */
+const size_t DEFAULT_FLUSH_SIZE      = 1024;
+/* Streaming progress is reported at most every PROGRESS_INTERVAL_SEC */
+const size_t PROGRESS_CHECK_ENTRIES  = 1000;
+const int PROGRESS_INTERVAL_SEC      = 1;
+
 const string SWSS_CONFIG_DIR    = "/etc/swss/config.d/";
 
 void usage()
 {
-    cout << "Usage: swssconfig [FILE...]" << endl;
+    cout << "Usage: swssconfig [-s [-b flush_size]] [FILE...]" << endl;
     cout << "       (default config folder is /etc/swss/config.d/)" << endl;
+    cout << "       -s: stream the files, each entry is written as soon as it is parsed" << endl;
+    cout << "           through a pipeline, and the progress is reported" << endl;
+    cout << "       -b flush_size: number of operations sent at once in streaming mode" << endl;
+    cout << "                      (default " << DEFAULT_FLUSH_SIZE << ")" << endl;
 }
 
 void dump_db_item(KeyOpFieldsValuesTuple &db_item)
@@ -41,10 +58,20 @@ void dump_db_item(KeyOpFieldsValuesTuple &db_item)
     SWSS_LOG_DEBUG("]");
 }
 
-bool write_db_data(vector<KeyOpFieldsValuesTuple> &db_items)
+/*
+ * Writes the items to the APPL_DB tables through one producer per table,
+ * all the producers share the pipeline.
+ */
+class DbWriter
 {
-    DBConnector db(APPL_DB, hostname, db_port, 0);
-    for (auto &db_item : db_items)
+public:
+    DbWriter(RedisPipeline *pipeline, bool buffered) :
+        m_pipeline(pipeline),
+        m_buffered(buffered)
+    {
+    }
+
+    bool write(KeyOpFieldsValuesTuple &db_item)
     {
         dump_db_item(db_item);
 
@@ -57,17 +84,99 @@ bool write_db_data(vector<KeyOpFieldsValuesTuple> &db_items)
         }
         string table_name = key.substr(0, pos);
         string key_name = key.substr(pos + 1);
-        ProducerStateTable producer(&db, table_name);
+
+        auto &producer = m_producers[table_name];
+        if (!producer)
+        {
+            producer.reset(new ProducerStateTable(m_pipeline, table_name, m_buffered));
+        }
 
         if (kfvOp(db_item) == SET_COMMAND)
-            producer.set(key_name, kfvFieldsValues(db_item), SET_COMMAND);
+            producer->set(key_name, kfvFieldsValues(db_item), SET_COMMAND);
         else if (kfvOp(db_item) == DEL_COMMAND)
-            producer.del(key_name, DEL_COMMAND);
+            producer->del(key_name, DEL_COMMAND);
         else
         {
             SWSS_LOG_ERROR("Invalid operation: %s\n", kfvOp(db_item).c_str());
             return false;
         }
+        return true;
+    }
+
+    void flush()
+    {
+        m_pipeline->flush();
+    }
+
+private:
+    RedisPipeline *m_pipeline;
+    bool m_buffered;
+    map<string, unique_ptr<ProducerStateTable>> m_producers;
+};
+
+bool write_db_data(vector<KeyOpFieldsValuesTuple> &db_items)
+{
+    DBConnector db(APPL_DB, hostname, db_port, 0);
+    /* Every operation is sent right away */
+    RedisPipeline pipeline(&db, 1);
+    DbWriter writer(&pipeline, false);
+
+    for (auto &db_item : db_items)
+    {
+        if (!writer.write(db_item))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool load_json_db_item(json &arr_item, KeyOpFieldsValuesTuple &cur_db_item)
+{
+    if (arr_item.is_object())
+    {
+        if (el_count != arr_item.size())
+        {
+            SWSS_LOG_ERROR("Chlid elements must have both key and op entry. %s",
+                           arr_item.dump().c_str());
+            return false;
+        }
+
+        for (json::iterator child_it = arr_item.begin(); child_it != arr_item.end(); child_it++) {
+            auto cur_obj_key = child_it.key();
+            auto &cur_obj = child_it.value();
+
+            string field_str;
+            string value_str;
+
+            if (cur_obj.is_object()) {
+                kfvKey(cur_db_item) = cur_obj_key;
+                for (json::iterator cur_obj_it = cur_obj.begin(); cur_obj_it != cur_obj.end(); cur_obj_it++)
+                {
+                    string field_str = cur_obj_it.key();
+                    string value_str;
+                    if ((*cur_obj_it).is_number())
+                        value_str = to_string((*cur_obj_it).get<int>());
+                    else if ((*cur_obj_it).is_string())
+                        value_str = (*cur_obj_it).get<string>();
+                    kfvFieldsValues(cur_db_item).push_back(FieldValueTuple(field_str, value_str));
+                }
+            }
+            else
+            {
+                if (op_name != child_it.key())
+                {
+                    SWSS_LOG_ERROR("Invalid entry. %s", arr_item.dump().c_str());
+                    return false;
+                }
+                kfvOp(cur_db_item) = cur_obj.get<string>();
+             }
+        }
+    }
+    else
+    {
+        SWSS_LOG_ERROR("Child elements must be objects. element:%s", arr_item.dump().c_str());
+        return false;
     }
     return true;
 }
@@ -85,57 +194,68 @@ bool load_json_db_data(ifstream &fs, vector<KeyOpFieldsValuesTuple> &db_items)
 
     for (size_t i = 0; i < json_array.size(); i++)
     {
-        auto &arr_item = json_array[i];
-
-        if (arr_item.is_object())
+        db_items.push_back(KeyOpFieldsValuesTuple());
+        if (!load_json_db_item(json_array[i], db_items.back()))
         {
-            if (el_count != arr_item.size())
-            {
-                SWSS_LOG_ERROR("Chlid elements must have both key and op entry. %s",
-                               arr_item.dump().c_str());
-                return false;
-            }
-
-            db_items.push_back(KeyOpFieldsValuesTuple());
-            auto &cur_db_item = db_items[db_items.size() - 1];
-
-            for (json::iterator child_it = arr_item.begin(); child_it != arr_item.end(); child_it++) {
-                auto cur_obj_key = child_it.key();
-                auto &cur_obj = child_it.value();
-
-                string field_str;
-                string value_str;
-
-                if (cur_obj.is_object()) {
-                    kfvKey(cur_db_item) = cur_obj_key;
-                    for (json::iterator cur_obj_it = cur_obj.begin(); cur_obj_it != cur_obj.end(); cur_obj_it++)
-                    {
-                        string field_str = cur_obj_it.key();
-                        string value_str;
-                        if ((*cur_obj_it).is_number())
-                            value_str = to_string((*cur_obj_it).get<int>());
-                        else if ((*cur_obj_it).is_string())
-                            value_str = (*cur_obj_it).get<string>();
-                        kfvFieldsValues(cur_db_item).push_back(FieldValueTuple(field_str, value_str));
-                    }
-                }
-                else
-                {
-                    if (op_name != child_it.key())
-                    {
-                        SWSS_LOG_ERROR("Invalid entry. %s", arr_item.dump().c_str());
-                        return false;
-                    }
-                    kfvOp(cur_db_item) = cur_obj.get<string>();
-                 }
-            }
+            return false;
         }
-        else
+    }
+    return true;
+}
+
+void report_progress(const string &file, const JsonArrayReader &reader,
+                     chrono::steady_clock::time_point start, bool done)
+{
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    double seconds = max((double)elapsed / 1000, 0.001);
+    size_t entries = reader.getElementsRead();
+    size_t bytes = reader.getBytesRead();
+
+    char line[256];
+    snprintf(line, sizeof(line), "%s: %s %zu entries, %zu bytes in %.3f s (%.0f entries/s, %.1f MB/s)",
+             file.c_str(), done ? "loaded" : "loading", entries, bytes, seconds,
+             (double)entries / seconds, (double)bytes / seconds / 1e6);
+
+    SWSS_LOG_NOTICE("%s", line);
+    cout << line << endl;
+}
+
+/*
+ * Load the JSON file element by element and write each item as soon as it is
+ * parsed, through a pipeline flushed every flush_size operations. Items are
+ * written up to the first invalid one.
+ */
+bool stream_json_db_data(const string &file, ifstream &fs, DbWriter &writer)
+{
+    JsonArrayReader reader(fs);
+    string element;
+    auto start = chrono::steady_clock::now();
+    auto last_report = start;
+
+    while (reader.next(element))
+    {
+        json arr_item = json::parse(element);
+        KeyOpFieldsValuesTuple db_item;
+
+        if (!load_json_db_item(arr_item, db_item) || !writer.write(db_item))
         {
-            SWSS_LOG_ERROR("Child elements must be objects. element:%s", arr_item.dump().c_str());
+            writer.flush();
             return false;
         }
+
+        if (reader.getElementsRead() % PROGRESS_CHECK_ENTRIES == 0)
+        {
+            auto now = chrono::steady_clock::now();
+            if (now - last_report >= chrono::seconds(PROGRESS_INTERVAL_SEC))
+            {
+                report_progress(file, reader, start, false);
+                last_report = now;
+            }
+        }
     }
+
+    writer.flush();
+    report_progress(file, reader, start, true);
     return true;
 }
 
@@ -162,19 +282,43 @@ vector<string> read_directory(const string &path)
 
 int main(int argc, char **argv)
 {
-    vector<string> files;
-    if (argc == 1)
+    bool streaming = false;
+    size_t flush_size = DEFAULT_FLUSH_SIZE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "sb:h")) != -1)
     {
-        files = read_directory(SWSS_CONFIG_DIR);
+        switch (opt)
+        {
+        case 's':
+            streaming = true;
+            break;
+        case 'b':
+            flush_size = strtoul(optarg, NULL, 0);
+            if (flush_size == 0)
+            {
+                cerr << "Invalid flush size " << optarg << endl;
+                usage();
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'h':
+            usage();
+            exit(EXIT_SUCCESS);
+        default:
+            usage();
+            exit(EXIT_FAILURE);
+        }
     }
-    if (argc == 2 && !strcmp(argv[1], "-h"))
+
+    vector<string> files;
+    if (optind == argc)
     {
-        usage();
-        exit(EXIT_SUCCESS);
+        files = read_directory(SWSS_CONFIG_DIR);
     }
     else
     {
-        for (auto i = 1; i < argc; i++)
+        for (auto i = optind; i < argc; i++)
         {
             files.push_back(string(argv[i]));
         }
@@ -195,6 +339,20 @@ int main(int argc, char **argv)
                 return EXIT_FAILURE;
             }
 
+            if (streaming)
+            {
+                DBConnector db(APPL_DB, hostname, db_port, 0);
+                RedisPipeline pipeline(&db, flush_size);
+                DbWriter writer(&pipeline, true);
+
+                if (!stream_json_db_data(i, fs, writer))
+                {
+                    SWSS_LOG_ERROR("Failed applying data from JSON file %s", i.c_str());
+                    return EXIT_FAILURE;
+                }
+                continue;
+            }
+
             if (!load_json_db_data(fs, db_items))
             {
                 SWSS_LOG_ERROR("Failed loading data from JSON file %s", i.c_str());
@@ -1,7 +1,24 @@
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <dbconnector.h>
+#include <redisreply.h>
+#include <redispipeline.h>
 #include <producerstatetable.h>
 #include <schema.h>
 #include <tokenize.h>
@@ -9,15 +26,46 @@
 using namespace std;
 using namespace swss;
 
+typedef chrono::steady_clock Clock;
+
 constexpr int DB_PORT = 6379;
 constexpr char* DB_HOSTNAME = "localhost";
 
+/* Default number of operations sent to redis at once */
+constexpr size_t DEFAULT_FLUSH_SIZE = 128;
+/* Default time to wait for orchagent to drain the replayed keys */
+constexpr int DEFAULT_DRAIN_TIMEOUT_SEC = 60;
+/*
+ * Interval between two polls of the drained keys: it doubles up to the
+ * maximum while keys are pending and none is drained, and is reset once one
+ * is. The drain latencies are measured to within the interval.
+ */
+constexpr int DRAIN_POLL_MIN_MSEC = 1;
+constexpr int DRAIN_POLL_MAX_MSEC = 32;
+/* Interval between two checks of the keys still pending or of syncd queue */
+constexpr int WAIT_POLL_MSEC = 10;
+/* ASIC_DB is settled once syncd queue stayed empty for this long */
+constexpr int ASIC_IDLE_MSEC = 200;
+
+/* Queue of the operations sent by sairedis to syncd */
+const string ASIC_OP_QUEUE = "ASIC_STATE_KEY_VALUE_OP_QUEUE";
+
 static int line_index = 0;
 static DBConnector db(APPL_DB, DB_HOSTNAME, DB_PORT, 0);
 
 void usage()
 {
-	cout << "Usage: swssplayer <file>" << endl;
+	cout << "Usage: swssplayer [-r speed] [-b flush_size] [-t table]... [-l [-a] [-w timeout]] <file>" << endl;
+	cout << "       Replay a swss.rec recording to APPL_DB" << endl;
+	cout << "       -r speed: honor the recorded timestamps, speed multiplier e.g. 1 for real time," << endl;
+	cout << "                 2 for twice as fast (default: as fast as possible)" << endl;
+	cout << "       -b flush_size: number of operations sent at once (default " << DEFAULT_FLUSH_SIZE << ")" << endl;
+	cout << "       -t table: only replay the operations of this APPL_DB table, may be repeated" << endl;
+	cout << "       -l: measure the latency until orchagent drains each key, to within the poll" << endl;
+	cout << "           interval of " << DRAIN_POLL_MIN_MSEC << " to " << DRAIN_POLL_MAX_MSEC << " ms" << endl;
+	cout << "       -a: also wait for syncd to apply all the operations to ASIC_DB" << endl;
+	cout << "       -w timeout: seconds to wait for the keys to be drained (default "
+	     << DEFAULT_DRAIN_TIMEOUT_SEC << ")" << endl;
 	/* TODO: Add sample input file */
 }
 
@@ -37,46 +85,487 @@ vector<FieldValueTuple> processFieldsValuesTuple(string s)
 	return result;
 }
 
-void processTokens(vector<string> tokens)
+/* Parse a timestamp of the recording, i.e. 2019-01-01.12:00:00.123456 */
+bool parseTimestamp(const string &ts, int64_t &usec)
 {
-	auto key = tokens[1];
+	struct tm tm;
+	memset(&tm, 0, sizeof(tm));
 
-	/* Process the key */
-	auto v_key = tokenize(key, ':', 1);
-	auto table_name = v_key[0];
-	auto key_name = v_key[1];
+	const char *rest = strptime(ts.c_str(), "%Y-%m-%d.%H:%M:%S", &tm);
+	if (rest == NULL || *rest != '.')
+	{
+		return false;
+	}
+	tm.tm_isdst = -1;
 
-	ProducerStateTable producer(&db, table_name);
+	usec = (int64_t)mktime(&tm) * 1000000 + strtol(rest + 1, NULL, 10);
+	return true;
+}
 
-	/* Process the operation */
-	auto op = tokens[2];
-	if (op == SET_COMMAND)
+/*
+ * Watches the key sets of the APPL_DB tables: a key is drained when
+ * orchagent popped it from the key set of its table.
+ */
+class DrainWatcher
+{
+public:
+	DrainWatcher() :
+		m_db(APPL_DB, DB_HOSTNAME, DB_PORT, 0),
+		m_stop(false),
+		m_lastDrain(Clock::now())
 	{
-		auto tuples = processFieldsValuesTuple(tokens[3]);
-		producer.set(key_name, tuples, SET_COMMAND);
+		m_thread = thread(&DrainWatcher::run, this);
 	}
-	else if (op == DEL_COMMAND)
+
+	~DrainWatcher()
+	{
+		m_stop = true;
+		m_thread.join();
+	}
+
+	/* The key has been written to redis at the given time */
+	void sent(const string &keySet, const string &key, Clock::time_point time)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		/* Keep the oldest write of a key still pending */
+		m_pending[keySet].emplace(key, time);
+	}
+
+	size_t pending()
 	{
-		producer.del(key_name, DEL_COMMAND);
+		lock_guard<mutex> lock(m_mutex);
+		size_t count = 0;
+		for (auto &table : m_pending)
+		{
+			count += table.second.size();
+		}
+		return count;
 	}
+
+	/* Wait until all keys have been drained, return false on timeout */
+	bool wait(chrono::seconds timeout)
+	{
+		auto deadline = Clock::now() + timeout;
+		while (pending() != 0)
+		{
+			if (Clock::now() >= deadline)
+			{
+				return false;
+			}
+			this_thread::sleep_for(chrono::milliseconds(WAIT_POLL_MSEC));
+		}
+		return true;
+	}
+
+	vector<int64_t> getLatencies()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_latencies;
+	}
+
+	Clock::time_point getLastDrain()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_lastDrain;
+	}
+
+private:
+	DBConnector m_db;
+	thread m_thread;
+	atomic<bool> m_stop;
+
+	mutex m_mutex;
+	map<string, unordered_map<string, Clock::time_point>> m_pending;
+	vector<int64_t> m_latencies;
+	Clock::time_point m_lastDrain;
+
+	void run()
+	{
+		int interval = DRAIN_POLL_MIN_MSEC;
+
+		while (!m_stop)
+		{
+			vector<string> keySets;
+			{
+				lock_guard<mutex> lock(m_mutex);
+				for (auto &table : m_pending)
+				{
+					if (!table.second.empty())
+					{
+						keySets.push_back(table.first);
+					}
+				}
+			}
+
+			/* Only the tables with keys still pending are queried */
+			bool drained = false;
+			for (auto &keySet : keySets)
+			{
+				drained |= poll(keySet);
+			}
+
+			if (drained || keySets.empty())
+			{
+				interval = DRAIN_POLL_MIN_MSEC;
+			}
+			else
+			{
+				interval = min(interval * 2, DRAIN_POLL_MAX_MSEC);
+			}
+			this_thread::sleep_for(chrono::milliseconds(interval));
+		}
+	}
+
+	/* Return true when keys of the table were drained */
+	bool poll(const string &keySet)
+	{
+		/* Only the keys written before the query can be found drained */
+		auto queried = Clock::now();
+
+		RedisCommand smembers;
+		smembers.format("SMEMBERS %s", keySet.c_str());
+		RedisReply r(&m_db, smembers, REDIS_REPLY_ARRAY);
+		redisReply *reply = r.getContext();
+
+		unordered_set<string> keys;
+		for (size_t i = 0; i < reply->elements; i++)
+		{
+			keys.emplace(reply->element[i]->str, reply->element[i]->len);
+		}
+
+		auto now = Clock::now();
+
+		lock_guard<mutex> lock(m_mutex);
+		auto &pending = m_pending[keySet];
+		bool drained = false;
+		for (auto it = pending.begin(); it != pending.end();)
+		{
+			if (it->second <= queried && keys.find(it->first) == keys.end())
+			{
+				m_latencies.push_back(chrono::duration_cast<chrono::microseconds>(now - it->second).count());
+				m_lastDrain = now;
+				it = pending.erase(it);
+				drained = true;
+			}
+			else
+			{
+				it++;
+			}
+		}
+		return drained;
+	}
+};
+
+class Player
+{
+public:
+	Player(size_t flushSize, const set<string> &tables, DrainWatcher *watcher) :
+		m_pipeline(&db, flushSize + 1),
+		m_flushSize(flushSize),
+		m_tables(tables),
+		m_watcher(watcher),
+		m_operations(0),
+		m_skipped(0)
+	{
+	}
+
+	void processTokens(const vector<string> &tokens)
+	{
+		if (tokens.size() < 3)
+		{
+			m_skipped++;
+			return;
+		}
+
+		/* Process the key */
+		auto v_key = tokenize(tokens[1], ':', 1);
+		auto op = tokens[2];
+		if (v_key.size() != 2 || (op != SET_COMMAND && op != DEL_COMMAND))
+		{
+			/* Not an APPL_DB operation, e.g. the recording start */
+			m_skipped++;
+			return;
+		}
+
+		auto table_name = v_key[0];
+		auto key_name = v_key[1];
+		if (!m_tables.empty() && m_tables.find(table_name) == m_tables.end())
+		{
+			return;
+		}
+
+		auto &producer = m_producers[table_name];
+		if (!producer)
+		{
+			producer.reset(new ProducerStateTable(&m_pipeline, table_name, true));
+		}
+
+		/* Process the operation */
+		if (op == SET_COMMAND)
+		{
+			auto tuples = tokens.size() > 3 ? processFieldsValuesTuple(tokens[3]) : vector<FieldValueTuple>();
+			producer->set(key_name, tuples, SET_COMMAND);
+		}
+		else
+		{
+			producer->del(key_name, DEL_COMMAND);
+		}
+
+		m_operations++;
+		if (m_watcher)
+		{
+			m_unflushed.emplace_back(producer->getKeySetName(), key_name);
+		}
+		if (++m_buffered >= m_flushSize)
+		{
+			flush();
+		}
+	}
+
+	void flush()
+	{
+		m_pipeline.flush();
+		m_buffered = 0;
+
+		if (m_watcher)
+		{
+			auto now = Clock::now();
+			for (auto &key : m_unflushed)
+			{
+				m_watcher->sent(key.first, key.second, now);
+			}
+		}
+		m_unflushed.clear();
+	}
+
+	size_t getOperations() const
+	{
+		return m_operations;
+	}
+
+	size_t getSkipped() const
+	{
+		return m_skipped;
+	}
+
+private:
+	RedisPipeline m_pipeline;
+	size_t m_flushSize;
+	size_t m_buffered = 0;
+	set<string> m_tables;
+	DrainWatcher *m_watcher;
+	map<string, unique_ptr<ProducerStateTable>> m_producers;
+	/* Key set and key of the operations not flushed yet */
+	vector<pair<string, string>> m_unflushed;
+
+	size_t m_operations;
+	size_t m_skipped;
+};
+
+double toSeconds(Clock::duration d)
+{
+	return (double)chrono::duration_cast<chrono::microseconds>(d).count() / 1e6;
+}
+
+void reportLatencies(vector<int64_t> latencies)
+{
+	sort(latencies.begin(), latencies.end());
+
+	int64_t total = 0;
+	for (auto latency : latencies)
+	{
+		total += latency;
+	}
+
+	auto percentile = [&latencies](double p) {
+		return (double)latencies[min(latencies.size() - 1, (size_t)(p * (double)latencies.size()))] / 1000;
+	};
+
+	printf("Drain latency (ms): count %zu, avg %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n",
+	       latencies.size(), (double)total / (double)latencies.size() / 1000,
+	       percentile(0.50), percentile(0.90), percentile(0.99), (double)latencies.back() / 1000);
+}
+
+/* Wait until syncd applied all the operations queued in ASIC_DB */
+bool waitAsicSettled(chrono::seconds timeout, Clock::time_point &settled)
+{
+	DBConnector asicDb(ASIC_DB, DB_HOSTNAME, DB_PORT, 0);
+	auto deadline = Clock::now() + timeout;
+	bool empty = false;
+
+	while (Clock::now() < deadline)
+	{
+		RedisCommand llen;
+		llen.format("LLEN %s", ASIC_OP_QUEUE.c_str());
+		RedisReply r(&asicDb, llen, REDIS_REPLY_INTEGER);
+
+		auto now = Clock::now();
+		if (r.getContext()->integer != 0)
+		{
+			empty = false;
+		}
+		else if (!empty)
+		{
+			empty = true;
+			settled = now;
+		}
+		else if (now - settled >= chrono::milliseconds(ASIC_IDLE_MSEC))
+		{
+			return true;
+		}
+
+		this_thread::sleep_for(chrono::milliseconds(WAIT_POLL_MSEC));
+	}
+	return false;
 }
 
 int main(int argc, char **argv)
 {
-	if (argc != 2)
+	double speed = 0;
+	size_t flush_size = DEFAULT_FLUSH_SIZE;
+	set<string> tables;
+	bool latency = false;
+	bool asic = false;
+	int timeout = DEFAULT_DRAIN_TIMEOUT_SEC;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "r:b:t:law:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'r':
+			speed = atof(optarg);
+			if (speed <= 0)
+			{
+				usage();
+				exit(EXIT_FAILURE);
+			}
+			break;
+		case 'b':
+			flush_size = strtoul(optarg, NULL, 0);
+			if (flush_size == 0)
+			{
+				usage();
+				exit(EXIT_FAILURE);
+			}
+			break;
+		case 't':
+			tables.insert(optarg);
+			break;
+		case 'l':
+			latency = true;
+			break;
+		case 'a':
+			asic = true;
+			break;
+		case 'w':
+			timeout = atoi(optarg);
+			break;
+		case 'h':
+			usage();
+			exit(EXIT_SUCCESS);
+		default:
+			usage();
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (optind != argc - 1 || (asic && !latency))
 	{
 		usage();
 		exit(EXIT_FAILURE);
 	}
 
-	ifstream file(argv[1]);
+	ifstream file(argv[optind]);
+	if (!file)
+	{
+		cerr << "Failed to open file " << argv[optind] << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	unique_ptr<DrainWatcher> watcher(latency ? new DrainWatcher() : nullptr);
+	Player player(flush_size, tables, watcher.get());
+
 	string line;
+	bool first = true;
+	int64_t first_ts = 0;
+	int64_t ts = 0;
+	auto start = Clock::now();
 
 	while (getline(file, line))
 	{
 		auto tokens = tokenize(line, '|', 3);
-		processTokens(tokens);
-
 		line_index++;
+
+		/* Wait for the time of the operation relative to the first one */
+		if (speed > 0 && !tokens.empty() && parseTimestamp(tokens[0], ts))
+		{
+			if (first)
+			{
+				first = false;
+				first_ts = ts;
+			}
+
+			auto target = start + chrono::microseconds((int64_t)((double)(ts - first_ts) / speed));
+			if (Clock::now() < target)
+			{
+				player.flush();
+				this_thread::sleep_until(target);
+			}
+		}
+
+		player.processTokens(tokens);
+	}
+	player.flush();
+
+	auto sent = Clock::now();
+	double send_sec = toSeconds(sent - start);
+
+	printf("Replayed %zu operations from %d lines (%zu skipped) in %.3f s: %.0f ops/s\n",
+	       player.getOperations(), line_index, player.getSkipped(), send_sec,
+	       (double)player.getOperations() / max(send_sec, 1e-6));
+	if (speed > 0)
+	{
+		printf("Recording span %.3f s, replayed at %gx\n", (double)(ts - first_ts) / 1e6, speed);
+	}
+
+	if (!watcher)
+	{
+		return EXIT_SUCCESS;
+	}
+
+	int rc = EXIT_SUCCESS;
+
+	if (!watcher->wait(chrono::seconds(timeout)))
+	{
+		printf("%zu keys not drained after %d s\n", watcher->pending(), timeout);
+		rc = EXIT_FAILURE;
+	}
+
+	auto latencies = watcher->getLatencies();
+	if (latencies.empty())
+	{
+		return rc;
 	}
+	reportLatencies(latencies);
+
+	double drained_sec = toSeconds(watcher->getLastDrain() - start);
+	printf("Drained in %.3f s: %.0f ops/s\n", drained_sec,
+	       (double)player.getOperations() / max(drained_sec, 1e-6));
+
+	if (asic && rc == EXIT_SUCCESS)
+	{
+		Clock::time_point settled;
+		if (waitAsicSettled(chrono::seconds(timeout), settled))
+		{
+			printf("ASIC_DB settled in %.3f s\n", toSeconds(settled - start));
+		}
+		else
+		{
+			printf("ASIC_DB not settled after %d s\n", timeout);
+			rc = EXIT_FAILURE;
+		}
+	}
+
+	return rc;
 }
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <iostream>
+#include <string>
+
+#include "swssrecformat.h"
+
+using namespace std;
+
+/* Bytes read from the recording at once */
+#define READ_SIZE (64 * 1024)
+
+void usage()
+{
+    cout << "Usage: swssrecdecode <file>..." << endl;
+    cout << "       Print swss.rec recordings in the text format" << endl;
+    cout << "       Binary and gzip compressed recordings are decoded, text recordings" << endl;
+    cout << "       are printed as is. Rotated recordings are given oldest first, e.g." << endl;
+    cout << "       swssrecdecode swss.rec.bin.gz.2 swss.rec.bin.gz.1 swss.rec.bin.gz" << endl;
+}
+
+bool decodeFile(const char *name)
+{
+    gzFile gz = gzopen(name, "rb");
+    if (!gz)
+    {
+        cerr << "Failed to open file " << name << endl;
+        return false;
+    }
+
+    string data;
+    size_t offset = 0;
+    bool binary = false;
+    bool started = false;
+    bool error = false;
+    SwssRecord record;
+    char buffer[READ_SIZE];
+    int n;
+
+    while ((n = gzread(gz, buffer, sizeof(buffer))) > 0)
+    {
+        data.append(buffer, (size_t)n);
+
+        if (!started)
+        {
+            if (data.size() < SWSS_REC_MAGIC_SIZE)
+            {
+                continue;
+            }
+            started = true;
+            binary = isSwssRecordBinary(data.data(), data.size());
+        }
+
+        if (!binary)
+        {
+            fwrite(data.data(), 1, data.size(), stdout);
+            data.clear();
+            continue;
+        }
+
+        while (decodeSwssRecord(data.data(), data.size(), offset, record, error))
+        {
+            string line = formatSwssRecordText(record);
+            line += '\n';
+            fwrite(line.data(), 1, line.size(), stdout);
+        }
+
+        if (error)
+        {
+            break;
+        }
+
+        data.erase(0, offset);
+        offset = 0;
+    }
+
+    if (n < 0)
+    {
+        int errnum;
+        cerr << "Failed to read file " << name << ": " << gzerror(gz, &errnum) << endl;
+        gzclose(gz);
+        return false;
+    }
+    gzclose(gz);
+
+    if (!binary)
+    {
+        /* Shorter than a magic header, text */
+        fwrite(data.data(), 1, data.size(), stdout);
+        return true;
+    }
+
+    if (error)
+    {
+        cerr << "Corrupted record in file " << name << endl;
+        return false;
+    }
+
+    /* Magic headers of reopened recordings without any record left */
+    size_t pos = 0;
+    while (isSwssRecordBinary(data.data() + pos, data.size() - pos))
+    {
+        pos += SWSS_REC_MAGIC_SIZE;
+    }
+
+    /* The recorder may have been stopped in the middle of a record */
+    if (pos != data.size())
+    {
+        cerr << "Truncated record at the end of file " << name << endl;
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'h':
+            usage();
+            exit(EXIT_SUCCESS);
+        default:
+            usage();
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (optind == argc)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    int rc = EXIT_SUCCESS;
+    for (int i = optind; i < argc; i++)
+    {
+        if (!decodeFile(argv[i]))
+        {
+            rc = EXIT_FAILURE;
+        }
+    }
+
+    fflush(stdout);
+    return rc;
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <map>
+#include "aclcounterpoller.h"
+
+using namespace std;
+
+namespace
+{
+    const sai_object_id_t TABLE1 = 0x7000000000001;
+    const sai_object_id_t TABLE2 = 0x7000000000002;
+    const sai_object_id_t COUNTER1 = 0x9000000000001;
+    const sai_object_id_t COUNTER2 = 0x9000000000002;
+
+    struct FakeCounters
+    {
+        map<sai_object_id_t, AclRuleCounters> values;
+        size_t reads = 0;
+
+        AclCounterPoller::Reader reader()
+        {
+            return [this](const vector<sai_object_id_t> &oids,
+                          vector<AclRuleCounters> &counters, vector<bool> &valid)
+            {
+                reads++;
+                for (size_t i = 0; i < oids.size(); i++)
+                {
+                    auto it = values.find(oids[i]);
+                    valid[i] = it != values.end();
+                    if (valid[i])
+                    {
+                        counters[i] = it->second;
+                    }
+                }
+            };
+        }
+    };
+
+    AclCounterPollTable makeTable(sai_object_id_t oid, const string &id, uint32_t interval,
+                                  const vector<AclCounterPollRule> &rules)
+    {
+        return { oid, id, interval, rules };
+    }
+}
+
+TEST(aclcounterpoller, delta)
+{
+    FakeCounters fake;
+    AclCounterPoller poller(fake.reader());
+    auto now = chrono::steady_clock::now();
+
+    fake.values[COUNTER1] = AclRuleCounters(10, 1000);
+    poller.setTables({ makeTable(TABLE1, "T1", 10, {
+        { "R1", COUNTER1, AclRuleCounters() },
+        { "R2", SAI_NULL_OBJECT_ID, AclRuleCounters(5, 500) } }) });
+
+    poller.poll(now);
+    auto updates = poller.takeUpdates();
+    ASSERT_EQ(updates.size(), 2u);
+    EXPECT_EQ(updates[0].ruleId, "R1");
+    EXPECT_EQ(updates[0].counters.packets, 10u);
+    EXPECT_EQ(updates[1].ruleId, "R2");
+    EXPECT_EQ(updates[1].counters.bytes, 500u);
+    EXPECT_TRUE(poller.takeUpdates().empty());
+
+    /* Not due yet */
+    fake.values[COUNTER1] = AclRuleCounters(20, 2000);
+    poller.poll(now + chrono::seconds(5));
+    EXPECT_EQ(fake.reads, 1u);
+    EXPECT_TRUE(poller.takeUpdates().empty());
+
+    /* Only the changed counter is handed over */
+    poller.poll(now + chrono::seconds(10));
+    updates = poller.takeUpdates();
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].ruleId, "R1");
+    EXPECT_EQ(updates[0].counterOid, COUNTER1);
+    EXPECT_EQ(updates[0].counters.packets, 20u);
+
+    poller.poll(now + chrono::seconds(20));
+    EXPECT_TRUE(poller.takeUpdates().empty());
+}
+
+TEST(aclcounterpoller, tables)
+{
+    FakeCounters fake;
+    AclCounterPoller poller(fake.reader());
+    auto now = chrono::steady_clock::now();
+
+    fake.values[COUNTER1] = AclRuleCounters(1, 100);
+    fake.values[COUNTER2] = AclRuleCounters(2, 200);
+    poller.setTables({
+        makeTable(TABLE1, "T1", 1, { { "R1", COUNTER1, AclRuleCounters() } }),
+        makeTable(TABLE2, "T2", 60, { { "R1", COUNTER2, AclRuleCounters() } }) });
+
+    poller.poll(now);
+    EXPECT_EQ(poller.takeUpdates().size(), 2u);
+
+    /* Each table is polled at its own interval, pending updates are merged */
+    fake.values[COUNTER1] = AclRuleCounters(3, 300);
+    fake.values[COUNTER2] = AclRuleCounters(4, 400);
+    poller.poll(now + chrono::seconds(1));
+    fake.values[COUNTER1] = AclRuleCounters(5, 500);
+    poller.poll(now + chrono::seconds(2));
+    auto updates = poller.takeUpdates();
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].tableId, "T1");
+    EXPECT_EQ(updates[0].counters.packets, 5u);
+
+    /* A rule added back is published again, even with the same counters */
+    poller.setTables({ makeTable(TABLE2, "T2", 60, { { "R1", COUNTER2, AclRuleCounters() } }) });
+    poller.poll(now + chrono::seconds(3));
+    EXPECT_TRUE(poller.takeUpdates().empty());
+
+    poller.setTables({
+        makeTable(TABLE1, "T1", 1, { { "R1", COUNTER1, AclRuleCounters() } }),
+        makeTable(TABLE2, "T2", 60, { { "R1", COUNTER2, AclRuleCounters() } }) });
+    poller.poll(now + chrono::seconds(4));
+    updates = poller.takeUpdates();
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].tableOid, TABLE1);
+
+    /* Unreadable counters are skipped */
+    fake.values.erase(COUNTER1);
+    poller.poll(now + chrono::seconds(5));
+    EXPECT_TRUE(poller.takeUpdates().empty());
+}
+
+TEST(aclcounterpoller, thread)
+{
+    FakeCounters fake;
+    AclCounterPoller poller(fake.reader());
+
+    fake.values[COUNTER1] = AclRuleCounters(1, 100);
+    poller.setTables({ makeTable(TABLE1, "T1", 10, { { "R1", COUNTER1, AclRuleCounters() } }) });
+    poller.start();
+
+    vector<AclCounterUpdate> updates;
+    for (int i = 0; i < 500 && updates.empty(); i++)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+        updates = poller.takeUpdates();
+    }
+    poller.stop();
+
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].counters.bytes, 100u);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "batchrounds.h"
+
+TEST(batchrounds, backlog)
+{
+    BatchRounds rounds;
+    EXPECT_EQ(rounds.get(), 1u);
+
+    /* Doubles while the batches come full, up to the maximum */
+    rounds.adapt(1, true, 10, 100, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 2u);
+    rounds.adapt(2, true, 20, 200, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 4u);
+    rounds.adapt(4, true, 40, 400, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 8u);
+    rounds.adapt(8, true, 80, 800, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 8u);
+
+    /* Halves once the backlog is gone */
+    rounds.adapt(3, false, 30, 300, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 4u);
+    rounds.adapt(1, false, 10, 100, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 2u);
+    rounds.adapt(1, false, 10, 100, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 1u);
+    rounds.adapt(1, false, 10, 100, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 1u);
+}
+
+TEST(batchrounds, single)
+{
+    BatchRounds rounds;
+
+    /* Tables without configuration never go beyond a single batch */
+    rounds.adapt(1, true, 10, 100, 0, 1, false);
+    EXPECT_EQ(rounds.get(), 1u);
+    EXPECT_FALSE(rounds.canPop(1, 10, 0));
+}
+
+TEST(batchrounds, budget)
+{
+    BatchRounds rounds;
+
+    for (int i = 0; i < 4; i++)
+    {
+        rounds.adapt(rounds.get(), true, 100, 900 * rounds.get(), 50000, 64, false);
+    }
+    EXPECT_EQ(rounds.get(), 16u);
+
+    /* 1000 us per batch, doTask() included */
+    EXPECT_TRUE(rounds.canPop(1, 100, 50000));
+    EXPECT_TRUE(rounds.canPop(15, 1500, 50000));
+    EXPECT_FALSE(rounds.canPop(16, 1600, 50000));
+    EXPECT_FALSE(rounds.canPop(1, 100, 1500));
+
+    /* doTask() got slower than the budget allows, cut to the batches that fit */
+    rounds.adapt(16, true, 1600, 198400, 50000, 64, false);
+    EXPECT_EQ(rounds.get(), 4u);
+    EXPECT_TRUE(rounds.canPop(3, 300, 50000));
+    EXPECT_FALSE(rounds.canPop(3, 3000, 50000));
+
+    /* Stopped early by the budget, keep the batches that fit */
+    rounds.adapt(2, true, 200, 24000, 50000, 64, false);
+    EXPECT_EQ(rounds.get(), 2u);
+}
+
+TEST(batchrounds, yield)
+{
+    BatchRounds rounds;
+
+    rounds.adapt(1, true, 10, 100, 50000, 8, false);
+    rounds.adapt(2, true, 20, 200, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 4u);
+
+    /* A single batch while latency sensitive tables have tasks pending */
+    rounds.adapt(4, true, 40, 400, 50000, 8, true);
+    EXPECT_EQ(rounds.get(), 1u);
+    rounds.adapt(1, true, 10, 100, 50000, 8, false);
+    EXPECT_EQ(rounds.get(), 2u);
+
+    /* Lowered maximum */
+    rounds.adapt(2, true, 20, 200, 50000, 1, false);
+    EXPECT_EQ(rounds.get(), 1u);
+}
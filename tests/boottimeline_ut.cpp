@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "boottimeline.h"
+
+using namespace std;
+
+TEST(boottimeline, report)
+{
+    auto start = BootTimeline::Clock::now();
+    BootTimeline timeline(start);
+
+    timeline.mark("PortInitDone", start + chrono::milliseconds(900));
+    timeline.mark("PortConfigDone", start + chrono::microseconds(1500));
+    timeline.mark("PortConfigDone", start + chrono::milliseconds(2000));
+    EXPECT_TRUE(timeline.hasMark("PortConfigDone"));
+    EXPECT_FALSE(timeline.hasMark("ports ready"));
+
+    timeline.addPhase("attribute discovery", chrono::milliseconds(220), 32);
+    timeline.addPhase("host interfaces", chrono::milliseconds(100), 32);
+    timeline.addPhase("attribute discovery", chrono::milliseconds(100), 32);
+    timeline.addPhase("counter db", chrono::milliseconds(5), 0);
+
+    vector<string> expected = {
+        "PortConfigDone at +1.5 ms",
+        "PortInitDone at +900.0 ms",
+        "attribute discovery: 320.0 ms for 64 items (5.0 ms each)",
+        "host interfaces: 100.0 ms for 32 items (3.1 ms each)",
+        "counter db: 5.0 ms for 0 items",
+    };
+    EXPECT_EQ(timeline.report(), expected);
+}
+
+TEST(boottimeline, scopedPhase)
+{
+    BootTimeline timeline;
+    {
+        BootTimeline::ScopedPhase phase(timeline, "notify", 4);
+    }
+    {
+        BootTimeline::ScopedPhase phase(timeline, "notify", 4);
+    }
+
+    auto lines = timeline.report();
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].compare(0, 8, "notify: "), 0);
+    EXPECT_NE(lines[0].find(" for 8 items"), string::npos);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "crmcounter.h"
+
+using namespace std;
+
+namespace
+{
+    /* Count the threshold crossings while moving the counter to target */
+    int moveTo(CrmUsedCounter &counter, uint32_t target)
+    {
+        int crossings = 0;
+        while (counter.get() < target)
+        {
+            crossings += counter.inc();
+        }
+        while (counter.get() > target)
+        {
+            crossings += counter.dec();
+        }
+        return crossings;
+    }
+}
+
+TEST(crmcounter, percentage)
+{
+    CrmUsedCounter counter;
+
+    /* Not known before the first poll */
+    EXPECT_EQ(moveTo(counter, 100), 0);
+    EXPECT_EQ(moveTo(counter, 0), 0);
+
+    counter.setThresholds(CrmThresholdType::CRM_PERCENTAGE, 70, 85, 1000);
+
+    /* Leaves clear at 710 (71%), exceeds at 850 (85%) */
+    EXPECT_EQ(moveTo(counter, 709), 0);
+    EXPECT_TRUE(counter.inc());
+    EXPECT_EQ(counter.get(), 710u);
+    EXPECT_TRUE(counter.dec());
+    EXPECT_TRUE(counter.inc());
+    EXPECT_EQ(moveTo(counter, 849), 0);
+    EXPECT_TRUE(counter.inc());
+    EXPECT_EQ(moveTo(counter, 1000), 0);
+    EXPECT_EQ(moveTo(counter, 0), 2);
+}
+
+TEST(crmcounter, usedAndFree)
+{
+    CrmUsedCounter counter;
+
+    counter.setThresholds(CrmThresholdType::CRM_USED, 10, 20, 0);
+    EXPECT_EQ(moveTo(counter, 10), 0);
+    EXPECT_TRUE(counter.inc());
+    EXPECT_EQ(moveTo(counter, 19), 0);
+    EXPECT_TRUE(counter.inc());
+
+    /* 100 entries: free >= 90 exceeds up to 10 used, free <= 80 clears from 20 used */
+    counter.setThresholds(CrmThresholdType::CRM_FREE, 80, 90, 100);
+    EXPECT_EQ(moveTo(counter, 20), 0);
+    EXPECT_TRUE(counter.dec());
+    EXPECT_EQ(moveTo(counter, 11), 0);
+    EXPECT_TRUE(counter.dec());
+    EXPECT_EQ(moveTo(counter, 0), 0);
+}
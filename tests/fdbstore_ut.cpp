@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "fdbstore.h"
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    const sai_object_id_t VLAN10 = 0x2600000000000a;
+    const sai_object_id_t VLAN20 = 0x26000000000014;
+    const sai_object_id_t BP1 = 0x3a000000000001;
+    const sai_object_id_t BP2 = 0x3a000000000002;
+
+    FdbEntry makeEntry(const string &mac, sai_object_id_t bv_id)
+    {
+        return { MacAddress(mac), bv_id };
+    }
+
+    vector<string> macs(const vector<FdbEntry> &entries)
+    {
+        vector<string> result;
+        for (const auto &entry : entries)
+        {
+            result.push_back(entry.mac.to_string() + "@" + to_string(entry.bv_id == VLAN10 ? 10 : 20));
+        }
+        sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST(fdbstore, insert_erase)
+{
+    FdbStore store;
+    auto entry = makeEntry("00:00:00:00:00:01", VLAN10);
+
+    EXPECT_TRUE(store.insert(entry, { BP1, "dynamic" }));
+    EXPECT_FALSE(store.insert(entry, { BP2, "static" }));
+    EXPECT_TRUE(store.contains(entry));
+    ASSERT_NE(store.find(entry), nullptr);
+    EXPECT_EQ(store.find(entry)->bridge_port_id, BP1);
+    EXPECT_EQ(store.find(entry)->type, "dynamic");
+    EXPECT_EQ(store.size(), 1u);
+
+    EXPECT_TRUE(store.erase(entry));
+    EXPECT_FALSE(store.erase(entry));
+    EXPECT_FALSE(store.contains(entry));
+    EXPECT_EQ(store.find(entry), nullptr);
+    EXPECT_FALSE(store.hasEntries(BP1, SAI_NULL_OBJECT_ID, false));
+    EXPECT_FALSE(store.hasEntries(SAI_NULL_OBJECT_ID, VLAN10, false));
+    EXPECT_EQ(store.size(), 0u);
+}
+
+TEST(fdbstore, lookups)
+{
+    FdbStore store;
+
+    store.insert(makeEntry("00:00:00:00:00:01", VLAN10), { BP1, "dynamic" });
+    store.insert(makeEntry("00:00:00:00:00:02", VLAN10), { BP2, "dynamic" });
+    store.insert(makeEntry("00:00:00:00:00:01", VLAN20), { BP1, "static" });
+    store.insert(makeEntry("00:00:00:00:00:03", VLAN20), { BP1, "dynamic" });
+
+    EXPECT_EQ(macs(store.getEntries(SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID, false)),
+              vector<string>({ "00:00:00:00:00:01@10", "00:00:00:00:00:01@20",
+                               "00:00:00:00:00:02@10", "00:00:00:00:00:03@20" }));
+    EXPECT_EQ(macs(store.getEntries(SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID, true)),
+              vector<string>({ "00:00:00:00:00:01@10", "00:00:00:00:00:02@10", "00:00:00:00:00:03@20" }));
+
+    EXPECT_EQ(macs(store.getEntries(BP1, SAI_NULL_OBJECT_ID, false)),
+              vector<string>({ "00:00:00:00:00:01@10", "00:00:00:00:00:01@20", "00:00:00:00:00:03@20" }));
+    EXPECT_EQ(macs(store.getEntries(BP1, SAI_NULL_OBJECT_ID, true)),
+              vector<string>({ "00:00:00:00:00:01@10", "00:00:00:00:00:03@20" }));
+    EXPECT_EQ(macs(store.getEntries(SAI_NULL_OBJECT_ID, VLAN10, false)),
+              vector<string>({ "00:00:00:00:00:01@10", "00:00:00:00:00:02@10" }));
+    EXPECT_EQ(macs(store.getEntries(BP1, VLAN20, false)),
+              vector<string>({ "00:00:00:00:00:01@20", "00:00:00:00:00:03@20" }));
+    EXPECT_EQ(macs(store.getEntries(BP2, VLAN20, false)), vector<string>());
+
+    EXPECT_TRUE(store.hasEntries(BP2, VLAN10, true));
+    EXPECT_FALSE(store.hasEntries(BP2, VLAN20, false));
+    EXPECT_FALSE(store.hasEntries(0x3a000000000003, SAI_NULL_OBJECT_ID, false));
+
+    /* The indexes follow the removals */
+    store.erase(makeEntry("00:00:00:00:00:03", VLAN20));
+    EXPECT_FALSE(store.hasEntries(BP1, VLAN20, true));
+    EXPECT_TRUE(store.hasEntries(BP1, VLAN20, false));
+    store.erase(makeEntry("00:00:00:00:00:02", VLAN10));
+    EXPECT_FALSE(store.hasEntries(BP2, SAI_NULL_OBJECT_ID, false));
+}
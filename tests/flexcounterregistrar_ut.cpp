@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "flexcounterregistrar.h"
+
+using namespace std;
+
+namespace
+{
+    const string QUEUE_GROUP = "QUEUE_STAT_COUNTER";
+    const string WM_GROUP = "QUEUE_WATERMARK_STAT_COUNTER";
+
+    vector<string> keys(const vector<FlexCounterRegistration> &registrations)
+    {
+        vector<string> k;
+        for (const auto &r : registrations)
+        {
+            k.push_back(r.key);
+        }
+        return k;
+    }
+}
+
+TEST(flexcounterregistrar, lazy)
+{
+    FlexCounterRegistrar registrar;
+
+    registrar.setGroupCounters(QUEUE_GROUP, "QUEUE_COUNTER_ID_LIST", { "SAI_QUEUE_STAT_PACKETS", "SAI_QUEUE_STAT_BYTES" });
+    registrar.setGroupCounters(WM_GROUP, "QUEUE_COUNTER_ID_LIST", { "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES" });
+
+    for (auto id : { "oid:0x1", "oid:0x2", "oid:0x3" })
+    {
+        registrar.addObject(QUEUE_GROUP, id);
+        registrar.addObject(WM_GROUP, id);
+    }
+
+    /* Nothing is written for disabled groups */
+    EXPECT_FALSE(registrar.hasPending());
+    EXPECT_TRUE(registrar.getPending(10).empty());
+
+    registrar.enableGroup(WM_GROUP);
+    EXPECT_TRUE(registrar.isGroupEnabled(WM_GROUP));
+    EXPECT_FALSE(registrar.isGroupEnabled(QUEUE_GROUP));
+
+    auto registrations = registrar.getPending(2);
+    ASSERT_EQ(registrations.size(), 2u);
+    EXPECT_EQ(registrations[0].field, "QUEUE_COUNTER_ID_LIST");
+    EXPECT_EQ(registrations[0].value, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES");
+    EXPECT_TRUE(registrar.hasPending());
+    EXPECT_EQ(registrar.getPending(2).size(), 1u);
+    EXPECT_FALSE(registrar.hasPending());
+
+    /* Objects added to an enabled group are registered once */
+    registrar.addObject(WM_GROUP, "oid:0x4");
+    registrar.addObject(WM_GROUP, "oid:0x4");
+    registrar.enableGroup(WM_GROUP);
+    EXPECT_EQ(keys(registrar.getPending(10)), vector<string>({ "QUEUE_WATERMARK_STAT_COUNTER:oid:0x4" }));
+
+    registrar.enableGroup(QUEUE_GROUP);
+    registrations = registrar.getPending(10);
+    ASSERT_EQ(registrations.size(), 3u);
+    EXPECT_EQ(registrations[0].value, "SAI_QUEUE_STAT_PACKETS,SAI_QUEUE_STAT_BYTES");
+}
+
+TEST(flexcounterregistrar, remove)
+{
+    FlexCounterRegistrar registrar;
+    FlexCounterRegistration unregistration;
+
+    registrar.setGroupCounters("RIF_STAT_COUNTER", "RIF_COUNTER_ID_LIST", { "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS" });
+    registrar.enableGroup("RIF_STAT_COUNTER");
+
+    registrar.addObject("RIF_STAT_COUNTER", "oid:0x10");
+    registrar.addObject("RIF_STAT_COUNTER", "oid:0x11");
+
+    /* Removed before being written */
+    EXPECT_FALSE(registrar.removeObject("RIF_STAT_COUNTER", "oid:0x10", unregistration));
+    EXPECT_EQ(keys(registrar.getPending(10)), vector<string>({ "RIF_STAT_COUNTER:oid:0x11" }));
+
+    EXPECT_TRUE(registrar.removeObject("RIF_STAT_COUNTER", "oid:0x11", unregistration));
+    EXPECT_EQ(unregistration.key, "RIF_STAT_COUNTER:oid:0x11");
+    EXPECT_EQ(unregistration.field, "RIF_COUNTER_ID_LIST");
+    EXPECT_EQ(unregistration.value, "");
+    EXPECT_FALSE(registrar.removeObject("RIF_STAT_COUNTER", "oid:0x11", unregistration));
+    EXPECT_FALSE(registrar.removeObject("PG_WATERMARK_STAT_COUNTER", "oid:0x11", unregistration));
+
+    /* Added again, registered again */
+    registrar.addObject("RIF_STAT_COUNTER", "oid:0x11");
+    EXPECT_EQ(registrar.getPending(10).size(), 1u);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "flushpolicy.h"
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    map<string, string> getStats(const FlushPolicy &policy)
+    {
+        vector<FieldValueTuple> fvs;
+        policy.getStats(fvs);
+        return map<string, string>(fvs.begin(), fvs.end());
+    }
+}
+
+TEST(flushpolicy, parse)
+{
+    FlushPolicyConfig config;
+
+    ASSERT_TRUE(FlushPolicy::parse("", config));
+    EXPECT_EQ(config.ops, 1u);
+    EXPECT_EQ(config.interval, 0u);
+    EXPECT_FALSE(config.idle);
+
+    ASSERT_TRUE(FlushPolicy::parse("ops=64", config));
+    EXPECT_EQ(config.ops, 64u);
+    EXPECT_EQ(config.interval, 1000u);
+    EXPECT_FALSE(config.idle);
+
+    ASSERT_TRUE(FlushPolicy::parse("idle,time=500", config));
+    EXPECT_EQ(config.ops, 0u);
+    EXPECT_EQ(config.interval, 500u);
+    EXPECT_TRUE(config.idle);
+
+    EXPECT_FALSE(FlushPolicy::parse("ops=x", config));
+    EXPECT_FALSE(FlushPolicy::parse("always", config));
+}
+
+TEST(flushpolicy, flush_after_each_event)
+{
+    FlushPolicyConfig config;
+    ASSERT_TRUE(FlushPolicy::parse("", config));
+
+    int flushes = 0;
+    FlushPolicy policy([&]() { flushes++; }, config);
+
+    policy.opDone();
+    policy.opDone();
+    EXPECT_EQ(flushes, 2);
+    EXPECT_FALSE(policy.waitsForIdle());
+
+    auto stats = getStats(policy);
+    EXPECT_EQ(stats["flushes_ops"], "2");
+    EXPECT_EQ(stats["ops_per_flush_le_1"], "2");
+}
+
+TEST(flushpolicy, coalesce)
+{
+    FlushPolicyConfig config;
+    ASSERT_TRUE(FlushPolicy::parse("ops=4,idle", config));
+
+    int flushes = 0;
+    FlushPolicy policy([&]() { flushes++; }, config);
+
+    /* Flushed after the 4th event */
+    for (int i = 0; i < 6; i++)
+    {
+        policy.opDone();
+    }
+    EXPECT_EQ(flushes, 1);
+
+    /* The 2 events left are flushed once idle, then nothing is left */
+    EXPECT_TRUE(policy.waitsForIdle());
+    policy.onIdle();
+    EXPECT_EQ(flushes, 2);
+    EXPECT_FALSE(policy.waitsForIdle());
+    policy.onTimer();
+    policy.flush();
+    EXPECT_EQ(flushes, 2);
+
+    auto stats = getStats(policy);
+    EXPECT_EQ(stats["flushes_ops"], "1");
+    EXPECT_EQ(stats["flushes_idle"], "1");
+    EXPECT_EQ(stats["flushes_time"], "0");
+    EXPECT_EQ(stats["ops_per_flush_le_2"], "1");
+    EXPECT_EQ(stats["ops_per_flush_le_4"], "1");
+}
+
+TEST(flushpolicy, histogram)
+{
+    Histogram histogram(4);
+
+    for (uint64_t value : { 0, 1, 2, 3, 4, 8, 100 })
+    {
+        histogram.add(value);
+    }
+
+    vector<FieldValueTuple> fvs;
+    histogram.dump("h", fvs);
+
+    vector<FieldValueTuple> expected = {
+        { "h_le_1", "2" },
+        { "h_le_2", "1" },
+        { "h_le_4", "2" },
+        { "h_le_inf", "2" }
+    };
+    EXPECT_EQ(fvs, expected);
+}
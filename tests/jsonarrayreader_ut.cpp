@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "jsonarrayreader.h"
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    vector<string> readAll(const string &text)
+    {
+        istringstream in(text);
+        JsonArrayReader reader(in);
+        vector<string> elements;
+        string element;
+
+        while (reader.next(element))
+        {
+            elements.push_back(element);
+        }
+        EXPECT_EQ(reader.getElementsRead(), elements.size());
+        EXPECT_FALSE(reader.next(element));
+        return elements;
+    }
+}
+
+TEST(jsonarrayreader, elements)
+{
+    auto elements = readAll(
+        " [\n"
+        "  {\"PORT_TABLE:Ethernet0\": {\"mtu\": \"9100\", \"alias\": \"a[b]{c}\"}, \"OP\": \"SET\"},\n"
+        "  {\"ROUTE_TABLE:10.0.0.0/24\": {\"nexthop\": \"q\\\"}\\\\\"}, \"OP\": \"DEL\"} ,"
+        "  [1, [2]], \"x,]\", 42 , true\n"
+        "]\n");
+
+    ASSERT_EQ(elements.size(), 6u);
+    EXPECT_EQ(elements[0], "{\"PORT_TABLE:Ethernet0\": {\"mtu\": \"9100\", \"alias\": \"a[b]{c}\"}, \"OP\": \"SET\"}");
+    EXPECT_EQ(elements[1], "{\"ROUTE_TABLE:10.0.0.0/24\": {\"nexthop\": \"q\\\"}\\\\\"}, \"OP\": \"DEL\"}");
+    EXPECT_EQ(elements[2], "[1, [2]]");
+    EXPECT_EQ(elements[3], "\"x,]\"");
+    EXPECT_EQ(elements[4], "42");
+    EXPECT_EQ(elements[5], "true");
+
+    EXPECT_TRUE(readAll("[]").empty());
+    EXPECT_TRUE(readAll("  [ \n ]  \n").empty());
+}
+
+TEST(jsonarrayreader, offsets)
+{
+    istringstream in("[{\"a\": 1}, {\"b\": 2}]");
+    JsonArrayReader reader(in);
+    string element;
+
+    ASSERT_TRUE(reader.next(element));
+    EXPECT_EQ(reader.getBytesRead(), 9u);
+    ASSERT_TRUE(reader.next(element));
+    EXPECT_EQ(reader.getBytesRead(), 19u);
+    ASSERT_FALSE(reader.next(element));
+    EXPECT_EQ(reader.getBytesRead(), 20u);
+}
+
+TEST(jsonarrayreader, errors)
+{
+    EXPECT_THROW(readAll(""), runtime_error);
+    EXPECT_THROW(readAll("{\"a\": 1}"), runtime_error);
+    EXPECT_THROW(readAll("[{\"a\": 1}"), runtime_error);
+    EXPECT_THROW(readAll("[{\"a\": 1} {\"b\": 2}]"), runtime_error);
+    EXPECT_THROW(readAll("[{\"a\": 1},]"), runtime_error);
+    EXPECT_THROW(readAll("[,{\"a\": 1}]"), runtime_error);
+    EXPECT_THROW(readAll("[{\"a\": \"1}]"), runtime_error);
+    EXPECT_THROW(readAll("[{\"a\": 1}] x"), runtime_error);
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include <net/if.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "netlinkcmd.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * These tests program the kernel of the host, they are skipped when not
+ * running as root. All the links are named nlut* and removed at the end.
+ */
+namespace
+{
+    const string BRIDGE = "nlutbr";
+    const string PORT = "nlutport";
+    const string PEER = "nlutpeer";
+
+    bool canRun()
+    {
+        if (geteuid() != 0)
+        {
+            cout << "[ SKIPPED  ] requires CAP_NET_ADMIN" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    int run(const string &cmd)
+    {
+        return system((cmd + " >/dev/null 2>&1").c_str());
+    }
+
+    /* Probe a kernel feature with /sbin/ip */
+    bool kernelSupports(const string &cmd, const string &link)
+    {
+        if (run(cmd) != 0)
+        {
+            cout << "[ SKIPPED  ] kernel does not support '" << cmd << "'" << endl;
+            return false;
+        }
+        run("ip link del " + link);
+        return true;
+    }
+
+    string readSysfs(const string &path)
+    {
+        ifstream f(path);
+        string value;
+        f >> value;
+        return value;
+    }
+
+    void cleanup()
+    {
+        run("ip link del " + BRIDGE);
+        run("ip link del " + PORT);
+        run("ip link del nlutvrf");
+    }
+}
+
+TEST(netlinkcmd, links)
+{
+    if (!canRun())
+    {
+        return;
+    }
+    cleanup();
+
+    ASSERT_EQ(run("ip link add " + PORT + " type veth peer name " + PEER), 0);
+
+    NetlinkCmd nl;
+
+    nl.addBridge(BRIDGE, true, false);
+    nl.setLinkMtu(PORT, 1400);
+    nl.setLinkAdminState(PORT, true);
+    /* Resolving the bridge commits its creation first */
+    nl.setLinkMaster(PORT, BRIDGE);
+    nl.addAddress(BRIDGE, IpPrefix("10.250.0.1/24"));
+    nl.addAddress(BRIDGE, IpPrefix("fc00:250::1/64"));
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+    EXPECT_EQ(nl.pending(), 0u);
+
+    EXPECT_EQ(readSysfs("/sys/class/net/" + PORT + "/mtu"), "1400");
+    EXPECT_EQ(run("ip link show " + PORT + " | grep -q 'master " + BRIDGE + "'"), 0);
+    EXPECT_EQ(run("ip link show " + PORT + " | grep -q '<.*UP.*>'"), 0);
+    EXPECT_EQ(run("ip address show dev " + BRIDGE + " | grep -q 10.250.0.1/24"), 0);
+    EXPECT_EQ(run("ip address show dev " + BRIDGE + " | grep -q fc00:250::1/64"), 0);
+
+    nl.delAddress(BRIDGE, IpPrefix("10.250.0.1/24"));
+    nl.setLinkMaster(PORT, "");
+    nl.setLinkAdminState(PORT, false);
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+    EXPECT_NE(run("ip address show dev " + BRIDGE + " | grep -q 10.250.0.1/24"), 0);
+    EXPECT_NE(run("ip link show " + PORT + " | grep -q 'master " + BRIDGE + "'"), 0);
+    EXPECT_NE(run("ip link show " + PORT + " | grep -q '<.*UP.*>'"), 0);
+
+    /* Failed requests are reported, the next ones are still applied */
+    nl.addBridge(BRIDGE, false, false);
+    nl.delLink(PORT);
+    EXPECT_FALSE(nl.commit());
+    EXPECT_NE(nl.getError().find(BRIDGE), string::npos);
+    EXPECT_EQ(if_nametoindex(PORT.c_str()), 0u);
+
+    nl.setLinkMtu("nlutnone", 1500);
+    EXPECT_FALSE(nl.commit());
+    nl.addAddress("nlutnone", IpPrefix("10.250.0.1/24"));
+    EXPECT_FALSE(nl.commit());
+
+    cleanup();
+}
+
+TEST(netlinkcmd, vlan_vrf)
+{
+    if (!canRun() ||
+        !kernelSupports("ip link add nlutvrf type vrf table 1001", "nlutvrf") ||
+        !kernelSupports("ip link add " + BRIDGE + " type bridge && "
+                        "ip link add link " + BRIDGE + " name " + BRIDGE + ".10 type vlan id 10", BRIDGE))
+    {
+        cleanup();
+        return;
+    }
+    cleanup();
+
+    NetlinkCmd nl;
+
+    nl.addBridge(BRIDGE, true, false);
+    nl.addVrf("nlutvrf", 1001);
+    nl.addVlanLink(BRIDGE, BRIDGE + ".10", 10, MacAddress("00:11:22:33:44:55"), true);
+    nl.setLinkMaster(BRIDGE + ".10", "nlutvrf");
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+
+    EXPECT_EQ(readSysfs("/sys/class/net/" + BRIDGE + ".10/address"), "00:11:22:33:44:55");
+    EXPECT_EQ(run("ip -d link show nlutvrf | grep -q 'vrf table 1001'"), 0);
+    EXPECT_EQ(run("ip link show " + BRIDGE + ".10 | grep -q 'master nlutvrf'"), 0);
+
+    nl.delLink(BRIDGE + ".10");
+    nl.delLink("nlutvrf");
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+    EXPECT_EQ(if_nametoindex("nlutvrf"), 0u);
+
+    cleanup();
+}
+
+TEST(netlinkcmd, bridge_vlans)
+{
+    if (!canRun() ||
+        !kernelSupports("ip link add " + BRIDGE + " type bridge vlan_filtering 1", BRIDGE))
+    {
+        return;
+    }
+    cleanup();
+
+    ASSERT_EQ(run("ip link add " + PORT + " type veth peer name " + PEER), 0);
+
+    NetlinkCmd nl;
+
+    nl.addBridge(BRIDGE, true, true);
+    nl.delBridgeVlan(BRIDGE, 1, true);
+    nl.addBridgeVlan(BRIDGE, 20, false, true);
+    nl.setLinkMaster(PORT, BRIDGE);
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+    EXPECT_EQ(readSysfs("/sys/class/net/" + BRIDGE + "/bridge/vlan_filtering"), "1");
+
+    /* Drop the default VLAN the port got when enslaved */
+    nl.delBridgeVlan(PORT, 1, false);
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+    EXPECT_FALSE(nl.hasBridgeVlans(PORT));
+
+    nl.addBridgeVlan(PORT, 20, true, false);
+    EXPECT_TRUE(nl.hasBridgeVlans(PORT));
+    EXPECT_EQ(run("bridge vlan show dev " + PORT + " | grep -q 'PVID'"), 0);
+
+    nl.delBridgeVlan(PORT, 20, false);
+    EXPECT_FALSE(nl.hasBridgeVlans(PORT));
+
+    cleanup();
+}
+
+/*
+ * Program the addresses and MTU of interfaces with one /sbin/ip execution
+ * per change, as the cfgmgr daemons do, and through NetlinkCmd. Only reports
+ * the timings and changes the host interfaces, so it is disabled: run it as
+ * root with --gtest_also_run_disabled_tests --gtest_filter='*benchmark'.
+ */
+TEST(netlinkcmd, DISABLED_benchmark)
+{
+    if (!canRun())
+    {
+        return;
+    }
+    cleanup();
+
+    const int count = 500;
+
+    ASSERT_EQ(run("ip link add " + BRIDGE + " up type bridge"), 0);
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        run("/bin/bash -c \"ip link set " + BRIDGE + " mtu " + to_string(1280 + i) + " && "
+            "ip address add 10.251." + to_string(i / 250) + "." + to_string(i % 250 + 1) + "/32 dev " + BRIDGE + "\"");
+    }
+    for (int i = 0; i < count; i++)
+    {
+        run("ip address del 10.251." + to_string(i / 250) + "." + to_string(i % 250 + 1) + "/32 dev " + BRIDGE);
+    }
+    auto exec_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    NetlinkCmd nl;
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        nl.setLinkMtu(BRIDGE, (uint32_t)(1280 + i));
+        nl.addAddress(BRIDGE, IpPrefix("10.251." + to_string(i / 250) + "." + to_string(i % 250 + 1) + "/32"));
+    }
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+    EXPECT_EQ(run("ip address show dev " + BRIDGE + " | grep -q 10.251.1.250/32"), 0);
+    for (int i = 0; i < count; i++)
+    {
+        nl.delAddress(BRIDGE, IpPrefix("10.251." + to_string(i / 250) + "." + to_string(i % 250 + 1) + "/32"));
+    }
+    ASSERT_TRUE(nl.commit()) << nl.getError();
+    auto nl_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    EXPECT_NE(run("ip address show dev " + BRIDGE + " | grep -q 10.251.1.250/32"), 0);
+
+    cout << "[ BENCH    ] " << count << " MTU changes, " << count << " address adds and dels: exec "
+         << exec_us << " us, netlink " << nl_us << " us" << endl;
+
+    cleanup();
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "nexthopgroup.h"
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    NextHopGroupEntry makeEntry(sai_object_id_t id)
+    {
+        NextHopGroupEntry entry;
+        entry.next_hop_group_id = id;
+        entry.ref_count = 0;
+        return entry;
+    }
+
+    /* Member set of width next hops out of 10.0.0.0/16, picked by index */
+    IpAddresses makeNextHops(size_t index, size_t width)
+    {
+        IpAddresses nexthops;
+        for (size_t i = 0; i < width; i++)
+        {
+            size_t host = (index * 7 + i * 131) % 65000 + 1;
+            nexthops.add(IpAddress("10.0." + to_string(host >> 8) + "." + to_string(host & 0xff)));
+        }
+        return nexthops;
+    }
+}
+
+TEST(nexthopgroup, hash)
+{
+    /* The hash only depends on the members, not on how the set was built */
+    EXPECT_EQ(hashNextHops(IpAddresses("1.1.1.1,2.2.2.2")), hashNextHops(IpAddresses("2.2.2.2,1.1.1.1")));
+    EXPECT_NE(hashNextHops(IpAddresses("1.1.1.1,2.2.2.2")), hashNextHops(IpAddresses("1.1.1.1,2.2.2.3")));
+    EXPECT_NE(hashNextHops(IpAddresses("1.1.1.1")), hashNextHops(IpAddresses("1.1.1.1,2.2.2.2")));
+    EXPECT_NE(hashNextHops(IpAddresses("1.1.1.1")), hashNextHops(IpAddresses("::ffff:1.1.1.1")));
+}
+
+TEST(nexthopgroup, find_insert_erase)
+{
+    NextHopGroupTable table;
+
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.find(IpAddresses("1.1.1.1,2.2.2.2")).valid());
+    EXPECT_FALSE(table.contains(IpAddresses("1.1.1.1,2.2.2.2")));
+    EXPECT_EQ(table.refCount(IpAddresses("1.1.1.1,2.2.2.2")), 0);
+
+    auto nhg = table.insert(IpAddresses("1.1.1.1,2.2.2.2"), makeEntry(0x100));
+    ASSERT_TRUE(nhg.valid());
+    EXPECT_EQ(nhg.id(), 0x100u);
+    EXPECT_EQ(nhg.nexthops(), IpAddresses("1.1.1.1,2.2.2.2"));
+
+    table.insert(IpAddresses("fc00::1,fc00::2"), makeEntry(0x200));
+    EXPECT_EQ(table.size(), 2u);
+
+    EXPECT_TRUE(table.find(IpAddresses("2.2.2.2,1.1.1.1")) == nhg);
+    EXPECT_TRUE(table.contains(IpAddresses("fc00::1,fc00::2")));
+
+    EXPECT_EQ(nhg.ref(), 1);
+    EXPECT_EQ(nhg.ref(), 2);
+    EXPECT_EQ(table.refCount(IpAddresses("1.1.1.1,2.2.2.2")), 2);
+    EXPECT_EQ(nhg.unref(), 1);
+    EXPECT_EQ(table.find(IpAddresses("1.1.1.1,2.2.2.2")).refCount(), 1);
+
+    table.erase(nhg);
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_FALSE(table.contains(IpAddresses("1.1.1.1,2.2.2.2")));
+    EXPECT_EQ(table.find(IpAddresses("fc00::1,fc00::2")).id(), 0x200u);
+}
+
+TEST(nexthopgroup, groups_with)
+{
+    NextHopGroupTable table;
+
+    auto nhg1 = table.insert(IpAddresses("1.1.1.1,2.2.2.2"), makeEntry(1));
+    auto nhg2 = table.insert(IpAddresses("1.1.1.1,3.3.3.3"), makeEntry(2));
+    table.insert(IpAddresses("2.2.2.2,3.3.3.3"), makeEntry(3));
+
+    auto nhgs = table.groupsWith(IpAddress("1.1.1.1"));
+    ASSERT_EQ(nhgs.size(), 2u);
+    EXPECT_TRUE((nhgs[0] == nhg1 && nhgs[1] == nhg2) || (nhgs[0] == nhg2 && nhgs[1] == nhg1));
+    EXPECT_TRUE(table.groupsWith(IpAddress("4.4.4.4")).empty());
+
+    table.erase(nhg1);
+    nhgs = table.groupsWith(IpAddress("1.1.1.1"));
+    ASSERT_EQ(nhgs.size(), 1u);
+    EXPECT_TRUE(nhgs[0] == nhg2);
+    EXPECT_EQ(table.groupsWith(IpAddress("2.2.2.2")).size(), 1u);
+
+    table.erase(nhg2);
+    EXPECT_TRUE(table.groupsWith(IpAddress("1.1.1.1")).empty());
+}
+
+TEST(nexthopgroup, handle_stable)
+{
+    NextHopGroupTable table;
+
+    auto nhg = table.insert(IpAddresses("1.1.1.1,2.2.2.2"), makeEntry(1));
+    nhg.ref();
+
+    /* Handles survive the rehashes of the table */
+    for (size_t i = 0; i < 10000; i++)
+    {
+        table.insert(makeNextHops(i, 4), makeEntry(i + 2));
+    }
+    for (size_t i = 0; i < 10000; i += 2)
+    {
+        table.erase(table.find(makeNextHops(i, 4)));
+    }
+
+    EXPECT_TRUE(table.find(IpAddresses("1.1.1.1,2.2.2.2")) == nhg);
+    EXPECT_EQ(nhg.id(), 1u);
+    EXPECT_EQ(nhg.refCount(), 1);
+    EXPECT_EQ(table.size(), 5001u);
+}
+
+/*
+ * Microbenchmark of the route programming lookups: reference every group
+ * once per route through the former std::map<IpAddresses, NextHopGroupEntry>
+ * and through NextHopGroupTable. Only reports the timings, so it is disabled:
+ * run it with --gtest_also_run_disabled_tests --gtest_filter='*benchmark'.
+ */
+TEST(nexthopgroup, DISABLED_benchmark)
+{
+    const size_t groups = 20000;
+    const size_t routes = 200000;
+    const size_t width = 8;
+
+    vector<IpAddresses> nexthops;
+    for (size_t i = 0; i < groups; i++)
+    {
+        nexthops.push_back(makeNextHops(i, width));
+    }
+
+    map<IpAddresses, NextHopGroupEntry> ordered;
+    NextHopGroupTable table;
+    for (size_t i = 0; i < groups; i++)
+    {
+        ordered[nexthops[i]] = makeEntry(i + 1);
+        table.insert(nexthops[i], makeEntry(i + 1));
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < routes; i++)
+    {
+        ordered[nexthops[i % groups]].ref_count++;
+    }
+    auto map_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < routes; i++)
+    {
+        table.find(nexthops[i % groups]).ref();
+    }
+    auto table_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(ordered[nexthops[0]].ref_count, table.refCount(nexthops[0]));
+
+    cout << "[ BENCH    ] " << routes << " lookups over " << groups << " groups of " << width
+         << " next hops: map " << map_us << " us, table " << table_us << " us" << endl;
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "pfcwddetector.h"
+
+using namespace std;
+
+namespace
+{
+    const sai_object_id_t Q3 = 0x15000000000003;
+    const sai_object_id_t Q4 = 0x15000000000004;
+    const sai_object_id_t PORT = 0x1000000000002;
+    const uint32_t POLL = 100;
+
+    PfcWdQueueSample sample(uint64_t occupancy, uint64_t packets, uint64_t pfcRx, uint64_t pfcPause,
+                            bool paused = false, bool stormed = false)
+    {
+        return { occupancy, packets, pfcRx, pfcPause, paused, false, stormed, true };
+    }
+
+    vector<PfcWdDetectorEvent> poll(PfcWdDetector &detector, const PfcWdQueueSample &s)
+    {
+        return detector.poll({ s }, POLL);
+    }
+}
+
+TEST(pfcwddetector, storm)
+{
+    PfcWdDetector detector(PFC_WD_DETECT_ON2OFF);
+    detector.addQueue(Q3, PORT, 3, 300, 0, false);
+
+    /* Queue stuck with PFC frames received, detected after the detection time */
+    EXPECT_TRUE(poll(detector, sample(1000, 50, 10, 5)).empty());
+    EXPECT_TRUE(poll(detector, sample(1000, 50, 20, 5)).empty());
+    EXPECT_TRUE(poll(detector, sample(1000, 50, 30, 5)).empty());
+    auto events = poll(detector, sample(1000, 50, 40, 5));
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].queueId, Q3);
+    EXPECT_EQ(events[0].event, PFC_WD_EVENT_STORM);
+
+    /* Traffic resumed, the detection time starts over */
+    EXPECT_TRUE(poll(detector, sample(1000, 50, 50, 5)).empty());
+    EXPECT_TRUE(poll(detector, sample(1000, 60, 60, 5)).empty());
+    EXPECT_TRUE(poll(detector, sample(1000, 60, 70, 5)).empty());
+    EXPECT_TRUE(poll(detector, sample(1000, 60, 80, 5)).empty());
+    EXPECT_EQ(poll(detector, sample(1000, 60, 90, 5)).size(), 1u);
+
+    /* Empty queue paused without XON */
+    EXPECT_TRUE(poll(detector, sample(0, 60, 100, 5, true)).empty());
+    EXPECT_TRUE(poll(detector, sample(0, 60, 110, 5, true)).empty());
+    EXPECT_TRUE(poll(detector, sample(0, 60, 120, 5, true)).empty());
+    EXPECT_EQ(poll(detector, sample(0, 60, 130, 5, true)).size(), 1u);
+    EXPECT_TRUE(poll(detector, sample(0, 60, 140, 6, true)).empty());
+
+    /* Stormed queues are left to the restoration */
+    EXPECT_TRUE(poll(detector, sample(1000, 60, 140, 6, false, true)).empty());
+    EXPECT_TRUE(poll(detector, sample(1000, 60, 150, 6, false, true)).empty());
+    EXPECT_TRUE(poll(detector, sample(1000, 60, 160, 6, false, true)).empty());
+}
+
+TEST(pfcwddetector, restore)
+{
+    PfcWdDetector detector(PFC_WD_DETECT_PAUSE_DURATION);
+    detector.addQueue(Q3, PORT, 3, 200, 300, false);
+    detector.addQueue(Q4, PORT, 4, 200, 0, true);
+    ASSERT_EQ(detector.getQueues().size(), 2u);
+
+    /* Paused for most of the poll interval, in usecs */
+    vector<PfcWdQueueSample> samples = { sample(0, 10, 5, 0), sample(0, 10, 5, 0) };
+    EXPECT_TRUE(detector.poll(samples, POLL).empty());
+    samples = { sample(0, 10, 5, 90000), sample(0, 10, 5, 90000) };
+    EXPECT_TRUE(detector.poll(samples, POLL).empty());
+    samples = { sample(0, 10, 5, 180000), sample(0, 10, 5, 180000) };
+    EXPECT_EQ(detector.poll(samples, POLL).size(), 2u);
+
+    /* Both start over after a storm, the alert queue is restored once it stops */
+    samples = { sample(0, 10, 5, 270000, false, true), sample(0, 10, 5, 270000, false, true) };
+    EXPECT_TRUE(detector.poll(samples, POLL).empty());
+    samples = { sample(0, 10, 6, 360000, false, true), sample(0, 20, 5, 270000, false, true) };
+    auto events = detector.poll(samples, POLL);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].queueId, Q4);
+    EXPECT_EQ(events[0].event, PFC_WD_EVENT_RESTORE);
+
+    /* Restored when no PFC frame is received for the restoration time */
+    samples = { sample(0, 10, 6, 360000, false, true), sample(0, 30, 5, 270000) };
+    EXPECT_TRUE(detector.poll(samples, POLL).empty());
+    EXPECT_TRUE(detector.poll(samples, POLL).empty());
+    events = detector.poll(samples, POLL);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].queueId, Q3);
+    EXPECT_EQ(events[0].event, PFC_WD_EVENT_RESTORE);
+
+    detector.removeQueue(Q3);
+    ASSERT_EQ(detector.getQueues().size(), 1u);
+    EXPECT_EQ(detector.getQueues()[0].queueId, Q4);
+    EXPECT_EQ(detector.getPfcPauseField(4), "SAI_PORT_STAT_PFC_4_RX_PAUSE_DURATION");
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <cstdlib>
+#include "routetable.h"
+
+using namespace std;
+using namespace swss;
+
+TEST(routetable, find_insert_erase)
+{
+    RouteTable table;
+
+    EXPECT_TRUE(table.empty());
+    EXPECT_TRUE(table.find(IpPrefix("10.0.0.0/8")) == table.end());
+
+    EXPECT_TRUE(table.insert(IpPrefix("0.0.0.0/0"), IpAddresses()).second);
+    EXPECT_TRUE(table.insert(IpPrefix("10.0.0.0/8"), IpAddresses("1.1.1.1")).second);
+    EXPECT_TRUE(table.insert(IpPrefix("10.1.0.0/16"), IpAddresses("1.1.1.1,2.2.2.2")).second);
+    EXPECT_TRUE(table.insert(IpPrefix("2001:db8::/32"), IpAddresses("fc00::1")).second);
+    EXPECT_FALSE(table.insert(IpPrefix("10.0.0.0/8"), IpAddresses("3.3.3.3")).second);
+    EXPECT_EQ(table.size(), 4u);
+
+    auto it = table.find(IpPrefix("10.0.0.0/8"));
+    ASSERT_TRUE(it != table.end());
+    EXPECT_EQ(it->first, IpPrefix("10.0.0.0/8"));
+    EXPECT_EQ(it->second, IpAddresses("1.1.1.1"));
+
+    EXPECT_TRUE(table.find(IpPrefix("10.0.0.0/9")) == table.end());
+    EXPECT_TRUE(table.find(IpPrefix("10.0.0.0/7")) == table.end());
+
+    table.set(IpPrefix("10.0.0.0/8"), IpAddresses("3.3.3.3"));
+    EXPECT_EQ(table.find(IpPrefix("10.0.0.0/8"))->second, IpAddresses("3.3.3.3"));
+    EXPECT_EQ(table.size(), 4u);
+
+    EXPECT_EQ(table.erase(IpPrefix("10.0.0.0/8")), 1u);
+    EXPECT_EQ(table.erase(IpPrefix("10.0.0.0/8")), 0u);
+    EXPECT_EQ(table.size(), 3u);
+
+    /* Routes below the erased one are still reachable */
+    EXPECT_EQ(table.find(IpPrefix("10.1.0.0/16"))->second, IpAddresses("1.1.1.1,2.2.2.2"));
+    EXPECT_EQ(table.find(IpPrefix("2001:db8::/32"))->second, IpAddresses("fc00::1"));
+}
+
+TEST(routetable, longest_match)
+{
+    RouteTable table;
+
+    table.insert(IpPrefix("0.0.0.0/0"), IpAddresses());
+    table.insert(IpPrefix("10.0.0.0/8"), IpAddresses("1.1.1.1"));
+    table.insert(IpPrefix("10.1.0.0/16"), IpAddresses("2.2.2.2"));
+    table.insert(IpPrefix("10.1.1.128/25"), IpAddresses("3.3.3.3"));
+    table.insert(IpPrefix("::/0"), IpAddresses());
+    table.insert(IpPrefix("2001:db8::/32"), IpAddresses("fc00::1"));
+
+    EXPECT_EQ(table.longestMatch(IpAddress("10.1.1.200"))->first, IpPrefix("10.1.1.128/25"));
+    EXPECT_EQ(table.longestMatch(IpAddress("10.1.1.1"))->first, IpPrefix("10.1.0.0/16"));
+    EXPECT_EQ(table.longestMatch(IpAddress("10.2.0.1"))->first, IpPrefix("10.0.0.0/8"));
+    EXPECT_EQ(table.longestMatch(IpAddress("192.168.0.1"))->first, IpPrefix("0.0.0.0/0"));
+    EXPECT_EQ(table.longestMatch(IpAddress("2001:db8::1"))->first, IpPrefix("2001:db8::/32"));
+    EXPECT_EQ(table.longestMatch(IpAddress("2001:db9::1"))->first, IpPrefix("::/0"));
+
+    vector<IpPrefix> matches;
+    table.forEachMatch(IpAddress("10.1.1.200"), [&](RouteTable::iterator it) { matches.push_back(it->first); });
+    ASSERT_EQ(matches.size(), 4u);
+    EXPECT_EQ(matches[0], IpPrefix("0.0.0.0/0"));
+    EXPECT_EQ(matches[3], IpPrefix("10.1.1.128/25"));
+
+    table.erase(IpPrefix("0.0.0.0/0"));
+    EXPECT_TRUE(table.longestMatch(IpAddress("192.168.0.1")) == table.end());
+}
+
+TEST(routetable, nexthop_sets_interned)
+{
+    RouteTable table;
+
+    table.insert(IpPrefix("10.0.0.0/24"), IpAddresses("1.1.1.1,2.2.2.2"));
+    table.insert(IpPrefix("10.0.1.0/24"), IpAddresses("1.1.1.1,2.2.2.2"));
+    table.insert(IpPrefix("10.0.2.0/24"), IpAddresses("3.3.3.3"));
+
+    /* Empty set plus two distinct sets */
+    EXPECT_EQ(table.nextHopSetCount(), 3u);
+
+    table.set(IpPrefix("10.0.2.0/24"), IpAddresses("1.1.1.1,2.2.2.2"));
+    EXPECT_EQ(table.nextHopSetCount(), 2u);
+
+    table.erase(IpPrefix("10.0.0.0/24"));
+    table.erase(IpPrefix("10.0.1.0/24"));
+    EXPECT_EQ(table.nextHopSetCount(), 2u);
+
+    table.erase(IpPrefix("10.0.2.0/24"));
+    EXPECT_EQ(table.nextHopSetCount(), 1u);
+}
+
+TEST(routetable, nexthops_reference_stable)
+{
+    RouteTable table;
+
+    table.insert(IpPrefix("10.0.0.0/24"), IpAddresses("1.1.1.1,2.2.2.2"));
+    auto route = *table.find(IpPrefix("10.0.0.0/24"));
+    const IpAddresses &nexthops = route.second;
+
+    /* Interning new sets must not move the ones already referenced */
+    for (int i = 0; i < 1000; i++)
+    {
+        table.insert(IpPrefix("11." + to_string(i / 256) + "." + to_string(i % 256) + ".0/24"),
+                     IpAddresses("3.3." + to_string(i / 256) + "." + to_string(i % 256)));
+    }
+
+    EXPECT_EQ(&nexthops, &table.find(IpPrefix("10.0.0.0/24"))->second);
+    EXPECT_EQ(nexthops, IpAddresses("1.1.1.1,2.2.2.2"));
+}
+
+TEST(routetable, compare_with_map)
+{
+    RouteTable table;
+    map<IpPrefix, IpAddresses> reference;
+
+    srand(1);
+    for (int i = 0; i < 20000; i++)
+    {
+        /* Random canonical prefix within 10.0.0.0/12 */
+        int len = 8 + rand() % 17;
+        uint32_t addr = (10u << 24) | ((uint32_t)(rand() % 16) << 16) | ((uint32_t)(rand() % 16) << 8);
+        addr &= ~((1u << (32 - len)) - 1);
+        IpPrefix ip_prefix(to_string(addr >> 24) + "." + to_string((addr >> 16) & 0xff) + "."
+                           + to_string((addr >> 8) & 0xff) + ".0/" + to_string(len));
+
+        IpAddresses nexthops("1.1.1." + to_string(rand() % 4));
+
+        switch (rand() % 3)
+        {
+            case 0:
+                EXPECT_EQ(table.erase(ip_prefix), reference.erase(ip_prefix));
+                break;
+            case 1:
+                EXPECT_EQ(table.insert(ip_prefix, nexthops).second, reference.emplace(ip_prefix, nexthops).second);
+                break;
+            default:
+                table.set(ip_prefix, nexthops);
+                reference[ip_prefix] = nexthops;
+                break;
+        }
+    }
+
+    ASSERT_EQ(table.size(), reference.size());
+
+    size_t count = 0;
+    for (auto route : table)
+    {
+        auto ref = reference.find(route.first);
+        ASSERT_TRUE(ref != reference.end());
+        EXPECT_EQ(ref->second, route.second);
+        count++;
+    }
+    EXPECT_EQ(count, reference.size());
+}
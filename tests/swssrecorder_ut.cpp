@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "swssrecorder.h"
+
+using namespace std;
+
+namespace
+{
+    SwssRecord routeRecord(const string &key, const string &op, const vector<pair<string, string>> &values)
+    {
+        SwssRecord record;
+        record.time = 1546300800000123;
+        record.table = "ROUTE_TABLE:";
+        record.key = key;
+        record.op = op;
+        record.values = values;
+        return record;
+    }
+
+    string readAll(const string &file)
+    {
+        string data;
+        gzFile gz = gzopen(file.c_str(), "rb");
+        if (!gz)
+        {
+            return data;
+        }
+
+        char buffer[4096];
+        int n;
+        while ((n = gzread(gz, buffer, sizeof(buffer))) > 0)
+        {
+            data.append(buffer, (size_t)n);
+        }
+        gzclose(gz);
+        return data;
+    }
+
+    vector<string> decodeAll(const string &data)
+    {
+        vector<string> lines;
+        size_t offset = 0;
+        SwssRecord record;
+        bool error;
+
+        while (decodeSwssRecord(data.data(), data.size(), offset, record, error))
+        {
+            lines.push_back(formatSwssRecordText(record));
+        }
+        EXPECT_FALSE(error);
+        EXPECT_EQ(offset, data.size());
+        return lines;
+    }
+
+    string tempDir()
+    {
+        char dir[] = "/tmp/swssrecorder_utXXXXXX";
+        return mkdtemp(dir);
+    }
+}
+
+TEST(swssrecorder, format)
+{
+    auto record = routeRecord("10.0.0.0/24", "SET", { { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } });
+    string text = formatSwssRecordText(record);
+    EXPECT_EQ(text.substr(text.find('|') - 7),
+              ".000123|ROUTE_TABLE:10.0.0.0/24|SET|nexthop:10.0.0.1|ifname:Ethernet0");
+
+    string data = SWSS_REC_MAGIC;
+    encodeSwssRecord(record, data);
+    encodeSwssRecord(routeRecord("10.0.0.0/24", "DEL", {}), data);
+    data += SWSS_REC_MAGIC;
+
+    SwssRecord message;
+    message.type = SWSS_REC_MESSAGE;
+    message.table = "recording started";
+    encodeSwssRecord(message, data);
+    EXPECT_TRUE(isSwssRecordBinary(data.data(), data.size()));
+
+    /* Records are only decoded once complete */
+    size_t offset = 0;
+    SwssRecord decoded;
+    bool error;
+    for (size_t size = 0; size < SWSS_REC_MAGIC_SIZE + 20; size++)
+    {
+        EXPECT_FALSE(decodeSwssRecord(data.data(), size, offset, decoded, error));
+        EXPECT_FALSE(error);
+        EXPECT_EQ(offset, 0u);
+    }
+
+    auto lines = decodeAll(data);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0], text);
+    EXPECT_EQ(lines[1].substr(lines[1].find('|')), "|ROUTE_TABLE:10.0.0.0/24|DEL");
+    EXPECT_EQ(lines[2].substr(lines[2].find('|')), "|recording started");
+
+    /* Corrupted length */
+    data[SWSS_REC_MAGIC_SIZE + 3] = (char)0x7f;
+    offset = 0;
+    EXPECT_FALSE(decodeSwssRecord(data.data(), data.size(), offset, decoded, error));
+    EXPECT_TRUE(error);
+}
+
+TEST(swssrecorder, options)
+{
+    SwssRecorderOptions options;
+
+    EXPECT_TRUE(SwssRecorder::parseOptions("", options));
+    EXPECT_FALSE(options.binary);
+    EXPECT_EQ(SwssRecorder::getFileName("/var/log/swss", options), "/var/log/swss/swss.rec");
+
+    EXPECT_TRUE(SwssRecorder::parseOptions("binary,gzip,size=100", options));
+    EXPECT_TRUE(options.binary);
+    EXPECT_TRUE(options.compress);
+    EXPECT_EQ(options.maxFileSize, 100u * 1024 * 1024);
+    EXPECT_EQ(options.maxFiles, 5u);
+    EXPECT_EQ(SwssRecorder::getFileName("/var/log/swss", options), "/var/log/swss/swss.rec.bin.gz");
+
+    EXPECT_TRUE(SwssRecorder::parseOptions("size=1,files=2", options));
+    EXPECT_EQ(options.maxFiles, 2u);
+
+    EXPECT_FALSE(SwssRecorder::parseOptions("size=x", options));
+    EXPECT_FALSE(SwssRecorder::parseOptions("lz4", options));
+}
+
+TEST(swssrecorder, record)
+{
+    string dir = tempDir();
+    SwssRecorderOptions options;
+    options.binary = true;
+    options.compress = true;
+    string file = SwssRecorder::getFileName(dir, options);
+
+    /* Smaller ring than the records, the producers wait for the writer */
+    SwssRecorder recorder(64);
+    ASSERT_TRUE(recorder.open(file, options));
+    recorder.recordMessage("recording started");
+
+    vector<thread> producers;
+    for (int t = 0; t < 4; t++)
+    {
+        producers.emplace_back([&recorder, t] {
+            for (int i = 0; i < 1000; i++)
+            {
+                recorder.record("ROUTE_TABLE", ":", to_string(t) + "." + to_string(i), "SET", { { "nexthop", "10.0.0.1" } });
+            }
+        });
+    }
+    for (auto &p : producers)
+    {
+        p.join();
+    }
+
+    recorder.flush();
+    EXPECT_EQ(decodeAll(readAll(file)).size(), 4001u);
+
+    /* Reopened files start with a magic header again */
+    recorder.reopen();
+    recorder.record("ROUTE_TABLE", ":", "last", "DEL", {});
+    recorder.close();
+    EXPECT_FALSE(recorder.isOpen());
+
+    auto lines = decodeAll(readAll(file));
+    ASSERT_EQ(lines.size(), 4002u);
+    EXPECT_EQ(lines[4001].substr(lines[4001].find('|')), "|ROUTE_TABLE:last|DEL");
+
+    unlink(file.c_str());
+    rmdir(dir.c_str());
+}
+
+TEST(swssrecorder, rotate)
+{
+    string dir = tempDir();
+    SwssRecorderOptions options;
+    EXPECT_TRUE(SwssRecorder::parseOptions("size=1,files=2", options));
+    string file = SwssRecorder::getFileName(dir, options);
+
+    SwssRecorder recorder;
+    ASSERT_TRUE(recorder.open(file, options));
+
+    string value(1000, 'x');
+    for (int i = 0; i < 2500; i++)
+    {
+        recorder.record("ROUTE_TABLE", ":", to_string(i), "SET", { { "value", value } });
+        if (i % 100 == 0)
+        {
+            recorder.flush();
+        }
+    }
+    recorder.close();
+
+    /* Text records, in up to 3 files of at least 1MB except the current one */
+    string current = readAll(file);
+    string rotated1 = readAll(file + ".1");
+    string rotated2 = readAll(file + ".2");
+    EXPECT_GE(rotated1.size(), 1024u * 1024);
+    EXPECT_GE(rotated2.size(), 1024u * 1024);
+    EXPECT_EQ(access((file + ".3").c_str(), F_OK), -1);
+    EXPECT_EQ(current.back(), '\n');
+    EXPECT_NE(current.find("|ROUTE_TABLE:2499|SET|value:x"), string::npos);
+
+    unlink(file.c_str());
+    unlink((file + ".1").c_str());
+    unlink((file + ".2").c_str());
+    rmdir(dir.c_str());
+}
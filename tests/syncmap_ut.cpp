@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "syncmap.h"
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    KeyOpFieldsValuesTuple makeTask(const string &key, const string &op, const vector<FieldValueTuple> &values)
+    {
+        return KeyOpFieldsValuesTuple(key, op, values);
+    }
+
+    /* Former Consumer::addToSync merge, copying the tasks */
+    void legacyMergeToSync(SyncMap &toSync, const KeyOpFieldsValuesTuple &entry)
+    {
+        string key = kfvKey(entry);
+        string op  = kfvOp(entry);
+
+        if (toSync.find(key) == toSync.end() || op == DEL_COMMAND)
+        {
+            toSync[key] = entry;
+        }
+        else
+        {
+            KeyOpFieldsValuesTuple existing_data = toSync[key];
+
+            auto new_values = kfvFieldsValues(entry);
+            auto existing_values = kfvFieldsValues(existing_data);
+
+            for (auto it : new_values)
+            {
+                string field = fvField(it);
+                string value = fvValue(it);
+
+                auto iu = existing_values.begin();
+                while (iu != existing_values.end())
+                {
+                    string ofield = fvField(*iu);
+                    if (field == ofield)
+                        iu = existing_values.erase(iu);
+                    else
+                        iu++;
+                }
+                existing_values.push_back(FieldValueTuple(field, value));
+            }
+            toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
+        }
+    }
+
+    /* ROUTE_TABLE task of the index-th /24 prefix */
+    KeyOpFieldsValuesTuple makeRouteTask(size_t index, const string &nexthop)
+    {
+        string prefix = to_string(10 + (index >> 16)) + "." + to_string((index >> 8) & 0xff) + "." +
+                        to_string(index & 0xff) + ".0/24";
+        return makeTask(prefix, SET_COMMAND, { { "nexthop", nexthop }, { "ifname", "Ethernet0,Ethernet4" } });
+    }
+}
+
+TEST(syncmap, add_and_replace)
+{
+    SyncMap toSync;
+
+    mergeToSync(toSync, makeTask("k1", SET_COMMAND, { { "a", "1" } }));
+    mergeToSync(toSync, makeTask("k2", DEL_COMMAND, {}));
+    ASSERT_EQ(toSync.size(), 2u);
+    EXPECT_EQ(kfvOp(toSync["k2"]), DEL_COMMAND);
+
+    /* A DEL replaces the pending SET */
+    mergeToSync(toSync, makeTask("k1", DEL_COMMAND, {}));
+    EXPECT_EQ(kfvOp(toSync["k1"]), DEL_COMMAND);
+    EXPECT_TRUE(kfvFieldsValues(toSync["k1"]).empty());
+
+    /* A SET on a pending DEL becomes a SET */
+    mergeToSync(toSync, makeTask("k2", SET_COMMAND, { { "b", "2" } }));
+    EXPECT_EQ(kfvKey(toSync["k2"]), "k2");
+    EXPECT_EQ(kfvOp(toSync["k2"]), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(toSync["k2"]), vector<FieldValueTuple>({ { "b", "2" } }));
+}
+
+TEST(syncmap, merge_fields)
+{
+    /* Small updates are scanned, large ones indexed, both as the former merge */
+    for (size_t width : { 3, 40 })
+    {
+        SyncMap toSync;
+
+        vector<FieldValueTuple> values;
+        for (size_t i = 0; i < width; i++)
+        {
+            values.emplace_back("f" + to_string(i), "v" + to_string(i));
+        }
+        auto first = makeTask("key", SET_COMMAND, values);
+
+        /* Overwrite every other field, set one twice and add a new one */
+        values.clear();
+        for (size_t i = 0; i < width; i += 2)
+        {
+            values.emplace_back("f" + to_string(i), "w" + to_string(i));
+        }
+        values.emplace_back("f0", "x0");
+        values.emplace_back("new", "n");
+        auto second = makeTask("key", SET_COMMAND, values);
+
+        /* Fields not set again, then the fields set again at their last position */
+        vector<FieldValueTuple> expected;
+        for (size_t i = 1; i < width; i += 2)
+        {
+            expected.emplace_back("f" + to_string(i), "v" + to_string(i));
+        }
+        for (size_t i = 2; i < width; i += 2)
+        {
+            expected.emplace_back("f" + to_string(i), "w" + to_string(i));
+        }
+        expected.emplace_back("f0", "x0");
+        expected.emplace_back("new", "n");
+
+        mergeToSync(toSync, std::move(first));
+        mergeToSync(toSync, std::move(second));
+
+        EXPECT_EQ(kfvFieldsValues(toSync["key"]), expected);
+        EXPECT_EQ(kfvFieldsValues(toSync["key"]).size(), width + 1);
+    }
+}
+
+/*
+ * Microbenchmark of a burst of 1M ROUTE_TABLE tasks, then of an update of
+ * every route before the first burst was processed, through the former and
+ * the new merge. Only reports the timings, so it is disabled: run it with
+ * --gtest_also_run_disabled_tests --gtest_filter='*benchmark'.
+ */
+TEST(syncmap, DISABLED_benchmark)
+{
+    const size_t routes = 1000000;
+
+    auto burst = [&](const string &nexthop)
+    {
+        deque<KeyOpFieldsValuesTuple> entries;
+        for (size_t i = 0; i < routes; i++)
+        {
+            entries.push_back(makeRouteTask(i, nexthop));
+        }
+        return entries;
+    };
+
+    long legacy_us, merge_us;
+    {
+        SyncMap toSync;
+        auto adds = burst("10.0.0.1,10.0.0.3");
+        auto updates = burst("10.0.0.1");
+
+        auto start = chrono::steady_clock::now();
+        for (const auto &entry : adds)
+        {
+            legacyMergeToSync(toSync, entry);
+        }
+        for (const auto &entry : updates)
+        {
+            legacyMergeToSync(toSync, entry);
+        }
+        legacy_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(toSync.size(), routes);
+    }
+    {
+        SyncMap toSync;
+        auto adds = burst("10.0.0.1,10.0.0.3");
+        auto updates = burst("10.0.0.1");
+
+        auto start = chrono::steady_clock::now();
+        for (auto &entry : adds)
+        {
+            mergeToSync(toSync, std::move(entry));
+        }
+        for (auto &entry : updates)
+        {
+            mergeToSync(toSync, std::move(entry));
+        }
+        merge_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(toSync.size(), routes);
+        EXPECT_EQ(fvValue(kfvFieldsValues(toSync.begin()->second).front()), "10.0.0.1");
+    }
+
+    cout << "[ BENCH    ] " << routes << " route tasks added then updated: copying merge "
+         << legacy_us << " us, in place merge " << merge_us << " us" << endl;
+}
@@ -99,3 +99,29 @@ def test_PfcAsymmetric(dvs, testlog):
     pfc = getPortAttr(dvs, port_oid, 'SAI_PORT_ATTR_PRIORITY_FLOW_CONTROL')
     assert pfc == pfc_tx
 
+
+
+def test_PfcWdQueueMaps(dvs, testlog):
+
+    cfg_db = swsscommon.DBConnector(swsscommon.CONFIG_DB, dvs.redis_sock, 0)
+    cnt_db = swsscommon.DBConnector(swsscommon.COUNTERS_DB, dvs.redis_sock, 0)
+
+    # Enable the PFC watchdog counters only, the queue counters stay disabled
+    flex_counter_tbl = swsscommon.Table(cfg_db, 'FLEX_COUNTER_TABLE')
+    fvs = swsscommon.FieldValuePairs([('FLEX_COUNTER_STATUS', 'enable')])
+    flex_counter_tbl.set('PFCWD', fvs)
+
+    # The PFC watchdog plugins read the queue maps
+    queue_port_map_tbl = swsscommon.Table(cnt_db, 'COUNTERS_QUEUE_PORT_MAP')
+    queue_index_map_tbl = swsscommon.Table(cnt_db, 'COUNTERS_QUEUE_INDEX_MAP')
+
+    for i in range(50):
+        (status, fvs) = queue_port_map_tbl.get('')
+        if status and len(fvs) > 0:
+            break
+        time.sleep(0.2)
+
+    assert status and len(fvs) > 0
+
+    (status, fvs) = queue_index_map_tbl.get('')
+    assert status and len(fvs) > 0
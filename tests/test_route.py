@@ -4,6 +4,15 @@ import re
 import time
 import json
 
+def wait_for(check, timeout):
+    # poll the check until it holds or the timeout in seconds expires
+    deadline = time.time() + timeout
+    while not check():
+        if time.time() > deadline:
+            return False
+        time.sleep(0.2)
+    return True
+
 def test_RouteAdd(dvs, testlog):
 
     config_db = swsscommon.DBConnector(swsscommon.CONFIG_DB, dvs.redis_sock, 0)
@@ -40,3 +49,63 @@ def test_RouteAdd(dvs, testlog):
     rt_key = json.loads(addobjs[0]['key'])
 
     assert rt_key['dest'] == "2.2.2.0/24"
+
+def test_RouteWaitForNextHop(dvs, testlog):
+
+    config_db = swsscommon.DBConnector(swsscommon.CONFIG_DB, dvs.redis_sock, 0)
+    intf_tbl = swsscommon.Table(config_db, "INTERFACE")
+    fvs = swsscommon.FieldValuePairs([("NULL","NULL")])
+    intf_tbl.set("Ethernet8|10.0.0.4/31", fvs)
+    dvs.runcmd("ifconfig Ethernet8 up")
+
+    time.sleep(1)
+
+    db = swsscommon.DBConnector(0, dvs.redis_sock, 0)
+    ps = swsscommon.ProducerStateTable(db, "ROUTE_TABLE")
+    neigh_ps = swsscommon.ProducerStateTable(db, "NEIGH_TABLE")
+
+    pubsub = dvs.SubscribeAsicDbObject("SAI_OBJECT_TYPE_ROUTE_ENTRY")
+
+    # the next hop is not resolved, the route waits for it
+    fvs = swsscommon.FieldValuePairs([("nexthop","10.0.0.5"), ("ifname", "Ethernet8")])
+    ps.set("3.3.3.0/24", fvs)
+
+    (addobjs, delobjs) = dvs.GetSubscribedAsicDbObjects(pubsub)
+    assert len(addobjs) == 0
+
+    # other events do not retry the waiting route, which is counted
+    for i in range(5):
+        ps.set("4.4.4.%d/32" % i, swsscommon.FieldValuePairs([("nexthop","10.0.0.5"), ("ifname", "Ethernet8")]))
+        time.sleep(0.1)
+
+    # the statistics are published every 10 seconds
+    counters_db = swsscommon.DBConnector(swsscommon.COUNTERS_DB, dvs.redis_sock, 0)
+    stats_tbl = swsscommon.Table(counters_db, "ORCH_RETRY_STATS")
+
+    def retries_skipped():
+        (status, fvs) = stats_tbl.get("orchagent")
+        if not status:
+            return False
+        stats = dict(fvs)
+        return int(stats["skipped_retry_scans"]) > 0 and int(stats["skipped_retry_tasks"]) > 0
+
+    assert wait_for(retries_skipped, 15)
+
+    # resolving the next hop wakes the route up
+    neigh_ps.set("Ethernet8:10.0.0.5", swsscommon.FieldValuePairs([("neigh", "00:00:00:00:00:05"), ("family", "IPv4")]))
+
+    asic_db = swsscommon.DBConnector(swsscommon.ASIC_DB, dvs.redis_sock, 0)
+    route_tbl = swsscommon.Table(asic_db, "ASIC_STATE:SAI_OBJECT_TYPE_ROUTE_ENTRY")
+
+    def route_programmed():
+        dests = [json.loads(key)['dest'] for key in route_tbl.getKeys()]
+        return "3.3.3.0/24" in dests
+
+    assert wait_for(route_programmed, 10)
+
+    ps._del("3.3.3.0/24")
+    for i in range(5):
+        ps._del("4.4.4.%d/32" % i)
+    neigh_ps._del("Ethernet8:10.0.0.5")
+    intf_tbl._del("Ethernet8|10.0.0.4/31")
+    time.sleep(1)
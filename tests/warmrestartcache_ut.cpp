@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <map>
+#include "warmRestartCache.h"
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    vector<FieldValueTuple> neigh(const string &mac, const string &family)
+    {
+        return { { "neigh", mac }, { "family", family } };
+    }
+
+    map<string, pair<AppTableCache::cache_state_t, vector<FieldValueTuple>>> entries(const AppTableCache &cache)
+    {
+        map<string, pair<AppTableCache::cache_state_t, vector<FieldValueTuple>>> e;
+        cache.forEach([&](const string &key, AppTableCache::cache_state_t state, const vector<FieldValueTuple> &fv) {
+            e[key] = make_pair(state, fv);
+        });
+        return e;
+    }
+}
+
+TEST(warmrestartcache, states)
+{
+    AppTableCache cache;
+
+    cache.restore("Ethernet0:10.0.0.1", neigh("00:00:00:00:00:01", "IPv4"));
+    cache.restore("Ethernet0:10.0.0.2", neigh("00:00:00:00:00:02", "IPv4"));
+    cache.restore("Ethernet0:10.0.0.3", neigh("00:00:00:00:00:03", "IPv4"));
+    cache.restore("Ethernet0:fc00::4", neigh("00:00:00:00:00:04", "IPv6"));
+
+    EXPECT_EQ(cache.insert("Ethernet0:10.0.0.1", neigh("00:00:00:00:00:01", "IPv4"), false), AppTableCache::SAME);
+    EXPECT_EQ(cache.insert("Ethernet0:10.0.0.2", neigh("00:00:00:00:00:22", "IPv4"), false), AppTableCache::NEW);
+    EXPECT_EQ(cache.insert("Ethernet0:10.0.0.3", {}, true), AppTableCache::DELETE);
+    EXPECT_EQ(cache.insert("Ethernet0:10.0.0.5", neigh("00:00:00:00:00:05", "IPv4"), false), AppTableCache::NEW);
+    /* Delete of an unknown entry is a no-op */
+    EXPECT_EQ(cache.insert("Ethernet0:10.0.0.6", {}, true), AppTableCache::DELETE);
+    /* Fields are compared in order */
+    EXPECT_EQ(cache.insert("Ethernet0:fc00::4", { { "family", "IPv6" }, { "neigh", "00:00:00:00:00:04" } }, false),
+              AppTableCache::NEW);
+
+    auto e = entries(cache);
+    ASSERT_EQ(e.size(), 5u);
+    EXPECT_EQ(e["Ethernet0:10.0.0.1"].first, AppTableCache::SAME);
+    EXPECT_TRUE(e["Ethernet0:10.0.0.1"].second.empty());
+    EXPECT_EQ(e["Ethernet0:10.0.0.2"], make_pair(AppTableCache::NEW, neigh("00:00:00:00:00:22", "IPv4")));
+    EXPECT_EQ(e["Ethernet0:10.0.0.3"], make_pair(AppTableCache::DELETE, neigh("00:00:00:00:00:03", "IPv4")));
+    EXPECT_EQ(e["Ethernet0:10.0.0.5"], make_pair(AppTableCache::NEW, neigh("00:00:00:00:00:05", "IPv4")));
+    EXPECT_EQ(e["Ethernet0:fc00::4"].second, (vector<FieldValueTuple>{ { "family", "IPv6" }, { "neigh", "00:00:00:00:00:04" } }));
+
+    EXPECT_EQ(AppTableCache::getStateName(AppTableCache::STALE), "STALE");
+    EXPECT_EQ(AppTableCache::getStateName(AppTableCache::DELETE), "DELETE");
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(warmrestartcache, packing)
+{
+    AppTableCache cache;
+
+    /* Values longer than a single length byte, and empty ones */
+    vector<FieldValueTuple> fv = { { "a", string(300, 'x') }, { "b", "" }, { "c", string(127, 'y') }, { "d", string(128, 'z') } };
+    cache.restore("key", fv);
+
+    auto e = entries(cache);
+    EXPECT_EQ(e["key"], make_pair(AppTableCache::STALE, fv));
+
+    EXPECT_EQ(cache.insert("key", fv, false), AppTableCache::SAME);
+    fv[1].second = "b";
+    EXPECT_EQ(cache.insert("key", fv, false), AppTableCache::NEW);
+    EXPECT_EQ(entries(cache)["key"].second, fv);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <map>
+#include "warmRestartReconciler.h"
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    vector<FieldValueTuple> route(const string &nexthop, const string &ifname)
+    {
+        return { { "nexthop", nexthop }, { "ifname", ifname } };
+    }
+
+    /* Operations pushed down, "op key" to values */
+    map<string, vector<FieldValueTuple>> reconcile(WarmStartReconciler &reconciler, WarmStartReconciler::Stats &stats)
+    {
+        map<string, vector<FieldValueTuple>> ops;
+        stats = reconciler.reconcile([&](const string &key, const string &op, const vector<FieldValueTuple> &values) {
+            EXPECT_TRUE(ops.emplace(op + " " + key, values).second);
+        });
+        return ops;
+    }
+}
+
+TEST(warmstartreconciler, digest)
+{
+    auto digest = WarmStartReconciler::digest(route("10.1.1.1,10.1.1.2", "eth1,eth2"));
+
+    /* Order of the fields and of the values within a field don't matter */
+    EXPECT_EQ(WarmStartReconciler::digest({ { "ifname", "eth2,eth1" }, { "nexthop", "10.1.1.2,10.1.1.1" } }), digest);
+
+    EXPECT_NE(WarmStartReconciler::digest(route("10.1.1.1,10.1.1.3", "eth1,eth2")), digest);
+    EXPECT_NE(WarmStartReconciler::digest(route("10.1.1.1", "eth1")), digest);
+    EXPECT_NE(WarmStartReconciler::digest({ { "nexthop", "10.1.1.1,10.1.1.2" } }), digest);
+    EXPECT_NE(WarmStartReconciler::digest({ { "ab", "c" } }), WarmStartReconciler::digest({ { "a", "bc" } }));
+}
+
+TEST(warmstartreconciler, reconcile)
+{
+    WarmStartReconciler reconciler;
+    WarmStartReconciler::Stats stats;
+
+    reconciler.addRestored("1.0.0.0/24", route("10.1.1.1", "eth1"));
+    reconciler.addRestored("2.0.0.0/24", route("10.1.1.1,10.1.1.2", "eth1,eth2"));
+    reconciler.addRestored("3.0.0.0/24", route("10.1.1.1", "eth1"));
+    reconciler.addRestored("4.0.0.0/24", route("10.1.1.1", "eth1"));
+    reconciler.addRestored("5.0.0.0/24", route("10.1.1.1", "eth1"));
+    EXPECT_EQ(reconciler.getRestored(), 5u);
+
+    /* 1.0.0.0/24 is stale */
+    reconciler.refresh(make_tuple("2.0.0.0/24", SET_COMMAND, route("10.1.1.2,10.1.1.1", "eth2,eth1")));
+    reconciler.refresh(make_tuple("3.0.0.0/24", SET_COMMAND, route("10.1.1.3", "eth3")));
+    reconciler.refresh(make_tuple("4.0.0.0/24", DEL_COMMAND, vector<FieldValueTuple>()));
+    /* Changed and changed back */
+    reconciler.refresh(make_tuple("5.0.0.0/24", SET_COMMAND, route("10.1.1.3", "eth3")));
+    reconciler.refresh(make_tuple("5.0.0.0/24", SET_COMMAND, route("10.1.1.1", "eth1")));
+    reconciler.refresh(make_tuple("6.0.0.0/24", SET_COMMAND, route("10.1.1.6", "eth6")));
+    reconciler.refresh(make_tuple("7.0.0.0/24", SET_COMMAND, route("10.1.1.7", "eth7")));
+    reconciler.refresh(make_tuple("7.0.0.0/24", DEL_COMMAND, vector<FieldValueTuple>()));
+
+    auto ops = reconcile(reconciler, stats);
+
+    map<string, vector<FieldValueTuple>> expected = {
+        { "DEL 1.0.0.0/24", {} },
+        { "SET 3.0.0.0/24", route("10.1.1.3", "eth3") },
+        { "DEL 4.0.0.0/24", {} },
+        { "SET 6.0.0.0/24", route("10.1.1.6", "eth6") },
+    };
+    EXPECT_EQ(ops, expected);
+
+    EXPECT_EQ(stats.restored, 5u);
+    EXPECT_EQ(stats.stale, 1u);
+    EXPECT_EQ(stats.deleted, 1u);
+    EXPECT_EQ(stats.updated, 1u);
+    EXPECT_EQ(stats.unchanged, 2u);
+    EXPECT_EQ(stats.added, 1u);
+    EXPECT_EQ(stats.discarded, 1u);
+
+    /* Cleared by reconciliation */
+    EXPECT_EQ(reconciler.getRestored(), 0u);
+    EXPECT_TRUE(reconcile(reconciler, stats).empty());
+}
+
+TEST(warmstartreconciler, refreshBeforeRestore)
+{
+    WarmStartReconciler reconciler;
+    WarmStartReconciler::Stats stats;
+
+    reconciler.refresh(make_tuple("1.0.0.0/24", SET_COMMAND, route("10.1.1.1", "eth1")));
+    reconciler.refresh(make_tuple("2.0.0.0/24", SET_COMMAND, route("10.1.1.1", "eth1")));
+    reconciler.addRestored("1.0.0.0/24", route("10.1.1.1", "eth1"));
+    reconciler.addRestored("2.0.0.0/24", route("10.1.1.2", "eth2"));
+
+    auto ops = reconcile(reconciler, stats);
+
+    ASSERT_EQ(ops.size(), 1u);
+    EXPECT_EQ(ops.begin()->first, "SET 2.0.0.0/24");
+    EXPECT_EQ(stats.unchanged, 1u);
+    EXPECT_EQ(stats.updated, 1u);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "watermarkaggregator.h"
+
+using namespace std;
+
+namespace
+{
+    const sai_object_id_t Q1 = 0x15000000000001;
+    const sai_object_id_t Q2 = 0x15000000000002;
+    const string SHARED = "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES";
+
+    uint64_t get(const WatermarkAggregator &aggregator, WatermarkType type, sai_object_id_t id)
+    {
+        uint64_t value = 0;
+        EXPECT_TRUE(aggregator.get(type, id, SHARED, value));
+        return value;
+    }
+}
+
+TEST(watermarkaggregator, maxima)
+{
+    WatermarkAggregator aggregator;
+
+    aggregator.update(Q1, SHARED, 100);
+    aggregator.update(Q1, SHARED, 50);
+    EXPECT_EQ(get(aggregator, WM_PERIODIC, Q1), 100u);
+    EXPECT_EQ(get(aggregator, WM_PERSISTENT, Q1), 100u);
+    EXPECT_EQ(get(aggregator, WM_USER, Q1), 100u);
+
+    aggregator.clear(WM_PERIODIC, SHARED, { Q1 });
+    aggregator.update(Q1, SHARED, 30);
+    EXPECT_EQ(get(aggregator, WM_PERIODIC, Q1), 30u);
+    EXPECT_EQ(get(aggregator, WM_PERSISTENT, Q1), 100u);
+
+    aggregator.update(Q1, SHARED, 200);
+    EXPECT_EQ(get(aggregator, WM_PERIODIC, Q1), 200u);
+    EXPECT_EQ(get(aggregator, WM_USER, Q1), 200u);
+
+    /* Published values are only used until the first sample */
+    aggregator.load(WM_PERSISTENT, Q2, SHARED, 500);
+    aggregator.update(Q2, SHARED, 10);
+    aggregator.load(WM_PERSISTENT, Q2, SHARED, 1000);
+    EXPECT_EQ(get(aggregator, WM_PERSISTENT, Q2), 500u);
+    EXPECT_EQ(get(aggregator, WM_PERIODIC, Q2), 10u);
+}
+
+TEST(watermarkaggregator, updates)
+{
+    WatermarkAggregator aggregator;
+
+    EXPECT_FALSE(aggregator.hasUpdates());
+
+    aggregator.update(Q1, SHARED, 100);
+    aggregator.update(Q2, SHARED, 0);
+    EXPECT_TRUE(aggregator.hasUpdates());
+    EXPECT_EQ(aggregator.getUpdates().size(), 6u);
+    EXPECT_FALSE(aggregator.hasUpdates());
+
+    /* Samples below the maxima are not published again */
+    aggregator.update(Q1, SHARED, 100);
+    aggregator.update(Q1, SHARED, 20);
+    EXPECT_FALSE(aggregator.hasUpdates());
+
+    /* Cleared watermarks are published even if already zero */
+    aggregator.clear(WM_USER, SHARED, { Q1, Q2 });
+    auto updates = aggregator.getUpdates();
+    ASSERT_EQ(updates.size(), 2u);
+    for (const auto &update : updates)
+    {
+        EXPECT_EQ(update.type, WM_USER);
+        EXPECT_EQ(update.value, 0u);
+        EXPECT_EQ(update.stat, SHARED);
+    }
+
+    aggregator.update(Q1, SHARED, 60);
+    updates = aggregator.getUpdates();
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].type, WM_USER);
+    EXPECT_EQ(updates[0].id, Q1);
+    EXPECT_EQ(updates[0].value, 60u);
+}
+
+TEST(watermarkaggregator, clear)
+{
+    WatermarkAggregator aggregator;
+
+    aggregator.update(Q1, SHARED, 100);
+    aggregator.getUpdates();
+
+    /* The last poll read again after a clear does not come back */
+    aggregator.clear(WM_USER, SHARED, { Q1 });
+    aggregator.getUpdates();
+    aggregator.update(Q1, SHARED, 100);
+    aggregator.update(Q1, SHARED, 100);
+    EXPECT_FALSE(aggregator.hasUpdates());
+    EXPECT_EQ(get(aggregator, WM_USER, Q1), 0u);
+    EXPECT_EQ(get(aggregator, WM_PERSISTENT, Q1), 100u);
+
+    /* A new poll is folded in */
+    aggregator.update(Q1, SHARED, 40);
+    EXPECT_EQ(get(aggregator, WM_USER, Q1), 40u);
+
+    /* Then equal samples are folded in again, as they no longer follow a clear */
+    aggregator.clear(WM_PERIODIC, SHARED, { Q1 });
+    aggregator.update(Q1, SHARED, 40);
+    EXPECT_EQ(get(aggregator, WM_PERIODIC, Q1), 0u);
+    aggregator.update(Q1, SHARED, 10);
+    aggregator.update(Q1, SHARED, 10);
+    EXPECT_EQ(get(aggregator, WM_PERIODIC, Q1), 10u);
+
+    /* Cleared before any sample */
+    aggregator.clear(WM_USER, SHARED, { Q2 });
+    aggregator.update(Q2, SHARED, 70);
+    EXPECT_EQ(get(aggregator, WM_USER, Q2), 70u);
+}
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <string>
 #include "logger.h"
 #include "schema.h"
@@ -7,15 +8,6 @@
 using namespace std;
 using namespace swss;
 
-// Translation map from enum to string for cache entry state.
-const AppRestartAssist::cache_state_map AppRestartAssist::cacheStateMap =
-{
-    {STALE,     "STALE"},
-    {SAME,      "SAME"},
-    {NEW,       "NEW"},
-    {DELETE,    "DELETE"}
-};
-
 AppRestartAssist::AppRestartAssist(RedisPipeline *pipeline,
     const std::string &appName, const std::string &dockerName,
     ProducerStateTable *psTable, const uint32_t defaultWarmStartTimerValue):
@@ -23,6 +15,8 @@ AppRestartAssist::AppRestartAssist(RedisPipeline *pipeline,
     m_appName(appName),
     m_dockerName(dockerName),
     m_psTable(psTable),
+    m_pipeline(pipeline),
+    m_reconcileTable(pipeline, psTable->getTableName(), true),
     m_warmStartTimer(timespec{0, 0})
 {
     WarmStart::initialize(m_appName, m_dockerName);
@@ -87,35 +81,15 @@ string AppRestartAssist::joinVectorString(const vector<FieldValueTuple> &fv)
     return s;
 }
 
-// Set the cache entry state
-void AppRestartAssist::setCacheEntryState(std::vector<FieldValueTuple> &fvVector,
-    cache_state_t state)
-{
-    fvVector.back().second = cacheStateMap.at(state);
-}
-
-// Get the cache entry state
-AppRestartAssist::cache_state_t AppRestartAssist::getCacheEntryState(const std::vector<FieldValueTuple> &fvVector)
-{
-    for (auto &iter : cacheStateMap)
-    {
-        if (fvVector.back().second == iter.second)
-        {
-            return iter.first;
-        }
-    }
-    throw std::logic_error("cache entry state is invalid");
-}
-
-// Read table from APPDB and append stale flag then insert to cachemap
+// Read table from APPDB and insert to cache as STALE entries
 void AppRestartAssist::readTableToMap()
 {
+    auto start = chrono::steady_clock::now();
     vector<string> keys;
 
     m_appTable.getKeys(keys);
-    FieldValueTuple state(CACHE_STATE_FIELD, "");
 
-    for (const auto &key: keys)
+    for (auto &key: keys)
     {
         vector<FieldValueTuple> fv;
 
@@ -125,81 +99,31 @@ void AppRestartAssist::readTableToMap()
             continue;
         }
 
-        fv.push_back(state);
-        setCacheEntryState(fv, STALE);
-
-        string s = joinVectorString(fv);
+        // insert to the cache
+        appTableCache.restore(move(key), fv);
+    }
 
-        SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
-               "%s", m_appTableName.c_str(), key.c_str(), s.c_str());
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
 
-        // insert to the cache map
-        appTableCacheMap[key] = fv;
-    }
     WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
-    SWSS_LOG_NOTICE("Restored appDB table to internal cache map");
+    SWSS_LOG_NOTICE("Restored %zu entries of appDB table %s to internal cache map in %lld ms",
+            appTableCache.size(), m_appTableName.c_str(), (long long)elapsed.count());
     return;
 }
 
-/*
- * Check and insert to CacheMap Logic:
- * if delete_key:
- *  mark the entry as "DELETE";
- * else:
- *  if key exist {
- *    if it has different value: update with "NEW" flag.
- *    if same value:  mark it as "SAME";
- *  } else {
- *    insert with "NEW" flag.
- *   }
- */
-void AppRestartAssist::insertToMap(string key, vector<FieldValueTuple> fvVector, bool delete_key)
+void AppRestartAssist::insertToMap(const string &key, const vector<FieldValueTuple> &fvVector, bool delete_key)
 {
-    SWSS_LOG_INFO("Received message %s, key: %s, "
-            "%s, delete = %d", m_appTableName.c_str(), key.c_str(), joinVectorString(fvVector).c_str(), delete_key);
-
+    auto state = appTableCache.insert(key, fvVector, delete_key);
 
-    auto found = appTableCacheMap.find(key);
-
-    if (delete_key)
+    // Only the entries to reconcile are logged, the field-values are only formatted then
+    if (state == AppTableCache::DELETE)
     {
         SWSS_LOG_NOTICE("%s, delete key: %s, ", m_appTableName.c_str(), key.c_str());
-        /* mark it as DELETE if exist, otherwise, no-op */
-        if (found != appTableCacheMap.end())
-        {
-            setCacheEntryState(found->second, DELETE);
-        }
     }
-    else if (found != appTableCacheMap.end())
+    else if (state == AppTableCache::NEW)
     {
-        // check only the original vector range (exclude cache-state field/value)
-        if(!equal(fvVector.begin(), fvVector.end(), found->second.begin()))
-        {
-            SWSS_LOG_NOTICE("%s, found key: %s, new value ", m_appTableName.c_str(), key.c_str());
-
-            FieldValueTuple state(CACHE_STATE_FIELD, "");
-            fvVector.push_back(state);
-
-            // mark as NEW flag
-            setCacheEntryState(fvVector, NEW);
-            appTableCacheMap[key] = fvVector;
-        }
-        else
-        {
-            SWSS_LOG_INFO("%s, found key: %s, same value", m_appTableName.c_str(), key.c_str());
-
-            // mark as SAME flag
-            setCacheEntryState(found->second, SAME);
-        }
-    }
-    else
-    {
-        // not found, mark the entry as NEW and insert to map
-        SWSS_LOG_NOTICE("%s, not found key: %s, new", m_appTableName.c_str(), key.c_str());
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
-        fvVector.push_back(state);
-        setCacheEntryState(fvVector, NEW);
-        appTableCacheMap[key] = fvVector;
+        SWSS_LOG_NOTICE("%s, key: %s, new value %s", m_appTableName.c_str(), key.c_str(),
+                joinVectorString(fvVector).c_str());
     }
 
     return;
@@ -207,51 +131,63 @@ void AppRestartAssist::insertToMap(string key, vector<FieldValueTuple> fvVector,
 
 /*
  * Reconcile logic:
- *  iterate throught the cache map
+ *  iterate throught the cache
  *  if the entry has "SAME" flag, do nothing
  *  if has "STALE/DELETE" flag, delete it from appDB.
  *  else if "NEW" flag,  add it to appDB
- *  else, throw (should never happen)
+ *
+ * The diff is written to a buffered producer table and pushed to appDB in a
+ * single pipeline flush.
  */
 void AppRestartAssist::reconcile()
 {
-
     SWSS_LOG_ENTER();
-    for (auto iter = appTableCacheMap.begin(); iter != appTableCacheMap.end(); ++iter )
-    {
-        string s = joinVectorString(iter->second);
-        auto state = getCacheEntryState(iter->second);
 
-        if (state == SAME)
+    auto start = chrono::steady_clock::now();
+    size_t same = 0, stale = 0, deleted = 0, added = 0;
+
+    appTableCache.forEach([&](const string &key, cache_state_t state, const vector<FieldValueTuple> &fv)
+    {
+        if (state == AppTableCache::SAME)
         {
-            SWSS_LOG_INFO("%s SAME, key: %s, %s",
-                    m_appTableName.c_str(), iter->first.c_str(), s.c_str());
-            continue;
+            same++;
+            return;
         }
-        else if (state == STALE || state == DELETE)
-        {
-            SWSS_LOG_NOTICE("%s STALE/DELETE, key: %s, %s",
-                    m_appTableName.c_str(), iter->first.c_str(), s.c_str());
 
-            //delete from appDB
-            m_psTable->del(iter->first);
-        }
-        else if (state == NEW)
+        SWSS_LOG_NOTICE("%s %s, key: %s, %s%s:%s, ",
+                m_appTableName.c_str(), AppTableCache::getStateName(state).c_str(), key.c_str(),
+                joinVectorString(fv).c_str(), CACHE_STATE_FIELD.c_str(),
+                AppTableCache::getStateName(state).c_str());
+
+        if (state == AppTableCache::STALE || state == AppTableCache::DELETE)
         {
-            SWSS_LOG_NOTICE("%s NEW, key: %s, %s",
-                    m_appTableName.c_str(), iter->first.c_str(), s.c_str());
+            (state == AppTableCache::STALE ? stale : deleted)++;
 
-            //add to appDB, exclude the state
-            iter->second.pop_back();
-            m_psTable->set(iter->first, iter->second);
+            //delete from appDB
+            m_reconcileTable.del(key);
         }
         else
         {
-            throw std::logic_error("cache entry state is invalid");
+            added++;
+
+            //add to appDB
+            m_reconcileTable.set(key, fv);
         }
-    }
-    // reconcile finished, clear the map, mark the warmstart state
-    appTableCacheMap.clear();
+    });
+
+    auto diffed = chrono::steady_clock::now();
+    m_pipeline->flush();
+    auto flushed = chrono::steady_clock::now();
+
+    SWSS_LOG_NOTICE("Reconciled %s: %zu same, %zu stale, %zu deleted, %zu new entries "
+            "in %lld ms (diff %lld ms, flush %lld ms)", m_appTableName.c_str(),
+            same, stale, deleted, added,
+            (long long)chrono::duration_cast<chrono::milliseconds>(flushed - start).count(),
+            (long long)chrono::duration_cast<chrono::milliseconds>(diffed - start).count(),
+            (long long)chrono::duration_cast<chrono::milliseconds>(flushed - diffed).count());
+
+    // reconcile finished, clear the cache, mark the warmstart state
+    appTableCache.clear();
     WarmStart::setWarmStartState(m_appName, WarmStart::RECONCILED);
     m_warmStartInProgress = false;
     return;
@@ -8,6 +8,7 @@
 #include "producerstatetable.h"
 #include "selectabletimer.h"
 #include "select.h"
+#include "warmRestartCache.h"
 
 namespace swss {
 
@@ -58,26 +59,15 @@ public:
         ProducerStateTable *psTable, const uint32_t defaultWarmStartTimerValue = 0);
     virtual ~AppRestartAssist();
 
-    /*
-     * cache entry state
-     * STALE : Default in the cache, if no refresh for this entry,it is STALE
-     * SAME  : Same entry was added to cache later
-     * NEW   : New entry was added to cache later
-     * DELETE: Entry was deleted later
-     */
-    enum cache_state_t
-    {
-        STALE	= 0,
-        SAME 	= 1,
-        NEW 	= 2,
-        DELETE  = 3
-    };
+    // cache entry state, see AppTableCache
+    typedef AppTableCache::cache_state_t cache_state_t;
+
     // These functions were used as described in the class description
     void startReconcileTimer(Select &s);
     void stopReconcileTimer(Select &s);
     bool checkReconcileTimer(Selectable *s);
     void readTableToMap(void);
-    void insertToMap(std::string key, std::vector<FieldValueTuple> fvVector, bool delete_key);
+    void insertToMap(const std::string &key, const std::vector<FieldValueTuple> &fvVector, bool delete_key);
     void reconcile(void);
     bool isWarmStartInProgress(void)
     {
@@ -85,9 +75,6 @@ public:
     }
 
 private:
-    typedef std::map<cache_state_t, std::string> cache_state_map;
-    // Enum to string translation map
-    static const cache_state_map cacheStateMap;
     const std::string CACHE_STATE_FIELD = "cache-state";
 
     /*
@@ -96,25 +83,23 @@ private:
      * Precedence ascent order: Default -> loading class with value -> configuration
      */
     static const uint32_t DEFAULT_INTERNAL_TIMER_VALUE = 5;
-    typedef std::unordered_map<std::string, std::vector<swss::FieldValueTuple>> AppTableMap;
 
-    // cache map to store temperary application table
-    AppTableMap appTableCacheMap;
+    // cache to store temperary application table
+    AppTableCache appTableCache;
 
     Table m_appTable;                 // table handler
     std::string m_dockerName;         // docker name of the application
     std::string m_appName;            // application name
     ProducerStateTable *m_psTable;    // produce state table handler
+    RedisPipeline *m_pipeline;        // pipeline of the application table
+    ProducerStateTable m_reconcileTable; // buffered producer for the reconcile diff
     std::string m_appTableName;       // application table name
 
     bool m_warmStartInProgress;       // indicate if warm start is in progress
     uint32_t m_reconcileTimer;        // reconcile timer value
     SelectableTimer m_warmStartTimer; // reconcile timer
 
-    // Set or get cache entry state
     std::string joinVectorString(const std::vector<FieldValueTuple> &fv);
-    void setCacheEntryState(std::vector<FieldValueTuple> &fvVector, cache_state_t state);
-    cache_state_t getCacheEntryState(const std::vector<FieldValueTuple> &fvVector);
 };
 
 }
@@ -0,0 +1,181 @@
+#include <stdexcept>
+#include "warmRestartCache.h"
+
+using namespace std;
+using namespace swss;
+
+void AppTableCache::restore(string key, const vector<FieldValueTuple> &fvVector)
+{
+    Entry &entry = m_entries[move(key)];
+
+    entry.schema = internSchema(fvVector);
+    entry.state = STALE;
+    entry.values = pack(fvVector);
+}
+
+/*
+ * Check and insert to cache logic:
+ * if delete_key:
+ *  mark the entry as "DELETE";
+ * else:
+ *  if key exist {
+ *    if it has different value: update with "NEW" flag.
+ *    if same value:  mark it as "SAME";
+ *  } else {
+ *    insert with "NEW" flag.
+ *   }
+ */
+AppTableCache::cache_state_t AppTableCache::insert(const string &key, const vector<FieldValueTuple> &fvVector, bool delete_key)
+{
+    auto found = m_entries.find(key);
+
+    if (delete_key)
+    {
+        /* mark it as DELETE if exist, otherwise, no-op */
+        if (found != m_entries.end())
+        {
+            found->second.state = DELETE;
+        }
+        return DELETE;
+    }
+
+    uint32_t schema = internSchema(fvVector);
+    string values = pack(fvVector);
+
+    if (found != m_entries.end())
+    {
+        Entry &entry = found->second;
+        if (entry.schema == schema && entry.values == values)
+        {
+            entry.state = SAME;
+            return SAME;
+        }
+
+        entry.schema = schema;
+        entry.state = NEW;
+        entry.values = move(values);
+        return NEW;
+    }
+
+    m_entries.emplace(key, Entry{ schema, NEW, move(values) });
+    return NEW;
+}
+
+void AppTableCache::forEach(const EntryFunc &func) const
+{
+    static const vector<FieldValueTuple> empty;
+
+    for (const auto &it : m_entries)
+    {
+        if (it.second.state == SAME)
+        {
+            func(it.first, SAME, empty);
+        }
+        else
+        {
+            func(it.first, it.second.state, unpack(it.second));
+        }
+    }
+}
+
+size_t AppTableCache::size() const
+{
+    return m_entries.size();
+}
+
+void AppTableCache::clear()
+{
+    unordered_map<string, Entry>().swap(m_entries);
+    m_fields.clear();
+    m_fieldIds.clear();
+    m_schemas.clear();
+    m_schemaIds.clear();
+}
+
+const string &AppTableCache::getStateName(cache_state_t state)
+{
+    static const string names[] = { "STALE", "SAME", "NEW", "DELETE" };
+
+    if (state > DELETE)
+    {
+        throw logic_error("cache entry state is invalid");
+    }
+    return names[state];
+}
+
+uint32_t AppTableCache::internSchema(const vector<FieldValueTuple> &fvVector)
+{
+    vector<uint32_t> schema;
+    schema.reserve(fvVector.size());
+
+    for (const auto &fv : fvVector)
+    {
+        auto field = m_fieldIds.find(fvField(fv));
+        if (field == m_fieldIds.end())
+        {
+            field = m_fieldIds.emplace(fvField(fv), (uint32_t)m_fields.size()).first;
+            m_fields.push_back(fvField(fv));
+        }
+        schema.push_back(field->second);
+    }
+
+    auto found = m_schemaIds.find(schema);
+    if (found != m_schemaIds.end())
+    {
+        return found->second;
+    }
+
+    uint32_t id = (uint32_t)m_schemas.size();
+    m_schemas.push_back(schema);
+    m_schemaIds.emplace(move(schema), id);
+    return id;
+}
+
+// Each value is preceded by its length, 7 bits per byte
+string AppTableCache::pack(const vector<FieldValueTuple> &fvVector)
+{
+    string packed;
+
+    for (const auto &fv : fvVector)
+    {
+        const string &value = fvValue(fv);
+
+        size_t length = value.size();
+        do
+        {
+            uint8_t byte = (uint8_t)(length & 0x7f);
+            length >>= 7;
+            packed.push_back((char)(length ? byte | 0x80 : byte));
+        } while (length);
+
+        packed.append(value);
+    }
+
+    return packed;
+}
+
+vector<FieldValueTuple> AppTableCache::unpack(const Entry &entry) const
+{
+    const auto &schema = m_schemas[entry.schema];
+    vector<FieldValueTuple> fvVector;
+    fvVector.reserve(schema.size());
+
+    size_t pos = 0;
+    for (auto field : schema)
+    {
+        size_t length = 0;
+        int shift = 0;
+        uint8_t byte;
+        do
+        {
+            byte = (uint8_t)entry.values[pos++];
+            length |= (size_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        fvVector.emplace_back(m_fields[field], entry.values.substr(pos, length));
+        pos += length;
+    }
+
+    return fvVector;
+}
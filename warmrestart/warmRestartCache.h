@@ -0,0 +1,87 @@
+#ifndef __WARM_RESTART_CACHE__
+#define __WARM_RESTART_CACHE__
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Compact cache of an application table during warm restart.
+ *
+ * Each entry only holds the id of its interned list of field names, its
+ * values packed into a single length-prefixed string, and its cache state.
+ * Entries are compared on their packed form, field names and values in order.
+ */
+class AppTableCache
+{
+public:
+    /*
+     * cache entry state
+     * STALE : Default in the cache, if no refresh for this entry,it is STALE
+     * SAME  : Same entry was added to cache later
+     * NEW   : New entry was added to cache later
+     * DELETE: Entry was deleted later
+     */
+    enum cache_state_t : uint8_t
+    {
+        STALE   = 0,
+        SAME    = 1,
+        NEW     = 2,
+        DELETE  = 3
+    };
+
+    typedef std::function<void(const std::string &key, cache_state_t state,
+                               const std::vector<FieldValueTuple> &fvVector)> EntryFunc;
+
+    // Insert an entry read from the application table, as STALE
+    void restore(std::string key, const std::vector<FieldValueTuple> &fvVector);
+
+    /*
+     * Insert a refreshed entry and return its state, the key is only copied
+     * for new entries. Deleting an entry not in the cache is a no-op, DELETE
+     * is still returned.
+     */
+    cache_state_t insert(const std::string &key, const std::vector<FieldValueTuple> &fvVector, bool delete_key);
+
+    /*
+     * Call func for each entry. The field-values are only unpacked for the
+     * entries to reconcile: they are empty for SAME entries.
+     */
+    void forEach(const EntryFunc &func) const;
+
+    size_t size() const;
+    void clear();
+
+    static const std::string &getStateName(cache_state_t state);
+
+private:
+    struct Entry
+    {
+        uint32_t      schema;   // id of the list of field names
+        cache_state_t state;
+        std::string   values;   // values packed with their length
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;
+
+    // Interned field names and lists of field names
+    std::vector<std::string> m_fields;
+    std::unordered_map<std::string, uint32_t> m_fieldIds;
+    std::vector<std::vector<uint32_t>> m_schemas;
+    std::map<std::vector<uint32_t>, uint32_t> m_schemaIds;
+
+    uint32_t internSchema(const std::vector<FieldValueTuple> &fvVector);
+    static std::string pack(const std::vector<FieldValueTuple> &fvVector);
+    std::vector<FieldValueTuple> unpack(const Entry &entry) const;
+};
+
+}
+
+#endif
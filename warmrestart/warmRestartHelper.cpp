@@ -1,4 +1,5 @@
 #include <cassert>
+#include <chrono>
 #include <sstream>
 
 #include "warmRestartHelper.h"
@@ -7,11 +8,16 @@
 using namespace swss;
 
 
+/* Operations pushed to AppDB before flushing the pipeline during reconciliation */
+#define RECONCILE_BATCH_SIZE 1024
+
+
 WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  ProducerStateTable *syncTable,
                                  const std::string  &syncTableName,
                                  const std::string  &dockerName,
                                  const std::string  &appName) :
+    m_pipeline(pipeline),
     m_restorationTable(pipeline, syncTableName, false),
     m_syncTable(syncTable),
     m_syncTableName(syncTableName),
@@ -65,8 +71,7 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
-    m_refreshMap.clear();
+    m_reconciler.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
     m_enabled = enabled;
@@ -104,13 +109,24 @@ bool WarmStartHelper::runRestoration()
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    /* Entries are digested one at a time, the table is never held in memory */
+    std::vector<std::string> keys;
+    m_restorationTable.getKeys(keys);
+
+    for (const auto &key : keys)
+    {
+        std::vector<FieldValueTuple> values;
+        if (m_restorationTable.get(key, values))
+        {
+            m_reconciler.addRestored(key, values);
+        }
+    }
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (!m_reconciler.getRestored())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -122,7 +138,7 @@ bool WarmStartHelper::runRestoration()
 
     SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
                     "application.",
-                    m_restorationVector.size(),
+                    m_reconciler.getRestored(),
                     m_appName.c_str());
 
     setState(WarmStart::RESTORED);
@@ -136,9 +152,7 @@ bool WarmStartHelper::runRestoration()
 
 void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
 {
-    const std::string key = kfvKey(kfv);
-
-    m_refreshMap[key] = kfv;
+    m_reconciler.refresh(kfv);
 }
 
 
@@ -148,6 +162,9 @@ void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
  * generated by the application once it completes its restart cycle. If a
  * state-diff is found between these two, we will be honoring the refreshed
  * one received from the application, and will proceed to push it down to AppDB.
+ *
+ * The diff is pushed down in batches of RECONCILE_BATCH_SIZE operations, so
+ * that orchagent starts processing it while it is still being written.
  */
 void WarmStartHelper::reconcile(void)
 {
@@ -156,102 +173,40 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
-    {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
-
-        auto iter = m_refreshMap.find(restoredKey);
-
-        /*
-         * If the restored element is not found in the refreshMap, we must
-         * push a delete operation for this entry.
-         */
-        if (iter == m_refreshMap.end())
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+    auto start = std::chrono::steady_clock::now();
+    size_t pending = 0;
 
-            m_syncTable->del(restoredKey);
-            continue;
-        }
-
-        /*
-         * If an explicit delete request is sent by the application, process it
-         * right away.
-         */
-        else if (kfvOp(iter->second) == DEL_COMMAND)
+    auto stats = m_reconciler.reconcile([&](const std::string                  &key,
+                                            const std::string                  &op,
+                                            const std::vector<FieldValueTuple> &values)
+    {
+        if (op == DEL_COMMAND)
         {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
-
-            m_syncTable->del(restoredKey);
+            m_syncTable->del(key);
         }
-
-        /*
-         * If a matching entry is found in refreshMap, proceed to compare it
-         * with its restored counterpart.
-         */
         else
         {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
-
-            if (compareAllFV(restoredFV, refreshedFV))
-            {
-                SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
-                                printKFV(refreshedKey, refreshedFV).c_str());
-
-                m_syncTable->set(refreshedKey, refreshedFV);
-            }
-            else
-            {
-                SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
-                              "existing entry %s",
-                              printKFV(refreshedKey, refreshedFV).c_str());
-            }
+            m_syncTable->set(key, values);
         }
 
-        /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
-    }
-
-    /*
-     * Iterate through all the entries left in the refreshMap, which correspond
-     * to brand-new entries to be pushed down to AppDB.
-     */
-    for (auto &kfv : m_refreshMap)
-    {
-        auto refreshedKey = kfvKey(kfv.second);
-        auto refreshedOp  = kfvOp(kfv.second);
-        auto refreshedFV  = kfvFieldsValues(kfv.second);
-
-        /*
-         * During warm-reboot, apps could receive an 'add' and a 'delete' for an
-         * entry that does not exist in AppDB. In these cases we must prevent the
-         * 'delete' from being pushed down to AppDB, so we are handling this case
-         * differently than the 'add' one.
-         */
-        if(refreshedOp == DEL_COMMAND)
+        if (++pending >= RECONCILE_BATCH_SIZE)
         {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: discarding non-existing"
-                            " entry %s\n",
-                            refreshedKey.c_str());
+            m_pipeline->flush();
+            pending = 0;
         }
-        else
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: introducing new entry %s",
-                            printKFV(refreshedKey, refreshedFV).c_str());
+    });
 
-            m_syncTable->set(refreshedKey, refreshedFV);
-        }
-    }
+    m_pipeline->flush();
 
-    /* Clearing pending kfv's from refreshMap */
-    m_refreshMap.clear();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
 
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
+    SWSS_LOG_NOTICE("Warm-Restart reconciliation of %s: %zu restored entries, "
+                    "%zu stale, %zu deleted, %zu updated, %zu unchanged, %zu new, "
+                    "%zu discarded deletes, in %lld ms",
+                    m_appName.c_str(), stats.restored, stats.stale, stats.deleted,
+                    stats.updated, stats.unchanged, stats.added, stats.discarded,
+                    (long long)elapsed.count());
 
     setState(WarmStart::RECONCILED);
 
@@ -260,94 +215,6 @@ void WarmStartHelper::reconcile(void)
 }
 
 
-/*
- * Compare all field-value-tuples within two vectors.
- *
- * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
- *          v2 {nexthop: 10.1.1.2, ifname: eth2}
- *
- * Returns:
- *
- *    'false' : If the content of both 'fields' and 'values' fully match
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
-                                   const std::vector<FieldValueTuple> &v2)
-{
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
-
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
-    {
-        auto v1Iter = v1Map.find(v2fv.first);
-        /*
-         * The sizes of both tuple-vectors should always match within any
-         * given application. In other words, all fields within v1 should be
-         * also present in v2.
-         *
-         * To make this possible, every application should continue relying on a
-         * uniform schema to create/generate information. For example, fpmsyncd
-         * will be always expected to push FieldValueTuples with "nexthop" and
-         * "ifname" fields; neighsyncd is expected to make use of "family" and
-         * "neigh" fields, etc. The existing reconciliation logic will rely on
-         * this assumption.
-         */
-        assert(v1Iter != v1Map.end());
-
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-
-/*
- * Compare the values of a single field-value within two different KFVs.
- *
- * Example: s1 {nexthop: 10.1.1.1, 10.1.1.2}
- *          s2 {nexthop: 10.1.1.2, 10.1.1.1}
- *
- * Example: s1 {Ethernet1, Ethernet2}
- *          s2 {Ethernet2, Ethernet1}
- *
- * Returns:
- *
- *    'false' : If the content of both strings fully matches
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
-{
-    if (s1.size() != s2.size())
-    {
-        return true;
-    }
-
-    std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
-    std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
-
-    if (splitValuesS1.size() != splitValuesS2.size())
-    {
-        return true;
-    }
-
-    std::sort(splitValuesS1.begin(), splitValuesS1.end());
-    std::sort(splitValuesS2.begin(), splitValuesS2.end());
-
-    for (size_t i = 0; i < splitValuesS1.size(); i++)
-    {
-        if (splitValuesS1[i] != splitValuesS2[i])
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-
 /*
  * Helper method to print KFVs in a friendly fashion.
  *
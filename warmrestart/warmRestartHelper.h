@@ -13,6 +13,7 @@
 #include "table.h"
 #include "tokenize.h"
 #include "warm_restart.h"
+#include "warmRestartReconciler.h"
 
 
 namespace swss {
@@ -29,15 +30,6 @@ class WarmStartHelper {
 
     ~WarmStartHelper();
 
-    /* fvVector type to be used to host AppDB restored elements */
-    using kfvVector = std::vector<KeyOpFieldsValuesTuple>;
-
-    /*
-     * kfvMap type to be utilized to store all the new/refresh state coming
-     * from the restarting applications.
-     */
-    using kfvMap = std::unordered_map<std::string, KeyOpFieldsValuesTuple>;
-
     void setState(WarmStart::WarmStartState state);
 
     WarmStart::WarmStartState getState(void) const;
@@ -61,15 +53,10 @@ class WarmStartHelper {
 
   private:
 
-    bool compareAllFV(const std::vector<FieldValueTuple> &left,
-                      const std::vector<FieldValueTuple> &right);
-
-    bool compareOneFV(const std::string &v1, const std::string &v2);
-
-    ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
+    RedisPipeline            *m_pipeline;          // pipeline the producer-table writes to
     Table                     m_restorationTable;  // redis table to import current-state from
-    kfvVector                 m_restorationVector; // buffer struct to hold old state
-    kfvMap                    m_refreshMap;        // buffer struct to hold new state
+    ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
+    WarmStartReconciler       m_reconciler;        // digests of old state, diffs of new state
     WarmStart::WarmStartState m_state;             // cached value of warmStart's FSM state
     bool                      m_enabled;           // warm-reboot enabled/disabled status
     std::string               m_syncTableName;     // producer-table-name to sync/push state to
@@ -0,0 +1,202 @@
+#include <algorithm>
+
+#include "tokenize.h"
+#include "warmRestartReconciler.h"
+
+
+using namespace swss;
+
+
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME        = 1099511628211ULL;
+
+void hashBytes(uint64_t &hash, const std::string &s)
+{
+    for (unsigned char c : s)
+    {
+        hash ^= c;
+        hash *= FNV_PRIME;
+    }
+
+    /* Terminator, so that ("ab", "c") and ("a", "bc") differ */
+    hash ^= 0xff;
+    hash *= FNV_PRIME;
+}
+
+}
+
+
+void WarmStartReconciler::addRestored(const std::string                  &key,
+                                      const std::vector<FieldValueTuple> &values)
+{
+    Entry &entry = m_entries[key];
+
+    if (!entry.restored)
+    {
+        m_restored++;
+    }
+
+    entry.restored       = true;
+    entry.restoredDigest = digest(values);
+
+    /* Refreshed before being restored */
+    if (entry.state == REFRESHED_SET && digest(entry.values) == entry.restoredDigest)
+    {
+        entry.state = REFRESHED_SAME;
+        std::vector<FieldValueTuple>().swap(entry.values);
+    }
+}
+
+
+void WarmStartReconciler::refresh(const KeyOpFieldsValuesTuple &kfv)
+{
+    Entry &entry = m_entries[kfvKey(kfv)];
+
+    if (kfvOp(kfv) == DEL_COMMAND)
+    {
+        entry.state = REFRESHED_DEL;
+        std::vector<FieldValueTuple>().swap(entry.values);
+    }
+    else if (entry.restored && digest(kfvFieldsValues(kfv)) == entry.restoredDigest)
+    {
+        entry.state = REFRESHED_SAME;
+        std::vector<FieldValueTuple>().swap(entry.values);
+    }
+    else
+    {
+        entry.state  = REFRESHED_SET;
+        entry.values = kfvFieldsValues(kfv);
+    }
+}
+
+
+/*
+ * Restored entries not refreshed, or explicitly deleted by the application,
+ * are deleted from AppDB. Refreshed entries are pushed down when their values
+ * changed or when they were not restored. Deletes of entries that were never
+ * restored are discarded: the application could receive an 'add' and a
+ * 'delete' for an entry that does not exist in AppDB.
+ */
+WarmStartReconciler::Stats WarmStartReconciler::reconcile(const ApplyFunc &apply)
+{
+    static const std::string setOp = SET_COMMAND;
+    static const std::string delOp = DEL_COMMAND;
+    static const std::vector<FieldValueTuple> noValues;
+
+    Stats stats;
+    stats.restored = m_restored;
+
+    for (auto &it : m_entries)
+    {
+        const Entry &entry = it.second;
+
+        switch (entry.state)
+        {
+            case NOT_REFRESHED:
+                if (entry.restored)
+                {
+                    stats.stale++;
+                    apply(it.first, delOp, noValues);
+                }
+                break;
+
+            case REFRESHED_SAME:
+                stats.unchanged++;
+                break;
+
+            case REFRESHED_SET:
+                if (entry.restored)
+                {
+                    stats.updated++;
+                }
+                else
+                {
+                    stats.added++;
+                }
+                apply(it.first, setOp, entry.values);
+                break;
+
+            case REFRESHED_DEL:
+                if (entry.restored)
+                {
+                    stats.deleted++;
+                    apply(it.first, delOp, noValues);
+                }
+                else
+                {
+                    stats.discarded++;
+                }
+                break;
+        }
+    }
+
+    clear();
+
+    return stats;
+}
+
+
+void WarmStartReconciler::clear(void)
+{
+    std::unordered_map<std::string, Entry>().swap(m_entries);
+    m_restored = 0;
+}
+
+
+size_t WarmStartReconciler::getRestored(void) const
+{
+    return m_restored;
+}
+
+
+/*
+ * Digest of the field-values, equal for:
+ *
+ *   {nexthop: 10.1.1.1,10.1.1.2 | ifname: eth1,eth2}
+ *   {ifname: eth2,eth1 | nexthop: 10.1.1.2,10.1.1.1}
+ */
+uint64_t WarmStartReconciler::digest(const std::vector<FieldValueTuple> &values)
+{
+    std::vector<std::string> items;
+    items.reserve(values.size());
+
+    for (const auto &fv : values)
+    {
+        std::string item = fvField(fv);
+        item += '\0';
+
+        const std::string &value = fvValue(fv);
+        if (value.find(',') == std::string::npos)
+        {
+            item += value;
+        }
+        else
+        {
+            auto tokens = tokenize(value, ',');
+            std::sort(tokens.begin(), tokens.end());
+
+            for (size_t i = 0; i < tokens.size(); i++)
+            {
+                if (i)
+                {
+                    item += ',';
+                }
+                item += tokens[i];
+            }
+        }
+
+        items.push_back(std::move(item));
+    }
+
+    std::sort(items.begin(), items.end());
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (const auto &item : items)
+    {
+        hashBytes(hash, item);
+    }
+
+    return hash;
+}
@@ -0,0 +1,83 @@
+#ifndef __WARMRESTART_RECONCILER__
+#define __WARMRESTART_RECONCILER__
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+
+namespace swss {
+
+
+/*
+ * Reconciliation of a restored AppDB table with the state refreshed by a
+ * restarting application.
+ *
+ * Restored entries are only kept as a 64-bit digest of their field-values,
+ * insensitive to the order of the fields and of the comma separated values
+ * within a field (e.g. ECMP nexthops). Refreshed entries matching their
+ * restored digest are dropped as they arrive, so only the entries to be
+ * pushed down to AppDB keep their field-values until reconciliation.
+ */
+class WarmStartReconciler {
+  public:
+
+    struct Stats
+    {
+        size_t restored  = 0;  // entries restored from AppDB
+        size_t stale     = 0;  // restored entries not refreshed, deleted
+        size_t deleted   = 0;  // restored entries deleted by the application
+        size_t updated   = 0;  // restored entries refreshed with new values
+        size_t unchanged = 0;  // restored entries refreshed with the same values
+        size_t added     = 0;  // new entries
+        size_t discarded = 0;  // deletes of entries never restored
+    };
+
+    /* Called for each set/del to push down to AppDB */
+    using ApplyFunc = std::function<void(const std::string                  &key,
+                                         const std::string                  &op,
+                                         const std::vector<FieldValueTuple> &values)>;
+
+    void addRestored(const std::string &key, const std::vector<FieldValueTuple> &values);
+
+    void refresh(const KeyOpFieldsValuesTuple &kfv);
+
+    /* Push the diff through apply and clear the reconciler */
+    Stats reconcile(const ApplyFunc &apply);
+
+    void clear(void);
+
+    size_t getRestored(void) const;
+
+    static uint64_t digest(const std::vector<FieldValueTuple> &values);
+
+  private:
+
+    enum RefreshState : uint8_t
+    {
+        NOT_REFRESHED,
+        REFRESHED_SAME,
+        REFRESHED_SET,
+        REFRESHED_DEL
+    };
+
+    struct Entry
+    {
+        uint64_t                     restoredDigest = 0;
+        bool                         restored       = false;
+        RefreshState                 state          = NOT_REFRESHED;
+        std::vector<FieldValueTuple> values;        // refreshed values to push down
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;
+    size_t                                 m_restored = 0;
+};
+
+
+}
+
+#endif